@@ -162,4 +162,78 @@
  */
 #define CONFIG_PARSER_ENABLE_PARSE_TIME_BYTE_CODE_OPTIMIZER
 
+/**
+ * Disable the compiled code cache of eval and jerry_parse
+ */
+// #define CONFIG_PARSER_CODE_CACHE_DISABLE
+
+/**
+ * Number of entries in the compiled code cache
+ */
+#define CONFIG_PARSER_CODE_CACHE_SIZE (8)
+
+/**
+ * Maximum size of a source code stored in the compiled code cache
+ *
+ * The cache keeps a copy of the source, so longer sources are always compiled.
+ */
+#define CONFIG_PARSER_CODE_CACHE_MAX_SOURCE_SIZE (4096)
+
+/**
+ * Size of the sample ring buffer of the CPU profiler (JERRY_CPU_PROFILER), in 32 bit words (must be a power of 2)
+ */
+#define CONFIG_CPU_PROFILER_BUFFER_SIZE (64 * 1024)
+
+/**
+ * Maximum number of stack frames recorded by the CPU profiler for a sample (the innermost frames are kept)
+ */
+#define CONFIG_CPU_PROFILER_MAX_DEPTH (64)
+
+/**
+ * Number of entries in the opcode pair table of the opcode statistics (JERRY_VM_OPCODE_STATS),
+ * must be a power of 2
+ */
+#define CONFIG_VM_OPCODE_STATS_PAIR_TABLE_SIZE (4096)
+
+/**
+ * The cycles of one executed instruction out of this many (on average) are measured by
+ * the opcode statistics (JERRY_VM_OPCODE_STATS), must be a power of 2
+ *
+ * Cycles are only measured on targets with a time stamp counter (x86 and x86-64).
+ */
+#define CONFIG_VM_OPCODE_STATS_CYCLE_SAMPLE_RATE (64)
+
+/**
+ * Number of entries in the allocation site table of the heap profiler (JERRY_HEAP_PROFILER),
+ * must be a power of 2 and less than 65536
+ */
+#define CONFIG_HEAP_PROFILER_SITE_TABLE_SIZE (2048)
+
+/**
+ * Maximum number of entries in the timeline of the heap profiler (JERRY_HEAP_PROFILER)
+ *
+ * When the timeline is full, every second entry is dropped and the interval is doubled.
+ */
+#define CONFIG_HEAP_PROFILER_TIMELINE_SIZE (128)
+
+/**
+ * Number of allocated bytes between the entries of the heap profiler timeline at the start
+ */
+#define CONFIG_HEAP_PROFILER_TIMELINE_INTERVAL (16 * 1024)
+
+/**
+ * Number of events in the ring buffer of the timeline tracing (JERRY_TRACE), must be a power of 2
+ *
+ * When the buffer is full, the oldest events are overwritten.
+ */
+#define CONFIG_TRACE_BUFFER_SIZE (4096)
+
+/**
+ * The parser records line info for the byte code, and the virtual machine keeps the
+ * current instruction of each frame up to date, when any of the profilers is enabled
+ */
+#if defined (JERRY_CPU_PROFILER) || defined (JERRY_HEAP_PROFILER)
+#define JERRY_LINE_INFO
+#endif /* JERRY_CPU_PROFILER || JERRY_HEAP_PROFILER */
+
 #endif /* !CONFIG_H */
@@ -18,6 +18,7 @@
 #include "ecma-globals.h"
 #include "ecma-gc.h"
 #include "ecma-lcache.h"
+#include "jcontext.h"
 #include "jrt.h"
 #include "jmem-poolman.h"
 
@@ -64,9 +65,10 @@ JERRY_STATIC_ASSERT (sizeof (ecma_getter_setter_pointers_t) <= sizeof (uint64_t)
 /**
  * Template of an allocation routine.
  */
-#define ALLOC(ecma_type) ecma_ ## ecma_type ## _t * \
+#define ALLOC(ecma_type, category) ecma_ ## ecma_type ## _t * \
   ecma_alloc_ ## ecma_type (void) \
 { \
+  JMEM_SET_ALLOC_CATEGORY (category); \
   ecma_ ## ecma_type ## _t *p ## ecma_type = (ecma_ ## ecma_type ## _t *) jmem_pools_alloc (); \
   \
   JERRY_ASSERT (p ## ecma_type != NULL); \
@@ -86,17 +88,49 @@ JERRY_STATIC_ASSERT (sizeof (ecma_getter_setter_pointers_t) <= sizeof (uint64_t)
 /**
  * Declaration of alloc/free routine for specified ecma-type.
  */
-#define DECLARE_ROUTINES_FOR(ecma_type) \
-  ALLOC (ecma_type) \
+#define DECLARE_ROUTINES_FOR(ecma_type, category) \
+  ALLOC (ecma_type, category) \
   DEALLOC (ecma_type)
 
-DECLARE_ROUTINES_FOR (object)
-DECLARE_ROUTINES_FOR (number)
-DECLARE_ROUTINES_FOR (collection_header)
-DECLARE_ROUTINES_FOR (collection_chunk)
-DECLARE_ROUTINES_FOR (string)
-DECLARE_ROUTINES_FOR (getter_setter_pointers)
-DECLARE_ROUTINES_FOR (external_pointer)
+DECLARE_ROUTINES_FOR (object, JMEM_ALLOC_CATEGORY_OBJECT)
+DECLARE_ROUTINES_FOR (number, JMEM_ALLOC_CATEGORY_NUMBER)
+DECLARE_ROUTINES_FOR (collection_header, JMEM_ALLOC_CATEGORY_COLLECTION)
+DECLARE_ROUTINES_FOR (collection_chunk, JMEM_ALLOC_CATEGORY_COLLECTION)
+DECLARE_ROUTINES_FOR (getter_setter_pointers, JMEM_ALLOC_CATEGORY_OTHER)
+DECLARE_ROUTINES_FOR (external_pointer, JMEM_ALLOC_CATEGORY_OTHER)
+DEALLOC (string)
+
+/**
+ * Allocate memory for lexical environment
+ *
+ * @return pointer to allocated memory
+ */
+ecma_object_t *
+ecma_alloc_lexical_environment (void)
+{
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_LEXICAL_ENVIRONMENT);
+  ecma_object_t *lex_env_p = (ecma_object_t *) jmem_pools_alloc ();
+
+  JERRY_ASSERT (lex_env_p != NULL);
+
+  return lex_env_p;
+} /* ecma_alloc_lexical_environment */
+
+/**
+ * Allocate memory for ecma-string descriptor
+ *
+ * @return pointer to allocated memory
+ */
+ecma_string_t *
+ecma_alloc_string (jmem_alloc_category_t category) /**< category of the string (the kind of its container) */
+{
+  JMEM_SET_ALLOC_CATEGORY (category);
+  ecma_string_t *string_p = (ecma_string_t *) jmem_pools_alloc ();
+
+  JERRY_ASSERT (string_p != NULL);
+
+  return string_p;
+} /* ecma_alloc_string */
 
 /**
  * Allocate memory for extended object
@@ -106,6 +140,7 @@ DECLARE_ROUTINES_FOR (external_pointer)
 inline ecma_extended_object_t * __attr_always_inline___
 ecma_alloc_extended_object (void)
 {
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_EXTENDED_OBJECT);
   return jmem_heap_alloc_block (sizeof (ecma_extended_object_t));
 } /* ecma_alloc_extended_object */
 
@@ -126,6 +161,7 @@ ecma_dealloc_extended_object (ecma_extended_object_t *ext_object_p) /**< propert
 inline ecma_property_pair_t * __attr_always_inline___
 ecma_alloc_property_pair (void)
 {
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_PROPERTY_PAIR);
   return jmem_heap_alloc_block (sizeof (ecma_property_pair_t));
 } /* ecma_alloc_property_pair */
 
@@ -37,6 +37,13 @@ extern ecma_object_t *ecma_alloc_object (void);
  */
 extern void ecma_dealloc_object (ecma_object_t *);
 
+/**
+ * Allocate memory for lexical environment (it is freed by ecma_dealloc_object)
+ *
+ * @return pointer to allocated memory
+ */
+extern ecma_object_t *ecma_alloc_lexical_environment (void);
+
 /**
  * Allocate memory for ecma-number
  *
@@ -78,7 +85,7 @@ extern void ecma_dealloc_collection_chunk (ecma_collection_chunk_t *);
  *
  * @return pointer to allocated memory
  */
-extern ecma_string_t *ecma_alloc_string (void);
+extern ecma_string_t *ecma_alloc_string (jmem_alloc_category_t);
 
 /**
  * Dealloc memory from ecma-string descriptor
@@ -28,9 +28,12 @@
 #include "jrt.h"
 #include "jrt-libc-includes.h"
 #include "jrt-bit-fields.h"
+#include "js-parser.h"
 #include "re-compiler.h"
 #include "vm-defines.h"
+#include "vm-runtime-stats.h"
 #include "vm-stack.h"
+#include "vm-trace.h"
 
 #define JERRY_INTERNAL
 #include "jerry-internal.h"
@@ -81,6 +84,63 @@ ecma_gc_set_object_next (ecma_object_t *object_p, /**< object */
   ECMA_SET_POINTER (object_p->gc_next_cp, next_object_p);
 } /* ecma_gc_set_object_next */
 
+#ifdef JERRY_GC_MARK_BITMAP
+
+/**
+ * Get the index of the object in the mark bitmaps
+ *
+ * @return index of the bit
+ */
+static inline uint32_t __attr_always_inline___
+ecma_gc_get_bitmap_index (ecma_object_t *object_p) /**< object */
+{
+  jmem_cpointer_t object_cp;
+  ECMA_SET_NON_NULL_POINTER (object_cp, object_p);
+
+  uint32_t index = object_cp;
+
+  JERRY_ASSERT (index < JERRY_GC_BITMAP_SIZE * JERRY_BITSINBYTE);
+  return index;
+} /* ecma_gc_get_bitmap_index */
+
+/**
+ * Get the bit of the object in a mark bitmap
+ *
+ * @return true - if the bit is set
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+ecma_gc_bitmap_get (const uint8_t *bitmap_p, /**< bitmap */
+                    ecma_object_t *object_p) /**< object */
+{
+  uint32_t index = ecma_gc_get_bitmap_index (object_p);
+
+  return (bitmap_p[index / JERRY_BITSINBYTE] & (1u << (index % JERRY_BITSINBYTE))) != 0;
+} /* ecma_gc_bitmap_get */
+
+/**
+ * Set or clear the bit of the object in a mark bitmap
+ */
+static inline void __attr_always_inline___
+ecma_gc_bitmap_set (uint8_t *bitmap_p, /**< bitmap */
+                    ecma_object_t *object_p, /**< object */
+                    bool value) /**< new value of the bit */
+{
+  uint32_t index = ecma_gc_get_bitmap_index (object_p);
+  uint8_t mask = (uint8_t) (1u << (index % JERRY_BITSINBYTE));
+
+  if (value)
+  {
+    bitmap_p[index / JERRY_BITSINBYTE] = (uint8_t) (bitmap_p[index / JERRY_BITSINBYTE] | mask);
+  }
+  else
+  {
+    bitmap_p[index / JERRY_BITSINBYTE] = (uint8_t) (bitmap_p[index / JERRY_BITSINBYTE] & ~mask);
+  }
+} /* ecma_gc_bitmap_set */
+
+#endif /* JERRY_GC_MARK_BITMAP */
+
 /**
  * Get visited flag of the object.
  */
@@ -89,9 +149,13 @@ ecma_gc_is_object_visited (ecma_object_t *object_p) /**< object */
 {
   JERRY_ASSERT (object_p != NULL);
 
+#ifdef JERRY_GC_MARK_BITMAP
+  return ecma_gc_bitmap_get (JERRY_GC_BITMAP_CONTEXT (visited), object_p);
+#else /* !JERRY_GC_MARK_BITMAP */
   bool flag_value = (object_p->type_flags_refs & ECMA_OBJECT_FLAG_GC_VISITED) != 0;
 
   return flag_value != JERRY_CONTEXT (ecma_gc_visited_flip_flag);
+#endif /* JERRY_GC_MARK_BITMAP */
 } /* ecma_gc_is_object_visited */
 
 /**
@@ -103,6 +167,9 @@ ecma_gc_set_object_visited (ecma_object_t *object_p, /**< object */
 {
   JERRY_ASSERT (object_p != NULL);
 
+#ifdef JERRY_GC_MARK_BITMAP
+  ecma_gc_bitmap_set (JERRY_GC_BITMAP_CONTEXT (visited), object_p, is_visited);
+#else /* !JERRY_GC_MARK_BITMAP */
   if (is_visited != JERRY_CONTEXT (ecma_gc_visited_flip_flag))
   {
     object_p->type_flags_refs = (uint16_t) (object_p->type_flags_refs | ECMA_OBJECT_FLAG_GC_VISITED);
@@ -111,6 +178,7 @@ ecma_gc_set_object_visited (ecma_object_t *object_p, /**< object */
   {
     object_p->type_flags_refs = (uint16_t) (object_p->type_flags_refs & ~ECMA_OBJECT_FLAG_GC_VISITED);
   }
+#endif /* JERRY_GC_MARK_BITMAP */
 } /* ecma_gc_set_object_visited */
 
 /**
@@ -161,10 +229,34 @@ ecma_deref_object (ecma_object_t *object_p) /**< object */
 } /* ecma_deref_object */
 
 /**
- * Mark referenced object from property
+ * Mark a referenced object as visited.
  */
-static void
-ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
+static inline void __attr_always_inline___
+ecma_gc_mark_reference (ecma_object_t *object_p, /**< referenced object, or NULL for primitive values */
+                        ecma_value_t value, /**< referenced value */
+                        ecma_gc_reference_t reference, /**< kind of the reference */
+                        jmem_cpointer_t name_cp, /**< name of the property */
+                        void *user_p) /**< user pointer */
+{
+  JERRY_UNUSED (value);
+  JERRY_UNUSED (reference);
+  JERRY_UNUSED (name_cp);
+  JERRY_UNUSED (user_p);
+
+  if (object_p != NULL)
+  {
+    ecma_gc_set_object_visited (object_p, true);
+  }
+} /* ecma_gc_mark_reference */
+
+/**
+ * Visit the values referenced by a property
+ */
+static inline void __attr_always_inline___
+ecma_gc_visit_property (ecma_property_t *property_p, /**< property */
+                        jmem_cpointer_t name_cp, /**< name of the property */
+                        ecma_gc_reference_visitor_t visitor_p, /**< visitor */
+                        void *user_p) /**< user pointer passed to the visitor */
 {
   switch (ECMA_PROPERTY_GET_TYPE (property_p))
   {
@@ -176,7 +268,11 @@ ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
       {
         ecma_object_t *value_obj_p = ecma_get_object_from_value (value);
 
-        ecma_gc_set_object_visited (value_obj_p, true);
+        visitor_p (value_obj_p, value, ECMA_GC_REFERENCE_PROPERTY, name_cp, user_p);
+      }
+      else
+      {
+        visitor_p (NULL, value, ECMA_GC_REFERENCE_PROPERTY, name_cp, user_p);
       }
       break;
     }
@@ -187,12 +283,12 @@ ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
 
       if (getter_obj_p != NULL)
       {
-        ecma_gc_set_object_visited (getter_obj_p, true);
+        visitor_p (getter_obj_p, ECMA_GC_NO_VALUE, ECMA_GC_REFERENCE_GETTER, name_cp, user_p);
       }
 
       if (setter_obj_p != NULL)
       {
-        ecma_gc_set_object_visited (setter_obj_p, true);
+        visitor_p (setter_obj_p, ECMA_GC_NO_VALUE, ECMA_GC_REFERENCE_SETTER, name_cp, user_p);
       }
       break;
     }
@@ -203,6 +299,11 @@ ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
       switch (ECMA_PROPERTY_GET_INTERNAL_PROPERTY_TYPE (property_p))
       {
         case ECMA_INTERNAL_PROPERTY_ECMA_VALUE: /* an ecma_value_t except object */
+        {
+          visitor_p (NULL, property_value, ECMA_GC_REFERENCE_INTERNAL, ECMA_NULL_POINTER, user_p);
+          break;
+        }
+
         case ECMA_INTERNAL_PROPERTY_DATE_FLOAT: /* pointer to a ecma_number_t */
         case ECMA_INTERNAL_PROPERTY_CLASS: /* an enum */
         case ECMA_INTERNAL_PROPERTY_REGEXP_BYTECODE: /* pointer to a regexp bytecode array */
@@ -219,7 +320,11 @@ ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
           {
             ecma_object_t *obj_p = ecma_get_object_from_value (property_value);
 
-            ecma_gc_set_object_visited (obj_p, true);
+            visitor_p (obj_p, property_value, ECMA_GC_REFERENCE_INTERNAL, ECMA_NULL_POINTER, user_p);
+          }
+          else
+          {
+            visitor_p (NULL, property_value, ECMA_GC_REFERENCE_INTERNAL, ECMA_NULL_POINTER, user_p);
           }
 
           break;
@@ -238,11 +343,17 @@ ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
             bool is_moved = ecma_collection_iterator_next (&bound_args_iterator);
             JERRY_ASSERT (is_moved);
 
-            if (ecma_is_value_object (*bound_args_iterator.current_value_p))
+            ecma_value_t arg_value = *bound_args_iterator.current_value_p;
+
+            if (ecma_is_value_object (arg_value))
             {
-              ecma_object_t *obj_p = ecma_get_object_from_value (*bound_args_iterator.current_value_p);
+              ecma_object_t *obj_p = ecma_get_object_from_value (arg_value);
 
-              ecma_gc_set_object_visited (obj_p, true);
+              visitor_p (obj_p, arg_value, ECMA_GC_REFERENCE_INTERNAL, ECMA_NULL_POINTER, user_p);
+            }
+            else
+            {
+              visitor_p (NULL, arg_value, ECMA_GC_REFERENCE_INTERNAL, ECMA_NULL_POINTER, user_p);
             }
           }
 
@@ -255,7 +366,7 @@ ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
         {
           ecma_object_t *obj_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t, property_value);
 
-          ecma_gc_set_object_visited (obj_p, true);
+          visitor_p (obj_p, ECMA_GC_NO_VALUE, ECMA_GC_REFERENCE_INTERNAL, ECMA_NULL_POINTER, user_p);
 
           break;
         }
@@ -274,16 +385,17 @@ ecma_gc_mark_property (ecma_property_t *property_p) /**< property */
       break;
     }
   }
-} /* ecma_gc_mark_property */
+} /* ecma_gc_visit_property */
 
 /**
- * Mark objects as visited starting from specified object as root
+ * Visit the objects and the values referenced by an object
  */
-void
-ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
+static inline void __attr_always_inline___
+ecma_gc_visit_object (ecma_object_t *object_p, /**< object */
+                      ecma_gc_reference_visitor_t visitor_p, /**< visitor */
+                      void *user_p) /**< user pointer passed to the visitor */
 {
   JERRY_ASSERT (object_p != NULL);
-  JERRY_ASSERT (ecma_gc_is_object_visited (object_p));
 
   bool traverse_properties = true;
 
@@ -292,13 +404,13 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
     ecma_object_t *lex_env_p = ecma_get_lex_env_outer_reference (object_p);
     if (lex_env_p != NULL)
     {
-      ecma_gc_set_object_visited (lex_env_p, true);
+      visitor_p (lex_env_p, ECMA_GC_NO_VALUE, ECMA_GC_REFERENCE_OUTER_ENVIRONMENT, ECMA_NULL_POINTER, user_p);
     }
 
     if (ecma_get_lex_env_type (object_p) != ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
     {
       ecma_object_t *binding_object_p = ecma_get_lex_env_binding_object (object_p);
-      ecma_gc_set_object_visited (binding_object_p, true);
+      visitor_p (binding_object_p, ECMA_GC_NO_VALUE, ECMA_GC_REFERENCE_BINDING_OBJECT, ECMA_NULL_POINTER, user_p);
 
       traverse_properties = false;
     }
@@ -308,7 +420,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
     ecma_object_t *proto_p = ecma_get_object_prototype (object_p);
     if (proto_p != NULL)
     {
-      ecma_gc_set_object_visited (proto_p, true);
+      visitor_p (proto_p, ECMA_GC_NO_VALUE, ECMA_GC_REFERENCE_PROTOTYPE, ECMA_NULL_POINTER, user_p);
     }
 
     if (!ecma_get_object_is_builtin (object_p)
@@ -319,7 +431,7 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
       ecma_object_t *scope_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_object_t,
                                                                 ext_func_p->u.function.scope_cp);
 
-      ecma_gc_set_object_visited (scope_p, true);
+      visitor_p (scope_p, ECMA_GC_NO_VALUE, ECMA_GC_REFERENCE_SCOPE, ECMA_NULL_POINTER, user_p);
     }
   }
 
@@ -338,22 +450,52 @@ ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
     {
       JERRY_ASSERT (ECMA_PROPERTY_IS_PROPERTY_PAIR (prop_iter_p));
 
+      ecma_property_pair_t *prop_pair_p = (ecma_property_pair_t *) prop_iter_p;
+
       if (prop_iter_p->types[0].type_and_flags != ECMA_PROPERTY_TYPE_DELETED)
       {
-        ecma_gc_mark_property (prop_iter_p->types + 0);
+        ecma_gc_visit_property (prop_iter_p->types + 0, prop_pair_p->names_cp[0], visitor_p, user_p);
       }
 
       if (prop_iter_p->types[1].type_and_flags != ECMA_PROPERTY_TYPE_DELETED)
       {
-        ecma_gc_mark_property (prop_iter_p->types + 1);
+        ecma_gc_visit_property (prop_iter_p->types + 1, prop_pair_p->names_cp[1], visitor_p, user_p);
       }
 
       prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
                                       prop_iter_p->next_property_cp);
     }
   }
+} /* ecma_gc_visit_object */
+
+/**
+ * Mark objects as visited starting from specified object as root
+ */
+void
+ecma_gc_mark (ecma_object_t *object_p) /**< object to mark from */
+{
+  JERRY_ASSERT (object_p != NULL);
+  JERRY_ASSERT (ecma_gc_is_object_visited (object_p));
+
+  ecma_gc_visit_object (object_p, ecma_gc_mark_reference, NULL);
 } /* ecma_gc_mark */
 
+/**
+ * Pass the references of an object, which are followed by the garbage
+ * collector when it marks the reachable objects, to a visitor.
+ *
+ * Note:
+ *      object references are passed with the referenced object, and values
+ *      which are not objects are passed with NULL object pointer
+ */
+void
+ecma_gc_visit_references (ecma_object_t *object_p, /**< object */
+                          ecma_gc_reference_visitor_t visitor_p, /**< visitor */
+                          void *user_p) /**< user pointer passed to the visitor */
+{
+  ecma_gc_visit_object (object_p, visitor_p, user_p);
+} /* ecma_gc_visit_references */
+
 /**
  * Free specified object
  */
@@ -461,16 +603,117 @@ ecma_gc_sweep (ecma_object_t *object_p) /**< object to free */
   ecma_dealloc_object (object_p);
 } /* ecma_gc_sweep */
 
+#ifdef JERRY_GC_MARK_BITMAP
+
+/**
+ * Mark the reachable objects in the mark bitmaps and free the others.
+ *
+ * Live objects are only written when an object next to them in the object
+ * list is freed, so the pages of a heap shared by fork () stay shared.
+ */
+static void
+ecma_gc_mark_and_sweep_with_bitmap (void)
+{
+  memset (JERRY_GC_BITMAP_CONTEXT (visited), 0, JERRY_GC_BITMAP_SIZE);
+  memset (JERRY_GC_BITMAP_CONTEXT (scanned), 0, JERRY_GC_BITMAP_SIZE);
+
+  /* if some object is referenced from stack or globals (i.e. it is root), mark it */
+  for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+       obj_iter_p != NULL;
+       obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+  {
+    if (obj_iter_p->type_flags_refs >= ECMA_OBJECT_REF_ONE)
+    {
+      ecma_gc_set_object_visited (obj_iter_p, true);
+    }
+  }
+
+  bool marked_anything_during_current_iteration;
+
+  do
+  {
+    marked_anything_during_current_iteration = false;
+
+    for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+         obj_iter_p != NULL;
+         obj_iter_p = ecma_gc_get_object_next (obj_iter_p))
+    {
+      if (ecma_gc_is_object_visited (obj_iter_p)
+          && !ecma_gc_bitmap_get (JERRY_GC_BITMAP_CONTEXT (scanned), obj_iter_p))
+      {
+        ecma_gc_bitmap_set (JERRY_GC_BITMAP_CONTEXT (scanned), obj_iter_p, true);
+        ecma_gc_mark (obj_iter_p);
+        marked_anything_during_current_iteration = true;
+      }
+    }
+  }
+  while (marked_anything_during_current_iteration);
+
+  /* Sweeping objects that are currently unmarked */
+  ecma_object_t *last_live_obj_p = NULL;
+  ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+
+  while (obj_iter_p != NULL)
+  {
+    ecma_object_t *obj_next_p = ecma_gc_get_object_next (obj_iter_p);
+
+    if (!ecma_gc_is_object_visited (obj_iter_p))
+    {
+      ecma_gc_sweep (obj_iter_p);
+    }
+    else
+    {
+      /* The link is only rewritten if objects are freed before this one. */
+      if (last_live_obj_p == NULL)
+      {
+        JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = obj_iter_p;
+      }
+      else if (ecma_gc_get_object_next (last_live_obj_p) != obj_iter_p)
+      {
+        ecma_gc_set_object_next (last_live_obj_p, obj_iter_p);
+      }
+
+      last_live_obj_p = obj_iter_p;
+    }
+
+    obj_iter_p = obj_next_p;
+  }
+
+  if (last_live_obj_p == NULL)
+  {
+    JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY] = NULL;
+  }
+  else if (ecma_gc_get_object_next (last_live_obj_p) != NULL)
+  {
+    ecma_gc_set_object_next (last_live_obj_p, NULL);
+  }
+} /* ecma_gc_mark_and_sweep_with_bitmap */
+
+#endif /* JERRY_GC_MARK_BITMAP */
+
 /**
  * Run garbage collection
  */
 void
 ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
 {
+  VM_RUNTIME_STATS_ENTER (VM_RUNTIME_PHASE_GC);
+  VM_TRACE_BEGIN ();
+
+#ifdef JERRY_TRACE
+  size_t objects_number = JERRY_CONTEXT (ecma_gc_objects_number);
+#endif /* JERRY_TRACE */
+
   JERRY_CONTEXT (ecma_gc_new_objects) = 0;
 
   JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] == NULL);
 
+#ifdef JERRY_GC_MARK_BITMAP
+  ecma_gc_mark_and_sweep_with_bitmap ();
+
+  /* The remaining objects are all marked. */
+  ecma_object_t *live_objects_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+#else /* !JERRY_GC_MARK_BITMAP */
   /* if some object is referenced from stack or globals (i.e. it is root), mark it */
   for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
        obj_iter_p != NULL;
@@ -540,10 +783,13 @@ ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
     obj_iter_p = obj_next_p;
   }
 
+  ecma_object_t *live_objects_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
+#endif /* JERRY_GC_MARK_BITMAP */
+
   if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH)
   {
-    /* Remove the property hashmap of BLACK objects */
-    obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
+    /* Remove the property hashmap of the marked objects */
+    ecma_object_t *obj_iter_p = live_objects_p;
 
     while (obj_iter_p != NULL)
     {
@@ -564,17 +810,21 @@ ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
     }
   }
 
+#ifndef JERRY_GC_MARK_BITMAP
   /* Unmarking all objects */
-  ecma_object_t *black_objects = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK];
-  JERRY_CONTEXT (ecma_gc_objects_lists)[ECMA_GC_COLOR_WHITE_GRAY] = black_objects;
+  JERRY_CONTEXT (ecma_gc_objects_lists)[ECMA_GC_COLOR_WHITE_GRAY] = live_objects_p;
   JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] = NULL;
 
   JERRY_CONTEXT (ecma_gc_visited_flip_flag) = !JERRY_CONTEXT (ecma_gc_visited_flip_flag);
+#endif /* !JERRY_GC_MARK_BITMAP */
 
 #ifndef CONFIG_DISABLE_REGEXP_BUILTIN
   /* Free RegExp bytecodes stored in cache */
   re_cache_gc_run ();
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
+
+  VM_TRACE_END (VM_TRACE_EVENT_GC, severity, objects_number, JERRY_CONTEXT (ecma_gc_objects_number));
+  VM_RUNTIME_STATS_LEAVE ();
 } /* ecma_gc_run */
 
 /**
@@ -583,6 +833,11 @@ ecma_gc_run (jmem_free_unused_memory_severity_t severity) /**< gc severity */
 void
 ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity) /**< severity of the request */
 {
+  VM_TRACE_INSTANT (VM_TRACE_EVENT_FREE_UNUSED_MEMORY,
+                    severity,
+                    JERRY_CONTEXT (jmem_heap_allocated_size),
+                    JERRY_CONTEXT (jmem_heap_limit));
+
   if (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW)
   {
     /*
@@ -600,6 +855,10 @@ ecma_free_unused_memory (jmem_free_unused_memory_severity_t severity) /**< sever
   {
     JERRY_ASSERT (severity == JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH);
 
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+    parser_code_cache_release_unused ();
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
     /* Freeing as much memory as we currently can */
     ecma_gc_run (severity);
   }
@@ -26,11 +26,41 @@
  * @{
  */
 
+/**
+ * Kinds of the references followed by the garbage collector
+ */
+typedef enum
+{
+  ECMA_GC_REFERENCE_PROPERTY, /**< value of a named data property */
+  ECMA_GC_REFERENCE_GETTER, /**< getter of a named accessor property */
+  ECMA_GC_REFERENCE_SETTER, /**< setter of a named accessor property */
+  ECMA_GC_REFERENCE_INTERNAL, /**< value of an internal property */
+  ECMA_GC_REFERENCE_PROTOTYPE, /**< prototype of an object */
+  ECMA_GC_REFERENCE_SCOPE, /**< scope of a function */
+  ECMA_GC_REFERENCE_OUTER_ENVIRONMENT, /**< outer reference of a lexical environment */
+  ECMA_GC_REFERENCE_BINDING_OBJECT, /**< binding object of an object-bound lexical environment */
+} ecma_gc_reference_t;
+
+/**
+ * Value passed to the reference visitors for the references which are not stored as an ecma value
+ */
+#define ECMA_GC_NO_VALUE ((ecma_value_t) 0)
+
+/**
+ * Visitor of the references of an object
+ */
+typedef void (*ecma_gc_reference_visitor_t) (ecma_object_t *object_p,
+                                             ecma_value_t value,
+                                             ecma_gc_reference_t reference,
+                                             jmem_cpointer_t name_cp,
+                                             void *user_p);
+
 extern void ecma_init_gc_info (ecma_object_t *);
 extern void ecma_ref_object (ecma_object_t *);
 extern void ecma_deref_object (ecma_object_t *);
 extern void ecma_gc_run (jmem_free_unused_memory_severity_t);
 extern void ecma_free_unused_memory (jmem_free_unused_memory_severity_t);
+extern void ecma_gc_visit_references (ecma_object_t *, ecma_gc_reference_visitor_t, void *);
 
 /**
  * @}
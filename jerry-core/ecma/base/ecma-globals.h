@@ -810,6 +810,8 @@ typedef struct
 typedef enum
 {
   ECMA_STRING_CONTAINER_HEAP_UTF8_STRING, /**< actual data is on the heap as an utf-8 (cesu8) string */
+  ECMA_STRING_CONTAINER_EXTERNAL_STRING, /**< actual data is a cesu8 string owned by the host
+                                          *   (see also: ecma_external_string_t) */
   ECMA_STRING_CONTAINER_UINT32_IN_DESC, /**< actual data is UInt32-represeneted Number
                                              stored locally in the string's descriptor */
   ECMA_STRING_CONTAINER_MAGIC_STRING, /**< the ecma-string is equal to one of ECMA magic strings */
@@ -849,6 +851,13 @@ typedef enum
 #define ECMA_STRING_GET_CONTAINER(string_desc_p) \
   ((ecma_string_container_t) ((string_desc_p)->refs_and_container & ECMA_STRING_CONTAINER_MASK))
 
+/**
+ * Checks whether the characters of a string are stored in a buffer, so the
+ * string cannot be identified by the 'common_field' of its descriptor.
+ */
+#define ECMA_STRING_CONTAINER_HAS_BUFFER(container) \
+  ((container) <= ECMA_STRING_CONTAINER_EXTERNAL_STRING)
+
 /**
  * Checks whether the reference counter is 1.
  */
@@ -897,6 +906,18 @@ typedef struct ecma_string_t
   } u;
 } ecma_string_t;
 
+/**
+ * Descriptor of a string whose characters are stored in a host-owned buffer
+ */
+typedef struct
+{
+  ecma_string_t header; /**< string header */
+  lit_utf8_size_t size; /**< size of the string in bytes */
+  ecma_length_t length; /**< length of the string in characters */
+  const lit_utf8_byte_t *buffer_p; /**< host-owned cesu8 buffer */
+  ecma_external_pointer_t free_cb; /**< native free callback of the buffer (can be 0) */
+} ecma_external_string_t;
+
 /**
  * Compiled byte code data.
  */
@@ -0,0 +1,516 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Heap graph dump
+ *
+ * The dump is a line oriented text which is written in chunks, so it can be
+ * streamed into a file or a socket without allocating memory from the engine:
+ *
+ *   # jerry-heap-dump 1
+ *   O <id> <type> <self_size> <ref_count>
+ *   E <from_id> <to_id> <kind> [<name>]
+ *   S <from_id> <string_id> <string_size> <kind> [<name>]
+ *
+ * An "O" line describes an object or a lexical environment, the "E" and "S" lines
+ * following it describe its references to objects and strings. The identifiers are
+ * the compressed pointers of the objects and the strings, the objects whose
+ * reference counter is greater than zero are the roots of the garbage collector.
+ * The name of the property is the last field of the line, '\' and new line
+ * characters are escaped in it.
+ */
+
+#include "ecma-gc.h"
+#include "ecma-globals.h"
+#include "ecma-heap-dump.h"
+#include "ecma-helpers.h"
+#include "ecma-property-hashmap.h"
+#include "jcontext.h"
+#include "jrt-libc-includes.h"
+#include "lit-char-helpers.h"
+
+/** \addtogroup ecma ECMA
+ * @{
+ *
+ * \addtogroup ecmaheapdump Heap dump
+ * @{
+ */
+
+/**
+ * Size of the buffer which collects the output before it is passed to the callback
+ */
+#define ECMA_HEAP_DUMP_BUFFER_SIZE 256
+
+/**
+ * State of a heap dump
+ */
+typedef struct
+{
+  ecma_heap_dump_callback_t callback_p; /**< output callback */
+  void *user_p; /**< user pointer passed to the callback */
+  ecma_object_t *object_p; /**< object whose references are visited */
+  size_t number_size; /**< size of the numbers referenced by the object */
+  lit_utf8_size_t buffer_size; /**< number of bytes in the buffer */
+  lit_utf8_byte_t buffer[ECMA_HEAP_DUMP_BUFFER_SIZE]; /**< output buffer */
+} ecma_heap_dump_context_t;
+
+/**
+ * Names of the object types
+ */
+static const char * const ecma_heap_dump_object_type_names[] =
+{
+  "object",
+  "function",
+  "external_function",
+  "array",
+  "string",
+  "bound_function",
+  "arguments"
+};
+
+JERRY_STATIC_ASSERT (sizeof (ecma_heap_dump_object_type_names) / sizeof (const char *) == ECMA_OBJECT_TYPE__MAX + 1,
+                     ecma_heap_dump_object_type_names_must_have_an_entry_for_each_object_type);
+
+/**
+ * Names of the lexical environment types
+ */
+static const char * const ecma_heap_dump_lex_env_type_names[] =
+{
+  "declarative_environment",
+  "object_environment",
+  "this_object_environment"
+};
+
+JERRY_STATIC_ASSERT (sizeof (ecma_heap_dump_lex_env_type_names) / sizeof (const char *)
+                     == ECMA_LEXICAL_ENVIRONMENT_TYPE__MAX - ECMA_LEXICAL_ENVIRONMENT_TYPE_START + 1,
+                     ecma_heap_dump_lex_env_type_names_must_have_an_entry_for_each_lex_env_type);
+
+/**
+ * Names of the reference kinds
+ */
+static const char * const ecma_heap_dump_reference_names[] =
+{
+  "property",
+  "getter",
+  "setter",
+  "internal",
+  "prototype",
+  "scope",
+  "outer",
+  "binding"
+};
+
+JERRY_STATIC_ASSERT (sizeof (ecma_heap_dump_reference_names) / sizeof (const char *)
+                     == ECMA_GC_REFERENCE_BINDING_OBJECT + 1,
+                     ecma_heap_dump_reference_names_must_have_an_entry_for_each_reference_kind);
+
+/**
+ * Pass the collected output to the callback.
+ */
+static void
+ecma_heap_dump_flush (ecma_heap_dump_context_t *context_p) /**< heap dump context */
+{
+  if (context_p->buffer_size > 0)
+  {
+    context_p->callback_p (context_p->buffer, context_p->buffer_size, context_p->user_p);
+    context_p->buffer_size = 0;
+  }
+} /* ecma_heap_dump_flush */
+
+/**
+ * Append bytes to the output.
+ */
+static void
+ecma_heap_dump_append (ecma_heap_dump_context_t *context_p, /**< heap dump context */
+                       const lit_utf8_byte_t *data_p, /**< data */
+                       lit_utf8_size_t size) /**< size of the data */
+{
+  while (size > 0)
+  {
+    if (context_p->buffer_size == ECMA_HEAP_DUMP_BUFFER_SIZE)
+    {
+      ecma_heap_dump_flush (context_p);
+    }
+
+    lit_utf8_size_t copy_size = ECMA_HEAP_DUMP_BUFFER_SIZE - context_p->buffer_size;
+
+    if (copy_size > size)
+    {
+      copy_size = size;
+    }
+
+    memcpy (context_p->buffer + context_p->buffer_size, data_p, copy_size);
+    context_p->buffer_size += copy_size;
+    data_p += copy_size;
+    size -= copy_size;
+  }
+} /* ecma_heap_dump_append */
+
+/**
+ * Append a zero terminated string to the output.
+ */
+static void
+ecma_heap_dump_append_text (ecma_heap_dump_context_t *context_p, /**< heap dump context */
+                            const char *text_p) /**< zero terminated string */
+{
+  ecma_heap_dump_append (context_p, (const lit_utf8_byte_t *) text_p, (lit_utf8_size_t) strlen (text_p));
+} /* ecma_heap_dump_append_text */
+
+/**
+ * Append a space and a decimal number to the output.
+ */
+static void
+ecma_heap_dump_append_number (ecma_heap_dump_context_t *context_p, /**< heap dump context */
+                              size_t value) /**< value */
+{
+  lit_utf8_byte_t number_buffer[ECMA_MAX_CHARS_IN_STRINGIFIED_UINT32 + 1];
+
+  JERRY_ASSERT (value <= UINT32_MAX);
+
+  number_buffer[0] = LIT_CHAR_SP;
+  lit_utf8_size_t size = ecma_uint32_to_utf8_string ((uint32_t) value,
+                                                     number_buffer + 1,
+                                                     ECMA_MAX_CHARS_IN_STRINGIFIED_UINT32);
+
+  ecma_heap_dump_append (context_p, number_buffer, size + 1);
+} /* ecma_heap_dump_append_number */
+
+/**
+ * Append a space and the identifier of a heap block to the output.
+ */
+static void
+ecma_heap_dump_append_id (ecma_heap_dump_context_t *context_p, /**< heap dump context */
+                          const void *block_p) /**< object or string */
+{
+  jmem_cpointer_t block_cp;
+  ECMA_SET_NON_NULL_POINTER (block_cp, block_p);
+
+  ecma_heap_dump_append_number (context_p, block_cp);
+} /* ecma_heap_dump_append_id */
+
+/**
+ * Append a space and the characters of a string to the output,
+ * the '\' and the new line characters are escaped.
+ */
+static void
+ecma_heap_dump_append_name (ecma_heap_dump_context_t *context_p, /**< heap dump context */
+                            const ecma_string_t *string_p) /**< string */
+{
+  lit_utf8_byte_t number_buffer[ECMA_MAX_CHARS_IN_STRINGIFIED_UINT32];
+  lit_utf8_size_t size;
+  bool is_ascii;
+
+  const lit_utf8_byte_t *chars_p = ecma_string_raw_chars (string_p, &size, &is_ascii);
+
+  if (chars_p == NULL)
+  {
+    /* The characters of the numbers stored in the descriptor are not available. */
+    JERRY_ASSERT (size <= sizeof (number_buffer));
+
+    ecma_string_to_utf8_bytes (string_p, number_buffer, size);
+    chars_p = number_buffer;
+  }
+
+  ecma_heap_dump_append_text (context_p, " ");
+
+  const lit_utf8_byte_t *chars_end_p = chars_p + size;
+  const lit_utf8_byte_t *run_start_p = chars_p;
+
+  while (chars_p < chars_end_p)
+  {
+    const char *escape_p = NULL;
+
+    if (*chars_p == LIT_CHAR_BACKSLASH)
+    {
+      escape_p = "\\\\";
+    }
+    else if (*chars_p == LIT_CHAR_LF)
+    {
+      escape_p = "\\n";
+    }
+
+    chars_p++;
+
+    if (escape_p != NULL)
+    {
+      ecma_heap_dump_append (context_p, run_start_p, (lit_utf8_size_t) (chars_p - 1 - run_start_p));
+      ecma_heap_dump_append_text (context_p, escape_p);
+      run_start_p = chars_p;
+    }
+  }
+
+  ecma_heap_dump_append (context_p, run_start_p, (lit_utf8_size_t) (chars_end_p - run_start_p));
+} /* ecma_heap_dump_append_name */
+
+/**
+ * Get the size of the heap memory used by a string.
+ *
+ * @return size of the string in bytes
+ */
+static size_t
+ecma_heap_dump_get_string_size (const ecma_string_t *string_p) /**< string */
+{
+  switch (ECMA_STRING_GET_CONTAINER (string_p))
+  {
+    case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
+    {
+      return sizeof (ecma_string_t) + string_p->u.utf8_string.size;
+    }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      /* The characters are owned by the host. */
+      return sizeof (ecma_external_string_t);
+    }
+    default:
+    {
+      return sizeof (ecma_string_t);
+    }
+  }
+} /* ecma_heap_dump_get_string_size */
+
+/**
+ * Append a "S" line which describes a reference to a string.
+ */
+static void
+ecma_heap_dump_append_string_reference (ecma_heap_dump_context_t *context_p, /**< heap dump context */
+                                        const ecma_string_t *string_p, /**< referenced string */
+                                        const char *kind_p) /**< kind of the reference */
+{
+  ecma_heap_dump_append_text (context_p, "S");
+  ecma_heap_dump_append_id (context_p, context_p->object_p);
+  ecma_heap_dump_append_id (context_p, string_p);
+  ecma_heap_dump_append_number (context_p, ecma_heap_dump_get_string_size (string_p));
+  ecma_heap_dump_append_text (context_p, " ");
+  ecma_heap_dump_append_text (context_p, kind_p);
+} /* ecma_heap_dump_append_string_reference */
+
+/**
+ * Sum the size of the numbers referenced by an object.
+ */
+static void
+ecma_heap_dump_count_numbers (ecma_object_t *object_p, /**< referenced object, or NULL */
+                              ecma_value_t value, /**< referenced value */
+                              ecma_gc_reference_t reference, /**< kind of the reference */
+                              jmem_cpointer_t name_cp, /**< name of the property */
+                              void *user_p) /**< heap dump context */
+{
+  JERRY_UNUSED (reference);
+  JERRY_UNUSED (name_cp);
+
+  if (object_p == NULL && ecma_is_value_float_number (value))
+  {
+    ((ecma_heap_dump_context_t *) user_p)->number_size += sizeof (ecma_number_t);
+  }
+} /* ecma_heap_dump_count_numbers */
+
+/**
+ * Append the line which describes a reference of an object.
+ */
+static void
+ecma_heap_dump_append_reference (ecma_object_t *object_p, /**< referenced object, or NULL */
+                                 ecma_value_t value, /**< referenced value */
+                                 ecma_gc_reference_t reference, /**< kind of the reference */
+                                 jmem_cpointer_t name_cp, /**< name of the property */
+                                 void *user_p) /**< heap dump context */
+{
+  ecma_heap_dump_context_t *context_p = (ecma_heap_dump_context_t *) user_p;
+  const char *kind_p = ecma_heap_dump_reference_names[reference];
+
+  if (object_p != NULL)
+  {
+    ecma_heap_dump_append_text (context_p, "E");
+    ecma_heap_dump_append_id (context_p, context_p->object_p);
+    ecma_heap_dump_append_id (context_p, object_p);
+    ecma_heap_dump_append_text (context_p, " ");
+    ecma_heap_dump_append_text (context_p, kind_p);
+  }
+  else if (ecma_is_value_string (value))
+  {
+    ecma_heap_dump_append_string_reference (context_p, ecma_get_string_from_value (value), kind_p);
+  }
+  else
+  {
+    return;
+  }
+
+  if (name_cp != ECMA_NULL_POINTER)
+  {
+    ecma_heap_dump_append_name (context_p, ECMA_GET_NON_NULL_POINTER (ecma_string_t, name_cp));
+  }
+
+  ecma_heap_dump_append_text (context_p, "\n");
+} /* ecma_heap_dump_append_reference */
+
+/**
+ * Get the size of an object, its property list and its property hashmap.
+ *
+ * @return size of the object in bytes
+ */
+static size_t
+ecma_heap_dump_get_object_size (ecma_object_t *object_p) /**< object */
+{
+  size_t size = sizeof (ecma_object_t);
+
+  if (ecma_is_lexical_environment (object_p))
+  {
+    if (ecma_get_lex_env_type (object_p) != ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE)
+    {
+      return size;
+    }
+  }
+  else if (ecma_get_object_is_builtin (object_p)
+           || ecma_get_object_type (object_p) == ECMA_OBJECT_TYPE_EXTERNAL_FUNCTION
+           || ecma_get_object_type (object_p) == ECMA_OBJECT_TYPE_FUNCTION)
+  {
+    size = sizeof (ecma_extended_object_t);
+  }
+
+  ecma_property_header_t *prop_iter_p = ecma_get_property_list (object_p);
+
+  while (prop_iter_p != NULL)
+  {
+    if (ECMA_PROPERTY_GET_TYPE (prop_iter_p->types + 0) == ECMA_PROPERTY_TYPE_HASHMAP)
+    {
+      ecma_property_hashmap_t *hashmap_p = (ecma_property_hashmap_t *) prop_iter_p;
+
+      size += ECMA_PROPERTY_HASHMAP_GET_TOTAL_SIZE (hashmap_p->max_property_count);
+    }
+    else
+    {
+      size += sizeof (ecma_property_pair_t);
+    }
+
+    prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
+                                    prop_iter_p->next_property_cp);
+  }
+
+  return size;
+} /* ecma_heap_dump_get_object_size */
+
+/**
+ * Append the lines which describe an object and its references.
+ */
+static void
+ecma_heap_dump_object (ecma_heap_dump_context_t *context_p, /**< heap dump context */
+                       ecma_object_t *object_p) /**< object */
+{
+  const char *type_p;
+  bool has_property_list = true;
+
+  if (ecma_is_lexical_environment (object_p))
+  {
+    ecma_lexical_environment_type_t type = ecma_get_lex_env_type (object_p);
+
+    type_p = ecma_heap_dump_lex_env_type_names[type - ECMA_LEXICAL_ENVIRONMENT_TYPE_START];
+    has_property_list = (type == ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE);
+  }
+  else
+  {
+    type_p = ecma_heap_dump_object_type_names[ecma_get_object_type (object_p)];
+  }
+
+  context_p->object_p = object_p;
+  context_p->number_size = 0;
+  ecma_gc_visit_references (object_p, ecma_heap_dump_count_numbers, context_p);
+
+  ecma_heap_dump_append_text (context_p, "O");
+  ecma_heap_dump_append_id (context_p, object_p);
+  ecma_heap_dump_append_text (context_p, " ");
+
+  if (!ecma_is_lexical_environment (object_p) && ecma_get_object_is_builtin (object_p))
+  {
+    ecma_heap_dump_append_text (context_p, "builtin_");
+  }
+
+  ecma_heap_dump_append_text (context_p, type_p);
+  ecma_heap_dump_append_number (context_p, ecma_heap_dump_get_object_size (object_p) + context_p->number_size);
+  ecma_heap_dump_append_number (context_p, object_p->type_flags_refs / ECMA_OBJECT_REF_ONE);
+  ecma_heap_dump_append_text (context_p, "\n");
+
+  if (has_property_list)
+  {
+    /* The names of the properties. */
+    ecma_property_header_t *prop_iter_p = ecma_get_property_list (object_p);
+
+    if (prop_iter_p != NULL
+        && ECMA_PROPERTY_GET_TYPE (prop_iter_p->types + 0) == ECMA_PROPERTY_TYPE_HASHMAP)
+    {
+      prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
+                                      prop_iter_p->next_property_cp);
+    }
+
+    while (prop_iter_p != NULL)
+    {
+      ecma_property_pair_t *prop_pair_p = (ecma_property_pair_t *) prop_iter_p;
+
+      for (int i = 0; i < ECMA_PROPERTY_PAIR_ITEM_COUNT; i++)
+      {
+        if (prop_iter_p->types[i].type_and_flags != ECMA_PROPERTY_TYPE_DELETED
+            && prop_pair_p->names_cp[i] != ECMA_NULL_POINTER)
+        {
+          ecma_string_t *name_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, prop_pair_p->names_cp[i]);
+
+          ecma_heap_dump_append_string_reference (context_p, name_p, "name");
+          ecma_heap_dump_append_name (context_p, name_p);
+          ecma_heap_dump_append_text (context_p, "\n");
+        }
+      }
+
+      prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t,
+                                      prop_iter_p->next_property_cp);
+    }
+  }
+
+  ecma_gc_visit_references (object_p, ecma_heap_dump_append_reference, context_p);
+} /* ecma_heap_dump_object */
+
+/**
+ * Write the graph of the objects on the heap: the objects, their sizes and
+ * the references followed by the garbage collector.
+ *
+ * Note:
+ *      the dump does not allocate memory, and the callback must not
+ *      run code which allocates or frees objects
+ */
+void
+ecma_heap_dump (ecma_heap_dump_callback_t callback_p, /**< output callback */
+                void *user_p) /**< user pointer passed to the callback */
+{
+  /* The objects are only in the black list during garbage collection. */
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_BLACK] == NULL);
+
+  ecma_heap_dump_context_t context;
+  context.callback_p = callback_p;
+  context.user_p = user_p;
+  context.object_p = NULL;
+  context.number_size = 0;
+  context.buffer_size = 0;
+
+  ecma_heap_dump_append_text (&context, "# jerry-heap-dump 1\n");
+
+  for (ecma_object_t *obj_iter_p = JERRY_CONTEXT (ecma_gc_objects_lists) [ECMA_GC_COLOR_WHITE_GRAY];
+       obj_iter_p != NULL;
+       obj_iter_p = ECMA_GET_POINTER (ecma_object_t, obj_iter_p->gc_next_cp))
+  {
+    ecma_heap_dump_object (&context, obj_iter_p);
+  }
+
+  ecma_heap_dump_flush (&context);
+} /* ecma_heap_dump */
+
+/**
+ * @}
+ * @}
+ */
@@ -0,0 +1,42 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECMA_HEAP_DUMP_H
+#define ECMA_HEAP_DUMP_H
+
+#include "ecma-globals.h"
+
+/** \addtogroup ecma ECMA
+ * @{
+ *
+ * \addtogroup ecmaheapdump Heap dump
+ * @{
+ */
+
+/**
+ * Function type receiving the heap dump in chunks
+ */
+typedef void (*ecma_heap_dump_callback_t) (const lit_utf8_byte_t *buffer_p,
+                                           lit_utf8_size_t buffer_size,
+                                           void *user_p);
+
+extern void ecma_heap_dump (ecma_heap_dump_callback_t, void *);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* !ECMA_HEAP_DUMP_H */
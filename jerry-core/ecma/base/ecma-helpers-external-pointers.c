@@ -17,6 +17,7 @@
 #include "ecma-alloc.h"
 #include "ecma-globals.h"
 #include "ecma-helpers.h"
+#include "jcontext.h"
 
 /** \addtogroup ecma ECMA
  * @{
@@ -52,6 +53,11 @@ ecma_create_external_pointer_property (ecma_object_t *obj_p, /**< object to crea
   {
     prop_p = ecma_create_internal_property (obj_p, id);
 
+    if (id == ECMA_INTERNAL_PROPERTY_FREE_CALLBACK)
+    {
+      JERRY_CONTEXT (ecma_free_callback_count)++;
+    }
+
     is_new = true;
   }
   else
@@ -19,11 +19,15 @@
 #include "ecma-globals.h"
 #include "ecma-helpers.h"
 #include "ecma-lcache.h"
+#include "jcontext.h"
 #include "jrt.h"
 #include "jrt-libc-includes.h"
 #include "lit-char-helpers.h"
 #include "lit-magic-strings.h"
 
+#define JERRY_INTERNAL
+#include "jerry-internal.h"
+
 /** \addtogroup ecma ECMA
  * @{
  *
@@ -124,9 +128,18 @@ ecma_new_ecma_string_from_utf8 (const lit_utf8_byte_t *string_p, /**< utf-8 stri
     return ecma_get_magic_string_ex (magic_string_ex_id);
   }
 
-  JERRY_ASSERT (string_size > 0 && string_size <= UINT16_MAX);
+  JERRY_ASSERT (string_size > 0);
+
+  if (unlikely (string_size > UINT16_MAX))
+  {
+    /* Heap strings store their size in 16 bits. Only strings derived from
+     * external strings can be this long. */
+    jerry_fatal (ERR_OUT_OF_MEMORY);
+  }
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_STRING);
   ecma_string_t *string_desc_p = jmem_heap_alloc_block (sizeof (ecma_string_t) + string_size);
+  JERRY_CONTEXT (ecma_strings_number)++;
 
   string_desc_p->refs_and_container = ECMA_STRING_CONTAINER_HEAP_UTF8_STRING | ECMA_STRING_REF_ONE;
   string_desc_p->hash = lit_utf8_string_calc_hash (string_p, string_size);
@@ -153,6 +166,94 @@ ecma_new_ecma_string_from_code_unit (ecma_char_t code_unit) /**< code unit */
   return ecma_new_ecma_string_from_utf8 (lit_utf8_bytes, bytes_size);
 } /* ecma_new_ecma_string_from_code_unit */
 
+/**
+ * Allocate new ecma-string which refers to a host-owned cesu-8 buffer
+ * whose length and hash are already known
+ *
+ * Note:
+ *      the buffer must stay valid and unchanged until the free callback is called,
+ *      which happens when the string is freed. Strings equal to a magic string
+ *      are not stored externally, so the callback is called before returning.
+ *
+ * @return pointer to ecma-string descriptor
+ */
+ecma_string_t *
+ecma_new_ecma_external_string_with_hash (const lit_utf8_byte_t *string_p, /**< cesu-8 string */
+                                         lit_utf8_size_t string_size, /**< string size */
+                                         ecma_length_t string_length, /**< string length */
+                                         lit_string_hash_t string_hash, /**< string hash */
+                                         ecma_external_pointer_t free_cb) /**< free callback of the
+                                                                           *   buffer (can be 0) */
+{
+  JERRY_ASSERT (string_p != NULL || string_size == 0);
+  JERRY_ASSERT (lit_is_cesu8_string_valid (string_p, string_size));
+  JERRY_ASSERT (string_length == lit_utf8_string_length (string_p, string_size));
+  JERRY_ASSERT (string_hash == lit_utf8_string_calc_hash (string_p, string_size));
+
+  lit_magic_string_id_t magic_string_id;
+  lit_magic_string_ex_id_t magic_string_ex_id;
+  ecma_string_t *magic_string_p = NULL;
+
+  if (lit_is_utf8_string_magic (string_p, string_size, &magic_string_id))
+  {
+    magic_string_p = ecma_get_magic_string (magic_string_id);
+  }
+  else if (lit_is_ex_utf8_string_magic (string_p, string_size, &magic_string_ex_id))
+  {
+    magic_string_p = ecma_get_magic_string_ex (magic_string_ex_id);
+  }
+
+  if (magic_string_p != NULL)
+  {
+    if (free_cb != 0)
+    {
+      jerry_dispatch_external_string_free_callback (free_cb, string_p, string_size);
+    }
+    return magic_string_p;
+  }
+
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_EXTERNAL_STRING);
+  ecma_external_string_t *string_desc_p = jmem_heap_alloc_block (sizeof (ecma_external_string_t));
+  JERRY_CONTEXT (ecma_strings_number)++;
+
+  string_desc_p->header.refs_and_container = ECMA_STRING_CONTAINER_EXTERNAL_STRING | ECMA_STRING_REF_ONE;
+  string_desc_p->header.hash = string_hash;
+  string_desc_p->header.u.common_field = 0;
+  string_desc_p->size = string_size;
+  string_desc_p->length = string_length;
+  string_desc_p->buffer_p = string_p;
+  string_desc_p->free_cb = free_cb;
+
+  if (free_cb != 0)
+  {
+    JERRY_CONTEXT (ecma_free_callback_count)++;
+  }
+
+  return (ecma_string_t *) string_desc_p;
+} /* ecma_new_ecma_external_string_with_hash */
+
+/**
+ * Allocate new ecma-string which refers to a host-owned cesu-8 buffer
+ *
+ * See also:
+ *          ecma_new_ecma_external_string_with_hash
+ *
+ * @return pointer to ecma-string descriptor
+ */
+ecma_string_t *
+ecma_new_ecma_external_string (const lit_utf8_byte_t *string_p, /**< cesu-8 string */
+                               lit_utf8_size_t string_size, /**< string size */
+                               ecma_external_pointer_t free_cb) /**< free callback of the buffer (can be 0) */
+{
+  JERRY_ASSERT (string_p != NULL || string_size == 0);
+
+  return ecma_new_ecma_external_string_with_hash (string_p,
+                                                  string_size,
+                                                  lit_utf8_string_length (string_p, string_size),
+                                                  lit_utf8_string_calc_hash (string_p, string_size),
+                                                  free_cb);
+} /* ecma_new_ecma_external_string */
+
 /**
  * Initialize an ecma-string with an ecma-number
  */
@@ -206,7 +307,8 @@ ecma_init_ecma_length_string (ecma_string_t *string_desc_p) /**< ecma-string */
 ecma_string_t *
 ecma_new_ecma_string_from_uint32 (uint32_t uint32_number) /**< uint32 value of the string */
 {
-  ecma_string_t *string_desc_p = ecma_alloc_string ();
+  ecma_string_t *string_desc_p = ecma_alloc_string (JMEM_ALLOC_CATEGORY_UINT32_STRING);
+  JERRY_CONTEXT (ecma_strings_number)++;
 
   ecma_init_ecma_string_from_uint32 (string_desc_p, uint32_number);
   return string_desc_p;
@@ -250,7 +352,9 @@ ecma_new_ecma_string_from_number (ecma_number_t num) /**< ecma-number */
                 && !lit_is_ex_utf8_string_magic (str_buf, str_size, &magic_string_ex_id));
 #endif /* !JERRY_NDEBUG */
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_STRING);
   ecma_string_t *string_desc_p = jmem_heap_alloc_block (sizeof (ecma_string_t) + str_size);
+  JERRY_CONTEXT (ecma_strings_number)++;
 
   string_desc_p->refs_and_container = ECMA_STRING_CONTAINER_HEAP_UTF8_STRING | ECMA_STRING_REF_ONE;
   string_desc_p->hash = lit_utf8_string_calc_hash (str_buf, str_size);
@@ -273,7 +377,8 @@ ecma_new_ecma_string_from_magic_string_id (lit_magic_string_id_t id) /**< identi
 {
   JERRY_ASSERT (id < LIT_MAGIC_STRING__COUNT);
 
-  ecma_string_t *string_desc_p = ecma_alloc_string ();
+  ecma_string_t *string_desc_p = ecma_alloc_string (JMEM_ALLOC_CATEGORY_MAGIC_STRING);
+  JERRY_CONTEXT (ecma_strings_number)++;
   ecma_init_ecma_string_from_magic_string_id (string_desc_p, id);
 
   return string_desc_p;
@@ -289,7 +394,8 @@ ecma_new_ecma_string_from_magic_string_ex_id (lit_magic_string_ex_id_t id) /**<
 {
   JERRY_ASSERT (id < lit_get_magic_string_ex_count ());
 
-  ecma_string_t *string_desc_p = ecma_alloc_string ();
+  ecma_string_t *string_desc_p = ecma_alloc_string (JMEM_ALLOC_CATEGORY_MAGIC_STRING);
+  JERRY_CONTEXT (ecma_strings_number)++;
   ecma_init_ecma_string_from_magic_string_ex_id (string_desc_p, id);
 
   return string_desc_p;
@@ -303,7 +409,8 @@ ecma_new_ecma_string_from_magic_string_ex_id (lit_magic_string_ex_id_t id) /**<
 ecma_string_t *
 ecma_new_ecma_length_string (void)
 {
-  ecma_string_t *string_desc_p = ecma_alloc_string ();
+  ecma_string_t *string_desc_p = ecma_alloc_string (JMEM_ALLOC_CATEGORY_MAGIC_STRING);
+  JERRY_CONTEXT (ecma_strings_number)++;
   ecma_init_ecma_length_string (string_desc_p);
 
   return string_desc_p;
@@ -348,6 +455,15 @@ ecma_concat_ecma_strings (ecma_string_t *string1_p, /**< first ecma-string */
       utf8_string1_length = string1_p->u.utf8_string.length;
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string1_p;
+
+      utf8_string1_p = external_string_p->buffer_p;
+      utf8_string1_size = external_string_p->size;
+      utf8_string1_length = external_string_p->length;
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       utf8_string1_size = ecma_uint32_to_utf8_string (string1_p->u.uint32_number,
@@ -384,6 +500,15 @@ ecma_concat_ecma_strings (ecma_string_t *string1_p, /**< first ecma-string */
       utf8_string2_length = string2_p->u.utf8_string.length;
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string2_p;
+
+      utf8_string2_p = external_string_p->buffer_p;
+      utf8_string2_size = external_string_p->size;
+      utf8_string2_length = external_string_p->length;
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       utf8_string2_size = ecma_uint32_to_utf8_string (string2_p->u.uint32_number,
@@ -418,9 +543,14 @@ ecma_concat_ecma_strings (ecma_string_t *string1_p, /**< first ecma-string */
 
   lit_utf8_size_t new_size = utf8_string1_size + utf8_string2_size;
 
-  JERRY_ASSERT (new_size <= UINT16_MAX);
+  if (unlikely (new_size > UINT16_MAX))
+  {
+    jerry_fatal (ERR_OUT_OF_MEMORY);
+  }
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_STRING);
   ecma_string_t *string_desc_p = jmem_heap_alloc_block (sizeof (ecma_string_t) + new_size);
+  JERRY_CONTEXT (ecma_strings_number)++;
 
   string_desc_p->refs_and_container = ECMA_STRING_CONTAINER_HEAP_UTF8_STRING | ECMA_STRING_REF_ONE;
   string_desc_p->hash = lit_utf8_string_hash_combine (string1_p->hash, utf8_string2_p, utf8_string2_size);
@@ -473,6 +603,9 @@ ecma_deref_ecma_string (ecma_string_t *string_p) /**< ecma-string */
     return;
   }
 
+  JERRY_ASSERT (JERRY_CONTEXT (ecma_strings_number) > 0);
+  JERRY_CONTEXT (ecma_strings_number)--;
+
   switch (ECMA_STRING_GET_CONTAINER (string_p))
   {
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
@@ -480,6 +613,23 @@ ecma_deref_ecma_string (ecma_string_t *string_p) /**< ecma-string */
       jmem_heap_free_block (string_p, string_p->u.utf8_string.size + sizeof (ecma_string_t));
       return;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      ecma_external_string_t *external_string_p = (ecma_external_string_t *) string_p;
+
+      if (external_string_p->free_cb != 0)
+      {
+        JERRY_ASSERT (JERRY_CONTEXT (ecma_free_callback_count) > 0);
+        JERRY_CONTEXT (ecma_free_callback_count)--;
+
+        jerry_dispatch_external_string_free_callback (external_string_p->free_cb,
+                                                      external_string_p->buffer_p,
+                                                      external_string_p->size);
+      }
+
+      jmem_heap_free_block (external_string_p, sizeof (ecma_external_string_t));
+      return;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     case ECMA_STRING_CONTAINER_MAGIC_STRING:
     case ECMA_STRING_CONTAINER_MAGIC_STRING_EX:
@@ -518,6 +668,7 @@ ecma_string_to_number (const ecma_string_t *str_p) /**< ecma-string */
     }
 
     case ECMA_STRING_CONTAINER_HEAP_UTF8_STRING:
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
     case ECMA_STRING_CONTAINER_MAGIC_STRING:
     case ECMA_STRING_CONTAINER_MAGIC_STRING_EX:
     {
@@ -576,6 +727,11 @@ ecma_string_get_array_index (const ecma_string_t *str_p, /**< ecma-string */
       size = lit_get_magic_string_ex_size (str_p->u.magic_string_ex_id);
       raw_str_p = lit_get_magic_string_ex_utf8 (str_p->u.magic_string_ex_id);
     }
+    else if (type == ECMA_STRING_CONTAINER_EXTERNAL_STRING)
+    {
+      size = ((const ecma_external_string_t *) str_p)->size;
+      raw_str_p = ((const ecma_external_string_t *) str_p)->buffer_p;
+    }
     else
     {
       JERRY_ASSERT (type == ECMA_STRING_CONTAINER_HEAP_UTF8_STRING);
@@ -660,6 +816,14 @@ ecma_string_copy_to_utf8_buffer (const ecma_string_t *string_desc_p, /**< ecma-s
       memcpy (buffer_p, string_desc_p + 1, size);
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string_desc_p;
+
+      size = external_string_p->size;
+      memcpy (buffer_p, external_string_p->buffer_p, size);
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       const uint32_t uint32_number = string_desc_p->u.uint32_number;
@@ -791,6 +955,15 @@ ecma_string_raw_chars (const ecma_string_t *string_p, /**< ecma-string */
       result_p = (const lit_utf8_byte_t *) (string_p + 1);
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string_p;
+
+      size = external_string_p->size;
+      length = external_string_p->length;
+      result_p = external_string_p->buffer_p;
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       size = (lit_utf8_size_t) ecma_string_get_number_in_desc_size (string_p->u.uint32_number);
@@ -906,7 +1079,7 @@ ecma_compare_ecma_strings_longpath (const ecma_string_t *string1_p, /* ecma-stri
       }
       default:
       {
-        JERRY_ASSERT (ECMA_STRING_GET_CONTAINER (string1_p) == ECMA_STRING_CONTAINER_HEAP_UTF8_STRING);
+        JERRY_ASSERT (ECMA_STRING_CONTAINER_HAS_BUFFER (ECMA_STRING_GET_CONTAINER (string1_p)));
         break;
       }
     }
@@ -926,6 +1099,14 @@ ecma_compare_ecma_strings_longpath (const ecma_string_t *string1_p, /* ecma-stri
       utf8_string1_size = string1_p->u.utf8_string.size;
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string1_p;
+
+      utf8_string1_p = external_string_p->buffer_p;
+      utf8_string1_size = external_string_p->size;
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       utf8_string1_size = ecma_uint32_to_utf8_string (string1_p->u.uint32_number,
@@ -958,6 +1139,14 @@ ecma_compare_ecma_strings_longpath (const ecma_string_t *string1_p, /* ecma-stri
       utf8_string2_size = string2_p->u.utf8_string.size;
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string2_p;
+
+      utf8_string2_p = external_string_p->buffer_p;
+      utf8_string2_size = external_string_p->size;
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       utf8_string2_size = ecma_uint32_to_utf8_string (string2_p->u.uint32_number,
@@ -1014,7 +1203,7 @@ ecma_compare_ecma_strings (const ecma_string_t *string1_p, /* ecma-string */
 
   ecma_string_container_t string1_container = ECMA_STRING_GET_CONTAINER (string1_p);
 
-  if (string1_container != ECMA_STRING_CONTAINER_HEAP_UTF8_STRING
+  if (!ECMA_STRING_CONTAINER_HAS_BUFFER (string1_container)
       && string1_container == ECMA_STRING_GET_CONTAINER (string2_p))
   {
     return string1_p->u.common_field == string2_p->u.common_field;
@@ -1057,6 +1246,14 @@ ecma_compare_ecma_strings_relational (const ecma_string_t *string1_p, /**< ecma-
       utf8_string1_size = string1_p->u.utf8_string.size;
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string1_p;
+
+      utf8_string1_p = external_string_p->buffer_p;
+      utf8_string1_size = external_string_p->size;
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       utf8_string1_size = ecma_uint32_to_utf8_string (string1_p->u.uint32_number,
@@ -1089,6 +1286,14 @@ ecma_compare_ecma_strings_relational (const ecma_string_t *string1_p, /**< ecma-
       utf8_string2_size = string2_p->u.utf8_string.size;
       break;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      const ecma_external_string_t *external_string_p = (const ecma_external_string_t *) string2_p;
+
+      utf8_string2_p = external_string_p->buffer_p;
+      utf8_string2_size = external_string_p->size;
+      break;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       utf8_string2_size = ecma_uint32_to_utf8_string (string2_p->u.uint32_number,
@@ -1133,6 +1338,10 @@ ecma_string_get_length (const ecma_string_t *string_p) /**< ecma-string */
     {
       return (ecma_length_t) (string_p->u.utf8_string.length);
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      return ((const ecma_external_string_t *) string_p)->length;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       return ecma_string_get_number_in_desc_size (string_p->u.uint32_number);
@@ -1168,6 +1377,10 @@ ecma_string_get_size (const ecma_string_t *string_p) /**< ecma-string */
     {
       return (lit_utf8_size_t) string_p->u.utf8_string.size;
     }
+    case ECMA_STRING_CONTAINER_EXTERNAL_STRING:
+    {
+      return ((const ecma_external_string_t *) string_p)->size;
+    }
     case ECMA_STRING_CONTAINER_UINT32_IN_DESC:
     {
       return (lit_utf8_size_t) ecma_string_get_number_in_desc_size (string_p->u.uint32_number);
@@ -22,8 +22,12 @@
 #include "ecma-property-hashmap.h"
 #include "jrt-bit-fields.h"
 #include "byte-code.h"
+#include "jcontext.h"
 #include "re-compiler.h"
 
+#define JERRY_INTERNAL
+#include "jerry-internal.h"
+
 /** \addtogroup ecma ECMA
  * @{
  *
@@ -129,7 +133,7 @@ ecma_create_object (ecma_object_t *prototype_object_p, /**< pointer to prototybe
 ecma_object_t *
 ecma_create_decl_lex_env (ecma_object_t *outer_lexical_environment_p) /**< outer lexical environment */
 {
-  ecma_object_t *new_lexical_environment_p = ecma_alloc_object ();
+  ecma_object_t *new_lexical_environment_p = ecma_alloc_lexical_environment ();
 
   uint16_t type = ECMA_OBJECT_FLAG_BUILT_IN_OR_LEXICAL_ENV | ECMA_LEXICAL_ENVIRONMENT_DECLARATIVE;
   new_lexical_environment_p->type_flags_refs = type;
@@ -162,7 +166,7 @@ ecma_create_object_lex_env (ecma_object_t *outer_lexical_environment_p, /**< out
   JERRY_ASSERT (binding_obj_p != NULL
                 && !ecma_is_lexical_environment (binding_obj_p));
 
-  ecma_object_t *new_lexical_environment_p = ecma_alloc_object ();
+  ecma_object_t *new_lexical_environment_p = ecma_alloc_lexical_environment ();
 
   uint16_t type;
 
@@ -820,8 +824,17 @@ ecma_free_internal_property (ecma_property_t *property_p) /**< the property */
     }
 
     case ECMA_INTERNAL_PROPERTY_NATIVE_HANDLE: /* an external pointer */
+    {
+      ecma_free_external_pointer_in_property (property_p);
+
+      break;
+    }
+
     case ECMA_INTERNAL_PROPERTY_FREE_CALLBACK: /* an external pointer */
     {
+      JERRY_ASSERT (JERRY_CONTEXT (ecma_free_callback_count) > 0);
+      JERRY_CONTEXT (ecma_free_callback_count)--;
+
       ecma_free_external_pointer_in_property (property_p);
 
       break;
@@ -1439,7 +1452,29 @@ ecma_bytecode_deref (ecma_compiled_code_t *bytecode_p) /**< byte code pointer */
     return;
   }
 
-  if (bytecode_p->status_flags & CBC_CODE_FLAGS_FUNCTION)
+  if ((bytecode_p->status_flags & CBC_CODE_FLAGS_FUNCTION)
+      && (bytecode_p->status_flags & CBC_CODE_FLAGS_SNAPSHOT_FUNCTION))
+  {
+    cbc_snapshot_function_t *snapshot_function_p = (cbc_snapshot_function_t *) bytecode_p;
+
+    if (snapshot_function_p->bytecode_cp != JMEM_CP_NULL)
+    {
+      ecma_bytecode_deref (ECMA_GET_NON_NULL_POINTER (ecma_compiled_code_t, snapshot_function_p->bytecode_cp));
+    }
+
+    jerry_snapshot_free_function (bytecode_p);
+  }
+  else if ((bytecode_p->status_flags & CBC_CODE_FLAGS_FUNCTION)
+           && (bytecode_p->status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION))
+  {
+    cbc_lazy_function_t *lazy_function_p = (cbc_lazy_function_t *) bytecode_p;
+
+    if (lazy_function_p->bytecode_cp != JMEM_CP_NULL)
+    {
+      ecma_bytecode_deref (ECMA_GET_NON_NULL_POINTER (ecma_compiled_code_t, lazy_function_p->bytecode_cp));
+    }
+  }
+  else if (bytecode_p->status_flags & CBC_CODE_FLAGS_FUNCTION)
   {
     jmem_cpointer_t *literal_start_p = NULL;
     uint32_t literal_end;
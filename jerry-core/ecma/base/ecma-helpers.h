@@ -164,6 +164,11 @@ extern void ecma_free_value_if_not_object (ecma_value_t);
 /* ecma-helpers-string.c */
 extern ecma_string_t *ecma_new_ecma_string_from_utf8 (const lit_utf8_byte_t *, lit_utf8_size_t);
 extern ecma_string_t *ecma_new_ecma_string_from_code_unit (ecma_char_t);
+extern ecma_string_t *ecma_new_ecma_external_string_with_hash (const lit_utf8_byte_t *, lit_utf8_size_t,
+                                                               ecma_length_t, lit_string_hash_t,
+                                                               ecma_external_pointer_t);
+extern ecma_string_t *ecma_new_ecma_external_string (const lit_utf8_byte_t *, lit_utf8_size_t,
+                                                     ecma_external_pointer_t);
 extern ecma_string_t *ecma_new_ecma_string_from_uint32 (uint32_t);
 extern ecma_string_t *ecma_new_ecma_string_from_number (ecma_number_t);
 extern ecma_string_t *ecma_new_ecma_string_from_magic_string_id (lit_magic_string_id_t);
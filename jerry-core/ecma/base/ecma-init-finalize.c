@@ -20,7 +20,10 @@
 #include "ecma-lcache.h"
 #include "ecma-lex-env.h"
 #include "ecma-literal-storage.h"
+#include "jcontext.h"
+#include "jerry-port.h"
 #include "jmem-allocator.h"
+#include "js-parser.h"
 
 /** \addtogroup ecma ECMA
  * @{
@@ -38,6 +41,10 @@ ecma_init (void)
   ecma_lcache_init ();
   ecma_init_global_lex_env ();
 
+#ifndef CONFIG_DISABLE_PERFORMANCE_BUILTIN
+  JERRY_CONTEXT (ecma_builtin_performance_time_origin) = jerry_port_get_monotonic_time ();
+#endif /* !CONFIG_DISABLE_PERFORMANCE_BUILTIN */
+
   jmem_register_free_unused_memory_callback (ecma_free_unused_memory);
 } /* ecma_init */
 
@@ -49,12 +56,106 @@ ecma_finalize (void)
 {
   jmem_unregister_free_unused_memory_callback (ecma_free_unused_memory);
 
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+  parser_code_cache_free ();
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
   ecma_finalize_global_lex_env ();
   ecma_finalize_builtins ();
   ecma_gc_run (JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW);
   ecma_finalize_lit_storage ();
 } /* ecma_finalize */
 
+/**
+ * Store the state of ECMA components into a heap image
+ *
+ * Note:
+ *      the look-up cache is invalidated, since it is not stored
+ */
+void
+ecma_save_image (ecma_image_info_t *info_p) /**< [out] ECMA state */
+{
+  JERRY_ASSERT (JERRY_CONTEXT (vm_top_context_p) == NULL);
+
+  /* Properties are flagged when they are cached, and the cache is not stored. */
+  ecma_lcache_invalidate_all ();
+
+  for (uint32_t i = 0; i < ECMA_BUILTIN_ID__COUNT; i++)
+  {
+    ECMA_SET_POINTER (info_p->builtin_objects_cp[i], JERRY_CONTEXT (ecma_builtin_objects)[i]);
+  }
+
+  for (uint32_t i = 0; i < ECMA_GC_COLOR__COUNT; i++)
+  {
+    ECMA_SET_POINTER (info_p->gc_objects_lists_cp[i], JERRY_CONTEXT (ecma_gc_objects_lists)[i]);
+  }
+
+#ifndef CONFIG_DISABLE_REGEXP_BUILTIN
+  for (uint32_t i = 0; i < RE_CACHE_SIZE; i++)
+  {
+    ECMA_SET_POINTER (info_p->re_cache_cp[i], JERRY_CONTEXT (re_cache)[i]);
+  }
+
+  info_p->re_cache_idx = JERRY_CONTEXT (re_cache_idx);
+#endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
+
+  info_p->gc_visited_flip_flag = JERRY_CONTEXT (ecma_gc_visited_flip_flag);
+  ECMA_SET_POINTER (info_p->string_list_first_cp, JERRY_CONTEXT (string_list_first_p));
+  ECMA_SET_POINTER (info_p->number_list_first_cp, JERRY_CONTEXT (number_list_first_p));
+  ECMA_SET_POINTER (info_p->global_lex_env_cp, JERRY_CONTEXT (ecma_global_lex_env_p));
+  info_p->gc_objects_number = (uint32_t) JERRY_CONTEXT (ecma_gc_objects_number);
+  info_p->gc_new_objects = (uint32_t) JERRY_CONTEXT (ecma_gc_new_objects);
+  info_p->strings_number = (uint32_t) JERRY_CONTEXT (ecma_strings_number);
+  info_p->free_callback_count = JERRY_CONTEXT (ecma_free_callback_count);
+} /* ecma_save_image */
+
+/**
+ * Initialize ECMA components from a heap image
+ *
+ * Note:
+ *      the heap must be loaded before
+ */
+void
+ecma_load_image (const ecma_image_info_t *info_p) /**< ECMA state */
+{
+  ecma_lcache_init ();
+
+  for (uint32_t i = 0; i < ECMA_BUILTIN_ID__COUNT; i++)
+  {
+    JERRY_CONTEXT (ecma_builtin_objects)[i] = ECMA_GET_POINTER (ecma_object_t, info_p->builtin_objects_cp[i]);
+  }
+
+  for (uint32_t i = 0; i < ECMA_GC_COLOR__COUNT; i++)
+  {
+    JERRY_CONTEXT (ecma_gc_objects_lists)[i] = ECMA_GET_POINTER (ecma_object_t, info_p->gc_objects_lists_cp[i]);
+  }
+
+#ifndef CONFIG_DISABLE_REGEXP_BUILTIN
+  for (uint32_t i = 0; i < RE_CACHE_SIZE; i++)
+  {
+    JERRY_CONTEXT (re_cache)[i] = ECMA_GET_POINTER (const re_compiled_code_t, info_p->re_cache_cp[i]);
+  }
+
+  JERRY_CONTEXT (re_cache_idx) = info_p->re_cache_idx;
+#endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
+
+  JERRY_CONTEXT (ecma_gc_visited_flip_flag) = (info_p->gc_visited_flip_flag != 0);
+  JERRY_CONTEXT (string_list_first_p) = ECMA_GET_POINTER (ecma_lit_storage_item_t, info_p->string_list_first_cp);
+  JERRY_CONTEXT (number_list_first_p) = ECMA_GET_POINTER (ecma_lit_storage_item_t, info_p->number_list_first_cp);
+  JERRY_CONTEXT (ecma_global_lex_env_p) = ECMA_GET_POINTER (ecma_object_t, info_p->global_lex_env_cp);
+  JERRY_CONTEXT (ecma_gc_objects_number) = info_p->gc_objects_number;
+  JERRY_CONTEXT (ecma_gc_new_objects) = info_p->gc_new_objects;
+  JERRY_CONTEXT (ecma_strings_number) = info_p->strings_number;
+  JERRY_CONTEXT (ecma_free_callback_count) = info_p->free_callback_count;
+
+#ifndef CONFIG_DISABLE_PERFORMANCE_BUILTIN
+  /* The time origin is not stored, since the loaded engine starts a new time line. */
+  JERRY_CONTEXT (ecma_builtin_performance_time_origin) = jerry_port_get_monotonic_time ();
+#endif /* !CONFIG_DISABLE_PERFORMANCE_BUILTIN */
+
+  jmem_register_free_unused_memory_callback (ecma_free_unused_memory);
+} /* ecma_load_image */
+
 /**
  * @}
  * @}
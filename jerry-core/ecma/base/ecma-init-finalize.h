@@ -16,6 +16,10 @@
 #ifndef ECMA_INIT_FINALIZE_H
 #define ECMA_INIT_FINALIZE_H
 
+#include "ecma-builtins.h"
+#include "ecma-globals.h"
+#include "re-bytecode.h"
+
 /** \addtogroup ecma ECMA
  * @{
  *
@@ -23,8 +27,33 @@
  * @{
  */
 
+/**
+ * Description of the ECMA state stored in a heap image
+ *
+ * All pointers are stored as compressed pointers.
+ */
+typedef struct
+{
+  jmem_cpointer_t builtin_objects_cp[ECMA_BUILTIN_ID__COUNT]; /**< instances of built-in objects */
+  jmem_cpointer_t gc_objects_lists_cp[ECMA_GC_COLOR__COUNT]; /**< lists of objects */
+#ifndef CONFIG_DISABLE_REGEXP_BUILTIN
+  jmem_cpointer_t re_cache_cp[RE_CACHE_SIZE]; /**< regex cache */
+  uint8_t re_cache_idx; /**< evicted item index when regex cache is full */
+#endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
+  uint8_t gc_visited_flip_flag; /**< current state of an object's visited flag */
+  jmem_cpointer_t string_list_first_cp; /**< first item of the literal string list */
+  jmem_cpointer_t number_list_first_cp; /**< first item of the literal number list */
+  jmem_cpointer_t global_lex_env_cp; /**< global lexical environment */
+  uint32_t gc_objects_number; /**< number of currently allocated objects */
+  uint32_t gc_new_objects; /**< number of newly allocated objects since last GC session */
+  uint32_t strings_number; /**< number of currently allocated strings */
+  uint32_t free_callback_count; /**< number of host free callbacks which are not called yet */
+} ecma_image_info_t;
+
 extern void ecma_init (void);
 extern void ecma_finalize (void);
+extern void ecma_save_image (ecma_image_info_t *);
+extern void ecma_load_image (const ecma_image_info_t *);
 
 /**
  * @}
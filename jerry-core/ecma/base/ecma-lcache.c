@@ -78,6 +78,28 @@ ecma_lcache_row_index (jmem_cpointer_t object_cp, /**< compressed pointer to obj
 } /* ecma_lcache_row_index */
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
+/**
+ * Invalidate all LCache entries
+ */
+void
+ecma_lcache_invalidate_all (void)
+{
+#ifndef CONFIG_ECMA_LCACHE_DISABLE
+  for (uint32_t row_index = 0; row_index < ECMA_LCACHE_HASH_ROWS_COUNT; row_index++)
+  {
+    ecma_lcache_hash_entry_t *entries_p = JERRY_HASH_TABLE_CONTEXT (table)[row_index];
+
+    for (uint32_t entry_index = 0; entry_index < ECMA_LCACHE_HASH_ROW_LENGTH; entry_index++)
+    {
+      if (entries_p[entry_index].object_cp != ECMA_NULL_POINTER)
+      {
+        ecma_lcache_invalidate_entry (entries_p + entry_index);
+      }
+    }
+  }
+#endif /* !CONFIG_ECMA_LCACHE_DISABLE */
+} /* ecma_lcache_invalidate_all */
+
 /**
  * Insert an entry into LCache
  */
@@ -164,13 +186,16 @@ ecma_lcache_lookup (ecma_object_t *object_p, /**< object */
       JERRY_ASSERT ((prop_name_p->hash & ECMA_LCACHE_HASH_MASK) == (entry_prop_name_p->hash & ECMA_LCACHE_HASH_MASK));
 
       if (prop_name_p == entry_prop_name_p
-          || (prop_container != ECMA_STRING_CONTAINER_HEAP_UTF8_STRING
+          || (!ECMA_STRING_CONTAINER_HAS_BUFFER (prop_container)
               && prop_container == ECMA_STRING_GET_CONTAINER (entry_prop_name_p)
               && prop_name_p->u.common_field == entry_prop_name_p->u.common_field))
       {
         ecma_property_t *prop_p = entry_p->prop_p;
         JERRY_ASSERT (prop_p != NULL && ecma_is_property_lcached (prop_p));
 
+#ifdef JERRY_RUNTIME_STATS
+        JERRY_CONTEXT (ecma_lcache_hits)++;
+#endif /* JERRY_RUNTIME_STATS */
         return prop_p;
       }
       else
@@ -180,6 +205,10 @@ ecma_lcache_lookup (ecma_object_t *object_p, /**< object */
     }
     entry_p++;
   }
+
+#ifdef JERRY_RUNTIME_STATS
+  JERRY_CONTEXT (ecma_lcache_misses)++;
+#endif /* JERRY_RUNTIME_STATS */
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
   return NULL;
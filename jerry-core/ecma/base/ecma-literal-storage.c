@@ -65,16 +65,17 @@ ecma_finalize_lit_storage (void)
 } /* ecma_finalize_lit_storage */
 
 /**
- * Find or create a literal string.
+ * Find a literal string equal to the passed string, or insert the string
+ * into the literal storage if no such literal exists.
+ *
+ * Note:
+ *      the reference of the passed string is taken over
  *
  * @return ecma_string_t compressed pointer
  */
-jmem_cpointer_t
-ecma_find_or_create_literal_string (const lit_utf8_byte_t *chars_p, /**< string to be searched */
-                                    lit_utf8_size_t size) /**< size of the string */
+static jmem_cpointer_t
+ecma_find_or_insert_literal_string (ecma_string_t *string_p) /**< string to be searched */
 {
-  ecma_string_t *string_p = ecma_new_ecma_string_from_utf8 (chars_p, size);
-
   ecma_lit_storage_item_t *string_list_p = JERRY_CONTEXT (string_list_first_p);
   jmem_cpointer_t *empty_cpointer_p = NULL;
 
@@ -115,6 +116,7 @@ ecma_find_or_create_literal_string (const lit_utf8_byte_t *chars_p, /**< string
     return result;
   }
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_LITERAL_STORAGE);
   ecma_lit_storage_item_t *new_item_p = (ecma_lit_storage_item_t *) jmem_pools_alloc ();
 
   new_item_p->values[0] = result;
@@ -127,6 +129,18 @@ ecma_find_or_create_literal_string (const lit_utf8_byte_t *chars_p, /**< string
   JERRY_CONTEXT (string_list_first_p) = new_item_p;
 
   return result;
+} /* ecma_find_or_insert_literal_string */
+
+/**
+ * Find or create a literal string.
+ *
+ * @return ecma_string_t compressed pointer
+ */
+jmem_cpointer_t
+ecma_find_or_create_literal_string (const lit_utf8_byte_t *chars_p, /**< string to be searched */
+                                    lit_utf8_size_t size) /**< size of the string */
+{
+  return ecma_find_or_insert_literal_string (ecma_new_ecma_string_from_utf8 (chars_p, size));
 } /* ecma_find_or_create_literal_string */
 
 /**
@@ -182,7 +196,10 @@ ecma_find_or_create_literal_number (ecma_number_t number_arg) /**< number to be
     number_list_p = JMEM_CP_GET_POINTER (ecma_lit_storage_item_t, number_list_p->next_cp);
   }
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_LITERAL_STORAGE);
   ecma_string_t *string_p = (ecma_string_t *) jmem_pools_alloc ();
+  JERRY_CONTEXT (ecma_strings_number)++;
+
   string_p->refs_and_container = ECMA_STRING_REF_ONE | ECMA_STRING_LITERAL_NUMBER;
   string_p->u.lit_number = num;
 
@@ -195,6 +212,7 @@ ecma_find_or_create_literal_number (ecma_number_t number_arg) /**< number to be
     return result;
   }
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_LITERAL_STORAGE);
   ecma_lit_storage_item_t *new_item_p = (ecma_lit_storage_item_t *) jmem_pools_alloc ();
 
   new_item_p->values[0] = result;
@@ -219,8 +237,36 @@ ecma_find_or_create_literal_number (ecma_number_t number_arg) /**< number to be
  */
 #define JERRY_SNAPSHOT_LITERAL_ALIGNMENT (1u << JERRY_SNAPSHOT_LITERAL_ALIGNMENT_LOG)
 
+/**
+ * Header of a string literal in the snapshot, followed by the characters of the string.
+ *
+ * The length and the hash are stored as well, so a string can be
+ * loaded without reading its characters.
+ */
+typedef struct
+{
+  uint16_t size; /**< size of the string */
+  uint16_t length; /**< length of the string */
+  lit_string_hash_t hash; /**< hash of the string */
+} ecma_snapshot_string_header_t;
+
 #ifdef JERRY_ENABLE_SNAPSHOT_SAVE
 
+/**
+ * Checks whether a literal is saved into the snapshot.
+ *
+ * @return true - if the literal is saved
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+ecma_literal_is_saved_for_snapshot (const uint8_t *used_literals_p, /**< bitmap of the used literals
+                                                                      *   (NULL: all literals are used) */
+                                    jmem_cpointer_t literal_cp) /**< literal */
+{
+  return (literal_cp != JMEM_CP_NULL
+          && (used_literals_p == NULL || (used_literals_p[literal_cp >> 3] & (1u << (literal_cp & 0x7)))));
+} /* ecma_literal_is_saved_for_snapshot */
+
 /**
  * Save literals to specified snapshot buffer.
  *
@@ -231,6 +277,9 @@ bool
 ecma_save_literals_for_snapshot (uint8_t *buffer_p, /**< [out] output snapshot buffer */
                                  size_t buffer_size, /**< size of the buffer */
                                  size_t *in_out_buffer_offset_p, /**< [in,out] write position in the buffer */
+                                 const uint8_t *used_literals_p, /**< bitmap of the literals which are saved,
+                                                                  *   indexed by their compressed pointers
+                                                                  *   (NULL: all literals are saved) */
                                  lit_mem_to_snapshot_id_map_entry_t **out_map_p, /**< [out] map from literal identifiers
                                                                                   *   to the literal offsets
                                                                                   *   in snapshot */
@@ -248,12 +297,13 @@ ecma_save_literals_for_snapshot (uint8_t *buffer_p, /**< [out] output snapshot b
   {
     for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
     {
-      if (string_list_p->values[i] != JMEM_CP_NULL)
+      if (ecma_literal_is_saved_for_snapshot (used_literals_p, string_list_p->values[i]))
       {
         ecma_string_t *string_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t,
                                                                 string_list_p->values[i]);
 
-        lit_table_size += (uint32_t) JERRY_ALIGNUP (sizeof (uint16_t) + ecma_string_get_size (string_p),
+        lit_table_size += (uint32_t) JERRY_ALIGNUP (sizeof (ecma_snapshot_string_header_t)
+                                                    + ecma_string_get_size (string_p),
                                                     JERRY_SNAPSHOT_LITERAL_ALIGNMENT);
         string_count++;
       }
@@ -268,7 +318,7 @@ ecma_save_literals_for_snapshot (uint8_t *buffer_p, /**< [out] output snapshot b
   {
     for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
     {
-      if (number_list_p->values[i] != JMEM_CP_NULL)
+      if (ecma_literal_is_saved_for_snapshot (used_literals_p, number_list_p->values[i]))
       {
         lit_table_size += (uint32_t) sizeof (ecma_number_t);
         number_count++;
@@ -318,7 +368,7 @@ ecma_save_literals_for_snapshot (uint8_t *buffer_p, /**< [out] output snapshot b
   {
     for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
     {
-      if (string_list_p->values[i] != JMEM_CP_NULL)
+      if (ecma_literal_is_saved_for_snapshot (used_literals_p, string_list_p->values[i]))
       {
         map_p->literal_id = string_list_p->values[i];
         map_p->literal_offset = (jmem_cpointer_t) (literal_offset >> JERRY_SNAPSHOT_LITERAL_ALIGNMENT_LOG);
@@ -329,10 +379,15 @@ ecma_save_literals_for_snapshot (uint8_t *buffer_p, /**< [out] output snapshot b
 
         ecma_length_t length = ecma_string_get_size (string_p);
 
-        *((uint16_t *) buffer_p) = (uint16_t) length;
-        ecma_string_to_utf8_bytes (string_p, buffer_p + sizeof (uint16_t), length);
+        ecma_snapshot_string_header_t header;
+        header.size = (uint16_t) length;
+        header.length = (uint16_t) ecma_string_get_length (string_p);
+        header.hash = ecma_string_hash (string_p);
+
+        memcpy (buffer_p, &header, sizeof (ecma_snapshot_string_header_t));
+        ecma_string_to_utf8_bytes (string_p, buffer_p + sizeof (ecma_snapshot_string_header_t), length);
 
-        length = JERRY_ALIGNUP (sizeof (uint16_t) + length,
+        length = JERRY_ALIGNUP (sizeof (ecma_snapshot_string_header_t) + length,
                                 JERRY_SNAPSHOT_LITERAL_ALIGNMENT);
 
         buffer_p += length;
@@ -349,7 +404,7 @@ ecma_save_literals_for_snapshot (uint8_t *buffer_p, /**< [out] output snapshot b
   {
     for (int i = 0; i < ECMA_LIT_STORAGE_VALUE_COUNT; i++)
     {
-      if (number_list_p->values[i] != JMEM_CP_NULL)
+      if (ecma_literal_is_saved_for_snapshot (used_literals_p, number_list_p->values[i]))
       {
         map_p->literal_id = number_list_p->values[i];
         map_p->literal_offset = (jmem_cpointer_t) (literal_offset >> JERRY_SNAPSHOT_LITERAL_ALIGNMENT_LOG);
@@ -394,7 +449,8 @@ ecma_load_literals_from_buffer (const uint8_t *buffer_p, /**< buffer with litera
                                 uint32_t lit_table_size, /**< size of literal table in snapshot */
                                 lit_mem_to_snapshot_id_map_entry_t *map_p, /**< literal map */
                                 uint32_t string_count, /**< number of strings */
-                                uint32_t number_count) /**< number of numbers */
+                                uint32_t number_count, /**< number of numbers */
+                                bool copy_strings) /**< strings should be copied to memory */
 {
   /* The zero value is reserved for NULL (no literal)
    * constant so the first literal must have offset one. */
@@ -403,14 +459,16 @@ ecma_load_literals_from_buffer (const uint8_t *buffer_p, /**< buffer with litera
   /* Load strings first. */
   while (string_count > 0)
   {
-    if (lit_table_size < literal_offset + sizeof (uint32_t))
+    if (lit_table_size < literal_offset + sizeof (ecma_snapshot_string_header_t))
     {
       /* Buffer is not sufficent. */
       return false;
     }
 
-    lit_utf8_size_t length = *((uint16_t *) buffer_p);
-    lit_utf8_size_t aligned_length = JERRY_ALIGNUP (sizeof (uint16_t) + length,
+    ecma_snapshot_string_header_t header;
+    memcpy (&header, buffer_p, sizeof (ecma_snapshot_string_header_t));
+
+    lit_utf8_size_t aligned_length = JERRY_ALIGNUP (sizeof (ecma_snapshot_string_header_t) + header.size,
                                                     JERRY_SNAPSHOT_LITERAL_ALIGNMENT);
 
     if (lit_table_size < literal_offset + aligned_length)
@@ -419,7 +477,25 @@ ecma_load_literals_from_buffer (const uint8_t *buffer_p, /**< buffer with litera
       return false;
     }
 
-    map_p->literal_id = ecma_find_or_create_literal_string (buffer_p + sizeof (uint16_t), length);
+    const lit_utf8_byte_t *chars_p = buffer_p + sizeof (ecma_snapshot_string_header_t);
+
+    /* Short strings are copied, since their descriptor is smaller than an external one. */
+    if (copy_strings
+        || header.size <= sizeof (ecma_external_string_t) - sizeof (ecma_string_t))
+    {
+      map_p->literal_id = ecma_find_or_create_literal_string (chars_p, header.size);
+    }
+    else
+    {
+      /* The characters are used directly from the snapshot buffer. */
+      ecma_string_t *string_p = ecma_new_ecma_external_string_with_hash (chars_p,
+                                                                         header.size,
+                                                                         header.length,
+                                                                         header.hash,
+                                                                         0);
+      map_p->literal_id = ecma_find_or_insert_literal_string (string_p);
+    }
+
     map_p->literal_offset = (jmem_cpointer_t) (literal_offset >> JERRY_SNAPSHOT_LITERAL_ALIGNMENT_LOG);
     map_p++;
 
@@ -470,7 +546,9 @@ ecma_load_literals_from_snapshot (const uint8_t *buffer_p, /**< buffer with lite
                                                                                    *   in snapshot to identifiers
                                                                                    *   of loaded literals in literal
                                                                                    *   storage */
-                                  uint32_t *out_map_len_p) /**< [out] literals number */
+                                  uint32_t *out_map_len_p, /**< [out] literals number */
+                                  bool copy_strings) /**< strings should be copied to memory. If not set,
+                                                      *   the buffer must be kept until jerry_cleanup */
 {
   *out_map_p = NULL;
 
@@ -497,7 +575,12 @@ ecma_load_literals_from_snapshot (const uint8_t *buffer_p, /**< buffer with lite
   map_p = jmem_heap_alloc_block (total_count * sizeof (lit_mem_to_snapshot_id_map_entry_t));
   *out_map_p = map_p;
 
-  if (ecma_load_literals_from_buffer (buffer_p, lit_table_size, map_p, string_count, number_count))
+  if (ecma_load_literals_from_buffer (buffer_p,
+                                      lit_table_size,
+                                      map_p,
+                                      string_count,
+                                      number_count,
+                                      copy_strings))
   {
     return true;
   }
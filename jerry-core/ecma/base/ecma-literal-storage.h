@@ -44,14 +44,14 @@ extern jmem_cpointer_t ecma_find_or_create_literal_number (ecma_number_t);
 
 #ifdef JERRY_ENABLE_SNAPSHOT_SAVE
 extern bool
-ecma_save_literals_for_snapshot (uint8_t *, size_t, size_t *,
+ecma_save_literals_for_snapshot (uint8_t *, size_t, size_t *, const uint8_t *,
                                  lit_mem_to_snapshot_id_map_entry_t **, uint32_t *, uint32_t *);
 #endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
 
 #ifdef JERRY_ENABLE_SNAPSHOT_EXEC
 extern bool
 ecma_load_literals_from_snapshot (const uint8_t *, uint32_t,
-                                  lit_mem_to_snapshot_id_map_entry_t **, uint32_t *);
+                                  lit_mem_to_snapshot_id_map_entry_t **, uint32_t *, bool);
 #endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
 
 /**
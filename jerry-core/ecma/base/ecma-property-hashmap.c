@@ -17,6 +17,7 @@
 #include "ecma-globals.h"
 #include "ecma-helpers.h"
 #include "ecma-property-hashmap.h"
+#include "jcontext.h"
 #include "jrt-libc-includes.h"
 
 /** \addtogroup ecma ECMA
@@ -28,12 +29,6 @@
 
 #ifndef CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE
 
-/**
- * Compute the total size of the property hashmap.
- */
-#define ECMA_PROPERTY_HASHMAP_GET_TOTAL_SIZE(max_property_count) \
-  (sizeof (ecma_property_hashmap_t) + (max_property_count * sizeof (jmem_cpointer_t)) + (max_property_count >> 3))
-
 /**
  * Number of items in the stepping table.
  */
@@ -110,6 +105,7 @@ ecma_property_hashmap_create (ecma_object_t *object_p) /**< object */
 
   size_t total_size = ECMA_PROPERTY_HASHMAP_GET_TOTAL_SIZE (max_property_count);
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_HASHMAP);
   ecma_property_hashmap_t *hashmap_p = (ecma_property_hashmap_t *) jmem_heap_alloc_block_null_on_error (total_size);
 
   if (hashmap_p == NULL)
@@ -53,6 +53,12 @@ typedef struct
    */
 } ecma_property_hashmap_t;
 
+/**
+ * Compute the total size of the property hashmap.
+ */
+#define ECMA_PROPERTY_HASHMAP_GET_TOTAL_SIZE(max_property_count) \
+  (sizeof (ecma_property_hashmap_t) + (max_property_count * sizeof (jmem_cpointer_t)) + (max_property_count >> 3))
+
 extern void ecma_property_hashmap_create (ecma_object_t *);
 extern void ecma_property_hashmap_free (ecma_object_t *);
 extern void ecma_property_hashmap_insert (ecma_object_t *, ecma_string_t *, ecma_property_pair_t *, int);
@@ -168,6 +168,13 @@ OBJECT_VALUE (LIT_MAGIC_STRING_JSON_U,
               ECMA_PROPERTY_CONFIGURABLE_WRITABLE)
 #endif /* !CONFIG_DISABLE_JSON_BUILTIN */
 
+#ifndef CONFIG_DISABLE_PERFORMANCE_BUILTIN
+// Implementation-defined 'performance' object
+OBJECT_VALUE (LIT_MAGIC_STRING_PERFORMANCE,
+              ECMA_BUILTIN_ID_PERFORMANCE,
+              ECMA_PROPERTY_CONFIGURABLE_WRITABLE)
+#endif /* !CONFIG_DISABLE_PERFORMANCE_BUILTIN */
+
 /* Routine properties:
  *  (property name, C routine name, arguments number or NON_FIXED, value of the routine's length property) */
 
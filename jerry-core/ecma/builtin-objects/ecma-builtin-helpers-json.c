@@ -15,8 +15,10 @@
  */
 
 #include "ecma-alloc.h"
+#include "ecma-exceptions.h"
 #include "ecma-helpers.h"
 #include "ecma-builtin-helpers.h"
+#include "jmem-heap.h"
 #include "lit-char-helpers.h"
 
 /** \addtogroup ecma ECMA
@@ -94,215 +96,303 @@ ecma_has_string_value_in_collection (ecma_collection_header_t *collection_p, /**
 } /* ecma_has_string_value_in_collection*/
 
 /**
- * Common function to concatenate key-value pairs into an ecma-string.
- *
- * See also:
- *          ECMA-262 v5, 15.12.3
- *
- * Used by:
- *         - ecma_builtin_helper_json_create_formatted_json step 10.b.ii
- *         - ecma_builtin_helper_json_create_non_formatted_json step 10.a.i
- *
- * @return pointer to ecma-string
- *         Returned value must be freed with ecma_deref_ecma_string.
+ * Initial size of the output buffer when the whole output is collected
  */
-ecma_string_t *
-ecma_builtin_helper_json_create_separated_properties (ecma_collection_header_t *partial_p, /**< key-value pairs*/
-                                                      ecma_string_t *separator_p) /**< separator*/
-{
-  ecma_string_t *properties_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
-  ecma_string_t *tmp_str_p;
+#define ECMA_JSON_WRITER_INITIAL_SIZE 64
 
-  ecma_collection_iterator_t iterator;
-  ecma_collection_iterator_init (&iterator, partial_p);
-
-  uint32_t index = 0;
+/**
+ * Size of the output buffer when the output is passed to a callback
+ */
+#define ECMA_JSON_WRITER_CHUNK_SIZE 256
 
-  while (ecma_collection_iterator_next (&iterator))
-  {
-    ecma_value_t name_value = *iterator.current_value_p;
-    ecma_string_t *current_p = ecma_get_string_from_value (name_value);
+/**
+ * Maximum size of the collected output (limited by the size of a heap string)
+ */
+#define ECMA_JSON_WRITER_MAX_SIZE UINT16_MAX
 
-    if (index == 0)
-    {
-      index++;
+/**
+ * Initialize the output buffer of JSON.stringify()
+ *
+ * Note:
+ *      if the callback is NULL the whole output is collected into a single
+ *      growing buffer, otherwise the output is passed to the callback in chunks
+ */
+void
+ecma_builtin_helper_json_writer_init (ecma_json_writer_t *writer_p, /**< writer */
+                                      ecma_json_output_callback_t callback_p, /**< output callback or NULL */
+                                      void *user_p) /**< user pointer passed to the callback */
+{
+  writer_p->capacity = (callback_p != NULL) ? ECMA_JSON_WRITER_CHUNK_SIZE : ECMA_JSON_WRITER_INITIAL_SIZE;
+  writer_p->buffer_p = (lit_utf8_byte_t *) jmem_heap_alloc_block (writer_p->capacity);
+  writer_p->size = 0;
+  writer_p->callback_p = callback_p;
+  writer_p->user_p = user_p;
+  writer_p->is_overflow = false;
+} /* ecma_builtin_helper_json_writer_init */
 
-      tmp_str_p = ecma_concat_ecma_strings (properties_str_p, current_p);
-      ecma_deref_ecma_string (properties_str_p);
-      properties_str_p = tmp_str_p;
-      continue;
-    }
+/**
+ * Release the output buffer of JSON.stringify() without producing any output
+ */
+void
+ecma_builtin_helper_json_writer_free (ecma_json_writer_t *writer_p) /**< writer */
+{
+  jmem_heap_free_block (writer_p->buffer_p, writer_p->capacity);
+  writer_p->buffer_p = NULL;
+} /* ecma_builtin_helper_json_writer_free */
 
-    tmp_str_p = ecma_concat_ecma_strings (properties_str_p, separator_p);
-    ecma_deref_ecma_string (properties_str_p);
-    properties_str_p = tmp_str_p;
+/**
+ * Pass the buffered output to the callback
+ */
+static void
+ecma_builtin_helper_json_writer_flush (ecma_json_writer_t *writer_p) /**< writer */
+{
+  JERRY_ASSERT (writer_p->callback_p != NULL);
 
-    tmp_str_p = ecma_concat_ecma_strings (properties_str_p, current_p);
-    ecma_deref_ecma_string (properties_str_p);
-    properties_str_p = tmp_str_p;
+  if (writer_p->size > 0)
+  {
+    writer_p->callback_p (writer_p->buffer_p, writer_p->size, writer_p->user_p);
+    writer_p->size = 0;
   }
-
-  return properties_str_p;
-} /* ecma_builtin_helper_json_create_separated_properties */
+} /* ecma_builtin_helper_json_writer_flush */
 
 /**
- * Common function to create a formatted JSON string.
+ * Grow the output buffer, so at least the specified number of bytes can be appended
  *
- * See also:
- *          ECMA-262 v5, 15.12.3
- *
- * Used by:
- *         - ecma_builtin_json_object step 10.b
- *         - ecma_builtin_json_array step 10.b
- *
- * @return ecma value
- *         Returned value must be freed with ecma_free_value.
+ * @return true - if the buffer has enough free space,
+ *         false - if the output does not fit into a string
  */
-ecma_value_t
-ecma_builtin_helper_json_create_formatted_json (ecma_string_t *left_bracket_p, /**< left bracket*/
-                                                ecma_string_t *right_bracket_p, /**< right bracket*/
-                                                ecma_string_t *stepback_p, /**< stepback*/
-                                                ecma_collection_header_t *partial_p, /**< key-value pairs*/
-                                                ecma_json_stringify_context_t *context_p) /**< context*/
+static bool
+ecma_builtin_helper_json_writer_grow (ecma_json_writer_t *writer_p, /**< writer */
+                                      lit_utf8_size_t size) /**< number of bytes to append */
 {
-  /* 10.b */
-  ecma_string_t *comma_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_COMMA_CHAR);
-  ecma_string_t *line_feed_p = ecma_get_magic_string (LIT_MAGIC_STRING_NEW_LINE_CHAR);
-  ecma_string_t *properties_str_p;
-  ecma_string_t *separator_p;
-
-  /* 10.b.i */
-  ecma_string_t *tmp_str_p = ecma_concat_ecma_strings (comma_str_p, line_feed_p);
-  ecma_deref_ecma_string (comma_str_p);
-  separator_p = tmp_str_p;
-
-  tmp_str_p = ecma_concat_ecma_strings (separator_p, context_p->indent_str_p);
-  ecma_deref_ecma_string (separator_p);
-  separator_p = tmp_str_p;
+  JERRY_ASSERT (writer_p->callback_p == NULL);
 
-  /* 10.b.ii */
-  properties_str_p = ecma_builtin_helper_json_create_separated_properties (partial_p, separator_p);
-  ecma_deref_ecma_string (separator_p);
+  if (writer_p->is_overflow
+      || size > ECMA_JSON_WRITER_MAX_SIZE - writer_p->size)
+  {
+    writer_p->is_overflow = true;
+    return false;
+  }
 
-  /* 10.b.iii */
-  ecma_string_t *final_str_p;
+  lit_utf8_size_t new_capacity = writer_p->capacity;
 
-  tmp_str_p = ecma_concat_ecma_strings (left_bracket_p, line_feed_p);
-  final_str_p = tmp_str_p;
+  while (new_capacity - writer_p->size < size)
+  {
+    new_capacity *= 2;
+  }
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, context_p->indent_str_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+  lit_utf8_byte_t *new_buffer_p = (lit_utf8_byte_t *) jmem_heap_alloc_block (new_capacity);
+  memcpy (new_buffer_p, writer_p->buffer_p, writer_p->size);
+  jmem_heap_free_block (writer_p->buffer_p, writer_p->capacity);
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, properties_str_p);
-  ecma_deref_ecma_string (final_str_p);
-  ecma_deref_ecma_string (properties_str_p);
-  final_str_p = tmp_str_p;
+  writer_p->buffer_p = new_buffer_p;
+  writer_p->capacity = new_capacity;
+  return true;
+} /* ecma_builtin_helper_json_writer_grow */
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, line_feed_p);
-  ecma_deref_ecma_string (line_feed_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+/**
+ * Append a byte sequence to the output
+ */
+void
+ecma_builtin_helper_json_writer_append (ecma_json_writer_t *writer_p, /**< writer */
+                                        const lit_utf8_byte_t *data_p, /**< bytes to append */
+                                        lit_utf8_size_t size) /**< number of bytes */
+{
+  if (writer_p->callback_p != NULL)
+  {
+    while (size > writer_p->capacity - writer_p->size)
+    {
+      lit_utf8_size_t chunk_size = writer_p->capacity - writer_p->size;
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, stepback_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+      memcpy (writer_p->buffer_p + writer_p->size, data_p, chunk_size);
+      writer_p->size += chunk_size;
+      data_p += chunk_size;
+      size -= chunk_size;
 
-  tmp_str_p = ecma_concat_ecma_strings (final_str_p, right_bracket_p);
-  ecma_deref_ecma_string (final_str_p);
-  final_str_p = tmp_str_p;
+      ecma_builtin_helper_json_writer_flush (writer_p);
+    }
+  }
+  else if (size > writer_p->capacity - writer_p->size
+           && !ecma_builtin_helper_json_writer_grow (writer_p, size))
+  {
+    return;
+  }
 
-  return ecma_make_string_value (final_str_p);
-} /* ecma_builtin_helper_json_create_formatted_json */
+  memcpy (writer_p->buffer_p + writer_p->size, data_p, size);
+  writer_p->size += size;
+} /* ecma_builtin_helper_json_writer_append */
 
 /**
- * Common function to create a non-formatted JSON string.
- *
- * See also:
- *          ECMA-262 v5, 15.12.3
- *
- * Used by:
- *         - ecma_builtin_json_object step 10.a
- *         - ecma_builtin_json_array step 10.a
- *
- * @return ecma value
- *         Returned value must be freed with ecma_free_value.
+ * Append a single byte to the output
  */
-ecma_value_t
-ecma_builtin_helper_json_create_non_formatted_json (ecma_string_t *left_bracket_p, /**< left bracket*/
-                                                    ecma_string_t *right_bracket_p, /**< right bracket*/
-                                                    ecma_collection_header_t *partial_p) /**< key-value pairs*/
+void
+ecma_builtin_helper_json_writer_append_byte (ecma_json_writer_t *writer_p, /**< writer */
+                                             lit_utf8_byte_t byte) /**< byte to append */
 {
-  /* 10.a */
-  ecma_string_t *comma_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_COMMA_CHAR);
-  ecma_string_t *properties_str_p;
-  ecma_string_t *tmp_str_p;
+  if (writer_p->size < writer_p->capacity)
+  {
+    writer_p->buffer_p[writer_p->size++] = byte;
+    return;
+  }
 
-  /* 10.a.i */
-  properties_str_p = ecma_builtin_helper_json_create_separated_properties (partial_p, comma_str_p);
-  ecma_deref_ecma_string (comma_str_p);
+  ecma_builtin_helper_json_writer_append (writer_p, &byte, 1);
+} /* ecma_builtin_helper_json_writer_append_byte */
 
-  /* 10.a.ii */
-  tmp_str_p = ecma_concat_ecma_strings (left_bracket_p, properties_str_p);
-  ecma_deref_ecma_string (properties_str_p);
-  properties_str_p = tmp_str_p;
+/**
+ * Append a string to the output without any quoting
+ */
+void
+ecma_builtin_helper_json_writer_append_string (ecma_json_writer_t *writer_p, /**< writer */
+                                               const ecma_string_t *string_p) /**< string to append */
+{
+  ECMA_STRING_TO_UTF8_STRING (string_p, string_buff, string_buff_size);
 
-  tmp_str_p = ecma_concat_ecma_strings (properties_str_p, right_bracket_p);
-  ecma_deref_ecma_string (properties_str_p);
-  properties_str_p = tmp_str_p;
+  ecma_builtin_helper_json_writer_append (writer_p, string_buff, string_buff_size);
 
-  return ecma_make_string_value (properties_str_p);
-} /* ecma_builtin_helper_json_create_non_formatted_json */
+  ECMA_FINALIZE_UTF8_STRING (string_buff, string_buff_size);
+} /* ecma_builtin_helper_json_writer_append_string */
 
 /**
- * Convert decimal value to 4 digit hexadecimal string value.
+ * Append a string to the output as a quoted JSON string
  *
  * See also:
- *          ECMA-262 v5, 15.12.3
+ *          ECMA-262 v5, 15.12.3 (abstract operation 'Quote')
  *
- * Used by:
- *         - ecma_builtin_json_quote step 2.c.iii
- *
- * @return pointer to ecma-string
- *         Returned value must be freed with ecma_deref_ecma_string.
+ * Note:
+ *      the characters which need no escaping are copied in runs,
+ *      since every byte of a multi-byte CESU-8 sequence is above 0x7f
  */
-ecma_string_t *
-ecma_builtin_helper_json_create_hex_digit_ecma_string (uint8_t value) /**< value in decimal*/
+void
+ecma_builtin_helper_json_writer_append_quoted (ecma_json_writer_t *writer_p, /**< writer */
+                                               const ecma_string_t *string_p) /**< string to quote */
 {
-  /* 2.c.iii */
-  ecma_string_t *hex_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
+  /* 1. */
+  ecma_builtin_helper_json_writer_append_byte (writer_p, LIT_CHAR_DOUBLE_QUOTE);
+
+  ECMA_STRING_TO_UTF8_STRING (string_p, string_buff, string_buff_size);
 
-  JMEM_DEFINE_LOCAL_ARRAY (hex_buff, 4, lit_utf8_byte_t);
+  const lit_utf8_byte_t *run_start_p = string_buff;
+  const lit_utf8_byte_t *str_p = string_buff;
+  const lit_utf8_byte_t *str_end_p = string_buff + string_buff_size;
 
-  for (uint32_t i = 0; i < 4; i++)
+  while (str_p < str_end_p)
   {
-    uint8_t remainder = value % 16;
-    lit_utf8_byte_t ch = ' ';
+    lit_utf8_byte_t current_char = *str_p;
 
-    if (remainder < 10)
+    /* 2.d */
+    if (current_char >= LIT_CHAR_SP
+        && current_char != LIT_CHAR_BACKSLASH
+        && current_char != LIT_CHAR_DOUBLE_QUOTE)
     {
-      ch = (lit_utf8_byte_t) (LIT_CHAR_0 + remainder);
+      str_p++;
+      continue;
     }
+
+    ecma_builtin_helper_json_writer_append (writer_p, run_start_p, (lit_utf8_size_t) (str_p - run_start_p));
+    str_p++;
+    run_start_p = str_p;
+
+    lit_utf8_byte_t abbrev = LIT_CHAR_NULL;
+
+    switch (current_char)
+    {
+      /* 2.a */
+      case LIT_CHAR_BACKSLASH:
+      case LIT_CHAR_DOUBLE_QUOTE:
+      {
+        abbrev = current_char;
+        break;
+      }
+      /* 2.b */
+      case LIT_CHAR_BS:
+      {
+        abbrev = LIT_CHAR_LOWERCASE_B;
+        break;
+      }
+      case LIT_CHAR_FF:
+      {
+        abbrev = LIT_CHAR_LOWERCASE_F;
+        break;
+      }
+      case LIT_CHAR_LF:
+      {
+        abbrev = LIT_CHAR_LOWERCASE_N;
+        break;
+      }
+      case LIT_CHAR_CR:
+      {
+        abbrev = LIT_CHAR_LOWERCASE_R;
+        break;
+      }
+      case LIT_CHAR_TAB:
+      {
+        abbrev = LIT_CHAR_LOWERCASE_T;
+        break;
+      }
+      default:
+      {
+        break;
+      }
+    }
+
+    if (abbrev != LIT_CHAR_NULL)
+    {
+      lit_utf8_byte_t escape[2] = { LIT_CHAR_BACKSLASH, abbrev };
+      ecma_builtin_helper_json_writer_append (writer_p, escape, sizeof (escape));
+    }
+    /* 2.c */
     else
     {
-      uint8_t a = (uint8_t) (remainder - 10);
-      ch = (lit_utf8_byte_t) (LIT_CHAR_LOWERCASE_A + a);
+      const char *hex_digits_p = "0123456789abcdef";
+      lit_utf8_byte_t escape[6] =
+      {
+        LIT_CHAR_BACKSLASH, LIT_CHAR_LOWERCASE_U, LIT_CHAR_0, LIT_CHAR_0,
+        (lit_utf8_byte_t) hex_digits_p[current_char >> 4],
+        (lit_utf8_byte_t) hex_digits_p[current_char & 0xf]
+      };
+      ecma_builtin_helper_json_writer_append (writer_p, escape, sizeof (escape));
     }
+  }
 
-    hex_buff[3 - i] = ch;
+  ecma_builtin_helper_json_writer_append (writer_p, run_start_p, (lit_utf8_size_t) (str_p - run_start_p));
 
-    value = value / 16;
-  }
+  ECMA_FINALIZE_UTF8_STRING (string_buff, string_buff_size);
 
-  ecma_deref_ecma_string (hex_str_p);
-  hex_str_p = ecma_new_ecma_string_from_utf8 ((lit_utf8_byte_t *) hex_buff, 4);
+  /* 3. */
+  ecma_builtin_helper_json_writer_append_byte (writer_p, LIT_CHAR_DOUBLE_QUOTE);
+} /* ecma_builtin_helper_json_writer_append_quoted */
 
-  JMEM_FINALIZE_LOCAL_ARRAY (hex_buff);
+/**
+ * Finish the output of JSON.stringify() and release the output buffer
+ *
+ * @return ecma value
+ *         if the output is collected: the output string, or a RangeError if it does not fit into a string
+ *         if the output is passed to a callback: true
+ *         Returned value must be freed with ecma_free_value.
+ */
+ecma_value_t
+ecma_builtin_helper_json_writer_finalize (ecma_json_writer_t *writer_p) /**< writer */
+{
+  ecma_value_t ret_value;
 
-  JERRY_ASSERT (ecma_string_get_length (hex_str_p));
+  if (writer_p->callback_p != NULL)
+  {
+    ecma_builtin_helper_json_writer_flush (writer_p);
+    ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+  }
+  else if (writer_p->is_overflow)
+  {
+    ret_value = ecma_raise_range_error (ECMA_ERR_MSG ("JSON string is too long."));
+  }
+  else
+  {
+    ecma_string_t *result_p = ecma_new_ecma_string_from_utf8 (writer_p->buffer_p, writer_p->size);
+    ret_value = ecma_make_string_value (result_p);
+  }
 
-  return hex_str_p;
-} /* ecma_builtin_helper_json_create_hex_digit_ecma_string */
+  ecma_builtin_helper_json_writer_free (writer_p);
+  return ret_value;
+} /* ecma_builtin_helper_json_writer_finalize */
 
 /**
  * @}
@@ -132,6 +132,31 @@ extern ecma_value_t ecma_date_get_primitive_value (ecma_value_t);
 
 /* ecma-builtin-helper-json.c */
 
+/**
+ * Maximum size of the indentation text of JSON.stringify() in bytes
+ */
+#define ECMA_JSON_MAX_GAP_SIZE (10 * LIT_CESU8_MAX_BYTES_IN_CODE_UNIT)
+
+/**
+ * Callback which receives the output of JSON.stringify() in chunks
+ */
+typedef void (*ecma_json_output_callback_t) (const lit_utf8_byte_t *buffer_p,
+                                             lit_utf8_size_t buffer_size,
+                                             void *user_p);
+
+/**
+ * Output buffer of JSON.stringify()
+ */
+typedef struct
+{
+  lit_utf8_byte_t *buffer_p; /**< output buffer */
+  lit_utf8_size_t size; /**< number of bytes stored in the buffer */
+  lit_utf8_size_t capacity; /**< size of the buffer */
+  ecma_json_output_callback_t callback_p; /**< output callback, or NULL if the whole output is collected */
+  void *user_p; /**< user pointer passed to the callback */
+  bool is_overflow; /**< the collected output does not fit into a string */
+} ecma_json_writer_t;
+
 /**
  * Context for JSON.stringify()
  */
@@ -143,28 +168,53 @@ typedef struct
   /** Collection for traversing objects. */
   ecma_collection_header_t *occurence_stack_p;
 
-  /** The actual indentation text. */
-  ecma_string_t *indent_str_p;
-
-  /** The indentation text. */
-  ecma_string_t *gap_str_p;
-
   /** The replacer function. */
   ecma_object_t *replacer_function_p;
+
+  /** The 'toJSON' string. */
+  ecma_string_t *to_json_str_p;
+
+  /** The output buffer. */
+  ecma_json_writer_t *writer_p;
+
+  /** The actual indentation is the gap repeated this many times. */
+  uint32_t indent_level;
+
+  /** Size of the indentation text. */
+  lit_utf8_size_t gap_size;
+
+  /** The indentation text. */
+  lit_utf8_byte_t gap[ECMA_JSON_MAX_GAP_SIZE];
 } ecma_json_stringify_context_t;
 
 extern bool ecma_has_object_value_in_collection (ecma_collection_header_t *, ecma_value_t);
 extern bool ecma_has_string_value_in_collection (ecma_collection_header_t *, ecma_value_t);
 
-extern ecma_string_t *
-ecma_builtin_helper_json_create_hex_digit_ecma_string (uint8_t);
-extern ecma_string_t *
-ecma_builtin_helper_json_create_separated_properties (ecma_collection_header_t *, ecma_string_t *);
+extern void
+ecma_builtin_helper_json_writer_init (ecma_json_writer_t *, ecma_json_output_callback_t, void *);
+extern void
+ecma_builtin_helper_json_writer_free (ecma_json_writer_t *);
+extern void
+ecma_builtin_helper_json_writer_append (ecma_json_writer_t *, const lit_utf8_byte_t *, lit_utf8_size_t);
+extern void
+ecma_builtin_helper_json_writer_append_byte (ecma_json_writer_t *, lit_utf8_byte_t);
+extern void
+ecma_builtin_helper_json_writer_append_string (ecma_json_writer_t *, const ecma_string_t *);
+extern void
+ecma_builtin_helper_json_writer_append_quoted (ecma_json_writer_t *, const ecma_string_t *);
+extern ecma_value_t
+ecma_builtin_helper_json_writer_finalize (ecma_json_writer_t *);
+
+#ifndef CONFIG_DISABLE_JSON_BUILTIN
+
+/* ecma-builtin-json.c */
+
 extern ecma_value_t
-ecma_builtin_helper_json_create_formatted_json (ecma_string_t *, ecma_string_t *, ecma_string_t *,
-                                                ecma_collection_header_t *, ecma_json_stringify_context_t *);
+ecma_builtin_json_parse_buffer (const lit_utf8_byte_t *, lit_utf8_size_t);
 extern ecma_value_t
-ecma_builtin_helper_json_create_non_formatted_json (ecma_string_t *, ecma_string_t *, ecma_collection_header_t *);
+ecma_builtin_json_serialize (ecma_value_t, ecma_value_t, ecma_value_t, ecma_json_writer_t *);
+
+#endif /* !CONFIG_DISABLE_JSON_BUILTIN */
 
 /* ecma-builtin-helper-error.c */
 
@@ -30,6 +30,8 @@
 
 #define PROPERTY_DESCRIPTOR_LIST_NAME \
   PASTE (PASTE (ecma_builtin_, BUILTIN_UNDERSCORED_ID), _property_descriptor_list)
+#define PROPERTY_NAME_FILTER_NAME \
+  PASTE (PASTE (ecma_builtin_, BUILTIN_UNDERSCORED_ID), _property_name_filter)
 #define DISPATCH_ROUTINE_ROUTINE_NAME \
   PASTE (PASTE (ecma_builtin_, BUILTIN_UNDERSCORED_ID), _dispatch_routine)
 
@@ -107,6 +109,29 @@ const ecma_builtin_property_descriptor_t PROPERTY_DESCRIPTOR_LIST_NAME[] =
   }
 };
 
+/**
+ * Property name filter of the built-in object.
+ *
+ * Each property name sets one bit (see also: ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT),
+ * so most names, which are not built-in properties, are rejected without searching
+ * the property descriptor list.
+ */
+const uint64_t PROPERTY_NAME_FILTER_NAME =
+(
+#define ROUTINE(name, c_function_name, args_number, length_prop_value) \
+  ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT (name) |
+#define OBJECT_VALUE(name, obj_builtin_id, prop_attributes) \
+  ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT (name) |
+#define SIMPLE_VALUE(name, simple_value, prop_attributes) \
+  ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT (name) |
+#define NUMBER_VALUE(name, number_value, prop_attributes) \
+  ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT (name) |
+#define STRING_VALUE(name, magic_string_id, prop_attributes) \
+  ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT (name) |
+#include BUILTIN_INC_HEADER_NAME
+  0
+);
+
 /**
  * Dispatcher of the built-in's routines
  *
@@ -161,6 +186,7 @@ DISPATCH_ROUTINE_ROUTINE_NAME (uint16_t builtin_routine_id, /**< built-in wide r
 #undef PASTE_
 #undef PASTE
 #undef PROPERTY_DESCRIPTOR_LIST_NAME
+#undef PROPERTY_NAME_FILTER_NAME
 #undef DISPATCH_ROUTINE_ROUTINE_NAME
 #undef BUILTIN_UNDERSCORED_ID
 #undef BUILTIN_INC_HEADER_NAME
@@ -75,8 +75,10 @@ typedef enum
 typedef struct
 {
   ecma_json_token_type_t type; /**< type of the current token */
-  lit_utf8_byte_t *current_p; /**< current position of the string processed by the parser */
+  const lit_utf8_byte_t *current_p; /**< current position of the string processed by the parser */
   const lit_utf8_byte_t *end_p; /**< end of the string processed by the parser */
+  lit_utf8_byte_t *buffer_p; /**< buffer for the strings containing escape sequences */
+  lit_utf8_size_t buffer_size; /**< size of the buffer */
   union
   {
     struct
@@ -94,7 +96,8 @@ typedef struct
  * @return true if the match is successful
  */
 static bool
-ecma_builtin_json_check_id (lit_utf8_byte_t *string_p, /**< start position */
+ecma_builtin_json_check_id (const lit_utf8_byte_t *string_p, /**< start position */
+                            const lit_utf8_byte_t *end_p, /**< end of the string */
                             const char *id_p) /**< string identifier */
 {
   /*
@@ -118,88 +121,161 @@ ecma_builtin_json_check_id (lit_utf8_byte_t *string_p, /**< start position */
       return true;
     }
   }
-  while (*string_p == *id_p);
+  while (string_p < end_p && *string_p == *id_p);
 
   return false;
 } /* ecma_builtin_json_check_id */
 
+/**
+ * Check whether the current position holds a decimal digit.
+ *
+ * @return true if it does
+ */
+static inline bool __attr_always_inline___
+ecma_builtin_json_is_digit (const lit_utf8_byte_t *current_p, /**< current position */
+                            const lit_utf8_byte_t *end_p) /**< end of the string */
+{
+  return current_p < end_p && lit_char_is_decimal_digit (*current_p);
+} /* ecma_builtin_json_is_digit */
+
 /**
  * Parse and extract string token.
+ *
+ * Strings without escape sequences are referenced in place,
+ * the others are decoded into the buffer of the token.
  */
 static void
 ecma_builtin_json_parse_string (ecma_json_token_t *token_p) /**< token argument */
 {
-  lit_utf8_byte_t *current_p = token_p->current_p;
-  lit_utf8_byte_t *write_p = current_p;
+  const lit_utf8_byte_t *start_p = token_p->current_p;
+  const lit_utf8_byte_t *current_p = start_p;
+  const lit_utf8_byte_t *end_p = token_p->end_p;
+  bool has_escape = false;
 
-  token_p->u.string.start_p = current_p;
-
-  while (*current_p != LIT_CHAR_DOUBLE_QUOTE)
+  while (true)
   {
-    if (*current_p <= 0x1f)
+    if (current_p >= end_p || *current_p <= 0x1f)
     {
       return;
     }
+
+    if (*current_p == LIT_CHAR_DOUBLE_QUOTE)
+    {
+      break;
+    }
+
     if (*current_p == LIT_CHAR_BACKSLASH)
     {
+      has_escape = true;
       current_p++;
-      switch (*current_p)
+
+      if (current_p >= end_p)
       {
-        case LIT_CHAR_DOUBLE_QUOTE:
-        case LIT_CHAR_SLASH:
-        case LIT_CHAR_BACKSLASH:
-        {
-          break;
-        }
-        case LIT_CHAR_LOWERCASE_B:
-        {
-          *current_p = LIT_CHAR_BS;
-          break;
-        }
-        case LIT_CHAR_LOWERCASE_F:
-        {
-          *current_p = LIT_CHAR_FF;
-          break;
-        }
-        case LIT_CHAR_LOWERCASE_N:
-        {
-          *current_p = LIT_CHAR_LF;
-          break;
-        }
-        case LIT_CHAR_LOWERCASE_R:
-        {
-          *current_p = LIT_CHAR_CR;
-          break;
-        }
-        case LIT_CHAR_LOWERCASE_T:
-        {
-          *current_p = LIT_CHAR_TAB;
-          break;
-        }
-        case LIT_CHAR_LOWERCASE_U:
-        {
-          ecma_char_t code_unit;
+        return;
+      }
+    }
 
-          if (!(lit_read_code_unit_from_hex (current_p + 1, 4, &code_unit)))
-          {
-            return;
-          }
+    current_p++;
+  }
 
-          current_p += 5;
-          write_p += lit_code_unit_to_utf8 (code_unit, write_p);
-          continue;
-        }
-        default:
+  token_p->current_p = current_p + 1;
+
+  if (!has_escape)
+  {
+    token_p->u.string.start_p = start_p;
+    token_p->u.string.size = (lit_utf8_size_t) (current_p - start_p);
+    token_p->type = string_token;
+    return;
+  }
+
+  /* The decoded string is never longer than its source. */
+  lit_utf8_size_t source_size = (lit_utf8_size_t) (current_p - start_p);
+
+  if (source_size > token_p->buffer_size)
+  {
+    if (token_p->buffer_p != NULL)
+    {
+      jmem_heap_free_block (token_p->buffer_p, token_p->buffer_size);
+    }
+
+    token_p->buffer_p = (lit_utf8_byte_t *) jmem_heap_alloc_block (source_size);
+    token_p->buffer_size = source_size;
+  }
+
+  const lit_utf8_byte_t *read_p = start_p;
+  lit_utf8_byte_t *write_p = token_p->buffer_p;
+
+  while (read_p < current_p)
+  {
+    if (*read_p != LIT_CHAR_BACKSLASH)
+    {
+      *write_p++ = *read_p++;
+      continue;
+    }
+
+    read_p++;
+
+    switch (*read_p)
+    {
+      case LIT_CHAR_DOUBLE_QUOTE:
+      case LIT_CHAR_SLASH:
+      case LIT_CHAR_BACKSLASH:
+      {
+        *write_p++ = *read_p;
+        break;
+      }
+      case LIT_CHAR_LOWERCASE_B:
+      {
+        *write_p++ = LIT_CHAR_BS;
+        break;
+      }
+      case LIT_CHAR_LOWERCASE_F:
+      {
+        *write_p++ = LIT_CHAR_FF;
+        break;
+      }
+      case LIT_CHAR_LOWERCASE_N:
+      {
+        *write_p++ = LIT_CHAR_LF;
+        break;
+      }
+      case LIT_CHAR_LOWERCASE_R:
+      {
+        *write_p++ = LIT_CHAR_CR;
+        break;
+      }
+      case LIT_CHAR_LOWERCASE_T:
+      {
+        *write_p++ = LIT_CHAR_TAB;
+        break;
+      }
+      case LIT_CHAR_LOWERCASE_U:
+      {
+        ecma_char_t code_unit;
+
+        if (current_p - read_p < 5
+            || !(lit_read_code_unit_from_hex (read_p + 1, 4, &code_unit)))
         {
+          token_p->type = invalid_token;
           return;
         }
+
+        read_p += 5;
+        write_p += lit_code_unit_to_utf8 (code_unit, write_p);
+        continue;
+      }
+      default:
+      {
+        token_p->type = invalid_token;
+        return;
       }
     }
-    *write_p++ = *current_p++;
+
+    read_p++;
   }
 
-  token_p->u.string.size = (lit_utf8_size_t) (write_p - token_p->u.string.start_p);
-  token_p->current_p = current_p + 1;
+  token_p->u.string.start_p = token_p->buffer_p;
+  token_p->u.string.size = (lit_utf8_size_t) (write_p - token_p->buffer_p);
   token_p->type = string_token;
 } /* ecma_builtin_json_parse_string */
 
@@ -209,35 +285,40 @@ ecma_builtin_json_parse_string (ecma_json_token_t *token_p) /**< token argument
 static void
 ecma_builtin_json_parse_number (ecma_json_token_t *token_p) /**< token argument */
 {
-  lit_utf8_byte_t *current_p = token_p->current_p;
-  lit_utf8_byte_t *start_p = current_p;
+  const lit_utf8_byte_t *current_p = token_p->current_p;
+  const lit_utf8_byte_t *start_p = current_p;
+  const lit_utf8_byte_t *end_p = token_p->end_p;
 
   if (*current_p == LIT_CHAR_MINUS)
   {
     current_p++;
   }
 
-  if (*current_p == LIT_CHAR_0)
+  if (current_p < end_p && *current_p == LIT_CHAR_0)
   {
     current_p++;
-    if (lit_char_is_decimal_digit (*current_p))
+    if (ecma_builtin_json_is_digit (current_p, end_p))
     {
       return;
     }
   }
-  else if (lit_char_is_decimal_digit (*current_p))
+  else if (ecma_builtin_json_is_digit (current_p, end_p))
   {
     do
     {
       current_p++;
     }
-    while (lit_char_is_decimal_digit (*current_p));
+    while (ecma_builtin_json_is_digit (current_p, end_p));
+  }
+  else
+  {
+    return;
   }
 
-  if (*current_p == LIT_CHAR_DOT)
+  if (current_p < end_p && *current_p == LIT_CHAR_DOT)
   {
     current_p++;
-    if (!lit_char_is_decimal_digit (*current_p))
+    if (!ecma_builtin_json_is_digit (current_p, end_p))
     {
       return;
     }
@@ -246,18 +327,20 @@ ecma_builtin_json_parse_number (ecma_json_token_t *token_p) /**< token argument
     {
       current_p++;
     }
-    while (lit_char_is_decimal_digit (*current_p));
+    while (ecma_builtin_json_is_digit (current_p, end_p));
   }
 
-  if (*current_p == LIT_CHAR_LOWERCASE_E || *current_p == LIT_CHAR_UPPERCASE_E)
+  if (current_p < end_p
+      && (*current_p == LIT_CHAR_LOWERCASE_E || *current_p == LIT_CHAR_UPPERCASE_E))
   {
     current_p++;
-    if (*current_p == LIT_CHAR_PLUS || *current_p == LIT_CHAR_MINUS)
+    if (current_p < end_p
+        && (*current_p == LIT_CHAR_PLUS || *current_p == LIT_CHAR_MINUS))
     {
       current_p++;
     }
 
-    if (!lit_char_is_decimal_digit (*current_p))
+    if (!ecma_builtin_json_is_digit (current_p, end_p))
     {
       return;
     }
@@ -266,7 +349,7 @@ ecma_builtin_json_parse_number (ecma_json_token_t *token_p) /**< token argument
     {
       current_p++;
     }
-    while (lit_char_is_decimal_digit (*current_p));
+    while (ecma_builtin_json_is_digit (current_p, end_p));
   }
   token_p->type = number_token;
   token_p->u.number = ecma_utf8_string_to_number (start_p, (lit_utf8_size_t) (current_p - start_p));
@@ -283,10 +366,11 @@ ecma_builtin_json_parse_number (ecma_json_token_t *token_p) /**< token argument
 static void
 ecma_builtin_json_parse_next_token (ecma_json_token_t *token_p) /**< token argument */
 {
-  lit_utf8_byte_t *current_p = token_p->current_p;
+  const lit_utf8_byte_t *current_p = token_p->current_p;
+  const lit_utf8_byte_t *end_p = token_p->end_p;
   token_p->type = invalid_token;
 
-  while (current_p < token_p->end_p
+  while (current_p < end_p
          && (*current_p == LIT_CHAR_SP
              || *current_p == LIT_CHAR_CR
              || *current_p == LIT_CHAR_LF
@@ -295,7 +379,7 @@ ecma_builtin_json_parse_next_token (ecma_json_token_t *token_p) /**< token argum
     current_p++;
   }
 
-  if (current_p == token_p->end_p)
+  if (current_p == end_p)
   {
     token_p->type = end_token;
     return;
@@ -341,7 +425,7 @@ ecma_builtin_json_parse_next_token (ecma_json_token_t *token_p) /**< token argum
     }
     case LIT_CHAR_LOWERCASE_N:
     {
-      if (ecma_builtin_json_check_id (current_p, "null"))
+      if (ecma_builtin_json_check_id (current_p, end_p, "null"))
       {
         token_p->type = null_token;
         token_p->current_p = current_p + 4;
@@ -351,7 +435,7 @@ ecma_builtin_json_parse_next_token (ecma_json_token_t *token_p) /**< token argum
     }
     case LIT_CHAR_LOWERCASE_T:
     {
-      if (ecma_builtin_json_check_id (current_p, "true"))
+      if (ecma_builtin_json_check_id (current_p, end_p, "true"))
       {
         token_p->type = true_token;
         token_p->current_p = current_p + 4;
@@ -361,7 +445,7 @@ ecma_builtin_json_parse_next_token (ecma_json_token_t *token_p) /**< token argum
     }
     case LIT_CHAR_LOWERCASE_F:
     {
-      if (ecma_builtin_json_check_id (current_p, "false"))
+      if (ecma_builtin_json_check_id (current_p, end_p, "false"))
       {
         token_p->type = false_token;
         token_p->current_p = current_p + 5;
@@ -392,20 +476,21 @@ ecma_builtin_json_parse_next_token (ecma_json_token_t *token_p) /**< token argum
 static bool
 ecma_builtin_json_check_right_square_token (ecma_json_token_t *token_p) /**< token argument */
 {
-  lit_utf8_byte_t *current_p = token_p->current_p;
+  const lit_utf8_byte_t *current_p = token_p->current_p;
+  const lit_utf8_byte_t *end_p = token_p->end_p;
 
-  /*
-   * No need for end check since the string is zero terminated.
-   */
-  while (*current_p == LIT_CHAR_SP || *current_p == LIT_CHAR_CR
-         || *current_p == LIT_CHAR_LF || *current_p == LIT_CHAR_TAB)
+  while (current_p < end_p
+         && (*current_p == LIT_CHAR_SP
+             || *current_p == LIT_CHAR_CR
+             || *current_p == LIT_CHAR_LF
+             || *current_p == LIT_CHAR_TAB))
   {
     current_p++;
   }
 
   token_p->current_p = current_p;
 
-  if (*current_p == LIT_CHAR_RIGHT_SQUARE)
+  if (current_p < end_p && *current_p == LIT_CHAR_RIGHT_SQUARE)
   {
     token_p->current_p = current_p + 1;
     return true;
@@ -498,12 +583,14 @@ ecma_builtin_json_parse_value (ecma_json_token_t *token_p) /**< token argument *
           break;
         }
 
-        const lit_utf8_byte_t *string_start_p = token_p->u.string.start_p;
-        lit_utf8_size_t string_size = token_p->u.string.size;
+        /* The name is created before the next token overwrites the string buffer. */
+        ecma_string_t *name_p = ecma_new_ecma_string_from_utf8 (token_p->u.string.start_p,
+                                                                token_p->u.string.size);
         ecma_builtin_json_parse_next_token (token_p);
 
         if (token_p->type != colon_token)
         {
+          ecma_deref_ecma_string (name_p);
           break;
         }
 
@@ -511,10 +598,10 @@ ecma_builtin_json_parse_value (ecma_json_token_t *token_p) /**< token argument *
 
         if (ecma_is_value_undefined (value))
         {
+          ecma_deref_ecma_string (name_p);
           break;
         }
 
-        ecma_string_t *name_p = ecma_new_ecma_string_from_utf8 (string_start_p, string_size);
         ecma_builtin_json_define_value_property (object_p, name_p, value);
         ecma_deref_ecma_string (name_p);
         ecma_free_value (value);
@@ -686,6 +773,54 @@ ecma_builtin_json_walk (ecma_object_t *reviver_p, /**< reviver function */
   return ret_value;
 } /* ecma_builtin_json_walk */
 
+/**
+ * Parse a JSON text
+ *
+ * See also:
+ *          ECMA-262 v5, 15.12.2 (steps 1. - 3. of JSON.parse)
+ *
+ * Note:
+ *      the text is parsed in place, it is not copied
+ *
+ * @return ecma value - the parsed value, or a SyntaxError
+ *         Returned value must be freed with ecma_free_value.
+ */
+ecma_value_t
+ecma_builtin_json_parse_buffer (const lit_utf8_byte_t *str_start_p, /**< JSON text */
+                                lit_utf8_size_t string_size) /**< size of the JSON text */
+{
+  ecma_json_token_t token;
+  token.current_p = str_start_p;
+  token.end_p = str_start_p + string_size;
+  token.buffer_p = NULL;
+  token.buffer_size = 0;
+
+  ecma_value_t final_result = ecma_builtin_json_parse_value (&token);
+
+  if (!ecma_is_value_undefined (final_result))
+  {
+    ecma_builtin_json_parse_next_token (&token);
+
+    if (token.type != end_token)
+    {
+      ecma_free_value (final_result);
+      final_result = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+    }
+  }
+
+  if (token.buffer_p != NULL)
+  {
+    jmem_heap_free_block (token.buffer_p, token.buffer_size);
+  }
+
+  if (ecma_is_value_undefined (final_result))
+  {
+    return ecma_raise_syntax_error (ECMA_ERR_MSG (""));
+  }
+
+  return final_result;
+} /* ecma_builtin_json_parse_buffer */
+
 /**
  * The JSON object's 'parse' routine
  *
@@ -708,36 +843,16 @@ ecma_builtin_json_parse (ecma_value_t this_arg, /**< 'this' argument */
                   ret_value);
 
   const ecma_string_t *string_p = ecma_get_string_from_value (string);
-  const ecma_length_t string_size = (ecma_length_t) ecma_string_get_size (string_p);
-  const lit_utf8_size_t buffer_size = sizeof (lit_utf8_byte_t) * (string_size + 1);
-
-  JMEM_DEFINE_LOCAL_ARRAY (str_start_p, buffer_size, lit_utf8_byte_t);
-
-  const lit_utf8_size_t sz = ecma_string_copy_to_utf8_buffer (string_p, str_start_p, buffer_size);
-  JERRY_ASSERT (sz == string_size);
-
-  str_start_p[string_size] = LIT_BYTE_NULL;
-
-  ecma_json_token_t token;
-  token.current_p = str_start_p;
-  token.end_p = str_start_p + string_size;
 
-  ecma_value_t final_result = ecma_builtin_json_parse_value (&token);
+  ECMA_STRING_TO_UTF8_STRING (string_p, str_start_p, string_size);
 
-  if (!ecma_is_value_undefined (final_result))
-  {
-    ecma_builtin_json_parse_next_token (&token);
+  ecma_value_t final_result = ecma_builtin_json_parse_buffer (str_start_p, string_size);
 
-    if (token.type != end_token)
-    {
-      ecma_free_value (final_result);
-      final_result = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
-    }
-  }
+  ECMA_FINALIZE_UTF8_STRING (str_start_p, string_size);
 
-  if (ecma_is_value_undefined (final_result))
+  if (ECMA_IS_VALUE_ERROR (final_result))
   {
-    ret_value = ecma_raise_syntax_error (ECMA_ERR_MSG (""));
+    ret_value = final_result;
   }
   else
   {
@@ -766,290 +881,366 @@ ecma_builtin_json_parse (ecma_value_t this_arg, /**< 'this' argument */
     }
   }
 
-  JMEM_FINALIZE_LOCAL_ARRAY (str_start_p);
-
   ECMA_FINALIZE (string);
   return ret_value;
 } /* ecma_builtin_json_parse */
 
 static ecma_value_t
-ecma_builtin_json_str (ecma_string_t *key_p, ecma_object_t *holder_p, ecma_json_stringify_context_t *context_p);
-
-static ecma_value_t
-ecma_builtin_json_object (ecma_object_t *obj_p, ecma_json_stringify_context_t *context_p);
-
-static ecma_value_t
-ecma_builtin_json_array (ecma_object_t *obj_p, ecma_json_stringify_context_t *context_p);
+ecma_builtin_json_serialize_value (ecma_value_t value, ecma_json_stringify_context_t *context_p);
 
 /**
- * The JSON object's 'stringify' routine
+ * Get the value of a property for serialization (step 1 of abstract operation 'Str')
  *
- * See also:
- *          ECMA-262 v5, 15.12.3
+ * Note:
+ *      own data properties of general objects and arrays are read directly,
+ *      other properties are read with the [[Get]] operation
  *
  * @return ecma value
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
-ecma_builtin_json_stringify (ecma_value_t this_arg, /**< 'this' argument */
-                             ecma_value_t arg1,  /**< value */
-                             ecma_value_t arg2,  /**< replacer */
-                             ecma_value_t arg3)  /**< space */
+ecma_builtin_json_get_property (ecma_object_t *obj_p, /**< the object */
+                                ecma_string_t *name_p) /**< property name */
 {
-  JERRY_UNUSED (this_arg);
-  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
-
-  ecma_json_stringify_context_t context;
-
-  /* 1. */
-  context.occurence_stack_p = ecma_new_values_collection (NULL, 0, false);
+  ecma_object_type_t type = ecma_get_object_type (obj_p);
 
-  /* 2. */
-  context.indent_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
-
-  /* 3. */
-  context.property_list_p = ecma_new_values_collection (NULL, 0, false);
-
-  context.replacer_function_p = NULL;
-
-  /* 4. */
-  if (ecma_is_value_object (arg2))
+  if (type == ECMA_OBJECT_TYPE_GENERAL || type == ECMA_OBJECT_TYPE_ARRAY)
   {
-    ecma_object_t *obj_p = ecma_get_object_from_value (arg2);
+    ecma_property_t *property_p = ecma_find_named_property (obj_p, name_p);
 
-    /* 4.a */
-    if (ecma_op_is_callable (arg2))
+    if (property_p != NULL
+        && ECMA_PROPERTY_GET_TYPE (property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA)
     {
-      context.replacer_function_p = obj_p;
+      return ecma_copy_value (ecma_get_named_data_property_value (property_p));
     }
-    /* 4.b */
-    else if (ecma_object_get_class_name (obj_p) == LIT_MAGIC_STRING_ARRAY_UL)
-    {
-      ecma_string_t *length_str_p = ecma_new_ecma_length_string ();
-
-      ECMA_TRY_CATCH (array_length,
-                      ecma_op_object_get (obj_p, length_str_p),
-                      ret_value);
-
-      ECMA_OP_TO_NUMBER_TRY_CATCH (array_length_num,
-                                   array_length,
-                                   ret_value);
+  }
 
-      uint32_t array_length = ecma_number_to_uint32 (array_length_num);
-      uint32_t index = 0;
+  return ecma_op_object_get (obj_p, name_p);
+} /* ecma_builtin_json_get_property */
 
-      /* 4.b.ii */
-      while ((index < array_length) && ecma_is_value_empty (ret_value))
-      {
-        ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+/**
+ * Check whether an object surely has no 'toJSON' property
+ *
+ * Note:
+ *      only the prototype chains of general objects and arrays are checked,
+ *      which contain no built-in objects other than Object.prototype and
+ *      Array.prototype (these have no built-in 'toJSON' property)
+ *
+ * @return true - if the lookup of the 'toJSON' property can be skipped
+ *         false - otherwise
+ */
+static bool
+ecma_builtin_json_has_no_to_json (ecma_object_t *obj_p, /**< the object */
+                                  ecma_json_stringify_context_t *context_p) /**< context */
+{
+  do
+  {
+    ecma_object_type_t type = ecma_get_object_type (obj_p);
 
-        ECMA_TRY_CATCH (value,
-                        ecma_op_object_get (obj_p, index_str_p),
-                        ret_value);
+    if (type != ECMA_OBJECT_TYPE_GENERAL && type != ECMA_OBJECT_TYPE_ARRAY)
+    {
+      return false;
+    }
 
-        /* 4.b.ii.1 */
-        ecma_value_t item = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+    if (ecma_get_object_is_builtin (obj_p)
+        && !ecma_builtin_is (obj_p, ECMA_BUILTIN_ID_OBJECT_PROTOTYPE)
+        && !ecma_builtin_is (obj_p, ECMA_BUILTIN_ID_ARRAY_PROTOTYPE))
+    {
+      return false;
+    }
 
-        /* 4.b.ii.2 */
-        if (ecma_is_value_string (value))
-        {
-          item = ecma_copy_value (value);
-        }
-        /* 4.b.ii.3 */
-        else if (ecma_is_value_number (value))
-        {
-          ECMA_TRY_CATCH (str_val,
-                          ecma_op_to_string (value),
-                          ret_value);
+    if (ecma_find_named_property (obj_p, context_p->to_json_str_p) != NULL)
+    {
+      return false;
+    }
 
-          item = ecma_copy_value (str_val);
+    obj_p = ecma_get_object_prototype (obj_p);
+  }
+  while (obj_p != NULL);
 
-          ECMA_FINALIZE (str_val);
-        }
-        /* 4.b.ii.4 */
-        else if (ecma_is_value_object (value))
-        {
-          ecma_object_t *obj_val_p = ecma_get_object_from_value (value);
-          lit_magic_string_id_t class_name = ecma_object_get_class_name (obj_val_p);
+  return true;
+} /* ecma_builtin_json_has_no_to_json */
 
-          /* 4.b.ii.4.a */
-          if (class_name == LIT_MAGIC_STRING_NUMBER_UL
-              || class_name == LIT_MAGIC_STRING_STRING_UL)
-          {
-            ECMA_TRY_CATCH (val,
-                            ecma_op_to_string (value),
-                            ret_value);
+/**
+ * Abstract operation 'Str' defined in 15.12.3, steps 1. - 4.
+ *
+ * Computes the value which is serialized for a property of the holder object.
+ *
+ * See also:
+ *          ECMA-262 v5, 15.12.3
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_json_str (ecma_string_t *key_p, /**< property key*/
+                       ecma_object_t *holder_p, /**< the object*/
+                       ecma_json_stringify_context_t *context_p) /**< context*/
+{
+  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
 
-            item = ecma_copy_value (val);
+  /* 1. */
+  ECMA_TRY_CATCH (value,
+                  ecma_builtin_json_get_property (holder_p, key_p),
+                  ret_value);
 
-            ECMA_FINALIZE (val);
-          }
-        }
+  ecma_value_t my_val = ecma_copy_value (value);
 
-        /* 4.b.ii.5 */
-        if (!ecma_is_value_undefined (item))
-        {
-          if (!ecma_has_string_value_in_collection (context.property_list_p, item))
-          {
-            ecma_append_to_values_collection (context.property_list_p, item, true);
-            ecma_deref_ecma_string (ecma_get_string_from_value (item));
-          }
-          else
-          {
-            ecma_free_value (item);
-          }
-        }
+  /* 2. */
+  if (ecma_is_value_object (my_val)
+      && !ecma_builtin_json_has_no_to_json (ecma_get_object_from_value (my_val), context_p))
+  {
+    ecma_object_t *value_obj_p = ecma_get_object_from_value (my_val);
 
-        ECMA_FINALIZE (value);
+    /* 2.a */
+    ECMA_TRY_CATCH (toJSON,
+                    ecma_op_object_get (value_obj_p, context_p->to_json_str_p),
+                    ret_value);
 
-        ecma_deref_ecma_string (index_str_p);
+    /* 2.b */
+    if (ecma_op_is_callable (toJSON))
+    {
+      ecma_value_t key_value = ecma_make_string_value (key_p);
+      ecma_value_t call_args[] = { key_value };
+      ecma_object_t *toJSON_obj_p = ecma_get_object_from_value (toJSON);
 
-        index++;
-      }
+      ECMA_TRY_CATCH (func_ret_val,
+                      ecma_op_function_call (toJSON_obj_p, my_val, call_args, 1),
+                      ret_value);
 
-      ECMA_OP_TO_NUMBER_FINALIZE (array_length_num);
-      ECMA_FINALIZE (array_length);
+      ecma_free_value (my_val);
+      my_val = ecma_copy_value (func_ret_val);
 
-      ecma_deref_ecma_string (length_str_p);
+      ECMA_FINALIZE (func_ret_val);
     }
+
+    ECMA_FINALIZE (toJSON);
   }
 
-  if (ecma_is_value_empty (ret_value))
+  /* 3. */
+  if (context_p->replacer_function_p && ecma_is_value_empty (ret_value))
   {
-    ecma_value_t space = ecma_copy_value (arg3);
+    ecma_value_t holder_value = ecma_make_object_value (holder_p);
+    ecma_value_t key_value = ecma_make_string_value (key_p);
+    ecma_value_t call_args[] = { key_value, my_val };
 
-    /* 5. */
-    if (ecma_is_value_object (arg3))
-    {
-      ecma_object_t *obj_p = ecma_get_object_from_value (arg3);
-      lit_magic_string_id_t class_name = ecma_object_get_class_name (obj_p);
+    ECMA_TRY_CATCH (func_ret_val,
+                    ecma_op_function_call (context_p->replacer_function_p, holder_value, call_args, 2),
+                    ret_value);
 
-      /* 5.a */
-      if (class_name == LIT_MAGIC_STRING_NUMBER_UL)
-      {
-        ECMA_TRY_CATCH (val,
-                        ecma_op_to_number (arg3),
-                        ret_value);
+    ecma_free_value (my_val);
+    my_val = ecma_copy_value (func_ret_val);
 
-        ecma_free_value (space);
-        space = ecma_copy_value (val);
+    ECMA_FINALIZE (func_ret_val);
+  }
 
-        ECMA_FINALIZE (val);
-      }
-      /* 5.b */
-      else if (class_name == LIT_MAGIC_STRING_STRING_UL)
-      {
-        ECMA_TRY_CATCH (val,
-                        ecma_op_to_string (arg3),
-                        ret_value);
+  /* 4. */
+  if (ecma_is_value_object (my_val) && ecma_is_value_empty (ret_value))
+  {
+    ecma_object_t *obj_p = ecma_get_object_from_value (my_val);
+    lit_magic_string_id_t class_name = ecma_object_get_class_name (obj_p);
+
+    /* 4.a */
+    if (class_name == LIT_MAGIC_STRING_NUMBER_UL)
+    {
+      ECMA_TRY_CATCH (val,
+                      ecma_op_to_number (my_val),
+                      ret_value);
 
-        ecma_free_value (space);
-        space = ecma_copy_value (val);
+      ecma_free_value (my_val);
+      my_val = ecma_copy_value (val);
 
-        ECMA_FINALIZE (val);
-      }
+      ECMA_FINALIZE (val);
     }
+    /* 4.b */
+    else if (class_name == LIT_MAGIC_STRING_STRING_UL)
+    {
+      ECMA_TRY_CATCH (val,
+                      ecma_op_to_string (my_val),
+                      ret_value);
 
-    if (ecma_is_value_empty (ret_value))
+      ecma_free_value (my_val);
+      my_val = ecma_copy_value (val);
+
+      ECMA_FINALIZE (val);
+    }
+    /* 4.c */
+    else if (class_name == LIT_MAGIC_STRING_BOOLEAN_UL)
     {
-      /* 6. */
-      if (ecma_is_value_number (space))
-      {
-        ECMA_OP_TO_NUMBER_TRY_CATCH (array_length_num,
-                                     arg3,
-                                     ret_value);
+      ECMA_TRY_CATCH (val,
+                      ecma_op_to_primitive (my_val, ECMA_PREFERRED_TYPE_NO),
+                      ret_value);
 
-        /* 6.a */
-        int32_t num_of_spaces = ecma_number_to_int32 (array_length_num);
-        int32_t space = (num_of_spaces > 10) ? 10 : num_of_spaces;
+      ecma_free_value (my_val);
+      my_val = ecma_copy_value (val);
 
-        /* 6.b */
-        if (space < 1)
-        {
-          context.gap_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
-        }
-        else
-        {
-          JMEM_DEFINE_LOCAL_ARRAY (space_buff, space, char);
+      ECMA_FINALIZE (val);
+    }
+  }
 
-          for (int32_t i = 0; i < space; i++)
-          {
-            space_buff[i] = LIT_CHAR_SP;
-          }
+  if (ecma_is_value_empty (ret_value))
+  {
+    ret_value = my_val;
+  }
+  else
+  {
+    ecma_free_value (my_val);
+  }
 
-          context.gap_str_p = ecma_new_ecma_string_from_utf8 ((lit_utf8_byte_t *) space_buff, (lit_utf8_size_t) space);
+  ECMA_FINALIZE (value);
 
-          JMEM_FINALIZE_LOCAL_ARRAY (space_buff);
-        }
+  return ret_value;
+} /* ecma_builtin_json_str */
 
-        ECMA_OP_TO_NUMBER_FINALIZE (array_length_num);
-      }
-      /* 7. */
-      else if (ecma_is_value_string (space))
+/**
+ * Check whether a value computed by ecma_builtin_json_str has a JSON representation
+ * (abstract operation 'Str' defined in 15.12.3, step 11.)
+ *
+ * @return true - if the value is serialized by ecma_builtin_json_serialize_value
+ *         false - if the result of 'Str' is undefined
+ */
+static bool
+ecma_builtin_json_is_serializable (ecma_value_t value) /**< value */
+{
+  return !ecma_is_value_undefined (value) && !ecma_op_is_callable (value);
+} /* ecma_builtin_json_is_serializable */
+
+/**
+ * Append a line feed and the actual indentation to the output
+ */
+static void
+ecma_builtin_json_append_indent (ecma_json_stringify_context_t *context_p) /**< context */
+{
+  ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_LF);
+
+  for (uint32_t i = 0; i < context_p->indent_level; i++)
+  {
+    ecma_builtin_helper_json_writer_append (context_p->writer_p, context_p->gap, context_p->gap_size);
+  }
+} /* ecma_builtin_json_append_indent */
+
+/**
+ * Append a number to the output
+ *
+ * See also:
+ *          ECMA-262 v5, 15.12.3 (abstract operation 'Str', step 9.)
+ */
+static void
+ecma_builtin_json_append_number (ecma_number_t num, /**< number */
+                                 ecma_json_stringify_context_t *context_p) /**< context */
+{
+  /* 9.b */
+  if (ecma_number_is_nan (num) || ecma_number_is_infinity (num))
+  {
+    const lit_utf8_byte_t null_str[] = { 'n', 'u', 'l', 'l' };
+    ecma_builtin_helper_json_writer_append (context_p->writer_p, null_str, sizeof (null_str));
+    return;
+  }
+
+  /* 9.a */
+  lit_utf8_byte_t num_buffer[ECMA_MAX_CHARS_IN_STRINGIFIED_NUMBER];
+  lit_utf8_size_t num_size = ecma_number_to_utf8_string (num, num_buffer, sizeof (num_buffer));
+
+  ecma_builtin_helper_json_writer_append (context_p->writer_p, num_buffer, num_size);
+} /* ecma_builtin_json_append_number */
+
+/**
+ * Collect the enumerable own property names of a general, non built-in object
+ *
+ * Note:
+ *      the property list is walked directly instead of the generic property name
+ *      enumeration, the names are stored in creation order
+ *
+ * @return collection of strings
+ *         NULL - if the object is not a plain object or it has array index property names
+ *                (these must be listed in ascending order, so the generic enumeration is used)
+ */
+static ecma_collection_header_t *
+ecma_builtin_json_get_own_property_names (ecma_object_t *obj_p) /**< the object */
+{
+  if (ecma_get_object_type (obj_p) != ECMA_OBJECT_TYPE_GENERAL
+      || ecma_get_object_is_builtin (obj_p))
+  {
+    return NULL;
+  }
+
+  ecma_property_header_t *list_start_p = ecma_get_property_list (obj_p);
+
+  if (list_start_p != NULL
+      && ECMA_PROPERTY_GET_TYPE (list_start_p->types + 0) == ECMA_PROPERTY_TYPE_HASHMAP)
+  {
+    list_start_p = ECMA_GET_POINTER (ecma_property_header_t, list_start_p->next_property_cp);
+  }
+
+  /* First pass: count the names. */
+  ecma_length_t names_count = 0;
+
+  for (ecma_property_header_t *prop_iter_p = list_start_p;
+       prop_iter_p != NULL;
+       prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t, prop_iter_p->next_property_cp))
+  {
+    JERRY_ASSERT (ECMA_PROPERTY_IS_PROPERTY_PAIR (prop_iter_p));
+
+    for (int i = 0; i < ECMA_PROPERTY_PAIR_ITEM_COUNT; i++)
+    {
+      ecma_property_t *property_p = prop_iter_p->types + i;
+
+      if ((ECMA_PROPERTY_GET_TYPE (property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA
+           || ECMA_PROPERTY_GET_TYPE (property_p) == ECMA_PROPERTY_TYPE_NAMEDACCESSOR)
+          && ecma_is_property_enumerable (property_p))
       {
-        ecma_string_t *space_str_p = ecma_get_string_from_value (space);
-        ecma_length_t num_of_chars = ecma_string_get_length (space_str_p);
+        ecma_property_pair_t *prop_pair_p = (ecma_property_pair_t *) prop_iter_p;
+        ecma_string_t *name_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, prop_pair_p->names_cp[i]);
+        uint32_t index;
 
-        if (num_of_chars < 10)
-        {
-          ecma_ref_ecma_string (space_str_p);
-          context.gap_str_p = space_str_p;
-        }
-        else
+        if (ecma_string_get_array_index (name_p, &index))
         {
-          context.gap_str_p = ecma_string_substr (space_str_p, 0, 10);
+          return NULL;
         }
-      }
-      /* 8. */
-      else
-      {
-        context.gap_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
+
+        names_count++;
       }
     }
+  }
 
-    ecma_free_value (space);
-
-    if (ecma_is_value_empty (ret_value))
-    {
-      /* 9. */
-      ecma_object_t *obj_wrapper_p = ecma_op_create_object_object_noarg ();
-      ecma_string_t *empty_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
-
-      /* 10. */
-      ecma_value_t put_comp_val = ecma_op_object_put (obj_wrapper_p,
-                                                      empty_str_p,
-                                                      arg1,
-                                                      false);
+  /* Second pass: the property list is in reversed creation order. */
+  ecma_collection_header_t *names_p;
 
-      JERRY_ASSERT (ecma_is_value_true (put_comp_val));
-      ecma_free_value (put_comp_val);
+  JMEM_DEFINE_LOCAL_ARRAY (names_buffer_p, names_count, ecma_value_t);
 
-      /* 11. */
-      ECMA_TRY_CATCH (str_val,
-                      ecma_builtin_json_str (empty_str_p, obj_wrapper_p, &context),
-                      ret_value);
+  ecma_length_t name_pos = names_count;
 
-      ret_value = ecma_copy_value (str_val);
+  for (ecma_property_header_t *prop_iter_p = list_start_p;
+       prop_iter_p != NULL;
+       prop_iter_p = ECMA_GET_POINTER (ecma_property_header_t, prop_iter_p->next_property_cp))
+  {
+    for (int i = 0; i < ECMA_PROPERTY_PAIR_ITEM_COUNT; i++)
+    {
+      ecma_property_t *property_p = prop_iter_p->types + i;
 
-      ECMA_FINALIZE (str_val);
+      if ((ECMA_PROPERTY_GET_TYPE (property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA
+           || ECMA_PROPERTY_GET_TYPE (property_p) == ECMA_PROPERTY_TYPE_NAMEDACCESSOR)
+          && ecma_is_property_enumerable (property_p))
+      {
+        ecma_property_pair_t *prop_pair_p = (ecma_property_pair_t *) prop_iter_p;
+        ecma_string_t *name_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, prop_pair_p->names_cp[i]);
 
-      ecma_deref_object (obj_wrapper_p);
-      ecma_deref_ecma_string (empty_str_p);
+        names_buffer_p[--name_pos] = ecma_make_string_value (name_p);
+      }
     }
-
-    ecma_deref_ecma_string (context.gap_str_p);
   }
 
-  ecma_deref_ecma_string (context.indent_str_p);
+  JERRY_ASSERT (name_pos == 0);
 
-  ecma_free_values_collection (context.property_list_p, true);
-  ecma_free_values_collection (context.occurence_stack_p, true);
+  names_p = ecma_new_values_collection (names_buffer_p, names_count, true);
 
-  return ret_value;
-} /* ecma_builtin_json_stringify */
+  JMEM_FINALIZE_LOCAL_ARRAY (names_buffer_p);
+
+  return names_p;
+} /* ecma_builtin_json_get_own_property_names */
 
 /**
- * Abstract operation 'Quote' defined in 15.12.3
+ * Abstract operation 'JO' defined in 15.12.3
  *
  * See also:
  *          ECMA-262 v5, 15.12.3
@@ -1058,152 +1249,125 @@ ecma_builtin_json_stringify (ecma_value_t this_arg, /**< 'this' argument */
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
-ecma_builtin_json_quote (ecma_string_t *string_p) /**< string that should be quoted*/
+ecma_builtin_json_object (ecma_object_t *obj_p, /**< the object*/
+                          ecma_json_stringify_context_t *context_p) /**< context*/
 {
+  ecma_value_t obj_value = ecma_make_object_value (obj_p);
+
   /* 1. */
-  ecma_string_t *quote_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_DOUBLE_QUOTE_CHAR);
-  ecma_ref_ecma_string (quote_str_p);
-  ecma_string_t *product_str_p = quote_str_p;
-  ecma_string_t *tmp_str_p;
+  if (ecma_has_object_value_in_collection (context_p->occurence_stack_p, obj_value))
+  {
+    return ecma_raise_type_error (ECMA_ERR_MSG (""));
+  }
 
-  ECMA_STRING_TO_UTF8_STRING (string_p, string_buff, string_buff_size);
+  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+
+  /* 2. */
+  ecma_append_to_values_collection (context_p->occurence_stack_p, obj_value, true);
+
+  /* 3. - 4. */
+  context_p->indent_level++;
 
-  const lit_utf8_byte_t *str_p = string_buff;
-  const lit_utf8_byte_t *str_end_p = string_buff + string_buff_size;
+  ecma_collection_header_t *property_keys_p;
 
-  while (str_p < str_end_p)
+  /* 5. */
+  if (context_p->property_list_p->unit_number > 0)
+  {
+    property_keys_p = context_p->property_list_p;
+  }
+  /* 6. */
+  else
   {
-    ecma_char_t current_char = lit_utf8_read_next (&str_p);
+    property_keys_p = ecma_builtin_json_get_own_property_names (obj_p);
 
-    /* 2.a */
-    if (current_char == LIT_CHAR_BACKSLASH || current_char == LIT_CHAR_DOUBLE_QUOTE)
+    if (property_keys_p == NULL)
     {
-      ecma_string_t *backslash_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_BACKSLASH_CHAR);
+      property_keys_p = ecma_op_object_get_property_names (obj_p, false, true, false);
+    }
+  }
 
-      /* 2.a.i */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, backslash_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (backslash_str_p);
-      product_str_p = tmp_str_p;
+  /* 9. */
+  ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_LEFT_BRACE);
 
-      /* 2.a.ii */
-      ecma_string_t *current_char_str_p = ecma_new_ecma_string_from_code_unit (current_char);
+  bool is_empty = true;
 
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, current_char_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (current_char_str_p);
-      product_str_p = tmp_str_p;
-    }
-    /* 2.b */
-    else if (current_char == LIT_CHAR_BS
-             || current_char == LIT_CHAR_FF
-             || current_char == LIT_CHAR_LF
-             || current_char == LIT_CHAR_CR
-             || current_char == LIT_CHAR_TAB)
-    {
-      ecma_string_t *backslash_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_BACKSLASH_CHAR);
+  /* 7. - 8. */
+  ecma_collection_iterator_t iterator;
+  ecma_collection_iterator_init (&iterator, property_keys_p);
 
-      /* 2.b.i */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, backslash_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (backslash_str_p);
-      product_str_p = tmp_str_p;
+  while (ecma_collection_iterator_next (&iterator) && ecma_is_value_empty (ret_value))
+  {
+    ecma_value_t value = *iterator.current_value_p;
+    ecma_string_t *key_p = ecma_get_string_from_value (value);
 
-      /* 2.b.ii */
-      lit_utf8_byte_t abbrev = LIT_CHAR_SP;
+    /* 8.a */
+    ECMA_TRY_CATCH (str_val,
+                    ecma_builtin_json_str (key_p, obj_p, context_p),
+                    ret_value);
 
-      switch (current_char)
+    /* 8.b */
+    if (ecma_builtin_json_is_serializable (str_val))
+    {
+      /* 10. */
+      if (!is_empty)
       {
-        case LIT_CHAR_BS:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_B;
-          break;
-        }
-        case LIT_CHAR_FF:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_F;
-          break;
-        }
-        case LIT_CHAR_LF:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_N;
-          break;
-        }
-        case LIT_CHAR_CR:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_R;
-          break;
-        }
-        case LIT_CHAR_TAB:
-        {
-          abbrev = LIT_CHAR_LOWERCASE_T;
-          break;
-        }
+        ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_COMMA);
+      }
+
+      if (context_p->gap_size > 0)
+      {
+        ecma_builtin_json_append_indent (context_p);
       }
 
-      /* 2.b.iii */
-      ecma_string_t *abbrev_str_p = ecma_new_ecma_string_from_utf8 (&abbrev, 1);
+      is_empty = false;
 
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, abbrev_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (abbrev_str_p);
-      product_str_p = tmp_str_p;
-    }
-    /* 2.c */
-    else if (current_char < LIT_CHAR_SP)
-    {
-      ecma_string_t *backslash_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_BACKSLASH_CHAR);
+      /* 8.b.i - 8.b.ii */
+      ecma_builtin_helper_json_writer_append_quoted (context_p->writer_p, key_p);
+      ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_COLON);
+
+      /* 8.b.iii */
+      if (context_p->gap_size > 0)
+      {
+        ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_SP);
+      }
 
-      /* 2.c.i */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, backslash_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (backslash_str_p);
-      product_str_p = tmp_str_p;
+      /* 8.b.iv */
+      ret_value = ecma_builtin_json_serialize_value (str_val, context_p);
+    }
 
-      /* 2.c.ii */
-      lit_utf8_byte_t u_ch = LIT_CHAR_LOWERCASE_U;
-      ecma_string_t *u_ch_str_p = ecma_new_ecma_string_from_utf8 (&u_ch, 1);
+    ECMA_FINALIZE (str_val);
+  }
 
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, u_ch_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (u_ch_str_p);
-      product_str_p = tmp_str_p;
+  if (context_p->property_list_p->unit_number == 0)
+  {
+    ecma_free_values_collection (property_keys_p, true);
+  }
 
-      /* 2.c.iii */
-      ecma_string_t *hex_str_p = ecma_builtin_helper_json_create_hex_digit_ecma_string ((uint8_t) current_char);
+  if (!ecma_is_value_empty (ret_value))
+  {
+    return ret_value;
+  }
 
-      /* 2.c.iv */
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, hex_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (hex_str_p);
-      product_str_p = tmp_str_p;
-    }
-    /* 2.d */
-    else
-    {
-      ecma_string_t *current_char_str_p = ecma_new_ecma_string_from_code_unit (current_char);
+  /* 12. */
+  context_p->indent_level--;
 
-      tmp_str_p = ecma_concat_ecma_strings (product_str_p, current_char_str_p);
-      ecma_deref_ecma_string (product_str_p);
-      ecma_deref_ecma_string (current_char_str_p);
-      product_str_p = tmp_str_p;
-    }
+  /* 10.b.iii */
+  if (!is_empty && context_p->gap_size > 0)
+  {
+    ecma_builtin_json_append_indent (context_p);
   }
 
-  ECMA_FINALIZE_UTF8_STRING (string_buff, string_buff_size);
+  ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_RIGHT_BRACE);
 
-  /* 3. */
-  tmp_str_p = ecma_concat_ecma_strings (product_str_p, quote_str_p);
-  ecma_deref_ecma_string (product_str_p);
-  ecma_deref_ecma_string (quote_str_p);
-  product_str_p = tmp_str_p;
+  /* 11. */
+  ecma_remove_last_value_from_values_collection (context_p->occurence_stack_p);
 
-  /* 4. */
-  return ecma_make_string_value (product_str_p);
-} /* ecma_builtin_json_quote */
+  /* 13. */
+  return ret_value;
+} /* ecma_builtin_json_object */
 
 /**
- * Abstract operation 'Str' defined in 15.12.3
+ * Abstract operation 'JA' defined in 15.12.3
  *
  * See also:
  *          ECMA-262 v5, 15.12.3
@@ -1212,525 +1376,495 @@ ecma_builtin_json_quote (ecma_string_t *string_p) /**< string that should be quo
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
-ecma_builtin_json_str (ecma_string_t *key_p, /**< property key*/
-                       ecma_object_t *holder_p, /**< the object*/
-                       ecma_json_stringify_context_t *context_p) /**< context*/
+ecma_builtin_json_array (ecma_object_t *obj_p, /**< the array object*/
+                         ecma_json_stringify_context_t *context_p) /**< context*/
 {
-  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+  ecma_value_t obj_value = ecma_make_object_value (obj_p);
 
   /* 1. */
-  ECMA_TRY_CATCH (value,
-                  ecma_op_object_get (holder_p, key_p),
-                  ret_value);
+  if (ecma_has_object_value_in_collection (context_p->occurence_stack_p, obj_value))
+  {
+    return ecma_raise_type_error (ECMA_ERR_MSG (""));
+  }
 
-  ecma_value_t my_val = ecma_copy_value (value);
+  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
 
   /* 2. */
-  if (ecma_is_value_object (my_val))
+  ecma_append_to_values_collection (context_p->occurence_stack_p, obj_value, true);
+
+  /* 3. - 4. */
+  context_p->indent_level++;
+
+  ecma_string_t *length_str_p = ecma_new_ecma_length_string ();
+
+  /* 6. */
+  ECMA_TRY_CATCH (array_length,
+                  ecma_op_object_get (obj_p, length_str_p),
+                  ret_value);
+
+  ECMA_OP_TO_NUMBER_TRY_CATCH (array_length_num,
+                               array_length,
+                               ret_value);
+
+  uint32_t array_length = ecma_number_to_uint32 (array_length_num);
+
+  /* 9. */
+  ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_LEFT_SQUARE);
+
+  /* 5., 7. - 8. */
+  for (uint32_t index = 0;
+       index < array_length && ecma_is_value_empty (ret_value);
+       index++)
   {
-    ecma_object_t *value_obj_p = ecma_get_object_from_value (my_val);
-    ecma_string_t *to_json_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_TO_JSON_UL);
+    /* 10. */
+    if (index > 0)
+    {
+      ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_COMMA);
+    }
 
-    /* 2.a */
-    ECMA_TRY_CATCH (toJSON,
-                    ecma_op_object_get (value_obj_p, to_json_str_p),
+    if (context_p->gap_size > 0)
+    {
+      ecma_builtin_json_append_indent (context_p);
+    }
+
+    /* 8.a */
+    ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+
+    ECMA_TRY_CATCH (str_val,
+                    ecma_builtin_json_str (index_str_p, obj_p, context_p),
                     ret_value);
 
-    /* 2.b */
-    if (ecma_op_is_callable (toJSON))
+    /* 8.b */
+    if (!ecma_builtin_json_is_serializable (str_val))
     {
-      ecma_value_t key_value = ecma_make_string_value (key_p);
-      ecma_value_t call_args[] = { key_value };
-      ecma_object_t *toJSON_obj_p = ecma_get_object_from_value (toJSON);
+      ecma_builtin_json_serialize_value (ecma_make_simple_value (ECMA_SIMPLE_VALUE_NULL), context_p);
+    }
+    /* 8.c */
+    else
+    {
+      ret_value = ecma_builtin_json_serialize_value (str_val, context_p);
+    }
 
-      ECMA_TRY_CATCH (func_ret_val,
-                      ecma_op_function_call (toJSON_obj_p, my_val, call_args, 1),
-                      ret_value);
+    ECMA_FINALIZE (str_val);
+    ecma_deref_ecma_string (index_str_p);
+  }
 
-      ecma_free_value (my_val);
-      my_val = ecma_copy_value (func_ret_val);
+  if (ecma_is_value_empty (ret_value))
+  {
+    /* 12. */
+    context_p->indent_level--;
 
-      ECMA_FINALIZE (func_ret_val);
+    /* 10.b.iii */
+    if (array_length > 0 && context_p->gap_size > 0)
+    {
+      ecma_builtin_json_append_indent (context_p);
     }
 
-    ECMA_FINALIZE (toJSON);
+    ecma_builtin_helper_json_writer_append_byte (context_p->writer_p, LIT_CHAR_RIGHT_SQUARE);
 
-    ecma_deref_ecma_string (to_json_str_p);
+    /* 11. */
+    ecma_remove_last_value_from_values_collection (context_p->occurence_stack_p);
   }
 
-  /* 3. */
-  if (context_p->replacer_function_p && ecma_is_value_empty (ret_value))
-  {
-    ecma_value_t holder_value = ecma_make_object_value (holder_p);
-    ecma_value_t key_value = ecma_make_string_value (key_p);
-    ecma_value_t call_args[] = { key_value, my_val };
+  ECMA_OP_TO_NUMBER_FINALIZE (array_length_num);
+  ECMA_FINALIZE (array_length);
 
-    ECMA_TRY_CATCH (func_ret_val,
-                    ecma_op_function_call (context_p->replacer_function_p, holder_value, call_args, 2),
-                    ret_value);
+  ecma_deref_ecma_string (length_str_p);
 
-    ecma_free_value (my_val);
-    my_val = ecma_copy_value (func_ret_val);
+  /* 13. */
+  return ret_value;
+} /* ecma_builtin_json_array */
 
-    ECMA_FINALIZE (func_ret_val);
-  }
+/**
+ * Abstract operation 'Str' defined in 15.12.3, steps 5. - 10.
+ *
+ * Appends the JSON text of a value computed by ecma_builtin_json_str to the output.
+ *
+ * See also:
+ *          ECMA-262 v5, 15.12.3
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_json_serialize_value (ecma_value_t value, /**< value */
+                                   ecma_json_stringify_context_t *context_p) /**< context*/
+{
+  JERRY_ASSERT (ecma_builtin_json_is_serializable (value));
 
-  /* 4. */
-  if (ecma_is_value_object (my_val) && ecma_is_value_empty (ret_value))
+  /* 5. - 7. */
+  if (ecma_is_value_null (value) || ecma_is_value_boolean (value))
   {
-    ecma_object_t *obj_p = ecma_get_object_from_value (my_val);
-    lit_magic_string_id_t class_name = ecma_object_get_class_name (obj_p);
+    ecma_string_t *str_p = ecma_get_magic_string (ecma_is_value_null (value) ? LIT_MAGIC_STRING_NULL
+                                                  : (ecma_is_value_true (value) ? LIT_MAGIC_STRING_TRUE
+                                                                                : LIT_MAGIC_STRING_FALSE));
+    ecma_builtin_helper_json_writer_append_string (context_p->writer_p, str_p);
+    ecma_deref_ecma_string (str_p);
+  }
+  /* 8. */
+  else if (ecma_is_value_string (value))
+  {
+    ecma_builtin_helper_json_writer_append_quoted (context_p->writer_p, ecma_get_string_from_value (value));
+  }
+  /* 9. */
+  else if (ecma_is_value_number (value))
+  {
+    ecma_builtin_json_append_number (ecma_get_number_from_value (value), context_p);
+  }
+  /* 10. */
+  else
+  {
+    JERRY_ASSERT (ecma_is_value_object (value));
 
-    /* 4.a */
-    if (class_name == LIT_MAGIC_STRING_NUMBER_UL)
+    ecma_object_t *obj_p = ecma_get_object_from_value (value);
+
+    /* 10.a */
+    if (ecma_object_get_class_name (obj_p) == LIT_MAGIC_STRING_ARRAY_UL)
     {
-      ECMA_TRY_CATCH (val,
-                      ecma_op_to_number (my_val),
-                      ret_value);
+      return ecma_builtin_json_array (obj_p, context_p);
+    }
 
-      ecma_free_value (my_val);
-      my_val = ecma_copy_value (val);
+    /* 10.b */
+    return ecma_builtin_json_object (obj_p, context_p);
+  }
 
-      ECMA_FINALIZE (val);
-    }
-    /* 4.b */
-    else if (class_name == LIT_MAGIC_STRING_STRING_UL)
-    {
-      ECMA_TRY_CATCH (val,
-                      ecma_op_to_string (my_val),
-                      ret_value);
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+} /* ecma_builtin_json_serialize_value */
 
-      ecma_free_value (my_val);
-      my_val = ecma_copy_value (val);
+/**
+ * Compute the property list of JSON.stringify from an array replacer
+ *
+ * See also:
+ *          ECMA-262 v5, 15.12.3 (steps 4.b.i - 4.b.ii)
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_json_get_property_list (ecma_object_t *obj_p, /**< replacer array */
+                                     ecma_json_stringify_context_t *context_p) /**< context */
+{
+  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+  ecma_string_t *length_str_p = ecma_new_ecma_length_string ();
 
-      ECMA_FINALIZE (val);
-    }
-    /* 4.c */
-    else if (class_name == LIT_MAGIC_STRING_BOOLEAN_UL)
-    {
-      ECMA_TRY_CATCH (val,
-                      ecma_op_to_primitive (my_val, ECMA_PREFERRED_TYPE_NO),
-                      ret_value);
+  ECMA_TRY_CATCH (array_length,
+                  ecma_op_object_get (obj_p, length_str_p),
+                  ret_value);
 
-      ecma_free_value (my_val);
-      my_val = ecma_copy_value (val);
+  ECMA_OP_TO_NUMBER_TRY_CATCH (array_length_num,
+                               array_length,
+                               ret_value);
 
-      ECMA_FINALIZE (val);
-    }
-  }
+  uint32_t array_length = ecma_number_to_uint32 (array_length_num);
+  uint32_t index = 0;
 
-  if (ecma_is_value_empty (ret_value))
+  /* 4.b.ii */
+  while ((index < array_length) && ecma_is_value_empty (ret_value))
   {
-    /* 5. - 7. */
-    if (ecma_is_value_null (my_val) || ecma_is_value_boolean (my_val))
-    {
-      ret_value = ecma_op_to_string (my_val);
-      JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (ret_value));
-    }
-    /* 8. */
-    else if (ecma_is_value_string (my_val))
+    ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
+
+    ECMA_TRY_CATCH (value,
+                    ecma_op_object_get (obj_p, index_str_p),
+                    ret_value);
+
+    /* 4.b.ii.1 */
+    ecma_value_t item = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+
+    /* 4.b.ii.2 */
+    if (ecma_is_value_string (value))
     {
-      ecma_string_t *value_str_p = ecma_get_string_from_value (my_val);
-      ret_value = ecma_builtin_json_quote (value_str_p);
+      item = ecma_copy_value (value);
     }
-    /* 9. */
-    else if (ecma_is_value_number (my_val))
+    /* 4.b.ii.3 */
+    else if (ecma_is_value_number (value))
     {
-      ecma_number_t num_value_p = ecma_get_number_from_value (my_val);
+      ECMA_TRY_CATCH (str_val,
+                      ecma_op_to_string (value),
+                      ret_value);
 
-      /* 9.a */
-      if (!ecma_number_is_nan (num_value_p) && !ecma_number_is_infinity (num_value_p))
-      {
-        ret_value = ecma_op_to_string (my_val);
-        JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (ret_value));
-      }
-      else
-      {
-        /* 9.b */
-        ecma_string_t *null_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_NULL);
-        ret_value = ecma_make_string_value (null_str_p);
-      }
+      item = ecma_copy_value (str_val);
+
+      ECMA_FINALIZE (str_val);
     }
-    /* 10. */
-    else if (ecma_is_value_object (my_val) && !ecma_op_is_callable (my_val))
+    /* 4.b.ii.4 */
+    else if (ecma_is_value_object (value))
     {
-      ecma_object_t *obj_p = ecma_get_object_from_value (my_val);
-      lit_magic_string_id_t class_name = ecma_object_get_class_name (obj_p);
+      ecma_object_t *obj_val_p = ecma_get_object_from_value (value);
+      lit_magic_string_id_t class_name = ecma_object_get_class_name (obj_val_p);
 
-      /* 10.a */
-      if (class_name == LIT_MAGIC_STRING_ARRAY_UL)
+      /* 4.b.ii.4.a */
+      if (class_name == LIT_MAGIC_STRING_NUMBER_UL
+          || class_name == LIT_MAGIC_STRING_STRING_UL)
       {
         ECMA_TRY_CATCH (val,
-                        ecma_builtin_json_array (obj_p, context_p),
+                        ecma_op_to_string (value),
                         ret_value);
 
-        ret_value = ecma_copy_value (val);
+        item = ecma_copy_value (val);
 
         ECMA_FINALIZE (val);
       }
-      /* 10.b */
+    }
+
+    /* 4.b.ii.5 */
+    if (!ecma_is_value_undefined (item))
+    {
+      if (!ecma_has_string_value_in_collection (context_p->property_list_p, item))
+      {
+        ecma_append_to_values_collection (context_p->property_list_p, item, true);
+        ecma_deref_ecma_string (ecma_get_string_from_value (item));
+      }
       else
       {
-        ECMA_TRY_CATCH (val,
-                        ecma_builtin_json_object (obj_p, context_p),
-                        ret_value);
-
-        ret_value = ecma_copy_value (val);
-
-        ECMA_FINALIZE (val);
+        ecma_free_value (item);
       }
     }
-    else
-    {
-      /* 11. */
-      ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
-    }
+
+    ECMA_FINALIZE (value);
+
+    ecma_deref_ecma_string (index_str_p);
+
+    index++;
   }
 
-  ecma_free_value (my_val);
-  ECMA_FINALIZE (value);
+  ECMA_OP_TO_NUMBER_FINALIZE (array_length_num);
+  ECMA_FINALIZE (array_length);
+
+  ecma_deref_ecma_string (length_str_p);
 
   return ret_value;
-} /* ecma_builtin_json_str */
+} /* ecma_builtin_json_get_property_list */
 
 /**
- * Abstract operation 'JO' defined in 15.12.3
+ * Compute the indentation text of JSON.stringify
  *
  * See also:
- *          ECMA-262 v5, 15.12.3
+ *          ECMA-262 v5, 15.12.3 (steps 5. - 8.)
  *
  * @return ecma value
  *         Returned value must be freed with ecma_free_value.
  */
 static ecma_value_t
-ecma_builtin_json_object (ecma_object_t *obj_p, /**< the object*/
-                          ecma_json_stringify_context_t *context_p) /**< context*/
+ecma_builtin_json_get_gap (ecma_value_t arg, /**< space argument */
+                           ecma_json_stringify_context_t *context_p) /**< context */
 {
-  ecma_value_t obj_value = ecma_make_object_value (obj_p);
-
-  /* 1. */
-  if (ecma_has_object_value_in_collection (context_p->occurence_stack_p, obj_value))
-  {
-    return ecma_raise_type_error (ECMA_ERR_MSG (""));
-  }
-
   ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
-
-  /* 2. */
-  ecma_append_to_values_collection (context_p->occurence_stack_p, obj_value, true);
-
-  /* 3. */
-  ecma_string_t *stepback_p = context_p->indent_str_p;
-
-  /* 4. */
-  context_p->indent_str_p = ecma_concat_ecma_strings (context_p->indent_str_p, context_p->gap_str_p);
-
-  ecma_collection_header_t *property_keys_p;
+  ecma_value_t space = ecma_copy_value (arg);
 
   /* 5. */
-  if (context_p->property_list_p->unit_number > 0)
-  {
-    property_keys_p = context_p->property_list_p;
-  }
-  /* 6. */
-  else
+  if (ecma_is_value_object (arg))
   {
-    property_keys_p = ecma_new_values_collection (NULL, 0, true);
+    ecma_object_t *obj_p = ecma_get_object_from_value (arg);
+    lit_magic_string_id_t class_name = ecma_object_get_class_name (obj_p);
 
-    ecma_collection_header_t *props_p = ecma_op_object_get_property_names (obj_p, false, true, false);
+    /* 5.a */
+    if (class_name == LIT_MAGIC_STRING_NUMBER_UL)
+    {
+      ECMA_TRY_CATCH (val,
+                      ecma_op_to_number (arg),
+                      ret_value);
 
-    ecma_collection_iterator_t iter;
-    ecma_collection_iterator_init (&iter, props_p);
+      ecma_free_value (space);
+      space = ecma_copy_value (val);
 
-    while (ecma_collection_iterator_next (&iter))
+      ECMA_FINALIZE (val);
+    }
+    /* 5.b */
+    else if (class_name == LIT_MAGIC_STRING_STRING_UL)
     {
-      ecma_string_t *property_name_p = ecma_get_string_from_value (*iter.current_value_p);
-      ecma_property_t *property_p = ecma_op_object_get_own_property (obj_p, property_name_p);
+      ECMA_TRY_CATCH (val,
+                      ecma_op_to_string (arg),
+                      ret_value);
 
-      JERRY_ASSERT (ecma_is_property_enumerable (property_p));
+      ecma_free_value (space);
+      space = ecma_copy_value (val);
 
-      if (ECMA_PROPERTY_GET_TYPE (property_p) == ECMA_PROPERTY_TYPE_NAMEDDATA)
-      {
-        ecma_append_to_values_collection (property_keys_p, *iter.current_value_p, true);
-      }
+      ECMA_FINALIZE (val);
     }
-
-    ecma_free_values_collection (props_p, true);
   }
 
-  /* 7. */
-  ecma_collection_header_t *partial_p = ecma_new_values_collection (NULL, 0, true);
-
-  /* 8. */
-  ecma_collection_iterator_t iterator;
-  ecma_collection_iterator_init (&iterator, property_keys_p);
+  context_p->gap_size = 0;
 
-  while (ecma_collection_iterator_next (&iterator) && ecma_is_value_empty (ret_value))
+  if (ecma_is_value_empty (ret_value))
   {
-    ecma_value_t value = *iterator.current_value_p;
-    ecma_string_t *key_p = ecma_get_string_from_value (value);
-
-    /* 8.a */
-    ECMA_TRY_CATCH (str_val,
-                    ecma_builtin_json_str (key_p, obj_p, context_p),
-                    ret_value);
-
-    /* 8.b */
-    if (!ecma_is_value_undefined (str_val))
+    /* 6. */
+    if (ecma_is_value_number (space))
     {
-      ecma_string_t *colon_p = ecma_get_magic_string (LIT_MAGIC_STRING_COLON_CHAR);
-      ecma_string_t *value_str_p = ecma_get_string_from_value (str_val);
-      ecma_string_t *tmp_str_p;
-
-      /* 8.b.i */
-      ecma_value_t str_comp_val = ecma_builtin_json_quote (key_p);
-      JERRY_ASSERT (!ECMA_IS_VALUE_ERROR (str_comp_val));
-
-      ecma_string_t *member_str_p = ecma_get_string_from_value (str_comp_val);
-
-      /* 8.b.ii */
-      tmp_str_p = ecma_concat_ecma_strings (member_str_p, colon_p);
-      ecma_free_value (str_comp_val);
-      ecma_deref_ecma_string (colon_p);
-      member_str_p = tmp_str_p;
+      /* 6.a */
+      int32_t num_of_spaces = ecma_number_to_int32 (ecma_get_number_from_value (space));
+      int32_t gap_size = (num_of_spaces > 10) ? 10 : num_of_spaces;
 
-      /* 8.b.iii */
-      if (!ecma_string_is_empty (context_p->gap_str_p))
+      /* 6.b */
+      for (int32_t i = 0; i < gap_size; i++)
       {
-        ecma_string_t *space_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_SPACE_CHAR);
-
-        tmp_str_p = ecma_concat_ecma_strings (member_str_p, space_str_p);
-        ecma_deref_ecma_string (member_str_p);
-        ecma_deref_ecma_string (space_str_p);
-        member_str_p = tmp_str_p;
+        context_p->gap[i] = LIT_CHAR_SP;
       }
 
-      /* 8.b.iv */
-      tmp_str_p = ecma_concat_ecma_strings (member_str_p, value_str_p);
-      ecma_deref_ecma_string (member_str_p);
-      member_str_p = tmp_str_p;
-
-      /* 8.b.v */
-      ecma_value_t member_value = ecma_make_string_value (member_str_p);
-      ecma_append_to_values_collection (partial_p, member_value, true);
-      ecma_deref_ecma_string (member_str_p);
+      context_p->gap_size = (gap_size > 0) ? (lit_utf8_size_t) gap_size : 0;
     }
-
-    ECMA_FINALIZE (str_val);
-  }
-
-  if (context_p->property_list_p->unit_number == 0)
-  {
-    ecma_free_values_collection (property_keys_p, true);
-  }
-
-  if (!ecma_is_value_empty (ret_value))
-  {
-    ecma_free_values_collection (partial_p, true);
-    ecma_deref_ecma_string (stepback_p);
-    return ret_value;
-  }
-
-  /* 9. */
-  if (partial_p->unit_number == 0)
-  {
-    ecma_string_t *left_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_BRACE_CHAR);
-    ecma_string_t *right_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_BRACE_CHAR);
-
-    ecma_string_t *final_str_p = ecma_concat_ecma_strings (left_brace_str_p, right_brace_str_p);
-    ret_value = ecma_make_string_value (final_str_p);
-
-    ecma_deref_ecma_string (left_brace_str_p);
-    ecma_deref_ecma_string (right_brace_str_p);
-  }
-  /* 10. */
-  else
-  {
-    /* 10.a */
-    if (ecma_string_is_empty (context_p->gap_str_p))
+    /* 7. */
+    else if (ecma_is_value_string (space))
     {
-      ecma_string_t *left_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_BRACE_CHAR);
-      ecma_string_t *right_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_BRACE_CHAR);
-
-      ret_value = ecma_builtin_helper_json_create_non_formatted_json (left_brace_str_p,
-                                                                      right_brace_str_p,
-                                                                      partial_p);
+      ecma_string_t *space_str_p = ecma_get_string_from_value (space);
+      ecma_length_t num_of_chars = ecma_string_get_length (space_str_p);
 
-      ecma_deref_ecma_string (left_brace_str_p);
-      ecma_deref_ecma_string (right_brace_str_p);
-    }
-    /* 10.b */
-    else
-    {
-      ecma_string_t *left_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_BRACE_CHAR);
-      ecma_string_t *right_brace_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_BRACE_CHAR);
+      ecma_string_t *gap_str_p = ecma_string_substr (space_str_p, 0, (num_of_chars < 10) ? num_of_chars : 10);
 
-      ret_value = ecma_builtin_helper_json_create_formatted_json (left_brace_str_p,
-                                                                  right_brace_str_p,
-                                                                  stepback_p,
-                                                                  partial_p,
-                                                                  context_p);
+      context_p->gap_size = ecma_string_copy_to_utf8_buffer (gap_str_p, context_p->gap, sizeof (context_p->gap));
 
-      ecma_deref_ecma_string (left_brace_str_p);
-      ecma_deref_ecma_string (right_brace_str_p);
+      ecma_deref_ecma_string (gap_str_p);
     }
+    /* 8. */
   }
 
-  ecma_free_values_collection (partial_p, true);
-
-  /* 11. */
-  ecma_remove_last_value_from_values_collection (context_p->occurence_stack_p);
-
-  /* 12. */
-  ecma_deref_ecma_string (context_p->indent_str_p);
-  context_p->indent_str_p = stepback_p;
+  ecma_free_value (space);
 
-  /* 13. */
   return ret_value;
-} /* ecma_builtin_json_object */
+} /* ecma_builtin_json_get_gap */
 
 /**
- * Abstract operation 'JA' defined in 15.12.3
+ * Serialize a value into JSON text
  *
  * See also:
- *          ECMA-262 v5, 15.12.3
+ *          ECMA-262 v5, 15.12.3 (steps 1. - 11. of JSON.stringify)
  *
  * @return ecma value
+ *         true - if the JSON text is appended to the output,
+ *         undefined - if the value has no JSON representation,
+ *         error - otherwise
  *         Returned value must be freed with ecma_free_value.
  */
-static ecma_value_t
-ecma_builtin_json_array (ecma_object_t *obj_p, /**< the array object*/
-                         ecma_json_stringify_context_t *context_p) /**< context*/
+ecma_value_t
+ecma_builtin_json_serialize (ecma_value_t value, /**< value */
+                             ecma_value_t replacer, /**< replacer */
+                             ecma_value_t space, /**< space */
+                             ecma_json_writer_t *writer_p) /**< output buffer */
 {
-  ecma_value_t obj_value = ecma_make_object_value (obj_p);
+  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
 
-  /* 1. */
-  if (ecma_has_object_value_in_collection (context_p->occurence_stack_p, obj_value))
-  {
-    return ecma_raise_type_error (ECMA_ERR_MSG (""));
-  }
+  ecma_json_stringify_context_t context;
 
-  ecma_value_t ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+  /* 1. */
+  context.occurence_stack_p = ecma_new_values_collection (NULL, 0, false);
 
   /* 2. */
-  ecma_append_to_values_collection (context_p->occurence_stack_p, obj_value, true);
+  context.indent_level = 0;
 
   /* 3. */
-  ecma_string_t *stepback_p = context_p->indent_str_p;
-
-  /* 4. */
-  context_p->indent_str_p = ecma_concat_ecma_strings (context_p->indent_str_p, context_p->gap_str_p);
-
-  /* 5. */
-  ecma_collection_header_t *partial_p = ecma_new_values_collection (NULL, 0, true);
-
-  ecma_string_t *length_str_p = ecma_new_ecma_length_string ();
-
-  /* 6. */
-  ECMA_TRY_CATCH (array_length,
-                  ecma_op_object_get (obj_p, length_str_p),
-                  ret_value);
-
-  ECMA_OP_TO_NUMBER_TRY_CATCH (array_length_num,
-                               array_length,
-                               ret_value);
+  context.property_list_p = ecma_new_values_collection (NULL, 0, false);
 
-  uint32_t array_length = ecma_number_to_uint32 (array_length_num);
+  context.replacer_function_p = NULL;
+  context.to_json_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_TO_JSON_UL);
+  context.writer_p = writer_p;
 
-  /* 7. - 8. */
-  for (uint32_t index = 0;
-       index < array_length && ecma_is_value_empty (ret_value);
-       index++)
+  /* 4. */
+  if (ecma_is_value_object (replacer))
   {
+    ecma_object_t *obj_p = ecma_get_object_from_value (replacer);
 
-    /* 8.a */
-    ecma_string_t *index_str_p = ecma_new_ecma_string_from_uint32 (index);
-
-    ECMA_TRY_CATCH (str_val,
-                    ecma_builtin_json_str (index_str_p, obj_p, context_p),
-                    ret_value);
-
-    /* 8.b */
-    if (ecma_is_value_undefined (str_val))
+    /* 4.a */
+    if (ecma_op_is_callable (replacer))
     {
-      ecma_string_t *null_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_NULL);
-      ecma_append_to_values_collection (partial_p, ecma_make_string_value (null_str_p), true);
-      ecma_deref_ecma_string (null_str_p);
+      context.replacer_function_p = obj_p;
     }
-    /* 8.c */
-    else
+    /* 4.b */
+    else if (ecma_object_get_class_name (obj_p) == LIT_MAGIC_STRING_ARRAY_UL)
     {
-      ecma_append_to_values_collection (partial_p, str_val, true);
+      ret_value = ecma_builtin_json_get_property_list (obj_p, &context);
     }
+  }
 
-    ECMA_FINALIZE (str_val);
-    ecma_deref_ecma_string (index_str_p);
+  /* 5. - 8. */
+  if (ecma_is_value_empty (ret_value))
+  {
+    ret_value = ecma_builtin_json_get_gap (space, &context);
   }
 
   if (ecma_is_value_empty (ret_value))
   {
     /* 9. */
-    if (partial_p->unit_number == 0)
-    {
-      ecma_string_t *left_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR);
-      ecma_string_t *right_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR);
+    ecma_object_t *obj_wrapper_p = ecma_op_create_object_object_noarg ();
+    ecma_string_t *empty_str_p = ecma_get_magic_string (LIT_MAGIC_STRING__EMPTY);
 
-      ecma_string_t *final_str_p = ecma_concat_ecma_strings (left_square_str_p, right_square_str_p);
-      ret_value = ecma_make_string_value (final_str_p);
-
-      ecma_deref_ecma_string (left_square_str_p);
-      ecma_deref_ecma_string (right_square_str_p);
-    }
     /* 10. */
-    else
-    {
-      /* 10.a */
-      if (ecma_string_is_empty (context_p->gap_str_p))
-      {
-        ecma_string_t *left_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR);
-        ecma_string_t *right_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR);
+    ecma_value_t put_comp_val = ecma_op_object_put (obj_wrapper_p,
+                                                    empty_str_p,
+                                                    value,
+                                                    false);
 
-        ret_value = ecma_builtin_helper_json_create_non_formatted_json (left_square_str_p,
-                                                                        right_square_str_p,
-                                                                        partial_p);
+    JERRY_ASSERT (ecma_is_value_true (put_comp_val));
+    ecma_free_value (put_comp_val);
 
-        ecma_deref_ecma_string (left_square_str_p);
-        ecma_deref_ecma_string (right_square_str_p);
-      }
-      /* 10.b */
-      else
-      {
-        ecma_string_t *left_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_LEFT_SQUARE_CHAR);
-        ecma_string_t *right_square_str_p = ecma_get_magic_string (LIT_MAGIC_STRING_RIGHT_SQUARE_CHAR);
+    /* 11. */
+    ECMA_TRY_CATCH (str_val,
+                    ecma_builtin_json_str (empty_str_p, obj_wrapper_p, &context),
+                    ret_value);
 
-        ret_value = ecma_builtin_helper_json_create_formatted_json (left_square_str_p,
-                                                                    right_square_str_p,
-                                                                    stepback_p,
-                                                                    partial_p,
-                                                                    context_p);
+    if (ecma_builtin_json_is_serializable (str_val))
+    {
+      ret_value = ecma_builtin_json_serialize_value (str_val, &context);
 
-        ecma_deref_ecma_string (left_square_str_p);
-        ecma_deref_ecma_string (right_square_str_p);
+      if (ecma_is_value_empty (ret_value))
+      {
+        ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
       }
     }
+    else
+    {
+      ret_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+    }
+
+    ECMA_FINALIZE (str_val);
+
+    ecma_deref_object (obj_wrapper_p);
+    ecma_deref_ecma_string (empty_str_p);
   }
 
-  ECMA_OP_TO_NUMBER_FINALIZE (array_length_num);
-  ECMA_FINALIZE (array_length);
+  ecma_deref_ecma_string (context.to_json_str_p);
 
-  ecma_deref_ecma_string (length_str_p);
-  ecma_free_values_collection (partial_p, true);
+  ecma_free_values_collection (context.property_list_p, true);
+  ecma_free_values_collection (context.occurence_stack_p, true);
 
-  /* 11. */
-  ecma_remove_last_value_from_values_collection (context_p->occurence_stack_p);
+  return ret_value;
+} /* ecma_builtin_json_serialize */
 
-  /* 12. */
-  ecma_deref_ecma_string (context_p->indent_str_p);
-  context_p->indent_str_p = stepback_p;
+/**
+ * The JSON object's 'stringify' routine
+ *
+ * Note:
+ *      the JSON text is collected into a single growing buffer,
+ *      and the result string is created only once at the end
+ *
+ * See also:
+ *          ECMA-262 v5, 15.12.3
+ *
+ * @return ecma value
+ *         Returned value must be freed with ecma_free_value.
+ */
+static ecma_value_t
+ecma_builtin_json_stringify (ecma_value_t this_arg, /**< 'this' argument */
+                             ecma_value_t arg1,  /**< value */
+                             ecma_value_t arg2,  /**< replacer */
+                             ecma_value_t arg3)  /**< space */
+{
+  JERRY_UNUSED (this_arg);
+
+  ecma_json_writer_t writer;
+  ecma_builtin_helper_json_writer_init (&writer, NULL, NULL);
+
+  ecma_value_t ret_value = ecma_builtin_json_serialize (arg1, arg2, arg3, &writer);
+
+  if (ecma_is_value_true (ret_value))
+  {
+    ret_value = ecma_builtin_helper_json_writer_finalize (&writer);
+  }
+  else
+  {
+    ecma_builtin_helper_json_writer_free (&writer);
+  }
 
-  /* 13. */
   return ret_value;
-} /* ecma_builtin_json_array */
+} /* ecma_builtin_json_stringify */
 
 /**
  * @}
@@ -0,0 +1,68 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-builtins.h"
+#include "ecma-globals.h"
+#include "ecma-helpers.h"
+#include "jcontext.h"
+#include "jerry-port.h"
+#include "jrt.h"
+
+#ifndef CONFIG_DISABLE_PERFORMANCE_BUILTIN
+
+#define ECMA_BUILTINS_INTERNAL
+#include "ecma-builtins-internal.h"
+
+#define BUILTIN_INC_HEADER_NAME "ecma-builtin-performance.inc.h"
+#define BUILTIN_UNDERSCORED_ID performance
+#include "ecma-builtin-internal-routines-template.inc.h"
+
+/** \addtogroup ecma ECMA
+ * @{
+ *
+ * \addtogroup ecmabuiltins
+ * @{
+ *
+ * \addtogroup performance Implementation-defined Performance object built-in
+ * @{
+ */
+
+/**
+ * The Performance object's 'now' routine
+ *
+ * Unlike Date.now, the returned time is measured by the monotonic clock of the port
+ * (jerry_port_get_monotonic_time), so it has sub-millisecond resolution and it is not
+ * affected by the adjustments of the system time.
+ *
+ * @return ecma value
+ *         the time elapsed since the initialization of the engine in milliseconds
+ */
+static ecma_value_t
+ecma_builtin_performance_now (ecma_value_t this_arg) /**< this argument */
+{
+  JERRY_UNUSED (this_arg);
+
+  uint64_t elapsed_time = jerry_port_get_monotonic_time () - JERRY_CONTEXT (ecma_builtin_performance_time_origin);
+
+  return ecma_make_number_value (DOUBLE_TO_ECMA_NUMBER_T ((double) elapsed_time / 1000000.0));
+} /* ecma_builtin_performance_now */
+
+/**
+ * @}
+ * @}
+ * @}
+ */
+
+#endif /* !CONFIG_DISABLE_PERFORMANCE_BUILTIN */
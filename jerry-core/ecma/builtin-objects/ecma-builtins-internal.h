@@ -67,6 +67,12 @@ typedef struct
   uint16_t value; /**< value of the property */
 } ecma_builtin_property_descriptor_t;
 
+/**
+ * Bit of a property name in the property name filter of a built-in object
+ */
+#define ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT(magic_string_id) \
+  (((uint64_t) 1) << ((magic_string_id) & 0x3f))
+
 #define BUILTIN(builtin_id, \
                 object_type, \
                 object_prototype_builtin_id, \
@@ -75,6 +81,8 @@ typedef struct
                 lowercase_name) \
 extern const ecma_builtin_property_descriptor_t \
 ecma_builtin_ ## lowercase_name ## _property_descriptor_list[]; \
+extern const uint64_t \
+ecma_builtin_ ## lowercase_name ## _property_name_filter; \
 extern ecma_value_t \
 ecma_builtin_ ## lowercase_name ## _dispatch_call (const ecma_value_t *, \
                                                    ecma_length_t); \
@@ -322,6 +322,21 @@ static const ecma_builtin_property_list_reference_t ecma_builtin_property_list_r
 #include "ecma-builtins.inc.h"
 };
 
+/**
+ * Property name filters of the built-in objects
+ */
+static const uint64_t * const ecma_builtin_property_name_filters[] =
+{
+#define BUILTIN(builtin_id, \
+                object_type, \
+                object_prototype_builtin_id, \
+                is_extensible, \
+                is_static, \
+                lowercase_name) \
+  &ecma_builtin_ ## lowercase_name ## _property_name_filter,
+#include "ecma-builtins.inc.h"
+};
+
 /**
  * If the property's name is one of built-in properties of the object
  * that is not instantiated yet, instantiate the property and
@@ -377,6 +392,12 @@ ecma_builtin_try_to_instantiate_property (ecma_object_t *object_p, /**< object *
   JERRY_ASSERT (builtin_id < ECMA_BUILTIN_ID__COUNT);
   JERRY_ASSERT (ecma_builtin_is (object_p, builtin_id));
 
+  if (!(*ecma_builtin_property_name_filters[builtin_id] & ECMA_BUILTIN_PROPERTY_NAME_FILTER_BIT (magic_string_id)))
+  {
+    /* The name is not in the property list. */
+    return NULL;
+  }
+
   const ecma_builtin_property_descriptor_t *property_list_p = ecma_builtin_property_list_references[builtin_id];
 
   const ecma_builtin_property_descriptor_t *curr_property_p = property_list_p;
@@ -140,6 +140,16 @@ BUILTIN (ECMA_BUILTIN_ID_JSON,
          json)
 #endif /* !CONFIG_DISABLE_JSON_BUILTIN */
 
+#ifndef CONFIG_DISABLE_PERFORMANCE_BUILTIN
+/* The Performance object (implementation-defined) */
+BUILTIN (ECMA_BUILTIN_ID_PERFORMANCE,
+         ECMA_OBJECT_TYPE_GENERAL,
+         ECMA_BUILTIN_ID_OBJECT_PROTOTYPE,
+         true,
+         true,
+         performance)
+#endif /* !CONFIG_DISABLE_PERFORMANCE_BUILTIN */
+
 #ifndef CONFIG_DISABLE_DATE_BUILTIN
 /* The Date.prototype object (15.9.4) */
 BUILTIN (ECMA_BUILTIN_ID_DATE_PROTOTYPE,
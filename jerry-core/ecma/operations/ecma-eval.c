@@ -88,9 +88,12 @@ ecma_op_eval_chars_buffer (const lit_utf8_byte_t *code_p, /**< code characters b
 
   bool is_strict_call = (is_direct && is_called_from_strict_mode_code);
 
+  /* Eval code (including the code of the Function constructor) is compiled
+   * immediately, since syntax errors must be thrown by the eval call. */
   ecma_value_t parse_status = parser_parse_script (code_p,
                                                    code_buffer_size,
                                                    is_strict_call,
+                                                   false,
                                                    &bytecode_data_p);
 
   if (ECMA_IS_VALUE_ERROR (parse_status))
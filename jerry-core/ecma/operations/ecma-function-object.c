@@ -26,6 +26,7 @@
 #include "ecma-objects-general.h"
 #include "ecma-objects-arguments.h"
 #include "ecma-try-catch-macro.h"
+#include "js-parser.h"
 
 #define JERRY_INTERNAL
 #include "jerry-internal.h"
@@ -293,7 +294,17 @@ ecma_op_function_try_lazy_instantiate_property (ecma_object_t *obj_p, /**< the f
 
     // 14
     uint32_t len;
-    if (bytecode_data_p->status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
+    if (bytecode_data_p->status_flags & CBC_CODE_FLAGS_SNAPSHOT_FUNCTION)
+    {
+      cbc_snapshot_function_t *snapshot_function_p = (cbc_snapshot_function_t *) bytecode_data_p;
+      len = snapshot_function_p->argument_end;
+    }
+    else if (bytecode_data_p->status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION)
+    {
+      cbc_lazy_function_t *lazy_function_p = (cbc_lazy_function_t *) bytecode_data_p;
+      len = lazy_function_p->argument_end;
+    }
+    else if (bytecode_data_p->status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
     {
       cbc_uint16_arguments_t *args_p = (cbc_uint16_arguments_t *) bytecode_data_p;
       len = args_p->argument_end;
@@ -533,6 +544,88 @@ ecma_op_function_has_instance (ecma_object_t *func_obj_p, /**< Function object *
   return ret_value;
 } /* ecma_op_function_has_instance */
 
+/**
+ * Load the byte code of a function object created from a snapshot function,
+ * and replace the byte code of the function object with the result.
+ *
+ * Note:
+ *      the loaded byte code is also stored in the snapshot function,
+ *      so other function objects created from it are not loaded again
+ */
+static void
+ecma_op_function_load_from_snapshot (ecma_extended_object_t *ext_func_p) /**< function object */
+{
+  cbc_snapshot_function_t *snapshot_function_p;
+  snapshot_function_p = ECMA_GET_INTERNAL_VALUE_POINTER (cbc_snapshot_function_t,
+                                                         ext_func_p->u.function.bytecode_cp);
+
+  ecma_compiled_code_t *bytecode_data_p;
+
+  if (snapshot_function_p->bytecode_cp == JMEM_CP_NULL)
+  {
+    bytecode_data_p = jerry_snapshot_load_function (&snapshot_function_p->header);
+
+    /* The reference created by the loader is owned by the snapshot function. */
+    ECMA_SET_NON_NULL_POINTER (snapshot_function_p->bytecode_cp, bytecode_data_p);
+  }
+  else
+  {
+    bytecode_data_p = ECMA_GET_NON_NULL_POINTER (ecma_compiled_code_t, snapshot_function_p->bytecode_cp);
+  }
+
+  ecma_bytecode_ref (bytecode_data_p);
+  ECMA_SET_INTERNAL_VALUE_POINTER (ext_func_p->u.function.bytecode_cp, bytecode_data_p);
+  ecma_bytecode_deref (&snapshot_function_p->header);
+} /* ecma_op_function_load_from_snapshot */
+
+/**
+ * Compile the body of a function object created from a lazy function,
+ * and replace the byte code of the function object with the result.
+ *
+ * Note:
+ *      the compiled byte code is also stored in the lazy function,
+ *      so other function objects created from it are not compiled again
+ *
+ * @return empty value - if success
+ *         syntax error - otherwise
+ */
+static ecma_value_t
+ecma_op_function_compile_lazy (ecma_extended_object_t *ext_func_p) /**< function object */
+{
+  cbc_lazy_function_t *lazy_function_p;
+  lazy_function_p = ECMA_GET_INTERNAL_VALUE_POINTER (cbc_lazy_function_t,
+                                                     ext_func_p->u.function.bytecode_cp);
+
+  JERRY_ASSERT (lazy_function_p->header.status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION);
+
+  ecma_compiled_code_t *bytecode_data_p;
+
+  if (lazy_function_p->bytecode_cp == JMEM_CP_NULL)
+  {
+    ecma_value_t parse_status = parser_compile_lazy_function (&lazy_function_p->header, &bytecode_data_p);
+
+    if (ECMA_IS_VALUE_ERROR (parse_status))
+    {
+      return parse_status;
+    }
+
+    ecma_free_value (parse_status);
+
+    /* The reference created by the parser is owned by the lazy function. */
+    ECMA_SET_NON_NULL_POINTER (lazy_function_p->bytecode_cp, bytecode_data_p);
+  }
+  else
+  {
+    bytecode_data_p = ECMA_GET_NON_NULL_POINTER (ecma_compiled_code_t, lazy_function_p->bytecode_cp);
+  }
+
+  ecma_bytecode_ref (bytecode_data_p);
+  ECMA_SET_INTERNAL_VALUE_POINTER (ext_func_p->u.function.bytecode_cp, bytecode_data_p);
+  ecma_bytecode_deref (&lazy_function_p->header);
+
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_EMPTY);
+} /* ecma_op_function_compile_lazy */
+
 /**
  * [[Call]] implementation for Function objects,
  * created through 13.2 (ECMA_OBJECT_TYPE_FUNCTION)
@@ -581,6 +674,26 @@ ecma_op_function_call (ecma_object_t *func_obj_p, /**< Function object */
       bytecode_data_p = ECMA_GET_INTERNAL_VALUE_POINTER (const ecma_compiled_code_t,
                                                          ext_func_p->u.function.bytecode_cp);
 
+      if (unlikely (bytecode_data_p->status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION))
+      {
+        if (bytecode_data_p->status_flags & CBC_CODE_FLAGS_SNAPSHOT_FUNCTION)
+        {
+          ecma_op_function_load_from_snapshot (ext_func_p);
+        }
+        else
+        {
+          ecma_value_t compile_status = ecma_op_function_compile_lazy (ext_func_p);
+
+          if (ECMA_IS_VALUE_ERROR (compile_status))
+          {
+            return compile_status;
+          }
+        }
+
+        bytecode_data_p = ECMA_GET_INTERNAL_VALUE_POINTER (const ecma_compiled_code_t,
+                                                           ext_func_p->u.function.bytecode_cp);
+      }
+
       is_strict = (bytecode_data_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE) ? true : false;
       is_no_lex_env = (bytecode_data_p->status_flags & CBC_CODE_FLAGS_LEXICAL_ENV_NOT_NEEDED) ? true : false;
 
@@ -906,6 +906,12 @@ ecma_object_get_class_name (ecma_object_t *obj_p) /**< object */
             return LIT_MAGIC_STRING_JSON_U;
           }
 #endif /* !CONFIG_DISABLE_JSON_BUILTIN */
+#ifndef CONFIG_DISABLE_PERFORMANCE_BUILTIN
+          case ECMA_BUILTIN_ID_PERFORMANCE:
+          {
+            return LIT_MAGIC_STRING_OBJECT_UL;
+          }
+#endif /* !CONFIG_DISABLE_PERFORMANCE_BUILTIN */
 #ifndef CONFIG_DISABLE_ERROR_BUILTINS
           case ECMA_BUILTIN_ID_EVAL_ERROR_PROTOTYPE:
           case ECMA_BUILTIN_ID_RANGE_ERROR_PROTOTYPE:
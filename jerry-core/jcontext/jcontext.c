@@ -51,6 +51,60 @@ jerry_hash_table_t jerry_global_hash_table;
 
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
+#ifdef JERRY_GC_MARK_BITMAP
+
+/**
+ * Global mark bitmaps of the garbage collector.
+ */
+jerry_gc_bitmap_t jerry_global_gc_bitmap;
+
+#endif /* JERRY_GC_MARK_BITMAP */
+
+#ifdef JERRY_CPU_PROFILER
+
+/**
+ * Global sample buffer of the CPU profiler.
+ */
+jerry_cpu_profiler_t jerry_global_cpu_profiler;
+
+#endif /* JERRY_CPU_PROFILER */
+
+#ifdef JERRY_VM_OPCODE_STATS
+
+/**
+ * Global opcode execution statistics.
+ */
+jerry_opcode_stats_t jerry_global_opcode_stats;
+
+#endif /* JERRY_VM_OPCODE_STATS */
+
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * Global state of the heap profiler.
+ */
+jerry_heap_profiler_t jerry_global_heap_profiler;
+
+#endif /* JERRY_HEAP_PROFILER */
+
+#ifdef JERRY_TRACE
+
+/**
+ * Global state of the timeline tracing.
+ */
+jerry_trace_t jerry_global_trace;
+
+#endif /* JERRY_TRACE */
+
+#ifdef JMEM_STATS
+
+/**
+ * Global memory usage statistics of the allocation categories.
+ */
+jerry_mem_stats_t jerry_global_mem_stats;
+
+#endif /* JMEM_STATS */
+
 /**
  * @}
  * @}
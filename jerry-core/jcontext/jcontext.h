@@ -24,8 +24,10 @@
 #include "jmem-allocator.h"
 #include "jmem-config.h"
 #include "jrt.h"
+#include "js-parser.h"
 #include "re-bytecode.h"
 #include "vm-defines.h"
+#include "vm-runtime-stats.h"
 
 /** \addtogroup context Jerry context
  * @{
@@ -57,11 +59,24 @@ typedef struct
   jmem_pools_chunk_t *jmem_free_chunk_p; /**< list of free pool chunks */
   jmem_free_unused_memory_callback_t jmem_free_unused_memory_callback; /**< Callback for freeing up memory. */
 
+#ifdef JERRY_RUNTIME_STATS
+  size_t jmem_heap_peak_allocated_size; /**< high-water mark of the allocated regions */
+#endif /* JERRY_RUNTIME_STATS */
+
 #ifdef JMEM_STATS
   jmem_heap_stats_t jmem_heap_stats; /**< heap's memory usage statistics */
   jmem_pools_stats_t jmem_pools_stats; /**< pools' memory usage statistics */
 #endif /* MEM_STATS */
 
+#if defined (JERRY_HEAP_PROFILER) || defined (JMEM_STATS)
+  uint8_t jmem_alloc_category; /**< category of the next allocated block (jmem_alloc_category_t) */
+#endif /* JERRY_HEAP_PROFILER || JMEM_STATS */
+
+#ifdef JERRY_HEAP_PROFILER
+  jmem_track_callback_t jmem_track_alloc_callback; /**< callback of the allocated blocks */
+  jmem_track_callback_t jmem_track_free_callback; /**< callback of the freed blocks */
+#endif /* JERRY_HEAP_PROFILER */
+
 #ifdef JERRY_VALGRIND_FREYA
   bool valgrind_freya_mempool_request; /**< Tells whether a pool manager
                                         *   allocator request is in progress */
@@ -85,15 +100,44 @@ typedef struct
   uint8_t re_cache_idx; /**< evicted item index when regex cache is full (round-robin) */
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
 
+#ifndef CONFIG_DISABLE_PERFORMANCE_BUILTIN
+  uint64_t ecma_builtin_performance_time_origin; /**< monotonic time of the initialization (see performance.now) */
+#endif /* !CONFIG_DISABLE_PERFORMANCE_BUILTIN */
+
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+  parser_code_cache_entry_t *parser_code_cache[CONFIG_PARSER_CODE_CACHE_SIZE]; /**< compiled code cache of eval
+                                                                                *   and jerry_parse */
+  uint32_t parser_code_cache_counter; /**< number of cache look-ups (used for LRU eviction) */
+  jerry_code_cache_stats_t parser_code_cache_stats; /**< statistics of the compiled code cache */
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
   bool ecma_gc_visited_flip_flag; /**< current state of an object's visited flag */
   bool is_direct_eval_form_call; /**< direct call from eval */
   size_t ecma_gc_objects_number; /**< number of currently allocated objects */
   size_t ecma_gc_new_objects; /**< number of newly allocated objects since last GC session */
+  size_t ecma_strings_number; /**< number of currently allocated strings */
   ecma_lit_storage_item_t *string_list_first_p; /**< first item of the literal string list */
   ecma_lit_storage_item_t *number_list_first_p; /**< first item of the literal number list */
   ecma_object_t *ecma_global_lex_env_p; /**< global lexical environment */
+  uint32_t ecma_free_callback_count; /**< number of host free callbacks (of native handles
+                                      *   and external strings) which are not called yet */
   vm_frame_ctx_t *vm_top_context_p; /**< top (current) interpreter context */
 
+#ifdef JERRY_RUNTIME_STATS
+  /**
+   * Runtime statistics part.
+   */
+  uint64_t vm_runtime_phase_times[VM_RUNTIME_PHASE__COUNT]; /**< time spent in each phase (in nanoseconds) */
+  uint64_t vm_runtime_phase_counts[VM_RUNTIME_PHASE__COUNT]; /**< number of times each phase is entered */
+  uint64_t vm_runtime_phase_start_time; /**< monotonic time when the current phase is entered */
+  uint64_t vm_runtime_gc_max_pause; /**< duration of the longest garbage collection (in nanoseconds) */
+#ifndef CONFIG_ECMA_LCACHE_DISABLE
+  uint64_t ecma_lcache_hits; /**< number of successful lookup cache look-ups */
+  uint64_t ecma_lcache_misses; /**< number of failed lookup cache look-ups */
+#endif /* !CONFIG_ECMA_LCACHE_DISABLE */
+  uint8_t vm_runtime_phase; /**< current phase of the engine (vm_runtime_phase_t) */
+#endif /* JERRY_RUNTIME_STATS */
+
   /**
    * API part.
    */
@@ -139,6 +183,210 @@ typedef struct
 
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
+#ifdef JERRY_GC_MARK_BITMAP
+
+/**
+ * Size of a garbage collector bitmap, which has one bit for each JMEM_ALIGNMENT sized unit of the heap
+ */
+#define JERRY_GC_BITMAP_SIZE (JMEM_HEAP_SIZE / JMEM_ALIGNMENT / JERRY_BITSINBYTE)
+
+/**
+ * Mark bitmaps of the garbage collector.
+ *
+ * The objects are identified by their compressed pointers, so the mark state
+ * is kept outside of the objects, and the GC does not write live objects.
+ */
+typedef struct
+{
+  uint8_t visited[JERRY_GC_BITMAP_SIZE]; /**< objects which are reachable from the roots */
+  uint8_t scanned[JERRY_GC_BITMAP_SIZE]; /**< reachable objects whose references are marked */
+} jerry_gc_bitmap_t;
+
+#endif /* JERRY_GC_MARK_BITMAP */
+
+#ifdef JERRY_CPU_PROFILER
+
+/**
+ * Size of the sample buffer of the CPU profiler in 32 bit words (must be a power of 2)
+ */
+#define JERRY_CPU_PROFILER_BUFFER_SIZE CONFIG_CPU_PROFILER_BUFFER_SIZE
+
+/**
+ * Sample buffer of the CPU profiler.
+ *
+ * The samples are written by vm_profiler_sample, which may be called from a signal
+ * handler, and they are consumed by vm_profiler_dump. The indices are never wrapped,
+ * only their lower bits are used for accessing the buffer.
+ */
+typedef struct
+{
+  uint32_t buffer[JERRY_CPU_PROFILER_BUFFER_SIZE]; /**< ring buffer of the samples */
+  volatile uint32_t write_index; /**< end of the stored samples */
+  volatile uint32_t read_index; /**< start of the stored samples */
+  volatile uint32_t dropped_samples; /**< number of samples dropped since the buffer was full */
+  volatile uint8_t is_running; /**< samples are collected */
+} jerry_cpu_profiler_t;
+
+#endif /* JERRY_CPU_PROFILER */
+
+#ifdef JERRY_VM_OPCODE_STATS
+
+/**
+ * Number of counted opcodes: the extended opcodes follow the simple ones in the same
+ * way as in the decode table of the virtual machine.
+ */
+#define JERRY_OPCODE_STATS_COUNT ((CBC_END + 1) + (CBC_EXT_END + 1))
+
+/**
+ * Number of entries in the opcode pair table (must be a power of 2)
+ */
+#define JERRY_OPCODE_STATS_PAIR_TABLE_SIZE CONFIG_VM_OPCODE_STATS_PAIR_TABLE_SIZE
+
+/**
+ * Entry of the opcode pair table.
+ */
+typedef struct
+{
+  uint64_t count; /**< number of executions of the pair */
+  uint32_t key; /**< index of the pair plus one, zero for an unused entry */
+} jerry_opcode_pair_t;
+
+/**
+ * Execution statistics of the opcodes.
+ */
+typedef struct
+{
+  uint64_t counts[JERRY_OPCODE_STATS_COUNT]; /**< number of executions of each opcode */
+  uint64_t cycles[JERRY_OPCODE_STATS_COUNT]; /**< sum of the measured cycles of each opcode */
+  uint32_t cycle_samples[JERRY_OPCODE_STATS_COUNT]; /**< number of measurements of each opcode */
+  jerry_opcode_pair_t pairs[JERRY_OPCODE_STATS_PAIR_TABLE_SIZE]; /**< hash table of the opcode pairs */
+  uint64_t instruction_count; /**< number of executed instructions */
+  uint64_t dropped_pairs; /**< number of pairs not counted since the pair table was full */
+  uint64_t sample_start; /**< time stamp of the instruction whose cycles are measured */
+  uint32_t sample_countdown; /**< number of instructions until the next measurement */
+  uint32_t random_state; /**< state of the generator of the measurement intervals */
+  uint32_t pair_count; /**< number of used entries in the pair table */
+  uint32_t last_opcode; /**< opcode of the previous instruction plus one, zero at the start of a run */
+  uint32_t sampled_opcode; /**< opcode whose cycles are measured plus one, zero if there is none */
+} jerry_opcode_stats_t;
+
+#endif /* JERRY_VM_OPCODE_STATS */
+
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * Number of entries in the allocation site table (must be a power of 2)
+ */
+#define JERRY_HEAP_PROFILER_SITE_TABLE_SIZE CONFIG_HEAP_PROFILER_SITE_TABLE_SIZE
+
+/**
+ * Maximum number of entries in the timeline (must be even)
+ */
+#define JERRY_HEAP_PROFILER_TIMELINE_SIZE CONFIG_HEAP_PROFILER_TIMELINE_SIZE
+
+/**
+ * Maximum size of the function names stored by the sites (longer names are truncated)
+ */
+#define JERRY_HEAP_PROFILER_NAME_SIZE 23
+
+/**
+ * Allocation site: the allocations of a category by a source line.
+ */
+typedef struct
+{
+  uint64_t allocated_bytes; /**< total size of the allocated blocks */
+  uint32_t allocated_blocks; /**< number of the allocated blocks */
+  uint32_t live_bytes; /**< total size of the allocated blocks which are not freed yet */
+  uint32_t live_blocks; /**< number of the allocated blocks which are not freed yet */
+  uint32_t function_line; /**< first line of the function (0 for global code), or a special value
+                           *   if there is no JavaScript frame or it has no line info */
+  uint32_t line; /**< source line */
+  jmem_cpointer_t name_cp; /**< name of the function (only used for identifying the site, since the
+                            *   function and its name may be freed before the site is reported) */
+  lit_utf8_byte_t name[JERRY_HEAP_PROFILER_NAME_SIZE]; /**< copy of the name of the function */
+  uint8_t name_size; /**< size of the copied name */
+  uint8_t category; /**< category of the allocated blocks (jmem_alloc_category_t) */
+  uint8_t is_used; /**< the entry is used */
+} jerry_heap_profiler_site_t;
+
+/**
+ * Timeline entry of the heap profiler.
+ */
+typedef struct
+{
+  uint64_t allocated_bytes; /**< total size of the blocks allocated before the entry */
+  uint32_t live_bytes[JMEM_ALLOC_CATEGORY__COUNT]; /**< live bytes of each category */
+} jerry_heap_profiler_timeline_entry_t;
+
+/**
+ * State of the heap profiler.
+ */
+typedef struct
+{
+  uint16_t block_sites[JMEM_HEAP_AREA_SIZE / JMEM_ALIGNMENT]; /**< allocation site of each block plus one,
+                                                                *   stored for the first heap unit of
+                                                                *   the block (zero if unknown) */
+  jerry_heap_profiler_site_t sites[JERRY_HEAP_PROFILER_SITE_TABLE_SIZE]; /**< hash table of the sites */
+  jerry_heap_profiler_timeline_entry_t timeline[JERRY_HEAP_PROFILER_TIMELINE_SIZE]; /**< timeline */
+  uint32_t live_bytes[JMEM_ALLOC_CATEGORY__COUNT]; /**< live bytes of each category */
+  uint64_t allocated_bytes; /**< total size of the allocated blocks */
+  uint64_t untracked_bytes; /**< total size of the blocks allocated while the site table was full */
+  uint64_t next_timeline_entry; /**< allocated bytes at the next timeline entry */
+  uint32_t timeline_interval; /**< allocated bytes between two timeline entries */
+  uint32_t timeline_count; /**< number of timeline entries */
+  uint32_t site_count; /**< number of used entries in the site table */
+} jerry_heap_profiler_t;
+
+#endif /* JERRY_HEAP_PROFILER */
+
+#ifdef JERRY_TRACE
+
+/**
+ * Number of events in the ring buffer of the timeline tracing (must be a power of 2)
+ */
+#define JERRY_TRACE_BUFFER_SIZE CONFIG_TRACE_BUFFER_SIZE
+
+/**
+ * Event of the timeline tracing.
+ */
+typedef struct
+{
+  uint64_t start_time; /**< monotonic time of the start of the event in nanoseconds */
+  uint64_t duration; /**< duration of the event in nanoseconds (zero for instant events) */
+  uint32_t args[3]; /**< arguments of the event (their meaning depends on the type) */
+  uint8_t type; /**< type of the event (vm_trace_event_type_t) */
+} jerry_trace_event_t;
+
+/**
+ * State of the timeline tracing.
+ *
+ * The event count is never wrapped, only its lower bits are used for accessing the buffer.
+ */
+typedef struct
+{
+  jerry_trace_event_t events[JERRY_TRACE_BUFFER_SIZE]; /**< ring buffer of the events */
+  uint64_t event_count; /**< number of events recorded since the tracing is started */
+  uint64_t start_time; /**< monotonic time when the tracing is started */
+  uint8_t is_running; /**< events are recorded */
+} jerry_trace_t;
+
+#endif /* JERRY_TRACE */
+
+#ifdef JMEM_STATS
+
+/**
+ * Memory usage statistics of the allocation categories.
+ */
+typedef struct
+{
+  uint8_t block_categories[JMEM_HEAP_AREA_SIZE / JMEM_ALIGNMENT]; /**< category of each block plus one,
+                                                                   *   stored for the first heap unit of
+                                                                   *   the block (zero if unknown) */
+  jmem_alloc_category_stats_t categories[JMEM_ALLOC_CATEGORY__COUNT]; /**< statistics of each category */
+} jerry_mem_stats_t;
+
+#endif /* JMEM_STATS */
+
 /**
  * Global context.
  */
@@ -158,6 +406,60 @@ extern jerry_hash_table_t jerry_global_hash_table;
 
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
+#ifdef JERRY_GC_MARK_BITMAP
+
+/**
+ * Global mark bitmaps of the garbage collector.
+ */
+extern jerry_gc_bitmap_t jerry_global_gc_bitmap;
+
+#endif /* JERRY_GC_MARK_BITMAP */
+
+#ifdef JERRY_CPU_PROFILER
+
+/**
+ * Global sample buffer of the CPU profiler.
+ */
+extern jerry_cpu_profiler_t jerry_global_cpu_profiler;
+
+#endif /* JERRY_CPU_PROFILER */
+
+#ifdef JERRY_VM_OPCODE_STATS
+
+/**
+ * Global opcode execution statistics.
+ */
+extern jerry_opcode_stats_t jerry_global_opcode_stats;
+
+#endif /* JERRY_VM_OPCODE_STATS */
+
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * Global state of the heap profiler.
+ */
+extern jerry_heap_profiler_t jerry_global_heap_profiler;
+
+#endif /* JERRY_HEAP_PROFILER */
+
+#ifdef JERRY_TRACE
+
+/**
+ * Global state of the timeline tracing.
+ */
+extern jerry_trace_t jerry_global_trace;
+
+#endif /* JERRY_TRACE */
+
+#ifdef JMEM_STATS
+
+/**
+ * Global memory usage statistics of the allocation categories.
+ */
+extern jerry_mem_stats_t jerry_global_mem_stats;
+
+#endif /* JMEM_STATS */
+
 /**
  * Provides a reference to a field in the current context.
  */
@@ -177,6 +479,60 @@ extern jerry_hash_table_t jerry_global_hash_table;
 
 #endif /* !CONFIG_ECMA_LCACHE_DISABLE */
 
+#ifdef JERRY_GC_MARK_BITMAP
+
+/**
+ * Provides a reference to the global mark bitmaps of the garbage collector.
+ */
+#define JERRY_GC_BITMAP_CONTEXT(field) (jerry_global_gc_bitmap.field)
+
+#endif /* JERRY_GC_MARK_BITMAP */
+
+#ifdef JERRY_CPU_PROFILER
+
+/**
+ * Provides a reference to the global sample buffer of the CPU profiler.
+ */
+#define JERRY_CPU_PROFILER_CONTEXT(field) (jerry_global_cpu_profiler.field)
+
+#endif /* JERRY_CPU_PROFILER */
+
+#ifdef JERRY_VM_OPCODE_STATS
+
+/**
+ * Provides a reference to the global opcode execution statistics.
+ */
+#define JERRY_OPCODE_STATS_CONTEXT(field) (jerry_global_opcode_stats.field)
+
+#endif /* JERRY_VM_OPCODE_STATS */
+
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * Provides a reference to the global state of the heap profiler.
+ */
+#define JERRY_HEAP_PROFILER_CONTEXT(field) (jerry_global_heap_profiler.field)
+
+#endif /* JERRY_HEAP_PROFILER */
+
+#ifdef JERRY_TRACE
+
+/**
+ * Provides a reference to the global state of the timeline tracing.
+ */
+#define JERRY_TRACE_CONTEXT(field) (jerry_global_trace.field)
+
+#endif /* JERRY_TRACE */
+
+#ifdef JMEM_STATS
+
+/**
+ * Provides a reference to the global memory usage statistics of the allocation categories.
+ */
+#define JERRY_MEM_STATS_CONTEXT(field) (jerry_global_mem_stats.field)
+
+#endif /* JMEM_STATS */
+
 /**
  * @}
  * @}
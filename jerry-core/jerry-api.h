@@ -52,6 +52,10 @@ typedef enum
   JERRY_INIT_SHOW_OPCODES       = (1u << 1), /**< dump byte-code to stdout after parse */
   JERRY_INIT_MEM_STATS          = (1u << 2), /**< dump memory statistics */
   JERRY_INIT_MEM_STATS_SEPARATE = (1u << 3), /**< dump memory statistics and reset peak values after parse */
+  JERRY_INIT_LAZY_FUNCTIONS     = (1u << 4), /**< compile functions on their first call (the source
+                                              *   passed to jerry_parse must be kept) */
+  JERRY_INIT_OPTIMIZE_SNAPSHOT  = (1u << 5), /**< optimize the byte code stored in snapshots */
+  JERRY_INIT_OPCODE_STATS       = (1u << 6), /**< dump opcode execution statistics */
 } jerry_init_flag_t;
 
 /**
@@ -149,6 +153,11 @@ typedef jerry_value_t (*jerry_external_handler_t) (const jerry_value_t function_
  */
 typedef void (*jerry_object_free_callback_t) (const uintptr_t native_p);
 
+/**
+ * Free callback of an external string's buffer
+ */
+typedef void (*jerry_external_string_free_callback_t) (const jerry_char_t *string_p, jerry_size_t string_size);
+
 /**
  * Function type applied for each data property of an object
  */
@@ -156,14 +165,103 @@ typedef bool (*jerry_object_property_foreach_t) (const jerry_value_t property_na
                                                  const jerry_value_t property_value,
                                                  void *user_data_p);
 
+/**
+ * Function type receiving the output of JSON serialization in chunks
+ */
+typedef void (*jerry_json_output_callback_t) (const jerry_char_t *buffer_p,
+                                              jerry_size_t buffer_size,
+                                              void *user_data_p);
+
+/**
+ * Function type receiving the heap dump in chunks
+ */
+typedef void (*jerry_heap_dump_callback_t) (const jerry_char_t *buffer_p,
+                                            jerry_size_t buffer_size,
+                                            void *user_data_p);
+
+/**
+ * Statistics of the compiled code cache of eval and jerry_parse
+ */
+typedef struct
+{
+  uint32_t hits; /**< number of sources found in the cache */
+  uint32_t misses; /**< number of cacheable sources which were compiled */
+  uint32_t evictions; /**< number of entries replaced by a new entry */
+  uint32_t releases; /**< number of entries released to free up memory */
+} jerry_code_cache_stats_t;
+
+/**
+ * Runtime statistics of the engine
+ *
+ * The times are exclusive: the time of a garbage collection started by the parser
+ * is not included in the parse time, and the time of a native function is not
+ * included in the execution time of its JavaScript caller.
+ */
+typedef struct
+{
+  double parse_time; /**< time spent in the parser in milliseconds */
+  double execution_time; /**< time spent in the virtual machine in milliseconds */
+  double gc_time; /**< time spent in the garbage collector in milliseconds */
+  double gc_max_pause; /**< duration of the longest garbage collection in milliseconds */
+  double native_time; /**< time spent in native (external) functions in milliseconds */
+  uint64_t parse_count; /**< number of compiled sources and lazy functions */
+  uint64_t execution_count; /**< number of executed scripts, functions and eval codes */
+  uint64_t gc_count; /**< number of garbage collections */
+  uint64_t native_call_count; /**< number of native function calls */
+  uint64_t lcache_hits; /**< number of properties found in the lookup cache */
+  uint64_t lcache_misses; /**< number of properties not found in the lookup cache */
+  size_t heap_allocated_size; /**< size of the allocated heap memory */
+  size_t heap_peak_allocated_size; /**< high-water mark of the allocated heap memory */
+  size_t object_count; /**< number of the objects and lexical environments */
+  size_t string_count; /**< number of the strings */
+} jerry_runtime_stats_t;
+
+/**
+ * Types of the allocated memory blocks
+ */
+typedef enum
+{
+  JERRY_MEM_TYPE_OTHER, /**< not categorized (e.g. temporary buffers of the parser) */
+  JERRY_MEM_TYPE_OBJECT, /**< objects */
+  JERRY_MEM_TYPE_EXTENDED_OBJECT, /**< extended objects (e.g. functions, arrays and class objects) */
+  JERRY_MEM_TYPE_LEXICAL_ENVIRONMENT, /**< lexical environments */
+  JERRY_MEM_TYPE_STRING, /**< strings whose characters are stored on the heap */
+  JERRY_MEM_TYPE_EXTERNAL_STRING, /**< strings whose characters are owned by the host */
+  JERRY_MEM_TYPE_UINT32_STRING, /**< strings which represent an uint32 number */
+  JERRY_MEM_TYPE_MAGIC_STRING, /**< strings which refer to a magic string */
+  JERRY_MEM_TYPE_NUMBER, /**< heap allocated numbers */
+  JERRY_MEM_TYPE_PROPERTY_PAIR, /**< property pairs */
+  JERRY_MEM_TYPE_PROPERTY_HASHMAP, /**< property hashmaps */
+  JERRY_MEM_TYPE_BYTE_CODE, /**< compiled byte code of functions */
+  JERRY_MEM_TYPE_REGEXP_BYTE_CODE, /**< compiled byte code of regular expressions */
+  JERRY_MEM_TYPE_COLLECTION, /**< collection headers and chunks */
+  JERRY_MEM_TYPE_LITERAL_STORAGE, /**< literal storage items and literal numbers */
+  JERRY_MEM_TYPE__COUNT /**< number of memory types */
+} jerry_mem_type_t;
+
+/**
+ * Memory usage statistics of a memory type
+ */
+typedef struct
+{
+  size_t allocated_bytes; /**< currently allocated bytes */
+  size_t allocated_blocks; /**< currently allocated blocks */
+  size_t peak_allocated_bytes; /**< peak allocated bytes */
+  size_t alloc_count; /**< number of allocations */
+} jerry_mem_type_stats_t;
+
 /**
  * General engine functions
  */
 void jerry_init (jerry_init_flag_t);
 void jerry_cleanup (void);
+bool jerry_reset (jerry_init_flag_t);
 void jerry_register_magic_strings (const jerry_char_ptr_t *, uint32_t, const jerry_length_t *);
 void jerry_get_memory_limits (size_t *, size_t *);
 void jerry_gc (void);
+void jerry_get_code_cache_stats (jerry_code_cache_stats_t *);
+void jerry_get_runtime_stats (jerry_runtime_stats_t *);
+bool jerry_get_mem_type_stats (jerry_mem_type_t, jerry_mem_type_stats_t *);
 
 /**
  * Parser and executor functions
@@ -210,6 +308,7 @@ double jerry_get_number_value (const jerry_value_t);
 jerry_size_t jerry_get_string_size (const jerry_value_t);
 jerry_length_t jerry_get_string_length (const jerry_value_t);
 jerry_size_t jerry_string_to_char_buffer (const jerry_value_t, jerry_char_t *, jerry_size_t);
+bool jerry_get_string_view (const jerry_value_t, const jerry_char_t **, jerry_size_t *);
 
 /**
  * Functions for array object values
@@ -243,9 +342,11 @@ jerry_value_t jerry_create_boolean (bool);
 jerry_value_t jerry_create_error (jerry_error_t, const jerry_char_t *);
 jerry_value_t jerry_create_error_sz (jerry_error_t, const jerry_char_t *, jerry_size_t);
 jerry_value_t jerry_create_external_function (jerry_external_handler_t);
+jerry_value_t jerry_create_external_string (const jerry_char_t *, jerry_size_t, jerry_external_string_free_callback_t);
 jerry_value_t jerry_create_number (double);
 jerry_value_t jerry_create_null (void);
 jerry_value_t jerry_create_object (void);
+jerry_value_t jerry_create_object_with_properties (const jerry_value_t [], const jerry_value_t [], uint32_t);
 jerry_value_t jerry_create_string (const jerry_char_t *);
 jerry_value_t jerry_create_string_sz (const jerry_char_t *, jerry_size_t);
 jerry_value_t jerry_create_undefined (void);
@@ -261,6 +362,8 @@ jerry_value_t jerry_get_property (const jerry_value_t, const jerry_value_t);
 jerry_value_t jerry_get_property_by_index (const jerry_value_t , uint32_t);
 jerry_value_t jerry_set_property (const jerry_value_t, const jerry_value_t, const jerry_value_t);
 jerry_value_t jerry_set_property_by_index (const jerry_value_t, uint32_t, const jerry_value_t);
+jerry_value_t jerry_get_properties (const jerry_value_t, const jerry_value_t [], jerry_value_t [], uint32_t);
+jerry_value_t jerry_set_properties (const jerry_value_t, const jerry_value_t [], const jerry_value_t [], uint32_t);
 
 void jerry_init_property_descriptor_fields (jerry_property_descriptor_t *);
 jerry_value_t jerry_define_own_property (const jerry_value_t,
@@ -283,11 +386,57 @@ bool jerry_get_object_native_handle (const jerry_value_t, uintptr_t *);
 void jerry_set_object_native_handle (const jerry_value_t, uintptr_t, jerry_object_free_callback_t);
 bool jerry_foreach_object_property (const jerry_value_t, jerry_object_property_foreach_t, void *);
 
+/**
+ * JSON functions
+ */
+jerry_value_t jerry_json_parse (const jerry_char_t *, jerry_size_t);
+jerry_value_t jerry_json_stringify (const jerry_value_t, jerry_json_output_callback_t, void *);
+
 /**
  * Snapshot functions
  */
 size_t jerry_parse_and_save_snapshot (const jerry_char_t *, size_t, bool, bool, uint8_t *, size_t);
 jerry_value_t jerry_exec_snapshot (const void *, size_t, bool);
+jerry_value_t jerry_exec_snapshot_at (const void *, size_t, uint32_t, bool);
+size_t jerry_merge_snapshots (const void * const *, const size_t *, size_t, uint8_t *, size_t);
+
+/**
+ * Heap image functions
+ */
+size_t jerry_save_heap_image (uint8_t *, size_t);
+bool jerry_load_heap_image (jerry_init_flag_t, const uint8_t *, size_t);
+
+/**
+ * CPU profiler functions
+ */
+bool jerry_profiler_start (void);
+void jerry_profiler_stop (void);
+void jerry_profiler_sample (void);
+size_t jerry_profiler_dump (jerry_char_t *, size_t);
+
+/**
+ * Opcode statistics functions
+ */
+bool jerry_opcode_stats_print (void);
+void jerry_opcode_stats_reset (void);
+uint64_t jerry_opcode_stats_get_count (const char *, const char *);
+
+/**
+ * Heap profiler functions
+ */
+size_t jerry_heap_profiler_dump (jerry_char_t *, size_t);
+
+/**
+ * Timeline tracing functions
+ */
+bool jerry_trace_start (void);
+void jerry_trace_stop (void);
+size_t jerry_trace_dump (jerry_char_t *, size_t);
+
+/**
+ * Heap dump functions
+ */
+void jerry_heap_dump (jerry_heap_dump_callback_t, void *);
 
 /**
  * @}
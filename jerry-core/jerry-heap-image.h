@@ -0,0 +1,43 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JERRY_HEAP_IMAGE_H
+#define JERRY_HEAP_IMAGE_H
+
+#include "ecma-init-finalize.h"
+#include "jmem-allocator.h"
+
+/**
+ * Heap image header
+ *
+ * The header is followed by the used part of the heap area,
+ * starting at the next JMEM_ALIGNMENT aligned offset.
+ */
+typedef struct
+{
+  uint32_t version; /**< version number */
+  uint32_t heap_size; /**< heap size of the engine (JMEM_HEAP_SIZE) */
+  uint32_t builtin_count; /**< number of built-in objects */
+  uint32_t magic_string_count; /**< number of magic strings */
+  jmem_image_info_t jmem; /**< memory allocator state */
+  ecma_image_info_t ecma; /**< ECMA state */
+} jerry_heap_image_header_t;
+
+/**
+ * Jerry heap image format version
+ */
+#define JERRY_HEAP_IMAGE_VERSION (4u)
+
+#endif /* !JERRY_HEAP_IMAGE_H */
@@ -33,4 +33,13 @@ jerry_dispatch_external_function (ecma_object_t *,
 extern void
 jerry_dispatch_object_free_callback (ecma_external_pointer_t, ecma_external_pointer_t);
 
+extern void
+jerry_dispatch_external_string_free_callback (ecma_external_pointer_t, const lit_utf8_byte_t *, lit_utf8_size_t);
+
+extern ecma_compiled_code_t *
+jerry_snapshot_load_function (ecma_compiled_code_t *);
+
+extern void
+jerry_snapshot_free_function (ecma_compiled_code_t *);
+
 #endif /* !JERRY_INTERNAL_H */
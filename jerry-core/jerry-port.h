@@ -18,6 +18,7 @@
 #define JERRY_PORT_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #ifdef __cplusplus
@@ -140,6 +141,17 @@ bool jerry_port_get_time_zone (jerry_time_zone_t *tz_p);
  */
 double jerry_port_get_current_time (void);
 
+/**
+ * Get the value of a monotonic clock
+ *
+ * Note:
+ *      the clock is used for measuring elapsed time (e.g. by performance.now),
+ *      so it must not be affected by adjustments of the system time
+ *
+ * @return nanoseconds since an unspecified starting point
+ */
+uint64_t jerry_port_get_monotonic_time (void);
+
 /**
  * @}
  */
@@ -29,14 +29,19 @@ typedef struct
   uint32_t version; /**< version number */
   uint32_t lit_table_offset; /**< offset of the literal table */
   uint32_t lit_table_size; /**< size of literal table */
-  uint32_t is_run_global; /**< flag, indicating whether the snapshot
-                            *   was saved as 'Global scope'-mode code (true)
-                            *   or as eval-mode code (false) */
+  uint32_t number_of_funcs; /**< number of entry points */
+  /* The offsets of the entry points (uint32_t values) follow the header. */
 } jerry_snapshot_header_t;
 
+/**
+ * Flag of an entry point offset: the entry point is run as
+ * eval-mode code instead of 'Global scope'-mode code
+ */
+#define JERRY_SNAPSHOT_EVAL_CODE 0x1u
+
 /**
  * Jerry snapshot format version
  */
-#define JERRY_SNAPSHOT_VERSION (5u)
+#define JERRY_SNAPSHOT_VERSION (7u)
 
 #endif /* !JERRY_SNAPSHOT_H */
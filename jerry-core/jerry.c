@@ -25,6 +25,7 @@
 #include "ecma-eval.h"
 #include "ecma-function-object.h"
 #include "ecma-gc.h"
+#include "ecma-heap-dump.h"
 #include "ecma-helpers.h"
 #include "ecma-init-finalize.h"
 #include "ecma-lex-env.h"
@@ -33,10 +34,16 @@
 #include "ecma-objects-general.h"
 #include "jcontext.h"
 #include "jerry-api.h"
+#include "jerry-heap-image.h"
 #include "jerry-snapshot.h"
 #include "js-parser.h"
 #include "re-compiler.h"
 #include "vm.h"
+#include "vm-heap-profiler.h"
+#include "vm-opcode-stats.h"
+#include "vm-profiler.h"
+#include "vm-runtime-stats.h"
+#include "vm-trace.h"
 
 #define JERRY_INTERNAL
 #include "jerry-internal.h"
@@ -53,6 +60,24 @@ JERRY_STATIC_ASSERT ((int) ECMA_ERROR_COMMON == (int) JERRY_ERROR_COMMON
                      && (int) ECMA_ERROR_URI == (int) JERRY_ERROR_URI,
                      ecma_standard_error_t_must_be_equal_to_jerry_error_t);
 
+JERRY_STATIC_ASSERT ((int) JMEM_ALLOC_CATEGORY_OTHER == (int) JERRY_MEM_TYPE_OTHER
+                     && (int) JMEM_ALLOC_CATEGORY_OBJECT == (int) JERRY_MEM_TYPE_OBJECT
+                     && (int) JMEM_ALLOC_CATEGORY_EXTENDED_OBJECT == (int) JERRY_MEM_TYPE_EXTENDED_OBJECT
+                     && (int) JMEM_ALLOC_CATEGORY_LEXICAL_ENVIRONMENT == (int) JERRY_MEM_TYPE_LEXICAL_ENVIRONMENT
+                     && (int) JMEM_ALLOC_CATEGORY_STRING == (int) JERRY_MEM_TYPE_STRING
+                     && (int) JMEM_ALLOC_CATEGORY_EXTERNAL_STRING == (int) JERRY_MEM_TYPE_EXTERNAL_STRING
+                     && (int) JMEM_ALLOC_CATEGORY_UINT32_STRING == (int) JERRY_MEM_TYPE_UINT32_STRING
+                     && (int) JMEM_ALLOC_CATEGORY_MAGIC_STRING == (int) JERRY_MEM_TYPE_MAGIC_STRING
+                     && (int) JMEM_ALLOC_CATEGORY_NUMBER == (int) JERRY_MEM_TYPE_NUMBER
+                     && (int) JMEM_ALLOC_CATEGORY_PROPERTY_PAIR == (int) JERRY_MEM_TYPE_PROPERTY_PAIR
+                     && (int) JMEM_ALLOC_CATEGORY_HASHMAP == (int) JERRY_MEM_TYPE_PROPERTY_HASHMAP
+                     && (int) JMEM_ALLOC_CATEGORY_BYTE_CODE == (int) JERRY_MEM_TYPE_BYTE_CODE
+                     && (int) JMEM_ALLOC_CATEGORY_REGEXP_BYTE_CODE == (int) JERRY_MEM_TYPE_REGEXP_BYTE_CODE
+                     && (int) JMEM_ALLOC_CATEGORY_COLLECTION == (int) JERRY_MEM_TYPE_COLLECTION
+                     && (int) JMEM_ALLOC_CATEGORY_LITERAL_STORAGE == (int) JERRY_MEM_TYPE_LITERAL_STORAGE
+                     && (int) JMEM_ALLOC_CATEGORY__COUNT == (int) JERRY_MEM_TYPE__COUNT,
+                     jmem_alloc_category_t_must_be_equal_to_jerry_mem_type_t);
+
 #ifdef JERRY_ENABLE_ERROR_MESSAGES
 
 /**
@@ -129,17 +154,11 @@ jerry_create_type_error (void)
 } /* jerry_create_type_error */
 
 /**
- * Jerry engine initialization
+ * Initialize the context of the engine
  */
-void
-jerry_init (jerry_init_flag_t flags) /**< combination of Jerry flags */
+static void
+jerry_init_context (jerry_init_flag_t flags) /**< combination of Jerry flags */
 {
-  if (unlikely (JERRY_CONTEXT (jerry_api_available)))
-  {
-    /* This function cannot be called twice unless jerry_cleanup is called. */
-    JERRY_UNREACHABLE ();
-  }
-
   /* Zero out all members. */
   memset (&JERRY_CONTEXT (JERRY_CONTEXT_FIRST_MEMBER), 0, sizeof (jerry_context_t));
 
@@ -164,9 +183,50 @@ jerry_init (jerry_init_flag_t flags) /**< combination of Jerry flags */
 #endif /* !JMEM_STATS */
   }
 
+  if (flags & JERRY_INIT_OPCODE_STATS)
+  {
+#ifndef JERRY_VM_OPCODE_STATS
+    flags &= (jerry_init_flag_t) ~JERRY_INIT_OPCODE_STATS;
+
+    JERRY_WARNING_MSG ("Ignoring opcode statistics option because of '!JERRY_VM_OPCODE_STATS' build configuration.\n");
+#endif /* !JERRY_VM_OPCODE_STATS */
+  }
+
   JERRY_CONTEXT (jerry_init_flags) = flags;
 
+#ifdef JERRY_CPU_PROFILER
+  vm_profiler_init ();
+#endif /* JERRY_CPU_PROFILER */
+
+#ifdef JERRY_VM_OPCODE_STATS
+  vm_opcode_stats_init ();
+#endif /* JERRY_VM_OPCODE_STATS */
+
+#ifdef JERRY_HEAP_PROFILER
+  vm_heap_profiler_init ();
+  jmem_register_track_callbacks (vm_heap_profiler_alloc, vm_heap_profiler_free);
+#endif /* JERRY_HEAP_PROFILER */
+
+#ifdef JERRY_TRACE
+  vm_trace_init ();
+#endif /* JERRY_TRACE */
+
   jerry_make_api_available ();
+} /* jerry_init_context */
+
+/**
+ * Jerry engine initialization
+ */
+void
+jerry_init (jerry_init_flag_t flags) /**< combination of Jerry flags */
+{
+  if (unlikely (JERRY_CONTEXT (jerry_api_available)))
+  {
+    /* This function cannot be called twice unless jerry_cleanup is called. */
+    JERRY_UNREACHABLE ();
+  }
+
+  jerry_init_context (flags);
 
   jmem_init ();
   ecma_init ();
@@ -180,11 +240,426 @@ jerry_cleanup (void)
 {
   jerry_assert_api_available ();
 
+#ifdef JERRY_VM_OPCODE_STATS
+  if (JERRY_CONTEXT (jerry_init_flags) & JERRY_INIT_OPCODE_STATS)
+  {
+    vm_opcode_stats_print ();
+  }
+#endif /* JERRY_VM_OPCODE_STATS */
+
   jerry_make_api_unavailable ();
   ecma_finalize ();
   jmem_finalize ((JERRY_CONTEXT (jerry_init_flags) & JERRY_INIT_MEM_STATS) != 0);
 } /* jerry_cleanup */
 
+/**
+ * Reset the engine to the state after jerry_init: all objects, strings and byte code
+ * are discarded, and the global object and the built-ins become pristine again
+ *
+ * Note:
+ *      - JavaScript values received from the engine are inaccessible after the reset
+ *      - the registered external magic strings are kept
+ *      - the heap is re-initialized without freeing its content one by one, unless
+ *        there are native handles or external strings whose free callbacks must be called
+ *        (the callbacks of values which are not released by the host are not called)
+ *
+ * @return true - if the engine is reset,
+ *         false - if JavaScript code is running (the engine is not changed in this case)
+ */
+bool
+jerry_reset (jerry_init_flag_t flags) /**< combination of Jerry flags */
+{
+  jerry_assert_api_available ();
+
+  if (JERRY_CONTEXT (vm_top_context_p) != NULL)
+  {
+    return false;
+  }
+
+  const lit_utf8_byte_t **magic_string_ex_array = JERRY_CONTEXT (lit_magic_string_ex_array);
+  uint32_t magic_string_ex_count = JERRY_CONTEXT (lit_magic_string_ex_count);
+  const lit_utf8_size_t *magic_string_ex_sizes = JERRY_CONTEXT (lit_magic_string_ex_sizes);
+
+  if (JERRY_CONTEXT (ecma_free_callback_count) != 0)
+  {
+    /* The free callbacks are called by the finalization of the ECMA components. Values
+     * still held by the host are not freed, the re-initialization of the heap drops them. */
+    jerry_make_api_unavailable ();
+    ecma_finalize ();
+  }
+
+  jerry_init_context (flags);
+
+  jmem_init ();
+  ecma_init ();
+
+  JERRY_CONTEXT (lit_magic_string_ex_array) = magic_string_ex_array;
+  JERRY_CONTEXT (lit_magic_string_ex_count) = magic_string_ex_count;
+  JERRY_CONTEXT (lit_magic_string_ex_sizes) = magic_string_ex_sizes;
+
+  return true;
+} /* jerry_reset */
+
+/**
+ * Save the state of the engine (the heap with all objects, strings, literals and
+ * the global environment) into a heap image
+ *
+ * Note:
+ *      garbage collection is run and the compiled code cache is cleared before saving
+ *
+ * @return size of the heap image, if it was saved successfully
+ *         0 - otherwise (the buffer is too small or JavaScript code is running).
+ */
+size_t
+jerry_save_heap_image (uint8_t *buffer_p, /**< buffer for the heap image */
+                       size_t buffer_size) /**< the buffer's size */
+{
+  jerry_assert_api_available ();
+
+  if (JERRY_CONTEXT (vm_top_context_p) != NULL)
+  {
+    return 0;
+  }
+
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+  /* The compiled code cache is not stored. */
+  parser_code_cache_free ();
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
+  ecma_gc_run (JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW);
+
+  const size_t header_size = JERRY_ALIGNUP (sizeof (jerry_heap_image_header_t), JMEM_ALIGNMENT);
+  const size_t area_size = jmem_get_image_area_size ();
+
+  if (header_size + area_size > buffer_size)
+  {
+    return 0;
+  }
+
+  jerry_heap_image_header_t header;
+  memset (&header, 0, sizeof (header));
+
+  header.version = JERRY_HEAP_IMAGE_VERSION;
+  header.heap_size = (uint32_t) JMEM_HEAP_SIZE;
+  header.builtin_count = ECMA_BUILTIN_ID__COUNT;
+  header.magic_string_count = LIT_MAGIC_STRING__COUNT;
+
+  ecma_save_image (&header.ecma);
+  jmem_save_image (&header.jmem, buffer_p + header_size);
+
+  JERRY_ASSERT (header.jmem.area_size == area_size);
+
+  memcpy (buffer_p, &header, sizeof (header));
+  memset (buffer_p + sizeof (header), 0, header_size - sizeof (header));
+
+  return header_size + area_size;
+} /* jerry_save_heap_image */
+
+/**
+ * Initialize the engine from a heap image saved by jerry_save_heap_image
+ *
+ * Note:
+ *      this function is used instead of jerry_init, and the engine must be
+ *      terminated by jerry_cleanup as usual
+ *
+ * @return true - if the engine is initialized from the heap image,
+ *         false - if the heap image is invalid or it was saved by an incompatible engine
+ *                 (the engine is not initialized in this case)
+ */
+bool
+jerry_load_heap_image (jerry_init_flag_t flags, /**< combination of Jerry flags */
+                       const uint8_t *image_p, /**< heap image */
+                       size_t image_size) /**< size of the heap image */
+{
+  if (unlikely (JERRY_CONTEXT (jerry_api_available)))
+  {
+    /* This function cannot be called unless the engine is not initialized. */
+    JERRY_UNREACHABLE ();
+  }
+
+  const size_t header_size = JERRY_ALIGNUP (sizeof (jerry_heap_image_header_t), JMEM_ALIGNMENT);
+
+  if (image_size < header_size)
+  {
+    return false;
+  }
+
+  jerry_heap_image_header_t header;
+  memcpy (&header, image_p, sizeof (header));
+
+  if (header.version != JERRY_HEAP_IMAGE_VERSION
+      || header.heap_size != JMEM_HEAP_SIZE
+      || header.builtin_count != ECMA_BUILTIN_ID__COUNT
+      || header.magic_string_count != LIT_MAGIC_STRING__COUNT
+      || header.jmem.area_size > JMEM_HEAP_AREA_SIZE
+      || header.jmem.area_size > image_size - header_size)
+  {
+    return false;
+  }
+
+  jerry_init_context (flags);
+
+  if (!jmem_load_image (&header.jmem, image_p + header_size))
+  {
+    jerry_make_api_unavailable ();
+    return false;
+  }
+
+  ecma_load_image (&header.ecma);
+
+  return true;
+} /* jerry_load_heap_image */
+
+/**
+ * Start the sampling CPU profiler
+ *
+ * Note:
+ *      the samples are taken by jerry_profiler_sample, which is usually called
+ *      periodically by the host (e.g. from a timer signal handler)
+ *
+ * @return true - if the profiler is started,
+ *         false - if the engine is built without the CPU profiler (JERRY_CPU_PROFILER)
+ */
+bool
+jerry_profiler_start (void)
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_CPU_PROFILER
+  vm_profiler_start ();
+  return true;
+#else /* !JERRY_CPU_PROFILER */
+  return false;
+#endif /* JERRY_CPU_PROFILER */
+} /* jerry_profiler_start */
+
+/**
+ * Stop the sampling CPU profiler, the collected samples are kept until they are dumped
+ */
+void
+jerry_profiler_stop (void)
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_CPU_PROFILER
+  vm_profiler_stop ();
+#endif /* JERRY_CPU_PROFILER */
+} /* jerry_profiler_stop */
+
+/**
+ * Record the call stack of the running JavaScript code, if the profiler is started
+ *
+ * Note:
+ *      the function is async-signal-safe: it can be called from a signal handler
+ *      which interrupts the engine, but it must not be called from other threads
+ */
+void
+jerry_profiler_sample (void)
+{
+#ifdef JERRY_CPU_PROFILER
+  vm_profiler_sample ();
+#endif /* JERRY_CPU_PROFILER */
+} /* jerry_profiler_sample */
+
+/**
+ * Write the collected samples in collapsed stack format (one "frame;frame;frame count"
+ * line for each distinct call stack, starting from the outermost frame), and remove
+ * them from the sample buffer
+ *
+ * @return number of bytes written to the buffer (the output is not zero terminated)
+ *         0 - if the buffer is too small (the samples are kept), there are no samples, or
+ *             the engine is built without the CPU profiler (JERRY_CPU_PROFILER)
+ */
+size_t
+jerry_profiler_dump (jerry_char_t *buffer_p, /**< output buffer */
+                     size_t buffer_size) /**< size of the output buffer */
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_CPU_PROFILER
+  return vm_profiler_dump ((lit_utf8_byte_t *) buffer_p, buffer_size);
+#else /* !JERRY_CPU_PROFILER */
+  JERRY_UNUSED (buffer_p);
+  JERRY_UNUSED (buffer_size);
+  return 0;
+#endif /* JERRY_CPU_PROFILER */
+} /* jerry_profiler_dump */
+
+/**
+ * Print the opcode execution statistics: the executed opcodes ordered by their
+ * execution counts and the most frequent opcode pairs (the output is written by
+ * jerry_port_log with JERRY_LOG_LEVEL_DEBUG)
+ *
+ * Note:
+ *      the statistics are also printed by jerry_cleanup if the engine is
+ *      initialized with the JERRY_INIT_OPCODE_STATS flag
+ *
+ * @return true - if the statistics are printed,
+ *         false - if the engine is built without opcode statistics (JERRY_VM_OPCODE_STATS)
+ */
+bool
+jerry_opcode_stats_print (void)
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_VM_OPCODE_STATS
+  vm_opcode_stats_print ();
+  return true;
+#else /* !JERRY_VM_OPCODE_STATS */
+  return false;
+#endif /* JERRY_VM_OPCODE_STATS */
+} /* jerry_opcode_stats_print */
+
+/**
+ * Clear the opcode execution statistics
+ */
+void
+jerry_opcode_stats_reset (void)
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_VM_OPCODE_STATS
+  vm_opcode_stats_init ();
+#endif /* JERRY_VM_OPCODE_STATS */
+} /* jerry_opcode_stats_reset */
+
+/**
+ * Get the execution count of an opcode (e.g. "CBC_CALL"), or the number of times
+ * an opcode is immediately followed by another one
+ *
+ * @return number of executions
+ *         0 - if an opcode name is unknown, or the engine is built without
+ *             opcode statistics (JERRY_VM_OPCODE_STATS)
+ */
+uint64_t
+jerry_opcode_stats_get_count (const char *opcode_name_p, /**< name of the opcode */
+                              const char *next_opcode_name_p) /**< name of the next opcode, or NULL
+                                                               *   to get the count of a single opcode */
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_VM_OPCODE_STATS
+  return vm_opcode_stats_get_count (opcode_name_p, next_opcode_name_p);
+#else /* !JERRY_VM_OPCODE_STATS */
+  JERRY_UNUSED (opcode_name_p);
+  JERRY_UNUSED (next_opcode_name_p);
+  return 0;
+#endif /* JERRY_VM_OPCODE_STATS */
+} /* jerry_opcode_stats_get_count */
+
+/**
+ * Write the report of the heap profiler: one "live_bytes live_blocks allocated_bytes
+ * allocated_blocks category site" line for each allocation site sorted by the live
+ * bytes, followed by the timeline of the live bytes of each allocation category
+ *
+ * Note:
+ *      the blocks are attributed to the source line executed by the innermost
+ *      JavaScript frame when they are allocated, the collected data is kept
+ *
+ * @return number of bytes written to the buffer (the output is not zero terminated)
+ *         0 - if the buffer is too small, or the engine is built without the
+ *             heap profiler (JERRY_HEAP_PROFILER)
+ */
+size_t
+jerry_heap_profiler_dump (jerry_char_t *buffer_p, /**< output buffer */
+                          size_t buffer_size) /**< size of the output buffer */
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_HEAP_PROFILER
+  return vm_heap_profiler_dump ((lit_utf8_byte_t *) buffer_p, buffer_size);
+#else /* !JERRY_HEAP_PROFILER */
+  JERRY_UNUSED (buffer_p);
+  JERRY_UNUSED (buffer_size);
+  return 0;
+#endif /* JERRY_HEAP_PROFILER */
+} /* jerry_heap_profiler_dump */
+
+/**
+ * Discard the recorded events and start the timeline tracing: the garbage collections,
+ * the escalations of the allocator when it runs out of memory, the parser phases and
+ * the top-level jerry_run and jerry_call_function calls are recorded with timestamps
+ *
+ * Note:
+ *      the events are stored in a ring buffer, the oldest events are overwritten
+ *      when it is full (CONFIG_TRACE_BUFFER_SIZE)
+ *
+ * @return true - if the tracing is started,
+ *         false - if the engine is built without timeline tracing (JERRY_TRACE)
+ */
+bool
+jerry_trace_start (void)
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_TRACE
+  vm_trace_start ();
+  return true;
+#else /* !JERRY_TRACE */
+  return false;
+#endif /* JERRY_TRACE */
+} /* jerry_trace_start */
+
+/**
+ * Stop the timeline tracing, the recorded events are kept until the tracing is started again
+ */
+void
+jerry_trace_stop (void)
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_TRACE
+  vm_trace_stop ();
+#endif /* JERRY_TRACE */
+} /* jerry_trace_stop */
+
+/**
+ * Write the recorded events in the JSON trace event format of Chrome, which can be
+ * loaded by chrome://tracing or Perfetto (the timestamps are in microseconds since
+ * the tracing is started)
+ *
+ * @return number of bytes written to the buffer (the output is not zero terminated)
+ *         0 - if the buffer is too small, or the engine is built without
+ *             timeline tracing (JERRY_TRACE)
+ */
+size_t
+jerry_trace_dump (jerry_char_t *buffer_p, /**< output buffer */
+                  size_t buffer_size) /**< size of the output buffer */
+{
+  jerry_assert_api_available ();
+
+#ifdef JERRY_TRACE
+  return vm_trace_dump ((lit_utf8_byte_t *) buffer_p, buffer_size);
+#else /* !JERRY_TRACE */
+  JERRY_UNUSED (buffer_p);
+  JERRY_UNUSED (buffer_size);
+  return 0;
+#endif /* JERRY_TRACE */
+} /* jerry_trace_dump */
+
+/**
+ * Write the graph of the objects on the heap to the callback in chunks: a
+ * "# jerry-heap-dump 1" header followed by an "O <id> <type> <self_size> <ref_count>"
+ * line for each object and lexical environment, and an "E <from_id> <to_id> <kind> [<name>]"
+ * or "S <from_id> <string_id> <string_size> <kind> [<name>]" line for each of their
+ * references to objects and strings
+ *
+ * Note:
+ *      the objects whose reference counter is greater than zero are the roots of the
+ *      garbage collector, tools/heap-dominators.py computes the retained sizes from the dump;
+ *      the callback must not call any API function
+ */
+void
+jerry_heap_dump (jerry_heap_dump_callback_t callback_p, /**< output callback */
+                 void *user_data_p) /**< user data for the output callback */
+{
+  jerry_assert_api_available ();
+
+  JERRY_ASSERT (callback_p != NULL);
+
+  ecma_heap_dump (callback_p, user_data_p);
+} /* jerry_heap_dump */
+
 /**
  * Register external magic string array
  */
@@ -222,6 +697,80 @@ jerry_gc (void)
   ecma_gc_run (JMEM_FREE_UNUSED_MEMORY_SEVERITY_LOW);
 } /* jerry_gc */
 
+/**
+ * Get the statistics of the compiled code cache, which stores the byte code
+ * of the recently compiled short sources passed to jerry_parse and eval.
+ *
+ * Note:
+ *      all counters are zero if the cache is disabled
+ */
+void
+jerry_get_code_cache_stats (jerry_code_cache_stats_t *out_stats_p) /**< [out] cache statistics */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+  *out_stats_p = JERRY_CONTEXT (parser_code_cache_stats);
+#else /* CONFIG_PARSER_CODE_CACHE_DISABLE */
+  memset (out_stats_p, 0, sizeof (jerry_code_cache_stats_t));
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+} /* jerry_get_code_cache_stats */
+
+/**
+ * Get the runtime statistics: the time spent in the parser, the virtual machine, the
+ * garbage collector and native functions, the heap usage, the number of objects and
+ * strings, and the hits and misses of the property lookup cache.
+ *
+ * Note:
+ *      the statistics are collected since jerry_init (or the last jerry_reset), the times,
+ *      the counters and the lookup cache statistics are zero if the engine is built
+ *      without the runtime statistics (JERRY_RUNTIME_STATS)
+ */
+void
+jerry_get_runtime_stats (jerry_runtime_stats_t *out_stats_p) /**< [out] runtime statistics */
+{
+  jerry_assert_api_available ();
+
+  vm_runtime_stats_get (out_stats_p);
+} /* jerry_get_runtime_stats */
+
+/**
+ * Get the memory usage statistics of a memory type
+ *
+ * Note:
+ *      blocks loaded from a heap image are not counted
+ *
+ * @return true - if the statistics are available,
+ *         false - if the engine is built without memory statistics (JMEM_STATS)
+ *                 or the memory type is invalid
+ */
+bool
+jerry_get_mem_type_stats (jerry_mem_type_t type, /**< memory type */
+                          jerry_mem_type_stats_t *out_stats_p) /**< [out] memory usage statistics */
+{
+  jerry_assert_api_available ();
+
+#ifdef JMEM_STATS
+  if ((uint32_t) type >= JERRY_MEM_TYPE__COUNT)
+  {
+    return false;
+  }
+
+  jmem_alloc_category_stats_t stats;
+  jmem_get_alloc_category_stats ((jmem_alloc_category_t) type, &stats);
+
+  out_stats_p->allocated_bytes = stats.allocated_bytes;
+  out_stats_p->allocated_blocks = stats.allocated_blocks;
+  out_stats_p->peak_allocated_bytes = stats.peak_allocated_bytes;
+  out_stats_p->alloc_count = stats.alloc_count;
+  return true;
+#else /* !JMEM_STATS */
+  JERRY_UNUSED (type);
+  JERRY_UNUSED (out_stats_p);
+  return false;
+#endif /* JMEM_STATS */
+} /* jerry_get_mem_type_stats */
+
 /**
  * Simple Jerry runner
  *
@@ -261,6 +810,10 @@ jerry_run_simple (const jerry_char_t *script_source, /**< script source */
  * Parse script and construct an EcmaScript function. The lexical
  * environment is set to the global lexical environment.
  *
+ * Note:
+ *      when the engine is initialized with JERRY_INIT_LAZY_FUNCTIONS,
+ *      the source must be kept until jerry_cleanup is called
+ *
  * @return function object value - if script was parsed successfully,
  *         thrown error - otherwise
  */
@@ -276,9 +829,12 @@ jerry_parse (const jerry_char_t *source_p, /**< script source */
   ecma_compiled_code_t *bytecode_data_p;
   ecma_value_t parse_status;
 
+  bool is_lazy = (JERRY_CONTEXT (jerry_init_flags) & JERRY_INIT_LAZY_FUNCTIONS) != 0;
+
   parse_status = parser_parse_script (source_p,
                                       source_size,
                                       is_strict,
+                                      is_lazy,
                                       &bytecode_data_p);
 
   if (ECMA_IS_VALUE_ERROR (parse_status))
@@ -347,7 +903,11 @@ jerry_run (const jerry_value_t func_val) /**< function to run */
   bytecode_data_p = ECMA_GET_INTERNAL_VALUE_POINTER (const ecma_compiled_code_t,
                                                      ext_func_p->u.function.bytecode_cp);
 
-  return vm_run_global (bytecode_data_p);
+  VM_TRACE_BEGIN_TOP_LEVEL ();
+  ecma_value_t ret_value = vm_run_global (bytecode_data_p);
+  VM_TRACE_END (VM_TRACE_EVENT_RUN, 0, 0, 0);
+
+  return ret_value;
 } /* jerry_run */
 
 /**
@@ -856,24 +1416,72 @@ jerry_create_null (void)
 {
   jerry_assert_api_available ();
 
-  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_NULL);
-} /* jerry_create_null */
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_NULL);
+} /* jerry_create_null */
+
+/**
+ * Create new JavaScript object, like with new Object().
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return value of the created object
+ */
+jerry_value_t
+jerry_create_object (void)
+{
+  jerry_assert_api_available ();
+
+  return ecma_make_object_value (ecma_op_create_object_object_noarg ());
+} /* jerry_create_object */
 
 /**
- * Create new JavaScript object, like with new Object().
+ * Create an object with the given data properties.
  *
  * Note:
+ *      the properties are created as if the object was defined by an
+ *      object literal: they are writable, enumerable and configurable,
+ *      and a later duplicate name overwrites the earlier value.
  *      returned value must be freed with jerry_release_value, when it is no longer needed.
  *
- * @return value of the created object
+ * @return value of the created object - if success
+ *         value marked with error flag - otherwise
  */
 jerry_value_t
-jerry_create_object (void)
+jerry_create_object_with_properties (const jerry_value_t prop_names_p[], /**< property names (string values) */
+                                     const jerry_value_t values_p[], /**< property values */
+                                     uint32_t count) /**< number of properties */
 {
   jerry_assert_api_available ();
 
-  return ecma_make_object_value (ecma_op_create_object_object_noarg ());
-} /* jerry_create_object */
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (!ecma_is_value_string (prop_names_p[i])
+        || ECMA_IS_VALUE_ERROR (values_p[i]))
+    {
+      return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+    }
+  }
+
+  ecma_object_t *object_p = ecma_op_create_object_object_noarg ();
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    ecma_string_t *prop_name_p = ecma_get_string_from_value (prop_names_p[i]);
+    ecma_property_t *property_p = ecma_find_named_property (object_p, prop_name_p);
+
+    if (property_p == NULL)
+    {
+      property_p = ecma_create_named_data_property (object_p,
+                                                    prop_name_p,
+                                                    ECMA_PROPERTY_CONFIGURABLE_ENUMERABLE_WRITABLE);
+    }
+
+    ecma_named_data_property_assign_value (object_p, property_p, values_p[i]);
+  }
+
+  return ecma_make_object_value (object_p);
+} /* jerry_create_object_with_properties */
 
 /**
  * Create string from a valid CESU8 string
@@ -908,6 +1516,30 @@ jerry_create_string_sz (const jerry_char_t *str_p, /**< pointer to string */
   return ecma_make_string_value (ecma_str_p);
 } /* jerry_create_string_sz */
 
+/**
+ * Create string from a valid CESU8 string without copying it
+ *
+ * Note:
+ *      the buffer must stay valid and unchanged until free_cb is called, which happens
+ *      when the string is freed (possibly before this function returns)
+ *      returned value must be freed with jerry_release_value when it is no longer needed.
+ *
+ * @return value of the created string
+ */
+jerry_value_t
+jerry_create_external_string (const jerry_char_t *str_p, /**< pointer to string */
+                              jerry_size_t str_size, /**< string size */
+                              jerry_external_string_free_callback_t free_cb) /**< free callback of the
+                                                                              *   string buffer or NULL */
+{
+  jerry_assert_api_available ();
+
+  ecma_string_t *ecma_str_p = ecma_new_ecma_external_string ((const lit_utf8_byte_t *) str_p,
+                                                             (lit_utf8_size_t) str_size,
+                                                             (ecma_external_pointer_t) free_cb);
+  return ecma_make_string_value (ecma_str_p);
+} /* jerry_create_external_string */
+
 /**
  * Creates a jerry_value_t representing an undefined value.
  *
@@ -1028,6 +1660,48 @@ jerry_string_to_char_buffer (const jerry_value_t value, /**< input string value
                                           buffer_size);
 } /* jerry_string_to_char_buffer */
 
+/**
+ * Get the characters of a string without copying them.
+ *
+ * Note:
+ *      The returned buffer is not zero terminated and it is valid until the
+ *      string value is released. Strings which have no contiguous character
+ *      storage (e.g. strings of array indices) have no view: their characters
+ *      can be copied with jerry_string_to_char_buffer, and they are never
+ *      longer than 10 bytes.
+ *
+ * @return true  - if the view of the string is returned in buffer_p and size_p
+ *         false - if the value is not a string or the string has no view
+ */
+bool
+jerry_get_string_view (const jerry_value_t value, /**< input string value */
+                       const jerry_char_t **buffer_p, /**< [out] start of the characters */
+                       jerry_size_t *size_p) /**< [out] size of the string in bytes */
+{
+  jerry_assert_api_available ();
+
+  *buffer_p = NULL;
+  *size_p = 0;
+
+  if (!ecma_is_value_string (value))
+  {
+    return false;
+  }
+
+  lit_utf8_size_t size;
+  bool is_ascii;
+  const lit_utf8_byte_t *chars_p = ecma_string_raw_chars (ecma_get_string_from_value (value), &size, &is_ascii);
+
+  if (chars_p == NULL)
+  {
+    return false;
+  }
+
+  *buffer_p = (const jerry_char_t *) chars_p;
+  *size_p = (jerry_size_t) size;
+  return true;
+} /* jerry_get_string_view */
+
 /**
  * Checks whether the object or it's prototype objects have the given property.
  *
@@ -1153,6 +1827,67 @@ jerry_get_property_by_index (const jerry_value_t obj_val, /**< object value */
   return ret_value;
 } /* jerry_get_property_by_index */
 
+/**
+ * Get the values of multiple properties of the specified object.
+ *
+ * Note:
+ *      on success the values stored in values_p must be freed with jerry_release_value,
+ *      when they are no longer needed. On error all items of values_p are undefined.
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return true value - if the operation was successful
+ *         value marked with error flag - otherwise
+ */
+jerry_value_t
+jerry_get_properties (const jerry_value_t obj_val, /**< object value */
+                      const jerry_value_t prop_names_p[], /**< property names (string values) */
+                      jerry_value_t values_p[], /**< [out] property values */
+                      uint32_t count) /**< number of properties */
+{
+  jerry_assert_api_available ();
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    values_p[i] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+  }
+
+  if (!ecma_is_value_object (obj_val))
+  {
+    return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+  }
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (!ecma_is_value_string (prop_names_p[i]))
+    {
+      return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+    }
+  }
+
+  ecma_object_t *object_p = ecma_get_object_from_value (obj_val);
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    ecma_value_t value = ecma_op_object_get (object_p, ecma_get_string_from_value (prop_names_p[i]));
+
+    if (ECMA_IS_VALUE_ERROR (value))
+    {
+      while (i > 0)
+      {
+        i--;
+        ecma_free_value (values_p[i]);
+        values_p[i] = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+      }
+
+      return value;
+    }
+
+    values_p[i] = value;
+  }
+
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+} /* jerry_get_properties */
+
 /**
  * Set a property to the specified object with the given name.
  *
@@ -1214,6 +1949,59 @@ jerry_set_property_by_index (const jerry_value_t obj_val, /**< object value */
   return ret_value;
 } /* jerry_set_property_by_index */
 
+/**
+ * Set multiple properties of the specified object.
+ *
+ * Note:
+ *      the properties are set in order and the operation stops at the first
+ *      failure, so the properties before the failing one remain set.
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return true value - if the operation was successful
+ *         value marked with error flag - otherwise
+ */
+jerry_value_t
+jerry_set_properties (const jerry_value_t obj_val, /**< object value */
+                      const jerry_value_t prop_names_p[], /**< property names (string values) */
+                      const jerry_value_t values_p[], /**< values to set */
+                      uint32_t count) /**< number of properties */
+{
+  jerry_assert_api_available ();
+
+  if (!ecma_is_value_object (obj_val))
+  {
+    return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+  }
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (!ecma_is_value_string (prop_names_p[i])
+        || ECMA_IS_VALUE_ERROR (values_p[i]))
+    {
+      return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+    }
+  }
+
+  ecma_object_t *object_p = ecma_get_object_from_value (obj_val);
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    ecma_value_t ret_value = ecma_op_object_put (object_p,
+                                                 ecma_get_string_from_value (prop_names_p[i]),
+                                                 values_p[i],
+                                                 true);
+
+    if (ECMA_IS_VALUE_ERROR (ret_value))
+    {
+      return ret_value;
+    }
+
+    ecma_free_value (ret_value);
+  }
+
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+} /* jerry_set_properties */
+
 /**
  * Initialize property descriptor.
  */
@@ -1505,7 +2293,11 @@ jerry_call_function (const jerry_value_t func_obj_val, /**< function object to c
 
   if (jerry_value_is_function (func_obj_val))
   {
-    return jerry_invoke_function (false, func_obj_val, this_val, args_p, args_count);
+    VM_TRACE_BEGIN_TOP_LEVEL ();
+    jerry_value_t ret_value = jerry_invoke_function (false, func_obj_val, this_val, args_p, args_count);
+    VM_TRACE_END (VM_TRACE_EVENT_CALL, 0, 0, 0);
+
+    return ret_value;
   }
 
   return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
@@ -1736,48 +2528,279 @@ jerry_foreach_object_property (const jerry_value_t obj_val, /**< object value */
   return false;
 } /* jerry_foreach_object_property */
 
-#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+/**
+ * Parse a JSON text, like JSON.parse does, directly from the buffer
+ * without creating a string value for the text.
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return parsed value - if the text is a valid JSON text
+ *         value marked with error flag - otherwise
+ */
+jerry_value_t
+jerry_json_parse (const jerry_char_t *source_p, /**< JSON text, it must be a valid CESU8 string */
+                  jerry_size_t source_size) /**< size of the JSON text */
+{
+  jerry_assert_api_available ();
+
+#ifndef CONFIG_DISABLE_JSON_BUILTIN
+  return ecma_builtin_json_parse_buffer ((const lit_utf8_byte_t *) source_p, (lit_utf8_size_t) source_size);
+#else /* CONFIG_DISABLE_JSON_BUILTIN */
+  JERRY_UNUSED (source_p);
+  JERRY_UNUSED (source_size);
+
+  return ecma_raise_type_error (ECMA_ERR_MSG ("JSON built-in is disabled."));
+#endif /* !CONFIG_DISABLE_JSON_BUILTIN */
+} /* jerry_json_parse */
+
+/**
+ * Serialize a value into JSON text, like JSON.stringify does, and pass the text
+ * to the callback in chunks instead of creating a string value.
+ *
+ * Note:
+ *      the chunks are only valid during the callback, and the callback
+ *      must not call any API function;
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return true value - if the JSON text is passed to the callback
+ *         undefined value - if the value has no JSON representation
+ *         value marked with error flag - otherwise
+ */
+jerry_value_t
+jerry_json_stringify (const jerry_value_t value, /**< value to serialize */
+                      jerry_json_output_callback_t callback_p, /**< output callback */
+                      void *user_data_p) /**< user data for the output callback */
+{
+  jerry_assert_api_available ();
+
+  if (ECMA_IS_VALUE_ERROR (value)
+      || callback_p == NULL)
+  {
+    return ecma_raise_type_error (ECMA_ERR_MSG (wrong_args_msg_p));
+  }
+
+#ifndef CONFIG_DISABLE_JSON_BUILTIN
+  ecma_json_writer_t writer;
+  ecma_builtin_helper_json_writer_init (&writer, callback_p, user_data_p);
+
+  ecma_value_t undefined_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+  ecma_value_t ret_value = ecma_builtin_json_serialize (value, undefined_value, undefined_value, &writer);
+
+  if (ecma_is_value_true (ret_value))
+  {
+    return ecma_builtin_helper_json_writer_finalize (&writer);
+  }
+
+  ecma_builtin_helper_json_writer_free (&writer);
+  return ret_value;
+#else /* CONFIG_DISABLE_JSON_BUILTIN */
+  JERRY_UNUSED (user_data_p);
+
+  return ecma_raise_type_error (ECMA_ERR_MSG ("JSON built-in is disabled."));
+#endif /* !CONFIG_DISABLE_JSON_BUILTIN */
+} /* jerry_json_stringify */
+
+#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+
+/**
+ * Variables required to take a snapshot.
+ */
+typedef struct
+{
+  bool snapshot_error_occured;
+  size_t snapshot_buffer_write_offset;
+  size_t snapshot_code_start_offset; /**< offset of the first byte code block */
+  uint16_t *block_hash_p; /**< open addressing hash table of the saved byte code blocks
+                           *   (block offsets shifted by JMEM_ALIGNMENT_LOG, 0 marks free slots) */
+  uint32_t block_hash_size; /**< number of slots of the hash table (power of 2) */
+  uint32_t block_count; /**< number of blocks stored in the hash table */
+} snapshot_globals_t;
+
+/**
+ * Initial number of slots of the byte code block hash table (power of 2)
+ */
+#define SNAPSHOT_BLOCK_HASH_INITIAL_SIZE 64
+
+/**
+ * Maximum number of slots of the byte code block hash table
+ */
+#define SNAPSHOT_BLOCK_HASH_MAX_SIZE (1u << (sizeof (lit_string_hash_t) * JERRY_BITSINBYTE))
+
+/**
+ * Write data into the specified buffer.
+ *
+ * Note:
+ *      Offset is in-out and is incremented if the write operation completes successfully.
+ *
+ * @return true, if write was successful, i.e. offset + data_size doesn't exceed buffer size,
+ *         false - otherwise.
+ */
+static inline bool __attr_always_inline___
+snapshot_write_to_buffer_by_offset (uint8_t *buffer_p, /**< buffer */
+                                    size_t buffer_size, /**< size of buffer */
+                                    size_t *in_out_buffer_offset_p,  /**< [in,out] offset to write to
+                                                                      * incremented with data_size */
+                                    const void *data_p, /**< data */
+                                    size_t data_size) /**< size of the writable data */
+{
+  if (*in_out_buffer_offset_p + data_size > buffer_size)
+  {
+    return false;
+  }
+
+  memcpy (buffer_p + *in_out_buffer_offset_p, data_p, data_size);
+  *in_out_buffer_offset_p += data_size;
+
+  return true;
+} /* snapshot_write_to_buffer_by_offset */
+
+/**
+ * Calculate the hash of a saved byte code block.
+ *
+ * @return hash of the block
+ */
+static lit_string_hash_t
+snapshot_block_hash (const uint8_t *snapshot_buffer_p, /**< snapshot buffer */
+                     size_t block_offset) /**< offset of the block */
+{
+  const ecma_compiled_code_t *block_p = (const ecma_compiled_code_t *) (snapshot_buffer_p + block_offset);
+  size_t block_size = ((size_t) block_p->size) << JMEM_ALIGNMENT_LOG;
+
+  return lit_utf8_string_calc_hash ((const lit_utf8_byte_t *) block_p, (lit_utf8_size_t) block_size);
+} /* snapshot_block_hash */
+
+/**
+ * Insert a saved byte code block into the block hash table, which has at least one free slot.
+ */
+static void
+snapshot_block_hash_insert (const snapshot_globals_t *globals_p, /**< snapshot globals */
+                            lit_string_hash_t hash, /**< hash of the block */
+                            size_t block_offset) /**< offset of the block */
+{
+  uint32_t mask = globals_p->block_hash_size - 1;
+  uint32_t index = hash & mask;
+
+  while (globals_p->block_hash_p[index] != 0)
+  {
+    index = (index + 1) & mask;
+  }
+
+  globals_p->block_hash_p[index] = (uint16_t) (block_offset >> JMEM_ALIGNMENT_LOG);
+} /* snapshot_block_hash_insert */
+
+/**
+ * Double the size of the block hash table (or allocate it if it does not exist yet).
+ *
+ * Note:
+ *      the table is kept if the allocation fails, and the new blocks are not deduplicated
+ *      once it is half full, since deduplication is only a size optimization
+ *
+ * @return true - if the table is resized,
+ *         false - otherwise
+ */
+static bool
+snapshot_block_hash_grow (const uint8_t *snapshot_buffer_p, /**< snapshot buffer */
+                          snapshot_globals_t *globals_p) /**< [in,out] snapshot globals */
+{
+  uint32_t old_size = globals_p->block_hash_size;
+  uint32_t new_size = (old_size == 0) ? SNAPSHOT_BLOCK_HASH_INITIAL_SIZE : (old_size << 1);
+
+  if (new_size > SNAPSHOT_BLOCK_HASH_MAX_SIZE)
+  {
+    return false;
+  }
+
+  uint16_t *new_hash_p = (uint16_t *) jmem_heap_alloc_block_null_on_error (new_size * sizeof (uint16_t));
+
+  if (new_hash_p == NULL)
+  {
+    return false;
+  }
+
+  memset (new_hash_p, 0, new_size * sizeof (uint16_t));
+
+  uint16_t *old_hash_p = globals_p->block_hash_p;
+  globals_p->block_hash_p = new_hash_p;
+  globals_p->block_hash_size = new_size;
+
+  for (uint32_t i = 0; i < old_size; i++)
+  {
+    if (old_hash_p[i] != 0)
+    {
+      size_t block_offset = ((size_t) old_hash_p[i]) << JMEM_ALIGNMENT_LOG;
+      snapshot_block_hash_insert (globals_p, snapshot_block_hash (snapshot_buffer_p, block_offset), block_offset);
+    }
+  }
+
+  if (old_hash_p != NULL)
+  {
+    jmem_heap_free_block (old_hash_p, old_size * sizeof (uint16_t));
+  }
 
-/**
- * Variables required to take a snapshot.
- */
-typedef struct
-{
-  bool snapshot_error_occured;
-  size_t snapshot_buffer_write_offset;
-} snapshot_globals_t;
+  return true;
+} /* snapshot_block_hash_grow */
 
 /**
- * Write data into the specified buffer.
+ * Search a byte code block, which was saved before, with the same content as the last saved block.
+ * The last saved block is added to the block hash table if no identical block is found.
  *
  * Note:
- *      Offset is in-out and is incremented if the write operation completes successfully.
+ *      byte code blocks referenced by the last saved block are already deduplicated, so two
+ *      identical functions are stored as identical blocks with identical literal references.
+ *      Hence a block can only be identical to an earlier one if all of its sub-functions were
+ *      deduplicated, so the blocks in the table are never discarded.
  *
- * @return true, if write was successful, i.e. offset + data_size doesn't exceed buffer size,
- *         false - otherwise.
+ * @return offset of the identical block - if found
+ *         offset of the last saved block - otherwise
  */
-static inline bool __attr_always_inline___
-snapshot_write_to_buffer_by_offset (uint8_t *buffer_p, /**< buffer */
-                                    size_t buffer_size, /**< size of buffer */
-                                    size_t *in_out_buffer_offset_p,  /**< [in,out] offset to write to
-                                                                      * incremented with data_size */
-                                    const void *data_p, /**< data */
-                                    size_t data_size) /**< size of the writable data */
+static size_t
+snapshot_find_identical_block (const uint8_t *snapshot_buffer_p, /**< snapshot buffer */
+                               size_t block_offset, /**< offset of the last saved block */
+                               snapshot_globals_t *globals_p) /**< [in,out] snapshot globals */
 {
-  if (*in_out_buffer_offset_p + data_size > buffer_size)
+  const ecma_compiled_code_t *block_p = (const ecma_compiled_code_t *) (snapshot_buffer_p + block_offset);
+  size_t block_size = ((size_t) block_p->size) << JMEM_ALIGNMENT_LOG;
+  lit_string_hash_t hash = snapshot_block_hash (snapshot_buffer_p, block_offset);
+
+  if (globals_p->block_hash_size > 0)
   {
-    return false;
+    uint32_t mask = globals_p->block_hash_size - 1;
+    uint32_t index = hash & mask;
+
+    while (globals_p->block_hash_p[index] != 0)
+    {
+      size_t offset = ((size_t) globals_p->block_hash_p[index]) << JMEM_ALIGNMENT_LOG;
+      const ecma_compiled_code_t *current_p = (const ecma_compiled_code_t *) (snapshot_buffer_p + offset);
+
+      if (current_p->size == block_p->size
+          && memcmp (current_p, block_p, block_size) == 0)
+      {
+        return offset;
+      }
+
+      index = (index + 1) & mask;
+    }
   }
 
-  memcpy (buffer_p + *in_out_buffer_offset_p, data_p, data_size);
-  *in_out_buffer_offset_p += data_size;
+  if ((globals_p->block_count + 1) * 2 > globals_p->block_hash_size
+      && !snapshot_block_hash_grow (snapshot_buffer_p, globals_p))
+  {
+    return block_offset;
+  }
 
-  return true;
-} /* snapshot_write_to_buffer_by_offset */
+  snapshot_block_hash_insert (globals_p, hash, block_offset);
+  globals_p->block_count++;
+
+  return block_offset;
+} /* snapshot_find_identical_block */
 
 /**
  * Snapshot callback for byte codes.
  *
+ * Note:
+ *      identical byte code blocks are stored only once
+ *
  * @return start offset
  */
 static uint16_t
@@ -1848,31 +2871,78 @@ snapshot_add_compiled_code (ecma_compiled_code_t *compiled_code_p, /**< compiled
 
     copied_code_p->status_flags = compiled_code_p->status_flags;
 
+    if (!globals_p->snapshot_error_occured)
+    {
+      size_t block_offset = ((size_t) start_offset) << JMEM_ALIGNMENT_LOG;
+      size_t identical_offset = snapshot_find_identical_block (snapshot_buffer_p, block_offset, globals_p);
+
+      if (identical_offset != block_offset)
+      {
+        globals_p->snapshot_buffer_write_offset = block_offset;
+        start_offset = (uint16_t) (identical_offset >> JMEM_ALIGNMENT_LOG);
+      }
+    }
+
 #else /* CONFIG_DISABLE_REGEXP_BUILTIN */
     JERRY_UNREACHABLE (); /* RegExp is not supported in the selected profile. */
 #endif /* !CONFIG_DISABLE_REGEXP_BUILTIN */
     return start_offset;
   }
 
+  /* The optimized copy is stored instead of the byte code, but self
+   * references are still recognized by the original byte code. */
+  ecma_compiled_code_t *saved_code_p = NULL;
+
+  if (JERRY_CONTEXT (jerry_init_flags) & JERRY_INIT_OPTIMIZE_SNAPSHOT)
+  {
+    saved_code_p = parser_optimize_byte_code (compiled_code_p);
+  }
+
+  ecma_compiled_code_t *optimized_code_p = saved_code_p;
+
+  if (saved_code_p == NULL)
+  {
+    saved_code_p = compiled_code_p;
+  }
+
+  size_t saved_size = ((size_t) saved_code_p->size) << JMEM_ALIGNMENT_LOG;
+
+  if (saved_code_p->status_flags & CBC_CODE_FLAGS_HAS_LINE_INFO)
+  {
+    /* The line info refers to the function name in the heap, so it is not saved. */
+    saved_size -= CBC_GET_LINE_INFO (saved_code_p)->size;
+  }
+
   if (!snapshot_write_to_buffer_by_offset (snapshot_buffer_p,
                                            snapshot_buffer_size,
                                            &globals_p->snapshot_buffer_write_offset,
-                                           compiled_code_p,
-                                           ((size_t) compiled_code_p->size) << JMEM_ALIGNMENT_LOG))
+                                           saved_code_p,
+                                           saved_size))
   {
     globals_p->snapshot_error_occured = true;
+
+    if (optimized_code_p != NULL)
+    {
+      jmem_heap_free_block (optimized_code_p, ((size_t) optimized_code_p->size) << JMEM_ALIGNMENT_LOG);
+    }
     return 0;
   }
 
+  /* The reference counter is zero while the sub-functions are stored, so
+   * the block cannot be identical to any of them. */
+  copied_code_p->refs = 0;
+  copied_code_p->size = (uint16_t) (saved_size >> JMEM_ALIGNMENT_LOG);
+  copied_code_p->status_flags &= (uint16_t) ~CBC_CODE_FLAGS_HAS_LINE_INFO;
+
   /* Sub-functions and regular expressions are stored recursively. */
-  uint8_t *src_buffer_p = (uint8_t *) compiled_code_p;
+  uint8_t *src_buffer_p = (uint8_t *) saved_code_p;
   uint8_t *dst_buffer_p = (uint8_t *) copied_code_p;
   jmem_cpointer_t *src_literal_start_p;
   jmem_cpointer_t *dst_literal_start_p;
   uint32_t const_literal_end;
   uint32_t literal_end;
 
-  if (compiled_code_p->status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
+  if (saved_code_p->status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
   {
     src_literal_start_p = (jmem_cpointer_t *) (src_buffer_p + sizeof (cbc_uint16_arguments_t));
     dst_literal_start_p = (jmem_cpointer_t *) (dst_buffer_p + sizeof (cbc_uint16_arguments_t));
@@ -1909,6 +2979,29 @@ snapshot_add_compiled_code (ecma_compiled_code_t *compiled_code_p, /**< compiled
     }
   }
 
+  copied_code_p->refs = 1;
+
+  if (optimized_code_p != NULL)
+  {
+    /* The literals of the optimized copy are not referenced. */
+    jmem_heap_free_block (optimized_code_p, ((size_t) optimized_code_p->size) << JMEM_ALIGNMENT_LOG);
+  }
+
+  if (globals_p->snapshot_error_occured)
+  {
+    return 0;
+  }
+
+  /* The sub-functions stored after an identical block are not referenced by anything else. */
+  size_t block_offset = ((size_t) start_offset) << JMEM_ALIGNMENT_LOG;
+  size_t identical_offset = snapshot_find_identical_block (snapshot_buffer_p, block_offset, globals_p);
+
+  if (identical_offset != block_offset)
+  {
+    globals_p->snapshot_buffer_write_offset = block_offset;
+    start_offset = (uint16_t) (identical_offset >> JMEM_ALIGNMENT_LOG);
+  }
+
   return start_offset;
 } /* snapshot_add_compiled_code */
 
@@ -2006,46 +3099,120 @@ jerry_snapshot_set_offsets (uint8_t *buffer_p, /**< buffer */
   while (size > 0);
 } /* jerry_snapshot_set_offsets */
 
-#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
+/**
+ * Mark the literals referenced by the byte code blocks of a snapshot
+ * (the same literals which are mapped by jerry_snapshot_set_offsets).
+ */
+static void
+jerry_snapshot_mark_used_literals (const uint8_t *buffer_p, /**< buffer */
+                                   uint32_t size, /**< buffer size */
+                                   uint8_t *used_literals_p) /**< [out] bitmap of the used literals */
+{
+  JERRY_ASSERT (size > 0);
+
+  do
+  {
+    const ecma_compiled_code_t *bytecode_p = (const ecma_compiled_code_t *) buffer_p;
+    uint32_t code_size = ((uint32_t) bytecode_p->size) << JMEM_ALIGNMENT_LOG;
+
+    if (bytecode_p->status_flags & CBC_CODE_FLAGS_FUNCTION)
+    {
+      const jmem_cpointer_t *literal_start_p;
+      uint32_t argument_end;
+      uint32_t register_end;
+      uint32_t const_literal_end;
+
+      if (bytecode_p->status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
+      {
+        literal_start_p = (const jmem_cpointer_t *) (buffer_p + sizeof (cbc_uint16_arguments_t));
+
+        const cbc_uint16_arguments_t *args_p = (const cbc_uint16_arguments_t *) buffer_p;
+        argument_end = args_p->argument_end;
+        register_end = args_p->register_end;
+        const_literal_end = args_p->const_literal_end;
+      }
+      else
+      {
+        literal_start_p = (const jmem_cpointer_t *) (buffer_p + sizeof (cbc_uint8_arguments_t));
+
+        const cbc_uint8_arguments_t *args_p = (const cbc_uint8_arguments_t *) buffer_p;
+        argument_end = args_p->argument_end;
+        register_end = args_p->register_end;
+        const_literal_end = args_p->const_literal_end;
+      }
+
+      uint32_t start = register_end;
+
+      if ((bytecode_p->status_flags & CBC_CODE_FLAGS_ARGUMENTS_NEEDED)
+          && !(bytecode_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE))
+      {
+        start = 0;
+      }
+
+      for (uint32_t i = start; i < const_literal_end; i++)
+      {
+        if (i >= argument_end && i < register_end)
+        {
+          continue;
+        }
+
+        jmem_cpointer_t literal_cp = literal_start_p[i];
+        used_literals_p[literal_cp >> 3] = (uint8_t) (used_literals_p[literal_cp >> 3] | (1u << (literal_cp & 0x7)));
+      }
+    }
+
+    buffer_p += code_size;
+    size -= code_size;
+  }
+  while (size > 0);
+} /* jerry_snapshot_mark_used_literals */
 
 /**
- * Generate snapshot from specified source
+ * Save the byte code of the entry points and the literal table into a snapshot.
  *
- * @return size of snapshot, if it was generated succesfully
- *          (i.e. there are no syntax errors in source code, buffer size is sufficient,
- *           and snapshot support is enabled in current configuration through JERRY_ENABLE_SNAPSHOT),
- *         0 - otherwise.
+ * @return size of snapshot - if it was saved successfully,
+ *         0 - otherwise (the buffer is too small or a limit of the snapshot format is reached)
  */
-size_t
-jerry_parse_and_save_snapshot (const jerry_char_t *source_p, /**< script source */
-                               size_t source_size, /**< script source size */
-                               bool is_for_global, /**< snapshot would be executed as global (true)
-                                                    *   or eval (false) */
-                               bool is_strict, /**< strict mode */
-                               uint8_t *buffer_p, /**< buffer to save snapshot to */
-                               size_t buffer_size) /**< the buffer's size */
+static size_t
+snapshot_save (ecma_compiled_code_t **entry_points_p, /**< byte code of the entry points */
+               const uint32_t *entry_flags_p, /**< flags (JERRY_SNAPSHOT_EVAL_CODE) of the entry points */
+               uint32_t number_of_funcs, /**< number of entry points */
+               uint8_t *buffer_p, /**< buffer to save snapshot to */
+               size_t buffer_size) /**< the buffer's size */
 {
-#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+  JERRY_ASSERT (number_of_funcs > 0);
+
   snapshot_globals_t globals;
-  ecma_value_t parse_status;
-  ecma_compiled_code_t *bytecode_data_p;
+  size_t header_size = JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t) + number_of_funcs * sizeof (uint32_t),
+                                      JMEM_ALIGNMENT);
+
+  if (header_size > buffer_size)
+  {
+    return 0;
+  }
 
-  globals.snapshot_buffer_write_offset = JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t),
-                                                        JMEM_ALIGNMENT);
+  globals.snapshot_buffer_write_offset = header_size;
+  globals.snapshot_code_start_offset = header_size;
   globals.snapshot_error_occured = false;
+  globals.block_hash_p = NULL;
+  globals.block_hash_size = 0;
+  globals.block_count = 0;
 
-  parse_status = parser_parse_script (source_p,
-                                      source_size,
-                                      is_strict,
-                                      &bytecode_data_p);
+  memset (buffer_p, 0, header_size);
 
-  if (ECMA_IS_VALUE_ERROR (parse_status))
+  uint32_t *func_offsets_p = (uint32_t *) (buffer_p + sizeof (jerry_snapshot_header_t));
+
+  for (uint32_t i = 0; i < number_of_funcs; i++)
   {
-    ecma_free_value (parse_status);
-    return 0;
+    uint16_t start_offset = snapshot_add_compiled_code (entry_points_p[i], buffer_p, buffer_size, &globals);
+
+    func_offsets_p[i] = (((uint32_t) start_offset) << JMEM_ALIGNMENT_LOG) | entry_flags_p[i];
   }
 
-  snapshot_add_compiled_code (bytecode_data_p, buffer_p, buffer_size, &globals);
+  if (globals.block_hash_p != NULL)
+  {
+    jmem_heap_free_block (globals.block_hash_p, globals.block_hash_size * sizeof (uint16_t));
+  }
 
   if (globals.snapshot_error_occured)
   {
@@ -2055,24 +3222,50 @@ jerry_parse_and_save_snapshot (const jerry_char_t *source_p, /**< script source
   jerry_snapshot_header_t header;
   header.version = JERRY_SNAPSHOT_VERSION;
   header.lit_table_offset = (uint32_t) globals.snapshot_buffer_write_offset;
-  header.is_run_global = is_for_global;
+  header.number_of_funcs = number_of_funcs;
 
   lit_mem_to_snapshot_id_map_entry_t *lit_map_p = NULL;
   uint32_t literals_num;
 
-  if (!ecma_save_literals_for_snapshot (buffer_p,
-                                        buffer_size,
-                                        &globals.snapshot_buffer_write_offset,
-                                        &lit_map_p,
-                                        &literals_num,
-                                        &header.lit_table_size))
+  /* Optimized snapshots only contain the literals referenced by their byte code. */
+  uint8_t *used_literals_p = NULL;
+  const size_t used_literals_size = ((size_t) 1 << JMEM_CP_WIDTH) / JERRY_BITSINBYTE;
+
+  if ((JERRY_CONTEXT (jerry_init_flags) & JERRY_INIT_OPTIMIZE_SNAPSHOT)
+      && header.lit_table_offset > header_size)
+  {
+    used_literals_p = (uint8_t *) jmem_heap_alloc_block_null_on_error (used_literals_size);
+
+    if (used_literals_p != NULL)
+    {
+      memset (used_literals_p, 0, used_literals_size);
+      jerry_snapshot_mark_used_literals (buffer_p + header_size,
+                                         (uint32_t) (header.lit_table_offset - header_size),
+                                         used_literals_p);
+    }
+  }
+
+  bool is_saved = ecma_save_literals_for_snapshot (buffer_p,
+                                                   buffer_size,
+                                                   &globals.snapshot_buffer_write_offset,
+                                                   used_literals_p,
+                                                   &lit_map_p,
+                                                   &literals_num,
+                                                   &header.lit_table_size);
+
+  if (used_literals_p != NULL)
+  {
+    jmem_heap_free_block (used_literals_p, used_literals_size);
+  }
+
+  if (!is_saved)
   {
     JERRY_ASSERT (lit_map_p == NULL);
     return 0;
   }
 
-  jerry_snapshot_set_offsets (buffer_p + JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t), JMEM_ALIGNMENT),
-                              (uint32_t) (header.lit_table_offset - sizeof (jerry_snapshot_header_t)),
+  jerry_snapshot_set_offsets (buffer_p + header_size,
+                              (uint32_t) (header.lit_table_offset - header_size),
                               lit_map_p);
 
   size_t header_offset = 0;
@@ -2085,43 +3278,172 @@ jerry_parse_and_save_snapshot (const jerry_char_t *source_p, /**< script source
 
   if (lit_map_p != NULL)
   {
-    jmem_heap_free_block (lit_map_p, literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t));
+    jmem_heap_free_block (lit_map_p, literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t));
+  }
+
+  return globals.snapshot_buffer_write_offset;
+} /* snapshot_save */
+
+#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
+
+/**
+ * Generate snapshot from specified source
+ *
+ * @return size of snapshot, if it was generated succesfully
+ *          (i.e. there are no syntax errors in source code, buffer size is sufficient,
+ *           and snapshot support is enabled in current configuration through JERRY_ENABLE_SNAPSHOT),
+ *         0 - otherwise.
+ */
+size_t
+jerry_parse_and_save_snapshot (const jerry_char_t *source_p, /**< script source */
+                               size_t source_size, /**< script source size */
+                               bool is_for_global, /**< snapshot would be executed as global (true)
+                                                    *   or eval (false) */
+                               bool is_strict, /**< strict mode */
+                               uint8_t *buffer_p, /**< buffer to save snapshot to */
+                               size_t buffer_size) /**< the buffer's size */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+  ecma_value_t parse_status;
+  ecma_compiled_code_t *bytecode_data_p;
+
+  /* Snapshots contain the byte code of all functions. */
+  parse_status = parser_parse_script (source_p,
+                                      source_size,
+                                      is_strict,
+                                      false,
+                                      &bytecode_data_p);
+
+  if (ECMA_IS_VALUE_ERROR (parse_status))
+  {
+    ecma_free_value (parse_status);
+    return 0;
+  }
+
+  uint32_t entry_flags = is_for_global ? 0 : JERRY_SNAPSHOT_EVAL_CODE;
+  size_t snapshot_size = snapshot_save (&bytecode_data_p, &entry_flags, 1, buffer_p, buffer_size);
+
+  ecma_bytecode_deref (bytecode_data_p);
+
+  return snapshot_size;
+#else /* !JERRY_ENABLE_SNAPSHOT_SAVE */
+  JERRY_UNUSED (source_p);
+  JERRY_UNUSED (source_size);
+  JERRY_UNUSED (is_for_global);
+  JERRY_UNUSED (is_strict);
+  JERRY_UNUSED (buffer_p);
+  JERRY_UNUSED (buffer_size);
+
+  return 0;
+#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
+} /* jerry_parse_and_save_snapshot */
+
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+
+/**
+ * Byte code blocks shorter than this treshold are always copied into the memory.
+ * The memory / performance trade-of of byte code redirection does not worth
+ * in such cases.
+ */
+#define BYTECODE_NO_COPY_TRESHOLD 8
+
+/**
+ * Loader of the functions of a snapshot, which are loaded on their first call.
+ *
+ * The literal map of the snapshot follows the loader.
+ */
+typedef struct
+{
+  const uint8_t *snapshot_data_p; /**< snapshot data (it is not copied) */
+  uint32_t refs; /**< number of snapshot functions and snapshot executions using the loader */
+  uint32_t literals_num; /**< number of literal map entries */
+} snapshot_loader_t;
+
+/**
+ * Get the literal map of a snapshot loader.
+ */
+#define SNAPSHOT_LOADER_GET_LIT_MAP(loader_p) ((lit_mem_to_snapshot_id_map_entry_t *) ((loader_p) + 1))
+
+/**
+ * Get the allocated size of a snapshot loader.
+ */
+#define SNAPSHOT_LOADER_GET_SIZE(literals_num) \
+  (sizeof (snapshot_loader_t) + (literals_num) * sizeof (lit_mem_to_snapshot_id_map_entry_t))
+
+/**
+ * Create a snapshot function, which refers to the byte code in the snapshot
+ * until it is called the first time.
+ *
+ * @return snapshot function
+ */
+static ecma_compiled_code_t *
+snapshot_create_function (const ecma_compiled_code_t *bytecode_p, /**< byte code in the snapshot */
+                          size_t offset, /**< byte code offset */
+                          snapshot_loader_t *loader_p) /**< snapshot loader */
+{
+  size_t total_size = JERRY_ALIGNUP (sizeof (cbc_snapshot_function_t), JMEM_ALIGNMENT);
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_BYTE_CODE);
+  cbc_snapshot_function_t *snapshot_function_p = (cbc_snapshot_function_t *) jmem_heap_alloc_block (total_size);
+
+  snapshot_function_p->header.size = (uint16_t) (total_size >> JMEM_ALIGNMENT_LOG);
+  snapshot_function_p->header.refs = 1;
+  snapshot_function_p->header.status_flags = (CBC_CODE_FLAGS_FUNCTION
+                                              | CBC_CODE_FLAGS_LAZY_FUNCTION
+                                              | CBC_CODE_FLAGS_SNAPSHOT_FUNCTION);
+
+  if (bytecode_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE)
+  {
+    snapshot_function_p->header.status_flags |= CBC_CODE_FLAGS_STRICT_MODE;
+  }
+
+  if (bytecode_p->status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
+  {
+    snapshot_function_p->argument_end = ((const cbc_uint16_arguments_t *) bytecode_p)->argument_end;
+  }
+  else
+  {
+    snapshot_function_p->argument_end = ((const cbc_uint8_arguments_t *) bytecode_p)->argument_end;
   }
 
-  ecma_bytecode_deref (bytecode_data_p);
-
-  return globals.snapshot_buffer_write_offset;
-#else /* !JERRY_ENABLE_SNAPSHOT_SAVE */
-  JERRY_UNUSED (source_p);
-  JERRY_UNUSED (source_size);
-  JERRY_UNUSED (is_for_global);
-  JERRY_UNUSED (is_strict);
-  JERRY_UNUSED (buffer_p);
-  JERRY_UNUSED (buffer_size);
+  snapshot_function_p->offset = (uint16_t) (offset >> JMEM_ALIGNMENT_LOG);
+  snapshot_function_p->bytecode_cp = JMEM_CP_NULL;
 
-  return 0;
-#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
-} /* jerry_parse_and_save_snapshot */
+  ECMA_SET_NON_NULL_POINTER (snapshot_function_p->loader_cp, loader_p);
+  loader_p->refs++;
 
-#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+  return &snapshot_function_p->header;
+} /* snapshot_create_function */
 
 /**
- * Byte code blocks shorter than this treshold are always copied into the memory.
- * The memory / performance trade-of of byte code redirection does not worth
- * in such cases.
+ * Release a reference to a snapshot loader.
  */
-#define BYTECODE_NO_COPY_TRESHOLD 8
+static void
+snapshot_loader_deref (snapshot_loader_t *loader_p) /**< snapshot loader */
+{
+  JERRY_ASSERT (loader_p->refs > 0);
+
+  if (--loader_p->refs == 0)
+  {
+    jmem_heap_free_block (loader_p, SNAPSHOT_LOADER_GET_SIZE (loader_p->literals_num));
+  }
+} /* snapshot_loader_deref */
 
 /**
  * Load byte code from snapshot.
  *
+ * Note:
+ *      when a snapshot loader is passed, the nested functions are not loaded,
+ *      only snapshot functions are created for them
+ *
  * @return byte code
  */
 static ecma_compiled_code_t *
 snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data */
                              size_t offset, /**< byte code offset */
                              lit_mem_to_snapshot_id_map_entry_t *lit_map_p, /**< literal map */
-                             bool copy_bytecode) /**< byte code should be copied to memory */
+                             bool copy_bytecode, /**< byte code should be copied to memory */
+                             snapshot_loader_t *loader_p) /**< snapshot loader for the nested functions
+                                                           *   (NULL - if they are loaded immediately) */
 {
   ecma_compiled_code_t *bytecode_p = (ecma_compiled_code_t *) (snapshot_data_p + offset);
   uint32_t code_size = ((uint32_t) bytecode_p->size) << JMEM_ALIGNMENT_LOG;
@@ -2173,6 +3495,7 @@ snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data
   if (copy_bytecode
       || (header_size + (literal_end * sizeof (uint16_t)) + BYTECODE_NO_COPY_TRESHOLD > code_size))
   {
+    JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_BYTE_CODE);
     bytecode_p = (ecma_compiled_code_t *) jmem_heap_alloc_block (code_size);
 
     memcpy (bytecode_p, snapshot_data_p + offset, code_size);
@@ -2184,6 +3507,7 @@ snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data
     uint8_t *real_bytecode_p = ((uint8_t *) bytecode_p) + code_size;
     uint32_t total_size = JERRY_ALIGNUP (code_size + 1 + sizeof (uint8_t *), JMEM_ALIGNMENT);
 
+    JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_BYTE_CODE);
     bytecode_p = (ecma_compiled_code_t *) jmem_heap_alloc_block (total_size);
 
     memcpy (bytecode_p, snapshot_data_p + offset, code_size);
@@ -2227,11 +3551,20 @@ snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data
     }
     else
     {
-      ecma_compiled_code_t *literal_bytecode_p;
-      literal_bytecode_p = snapshot_load_compiled_code (snapshot_data_p,
-                                                        literal_offset,
-                                                        lit_map_p,
-                                                        copy_bytecode);
+      ecma_compiled_code_t *literal_bytecode_p = (ecma_compiled_code_t *) (snapshot_data_p + literal_offset);
+
+      if (loader_p != NULL && (literal_bytecode_p->status_flags & CBC_CODE_FLAGS_FUNCTION))
+      {
+        literal_bytecode_p = snapshot_create_function (literal_bytecode_p, literal_offset, loader_p);
+      }
+      else
+      {
+        literal_bytecode_p = snapshot_load_compiled_code (snapshot_data_p,
+                                                          literal_offset,
+                                                          lit_map_p,
+                                                          copy_bytecode,
+                                                          loader_p);
+      }
 
       ECMA_SET_NON_NULL_POINTER (literal_start_p[i],
                                  literal_bytecode_p);
@@ -2243,13 +3576,231 @@ snapshot_load_compiled_code (const uint8_t *snapshot_data_p, /**< snapshot data
 
 #endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
 
+/**
+ * Load the byte code of a snapshot function. Its nested functions
+ * are snapshot functions as well.
+ *
+ * @return loaded byte code
+ */
+ecma_compiled_code_t *
+jerry_snapshot_load_function (ecma_compiled_code_t *bytecode_p) /**< snapshot function */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+  JERRY_ASSERT (bytecode_p->status_flags & CBC_CODE_FLAGS_SNAPSHOT_FUNCTION);
+
+  cbc_snapshot_function_t *snapshot_function_p = (cbc_snapshot_function_t *) bytecode_p;
+  snapshot_loader_t *loader_p = ECMA_GET_NON_NULL_POINTER (snapshot_loader_t, snapshot_function_p->loader_cp);
+
+  return snapshot_load_compiled_code (loader_p->snapshot_data_p,
+                                      ((size_t) snapshot_function_p->offset) << JMEM_ALIGNMENT_LOG,
+                                      SNAPSHOT_LOADER_GET_LIT_MAP (loader_p),
+                                      false,
+                                      loader_p);
+#else /* !JERRY_ENABLE_SNAPSHOT_EXEC */
+  JERRY_UNUSED (bytecode_p);
+  JERRY_UNREACHABLE ();
+  return NULL;
+#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
+} /* jerry_snapshot_load_function */
+
+/**
+ * Release the snapshot loader referenced by a snapshot function, which is freed.
+ */
+void
+jerry_snapshot_free_function (ecma_compiled_code_t *bytecode_p) /**< snapshot function */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+  JERRY_ASSERT (bytecode_p->status_flags & CBC_CODE_FLAGS_SNAPSHOT_FUNCTION);
+
+  cbc_snapshot_function_t *snapshot_function_p = (cbc_snapshot_function_t *) bytecode_p;
+
+  snapshot_loader_deref (ECMA_GET_NON_NULL_POINTER (snapshot_loader_t, snapshot_function_p->loader_cp));
+#else /* !JERRY_ENABLE_SNAPSHOT_EXEC */
+  JERRY_UNUSED (bytecode_p);
+  JERRY_UNREACHABLE ();
+#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
+} /* jerry_snapshot_free_function */
+
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+
+/**
+ * Check the header of a snapshot.
+ *
+ * @return NULL - if the header is valid
+ *         error message - otherwise
+ */
+static const char *
+snapshot_check_header (const uint8_t *snapshot_data_p, /**< snapshot data */
+                       size_t snapshot_size) /**< size of snapshot */
+{
+  if (snapshot_size <= sizeof (jerry_snapshot_header_t))
+  {
+    return "Invalid snapshot format";
+  }
+
+  const jerry_snapshot_header_t *header_p = (const jerry_snapshot_header_t *) snapshot_data_p;
+
+  if (header_p->version != JERRY_SNAPSHOT_VERSION)
+  {
+    return "Invalid snapshot version";
+  }
+
+  /* The function offsets must fit into the snapshot, which also prevents
+   * the overflow of the code start computation on 32 bit systems. */
+  if (header_p->number_of_funcs == 0
+      || header_p->number_of_funcs > (snapshot_size - sizeof (jerry_snapshot_header_t)) / sizeof (uint32_t))
+  {
+    return "Invalid snapshot format";
+  }
+
+  size_t code_start = JERRY_ALIGNUP (sizeof (jerry_snapshot_header_t) + header_p->number_of_funcs * sizeof (uint32_t),
+                                     JMEM_ALIGNMENT);
+
+  if (code_start > header_p->lit_table_offset
+      || header_p->lit_table_offset >= snapshot_size)
+  {
+    return "Invalid snapshot format";
+  }
+
+  const uint32_t *func_offsets_p = (const uint32_t *) (snapshot_data_p + sizeof (jerry_snapshot_header_t));
+
+  for (uint32_t i = 0; i < header_p->number_of_funcs; i++)
+  {
+    uint32_t offset = func_offsets_p[i] & ~JERRY_SNAPSHOT_EVAL_CODE;
+
+    if (offset < code_start
+        || offset >= header_p->lit_table_offset
+        || (offset & (JMEM_ALIGNMENT - 1)) != 0)
+    {
+      return "Invalid snapshot format";
+    }
+  }
+
+  return NULL;
+} /* snapshot_check_header */
+
+/**
+ * Execute entry points of a snapshot. The literal table is loaded only once.
+ *
+ * @return result of the last executed entry point - if run was successful
+ *         thrown error - otherwise
+ */
+static jerry_value_t
+snapshot_exec (const uint8_t *snapshot_data_p, /**< snapshot data */
+               size_t snapshot_size, /**< size of snapshot */
+               uint32_t func_index, /**< index of the first entry point */
+               uint32_t func_count, /**< number of executed entry points */
+               bool copy_bytecode) /**< byte code should be copied to memory */
+{
+  const char *error_message_p = snapshot_check_header (snapshot_data_p, snapshot_size);
+
+  if (error_message_p != NULL)
+  {
+    return ecma_raise_type_error (error_message_p);
+  }
+
+  const jerry_snapshot_header_t *header_p = (const jerry_snapshot_header_t *) snapshot_data_p;
+  const uint32_t *func_offsets_p = (const uint32_t *) (snapshot_data_p + sizeof (jerry_snapshot_header_t));
+
+  if (func_index >= header_p->number_of_funcs
+      || func_count > header_p->number_of_funcs - func_index)
+  {
+    return ecma_raise_range_error ("Snapshot function index is out of range");
+  }
+
+  lit_mem_to_snapshot_id_map_entry_t *lit_map_p = NULL;
+  uint32_t literals_num;
+
+  if (!ecma_load_literals_from_snapshot (snapshot_data_p + header_p->lit_table_offset,
+                                         header_p->lit_table_size,
+                                         &lit_map_p,
+                                         &literals_num,
+                                         copy_bytecode))
+  {
+    JERRY_ASSERT (lit_map_p == NULL);
+    return ecma_raise_type_error ("Invalid snapshot format");
+  }
+
+  snapshot_loader_t *loader_p = NULL;
+
+  if (!copy_bytecode)
+  {
+    /* The snapshot is kept by the caller, so only the entry points are
+     * loaded now, and the nested functions are loaded on their first call. */
+    loader_p = (snapshot_loader_t *) jmem_heap_alloc_block (SNAPSHOT_LOADER_GET_SIZE (literals_num));
+    loader_p->snapshot_data_p = snapshot_data_p;
+    loader_p->refs = 1;
+    loader_p->literals_num = literals_num;
+
+    if (lit_map_p != NULL)
+    {
+      memcpy (SNAPSHOT_LOADER_GET_LIT_MAP (loader_p),
+              lit_map_p,
+              literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t));
+      jmem_heap_free_block (lit_map_p, literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t));
+    }
+
+    lit_map_p = SNAPSHOT_LOADER_GET_LIT_MAP (loader_p);
+  }
+
+  ecma_value_t ret_val = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
+
+  for (uint32_t i = func_index; i < func_index + func_count; i++)
+  {
+    ecma_compiled_code_t *bytecode_p;
+    bytecode_p = snapshot_load_compiled_code (snapshot_data_p,
+                                              func_offsets_p[i] & ~JERRY_SNAPSHOT_EVAL_CODE,
+                                              lit_map_p,
+                                              copy_bytecode,
+                                              loader_p);
+
+    ecma_free_value (ret_val);
+
+    if (bytecode_p == NULL)
+    {
+      ret_val = ecma_raise_type_error ("Invalid snapshot format");
+      break;
+    }
+
+    if (!(func_offsets_p[i] & JERRY_SNAPSHOT_EVAL_CODE))
+    {
+      ret_val = vm_run_global (bytecode_p);
+      ecma_bytecode_deref (bytecode_p);
+    }
+    else
+    {
+      ret_val = vm_run_eval (bytecode_p, false);
+    }
+
+    if (ECMA_IS_VALUE_ERROR (ret_val))
+    {
+      break;
+    }
+  }
+
+  if (loader_p != NULL)
+  {
+    snapshot_loader_deref (loader_p);
+  }
+  else if (lit_map_p != NULL)
+  {
+    jmem_heap_free_block (lit_map_p, literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t));
+  }
+
+  return ret_val;
+} /* snapshot_exec */
+
+#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
+
 /**
  * Execute snapshot from specified buffer
  *
  * Note:
+ *      all entry points of the snapshot are executed in order (a merged
+ *      snapshot has more than one), until one of them throws an error
  *      returned value must be freed with jerry_release_value, when it is no longer needed.
  *
- * @return result of bytecode - if run was successful
+ * @return result of the last entry point - if run was successful
  *         thrown error - otherwise
  */
 jerry_value_t
@@ -2266,76 +3817,199 @@ jerry_exec_snapshot (const void *snapshot_p, /**< snapshot */
 #ifdef JERRY_ENABLE_SNAPSHOT_EXEC
   JERRY_ASSERT (snapshot_p != NULL);
 
-  static const char * const invalid_version_error_p = "Invalid snapshot version";
-  static const char * const invalid_format_error_p = "Invalid snapshot format";
-  const uint8_t *snapshot_data_p = (uint8_t *) snapshot_p;
+  const uint8_t *snapshot_data_p = (const uint8_t *) snapshot_p;
+  uint32_t func_count = 0;
 
-  if (snapshot_size <= sizeof (jerry_snapshot_header_t))
+  if (snapshot_size > sizeof (jerry_snapshot_header_t))
   {
-    return ecma_raise_type_error (invalid_format_error_p);
+    func_count = ((const jerry_snapshot_header_t *) snapshot_data_p)->number_of_funcs;
   }
 
-  const jerry_snapshot_header_t *header_p = (const jerry_snapshot_header_t *) snapshot_data_p;
+  return snapshot_exec (snapshot_data_p, snapshot_size, 0, func_count, copy_bytecode);
+#else /* !JERRY_ENABLE_SNAPSHOT_EXEC */
+  JERRY_UNUSED (snapshot_p);
+  JERRY_UNUSED (snapshot_size);
+  JERRY_UNUSED (copy_bytecode);
 
-  if (header_p->version != JERRY_SNAPSHOT_VERSION)
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_FALSE);
+#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
+} /* jerry_exec_snapshot */
+
+/**
+ * Execute one entry point of a snapshot (e.g. one of the snapshots merged by jerry_merge_snapshots)
+ *
+ * Note:
+ *      returned value must be freed with jerry_release_value, when it is no longer needed.
+ *
+ * @return result of the entry point - if run was successful
+ *         thrown error - otherwise
+ */
+jerry_value_t
+jerry_exec_snapshot_at (const void *snapshot_p, /**< snapshot */
+                        size_t snapshot_size, /**< size of snapshot */
+                        uint32_t func_index, /**< index of the entry point */
+                        bool copy_bytecode) /**< flag, indicating whether the passed snapshot
+                                             *   buffer should be copied to the engine's memory
+                                             *   (see jerry_exec_snapshot) */
+{
+#ifdef JERRY_ENABLE_SNAPSHOT_EXEC
+  JERRY_ASSERT (snapshot_p != NULL);
+
+  return snapshot_exec ((const uint8_t *) snapshot_p, snapshot_size, func_index, 1, copy_bytecode);
+#else /* !JERRY_ENABLE_SNAPSHOT_EXEC */
+  JERRY_UNUSED (snapshot_p);
+  JERRY_UNUSED (snapshot_size);
+  JERRY_UNUSED (func_index);
+  JERRY_UNUSED (copy_bytecode);
+
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_FALSE);
+#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
+} /* jerry_exec_snapshot_at */
+
+/**
+ * Merge snapshots into one snapshot. The literals of the snapshots are stored in a single
+ * literal table, where each literal is stored once, and identical functions are stored once.
+ * The entry points of the input snapshots become the entry points of the merged snapshot in
+ * the same order, so they can be executed by jerry_exec_snapshot_at.
+ *
+ * Note:
+ *      the snapshots are loaded into the engine and the literal table of the merged
+ *      snapshot contains all literals of the engine, so a freshly initialized engine
+ *      should be used for merging
+ *
+ * @return size of the merged snapshot - if it was saved successfully,
+ *         0 - otherwise (an input snapshot is invalid, the snapshots have too many entry
+ *             points, the buffer is too small, or the snapshot save and exec features are
+ *             not enabled).
+ */
+size_t
+jerry_merge_snapshots (const void * const *snapshots_p, /**< snapshots */
+                       const size_t *snapshot_sizes_p, /**< sizes of the snapshots */
+                       size_t number_of_snapshots, /**< number of snapshots */
+                       uint8_t *buffer_p, /**< buffer to save the merged snapshot to */
+                       size_t buffer_size) /**< the buffer's size */
+{
+#if defined (JERRY_ENABLE_SNAPSHOT_SAVE) && defined (JERRY_ENABLE_SNAPSHOT_EXEC)
+  jerry_assert_api_available ();
+
+  uint32_t number_of_funcs = 0;
+
+  for (size_t i = 0; i < number_of_snapshots; i++)
   {
-    return ecma_raise_type_error (invalid_version_error_p);
-  }
+    const uint8_t *snapshot_data_p = (const uint8_t *) snapshots_p[i];
 
-  lit_mem_to_snapshot_id_map_entry_t *lit_map_p = NULL;
-  uint32_t literals_num;
+    if (snapshot_check_header (snapshot_data_p, snapshot_sizes_p[i]) != NULL)
+    {
+      return 0;
+    }
+
+    uint32_t snapshot_funcs = ((const jerry_snapshot_header_t *) snapshot_data_p)->number_of_funcs;
+
+    /* The size of the entry point table must not overflow. */
+    if (snapshot_funcs > UINT32_MAX / sizeof (ecma_compiled_code_t *) - number_of_funcs)
+    {
+      return 0;
+    }
+
+    number_of_funcs += snapshot_funcs;
+  }
 
-  if (header_p->lit_table_offset >= snapshot_size)
+  if (number_of_funcs == 0)
   {
-    return ecma_raise_type_error (invalid_version_error_p);
+    return 0;
   }
 
-  if (!ecma_load_literals_from_snapshot (snapshot_data_p + header_p->lit_table_offset,
-                                         header_p->lit_table_size,
-                                         &lit_map_p,
-                                         &literals_num))
+  ecma_compiled_code_t **entry_points_p;
+  entry_points_p = ((ecma_compiled_code_t **)
+                    jmem_heap_alloc_block_null_on_error (number_of_funcs * sizeof (ecma_compiled_code_t *)));
+
+  if (entry_points_p == NULL)
   {
-    JERRY_ASSERT (lit_map_p == NULL);
-    return ecma_raise_type_error (invalid_format_error_p);
+    return 0;
   }
 
-  ecma_compiled_code_t *bytecode_p;
-  bytecode_p = snapshot_load_compiled_code (snapshot_data_p,
-                                            sizeof (jerry_snapshot_header_t),
-                                            lit_map_p,
-                                            copy_bytecode);
+  uint32_t *entry_flags_p = (uint32_t *) jmem_heap_alloc_block_null_on_error (number_of_funcs * sizeof (uint32_t));
 
-  if (lit_map_p != NULL)
+  if (entry_flags_p == NULL)
   {
-    jmem_heap_free_block (lit_map_p, literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t));
+    jmem_heap_free_block (entry_points_p, number_of_funcs * sizeof (ecma_compiled_code_t *));
+    return 0;
   }
 
-  if (bytecode_p == NULL)
+  uint32_t loaded_funcs = 0;
+  bool is_valid = true;
+
+  for (size_t i = 0; i < number_of_snapshots && is_valid; i++)
   {
-    return ecma_raise_type_error (invalid_format_error_p);
+    const uint8_t *snapshot_data_p = (const uint8_t *) snapshots_p[i];
+    const jerry_snapshot_header_t *header_p = (const jerry_snapshot_header_t *) snapshot_data_p;
+    const uint32_t *func_offsets_p = (const uint32_t *) (snapshot_data_p + sizeof (jerry_snapshot_header_t));
+
+    lit_mem_to_snapshot_id_map_entry_t *lit_map_p = NULL;
+    uint32_t literals_num;
+
+    /* Equal literals of different snapshots are loaded as the same literal. */
+    if (!ecma_load_literals_from_snapshot (snapshot_data_p + header_p->lit_table_offset,
+                                           header_p->lit_table_size,
+                                           &lit_map_p,
+                                           &literals_num,
+                                           true))
+    {
+      JERRY_ASSERT (lit_map_p == NULL);
+      is_valid = false;
+      break;
+    }
+
+    for (uint32_t j = 0; j < header_p->number_of_funcs; j++)
+    {
+      entry_flags_p[loaded_funcs] = func_offsets_p[j] & JERRY_SNAPSHOT_EVAL_CODE;
+      entry_points_p[loaded_funcs] = snapshot_load_compiled_code (snapshot_data_p,
+                                                                  func_offsets_p[j] & ~JERRY_SNAPSHOT_EVAL_CODE,
+                                                                  lit_map_p,
+                                                                  true,
+                                                                  NULL);
+
+      if (entry_points_p[loaded_funcs] == NULL)
+      {
+        is_valid = false;
+        break;
+      }
+
+      loaded_funcs++;
+    }
+
+    if (lit_map_p != NULL)
+    {
+      jmem_heap_free_block (lit_map_p, literals_num * sizeof (lit_mem_to_snapshot_id_map_entry_t));
+    }
   }
 
-  ecma_value_t ret_val;
+  size_t snapshot_size = 0;
 
-  if (header_p->is_run_global)
+  if (is_valid)
   {
-    ret_val = vm_run_global (bytecode_p);
-    ecma_bytecode_deref (bytecode_p);
+    snapshot_size = snapshot_save (entry_points_p, entry_flags_p, number_of_funcs, buffer_p, buffer_size);
   }
-  else
+
+  for (uint32_t i = 0; i < loaded_funcs; i++)
   {
-    ret_val = vm_run_eval (bytecode_p, false);
+    ecma_bytecode_deref (entry_points_p[i]);
   }
 
-  return ret_val;
-#else /* !JERRY_ENABLE_SNAPSHOT_EXEC */
-  JERRY_UNUSED (snapshot_p);
-  JERRY_UNUSED (snapshot_size);
-  JERRY_UNUSED (copy_bytecode);
+  jmem_heap_free_block (entry_flags_p, number_of_funcs * sizeof (uint32_t));
+  jmem_heap_free_block (entry_points_p, number_of_funcs * sizeof (ecma_compiled_code_t *));
 
-  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_FALSE);
-#endif /* JERRY_ENABLE_SNAPSHOT_EXEC */
-} /* jerry_exec_snapshot */
+  return snapshot_size;
+#else /* !JERRY_ENABLE_SNAPSHOT_SAVE || !JERRY_ENABLE_SNAPSHOT_EXEC */
+  JERRY_UNUSED (snapshots_p);
+  JERRY_UNUSED (snapshot_sizes_p);
+  JERRY_UNUSED (number_of_snapshots);
+  JERRY_UNUSED (buffer_p);
+  JERRY_UNUSED (buffer_size);
+
+  return 0;
+#endif /* JERRY_ENABLE_SNAPSHOT_SAVE && JERRY_ENABLE_SNAPSHOT_EXEC */
+} /* jerry_merge_snapshots */
 
 /**
  * @}
@@ -2363,10 +4037,14 @@ jerry_dispatch_external_function (ecma_object_t *function_object_p, /**< externa
 {
   jerry_assert_api_available ();
 
+  VM_RUNTIME_STATS_ENTER (VM_RUNTIME_PHASE_NATIVE);
+
   ecma_value_t ret_value = ((jerry_external_handler_t) handler_p) (ecma_make_object_value (function_object_p),
                                                                    this_arg_value,
                                                                    arguments_list_p,
                                                                    arguments_list_len);
+
+  VM_RUNTIME_STATS_LEAVE ();
   return ret_value;
 } /* jerry_dispatch_external_function */
 
@@ -2388,3 +4066,25 @@ jerry_dispatch_object_free_callback (ecma_external_pointer_t freecb_p, /**< poin
 
   jerry_make_api_available ();
 } /* jerry_dispatch_object_free_callback */
+
+/**
+ * Dispatch call to the free callback of an external string's buffer
+ *
+ * Note:
+ *       the callback can be called during critical GC phase,
+ *       so should not perform any requests to engine.
+ */
+void
+jerry_dispatch_external_string_free_callback (ecma_external_pointer_t freecb_p, /**< pointer to free callback */
+                                              const lit_utf8_byte_t *string_p, /**< string buffer */
+                                              lit_utf8_size_t string_size) /**< string size */
+{
+  /* Strings can also be freed while the API is unavailable (e.g. in jerry_cleanup). */
+  bool is_api_available = JERRY_CONTEXT (jerry_api_available);
+
+  jerry_make_api_unavailable ();
+
+  ((jerry_external_string_free_callback_t) freecb_p) ((const jerry_char_t *) string_p, (jerry_size_t) string_size);
+
+  JERRY_CONTEXT (jerry_api_available) = is_api_available;
+} /* jerry_dispatch_external_string_free_callback */
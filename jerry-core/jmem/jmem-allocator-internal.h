@@ -26,6 +26,37 @@
 
 extern void jmem_run_free_unused_memory_callbacks (jmem_free_unused_memory_severity_t);
 
+#if defined (JERRY_HEAP_PROFILER) || defined (JMEM_STATS)
+
+extern void jmem_track_init (void);
+extern void jmem_track_alloc (void *, size_t);
+extern void jmem_track_free (void *, size_t);
+
+#  define JMEM_TRACK_INIT() jmem_track_init ()
+#  define JMEM_TRACK_ALLOC(p, s) jmem_track_alloc ((p), (s))
+#  define JMEM_TRACK_FREE(p, s) jmem_track_free ((p), (s))
+#else /* !JERRY_HEAP_PROFILER && !JMEM_STATS */
+#  define JMEM_TRACK_INIT()
+#  define JMEM_TRACK_ALLOC(p, s)
+#  define JMEM_TRACK_FREE(p, s)
+#endif /* JERRY_HEAP_PROFILER || JMEM_STATS */
+
+#ifdef JMEM_STATS
+
+/**
+ * Integer part of a ratio printed by the memory statistics (0 if the divisor is 0)
+ */
+#define JMEM_STATS_RATIO_INTEGER(dividend, divisor) \
+  ((divisor) == 0 ? 0 : (dividend) / (divisor))
+
+/**
+ * Four digit fraction part of a ratio printed by the memory statistics (0 if the divisor is 0)
+ */
+#define JMEM_STATS_RATIO_FRACTION(dividend, divisor) \
+  ((divisor) == 0 ? 0 : (dividend) % (divisor) * 10000 / (divisor))
+
+#endif /* JMEM_STATS */
+
 /**
  * @}
  */
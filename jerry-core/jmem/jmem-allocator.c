@@ -57,6 +57,65 @@ jmem_finalize (bool is_show_mem_stats) /**< show heap memory stats
   jmem_heap_finalize ();
 } /* jmem_finalize */
 
+/**
+ * Get the size of the heap area which is stored in a heap image
+ *
+ * Note:
+ *      free pool chunks are returned to the heap before the size is computed
+ *
+ * @return size of the heap area
+ */
+size_t
+jmem_get_image_area_size (void)
+{
+  jmem_pools_collect_empty ();
+
+  return jmem_heap_get_image_area_size ();
+} /* jmem_get_image_area_size */
+
+/**
+ * Store the state of the memory allocators into a heap image
+ */
+void
+jmem_save_image (jmem_image_info_t *info_p, /**< [out] allocator state */
+                 uint8_t *area_p) /**< [out] heap area of the image, its size must be
+                                   *         the value returned by jmem_get_image_area_size */
+{
+  JERRY_ASSERT (JERRY_CONTEXT (jmem_free_chunk_p) == NULL);
+
+  info_p->allocated_size = (uint32_t) JERRY_CONTEXT (jmem_heap_allocated_size);
+  info_p->area_size = (uint32_t) jmem_heap_get_image_area_size ();
+  info_p->first_free_offset = jmem_heap_save_image_area (area_p, info_p->area_size);
+
+#ifdef JMEM_STATS
+  info_p->heap_stats = JERRY_CONTEXT (jmem_heap_stats);
+  info_p->pools_stats = JERRY_CONTEXT (jmem_pools_stats);
+#endif /* JMEM_STATS */
+} /* jmem_save_image */
+
+/**
+ * Initialize memory allocators from a heap image
+ *
+ * @return true - if the memory allocators are initialized,
+ *         false - if the heap area of the image is invalid
+ */
+bool
+jmem_load_image (const jmem_image_info_t *info_p, /**< allocator state */
+                 const uint8_t *area_p) /**< heap area of the image */
+{
+  if (!jmem_heap_load_image_area (area_p, info_p->area_size, info_p->first_free_offset, info_p->allocated_size))
+  {
+    return false;
+  }
+
+#ifdef JMEM_STATS
+  JERRY_CONTEXT (jmem_heap_stats) = info_p->heap_stats;
+  JERRY_CONTEXT (jmem_pools_stats) = info_p->pools_stats;
+#endif /* JMEM_STATS */
+
+  return true;
+} /* jmem_load_image */
+
 /**
  * Compress pointer
  *
@@ -105,6 +164,25 @@ jmem_unregister_free_unused_memory_callback (jmem_free_unused_memory_callback_t
   JERRY_CONTEXT (jmem_free_unused_memory_callback) = NULL;
 } /* jmem_unregister_free_unused_memory_callback */
 
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * Register the callback routines which are notified about the allocated and freed blocks
+ */
+void
+jmem_register_track_callbacks (jmem_track_callback_t alloc_callback, /**< callback of the allocated blocks */
+                               jmem_track_callback_t free_callback) /**< callback of the freed blocks */
+{
+  /* Currently only one pair of callbacks is supported */
+  JERRY_ASSERT (JERRY_CONTEXT (jmem_track_alloc_callback) == NULL
+                && JERRY_CONTEXT (jmem_track_free_callback) == NULL);
+
+  JERRY_CONTEXT (jmem_track_alloc_callback) = alloc_callback;
+  JERRY_CONTEXT (jmem_track_free_callback) = free_callback;
+} /* jmem_register_track_callbacks */
+
+#endif /* JERRY_HEAP_PROFILER */
+
 /**
  * Run 'try to give memory back' callbacks with specified severity
  */
@@ -119,7 +197,162 @@ jmem_run_free_unused_memory_callbacks (jmem_free_unused_memory_severity_t severi
   jmem_pools_collect_empty ();
 } /* jmem_run_free_unused_memory_callbacks */
 
+#if defined (JERRY_HEAP_PROFILER) || defined (JMEM_STATS)
+
+/**
+ * Names of the allocation categories
+ */
+static const char * const jmem_alloc_category_names[JMEM_ALLOC_CATEGORY__COUNT] =
+{
+  "other",
+  "object",
+  "extended_object",
+  "lexical_environment",
+  "string",
+  "external_string",
+  "uint32_string",
+  "magic_string",
+  "number",
+  "property_pair",
+  "hashmap",
+  "byte_code",
+  "regexp_byte_code",
+  "collection",
+  "literal_storage"
+};
+
+/**
+ * Get the name of an allocation category
+ *
+ * @return zero terminated name
+ */
+const char *
+jmem_get_alloc_category_name (jmem_alloc_category_t category) /**< allocation category */
+{
+  JERRY_ASSERT (category < JMEM_ALLOC_CATEGORY__COUNT);
+
+  return jmem_alloc_category_names[category];
+} /* jmem_get_alloc_category_name */
+
+#ifdef JMEM_STATS
+
+/**
+ * Get the side table entry of a heap block.
+ *
+ * @return pointer to the category of the block plus one
+ */
+static inline uint8_t * __attr_always_inline___
+jmem_get_block_category (void *block_p) /**< heap block */
+{
+  size_t unit = (size_t) ((uint8_t *) block_p - JERRY_HEAP_CONTEXT (area)) >> JMEM_ALIGNMENT_LOG;
+
+  JERRY_ASSERT (unit < JMEM_HEAP_AREA_SIZE / JMEM_ALIGNMENT);
+  return JERRY_MEM_STATS_CONTEXT (block_categories) + unit;
+} /* jmem_get_block_category */
+
+#endif /* JMEM_STATS */
+
+/**
+ * Initialize the tracking of the allocated blocks: the blocks which are
+ * already allocated (e.g. loaded from a heap image) are not tracked.
+ */
+void
+jmem_track_init (void)
+{
+#ifdef JMEM_STATS
+  memset (&jerry_global_mem_stats, 0, sizeof (jerry_mem_stats_t));
+#endif /* JMEM_STATS */
+} /* jmem_track_init */
+
+/**
+ * Record an allocated block. The category of the block is the one set by the
+ * last JMEM_SET_ALLOC_CATEGORY, which is reset by the function.
+ */
+void
+jmem_track_alloc (void *block_p, /**< allocated block */
+                  size_t size) /**< size of the block */
+{
+#ifdef JERRY_HEAP_PROFILER
+  if (JERRY_CONTEXT (jmem_track_alloc_callback) != NULL)
+  {
+    JERRY_CONTEXT (jmem_track_alloc_callback) (block_p, size);
+  }
+#endif /* JERRY_HEAP_PROFILER */
+
 #ifdef JMEM_STATS
+  uint8_t category = JERRY_CONTEXT (jmem_alloc_category);
+  jmem_alloc_category_stats_t *stats_p = JERRY_MEM_STATS_CONTEXT (categories) + category;
+
+  *jmem_get_block_category (block_p) = (uint8_t) (category + 1);
+
+  stats_p->allocated_bytes += JERRY_ALIGNUP (size, JMEM_ALIGNMENT);
+  stats_p->allocated_blocks++;
+  stats_p->alloc_count++;
+
+  if (stats_p->allocated_bytes > stats_p->peak_allocated_bytes)
+  {
+    stats_p->peak_allocated_bytes = stats_p->allocated_bytes;
+  }
+#else /* !JMEM_STATS */
+  JERRY_UNUSED (block_p);
+  JERRY_UNUSED (size);
+#endif /* JMEM_STATS */
+
+  JERRY_CONTEXT (jmem_alloc_category) = JMEM_ALLOC_CATEGORY_OTHER;
+} /* jmem_track_alloc */
+
+/**
+ * Record a freed block.
+ */
+void
+jmem_track_free (void *block_p, /**< freed block */
+                 size_t size) /**< size of the block */
+{
+#ifdef JERRY_HEAP_PROFILER
+  if (JERRY_CONTEXT (jmem_track_free_callback) != NULL)
+  {
+    JERRY_CONTEXT (jmem_track_free_callback) (block_p, size);
+  }
+#endif /* JERRY_HEAP_PROFILER */
+
+#ifdef JMEM_STATS
+  uint8_t *block_category_p = jmem_get_block_category (block_p);
+
+  if (*block_category_p == 0)
+  {
+    /* Untracked block, e.g. loaded from a heap image or a pool chunk which is already freed. */
+    return;
+  }
+
+  jmem_alloc_category_stats_t *stats_p = JERRY_MEM_STATS_CONTEXT (categories) + *block_category_p - 1;
+  *block_category_p = 0;
+  size = JERRY_ALIGNUP (size, JMEM_ALIGNMENT);
+
+  JERRY_ASSERT (stats_p->allocated_bytes >= size && stats_p->allocated_blocks > 0);
+
+  stats_p->allocated_bytes -= size;
+  stats_p->allocated_blocks--;
+#else /* !JMEM_STATS */
+  JERRY_UNUSED (block_p);
+  JERRY_UNUSED (size);
+#endif /* JMEM_STATS */
+} /* jmem_track_free */
+
+#endif /* JERRY_HEAP_PROFILER || JMEM_STATS */
+
+#ifdef JMEM_STATS
+/**
+ * Get the memory usage statistics of an allocation category
+ */
+void
+jmem_get_alloc_category_stats (jmem_alloc_category_t category, /**< allocation category */
+                               jmem_alloc_category_stats_t *out_stats_p) /**< [out] statistics */
+{
+  JERRY_ASSERT (category < JMEM_ALLOC_CATEGORY__COUNT);
+
+  *out_stats_p = JERRY_MEM_STATS_CONTEXT (categories)[category];
+} /* jmem_get_alloc_category_stats */
+
 /**
  * Reset peak values in memory usage statistics
  */
@@ -128,8 +361,43 @@ jmem_stats_reset_peak (void)
 {
   jmem_heap_stats_reset_peak ();
   jmem_pools_stats_reset_peak ();
+
+  for (uint32_t category = 0; category < JMEM_ALLOC_CATEGORY__COUNT; category++)
+  {
+    jmem_alloc_category_stats_t *stats_p = JERRY_MEM_STATS_CONTEXT (categories) + category;
+    stats_p->peak_allocated_bytes = stats_p->allocated_bytes;
+  }
 } /* jmem_stats_reset_peak */
 
+/**
+ * Print memory usage statistics of the allocation categories
+ */
+static void
+jmem_alloc_category_stats_print (void)
+{
+  jerry_port_log (JERRY_LOG_LEVEL_DEBUG, "Allocation category stats:\n");
+
+  for (uint32_t category = 0; category < JMEM_ALLOC_CATEGORY__COUNT; category++)
+  {
+    const jmem_alloc_category_stats_t *stats_p = JERRY_MEM_STATS_CONTEXT (categories) + category;
+
+    if (stats_p->alloc_count == 0)
+    {
+      continue;
+    }
+
+    jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                    "  %s: allocated = %zu bytes in %zu blocks, peak allocated = %zu bytes, allocations = %zu\n",
+                    jmem_alloc_category_names[category],
+                    stats_p->allocated_bytes,
+                    stats_p->allocated_blocks,
+                    stats_p->peak_allocated_bytes,
+                    stats_p->alloc_count);
+  }
+
+  jerry_port_log (JERRY_LOG_LEVEL_DEBUG, "\n");
+} /* jmem_alloc_category_stats_print */
+
 /**
  * Print memory usage statistics
  */
@@ -137,6 +405,7 @@ void
 jmem_stats_print (void)
 {
   jmem_heap_stats_print ();
+  jmem_alloc_category_stats_print ();
   jmem_pools_stats_print ();
 } /* jmem_stats_print */
 #endif /* JMEM_STATS */
@@ -68,6 +68,62 @@ typedef enum
   JMEM_FREE_UNUSED_MEMORY_SEVERITY_HIGH, /* 'high' severity */
 } jmem_free_unused_memory_severity_t;
 
+/**
+ * Categories of the allocated blocks, which are reported by the heap profiler and the memory statistics
+ */
+typedef enum
+{
+  JMEM_ALLOC_CATEGORY_OTHER, /**< not categorized (e.g. temporary buffers of the parser) */
+  JMEM_ALLOC_CATEGORY_OBJECT, /**< objects */
+  JMEM_ALLOC_CATEGORY_EXTENDED_OBJECT, /**< extended objects (e.g. functions, arrays and class objects) */
+  JMEM_ALLOC_CATEGORY_LEXICAL_ENVIRONMENT, /**< lexical environments */
+  JMEM_ALLOC_CATEGORY_STRING, /**< strings whose characters are stored on the heap */
+  JMEM_ALLOC_CATEGORY_EXTERNAL_STRING, /**< strings whose characters are owned by the host */
+  JMEM_ALLOC_CATEGORY_UINT32_STRING, /**< strings which represent an uint32 number */
+  JMEM_ALLOC_CATEGORY_MAGIC_STRING, /**< strings which refer to a magic string */
+  JMEM_ALLOC_CATEGORY_NUMBER, /**< heap allocated numbers */
+  JMEM_ALLOC_CATEGORY_PROPERTY_PAIR, /**< property pairs */
+  JMEM_ALLOC_CATEGORY_HASHMAP, /**< property hashmaps */
+  JMEM_ALLOC_CATEGORY_BYTE_CODE, /**< compiled byte code of functions */
+  JMEM_ALLOC_CATEGORY_REGEXP_BYTE_CODE, /**< compiled byte code of regular expressions */
+  JMEM_ALLOC_CATEGORY_COLLECTION, /**< collection headers and chunks */
+  JMEM_ALLOC_CATEGORY_LITERAL_STORAGE, /**< literal storage items and literal numbers */
+  JMEM_ALLOC_CATEGORY__COUNT /**< number of categories */
+} jmem_alloc_category_t;
+
+#if defined (JERRY_HEAP_PROFILER) || defined (JMEM_STATS)
+
+/**
+ * Set the category of the next allocated block (the category is reset after each allocation)
+ */
+#define JMEM_SET_ALLOC_CATEGORY(category) (JERRY_CONTEXT (jmem_alloc_category) = (uint8_t) (category))
+
+extern const char *jmem_get_alloc_category_name (jmem_alloc_category_t);
+
+#else /* !JERRY_HEAP_PROFILER && !JMEM_STATS */
+
+/**
+ * Set the category of the next allocated block (the category is reset after each allocation)
+ */
+#define JMEM_SET_ALLOC_CATEGORY(category) JERRY_UNUSED (category)
+
+#endif /* JERRY_HEAP_PROFILER || JMEM_STATS */
+
+#ifdef JMEM_STATS
+
+/**
+ * Memory usage statistics of an allocation category
+ */
+typedef struct
+{
+  size_t allocated_bytes; /**< currently allocated bytes */
+  size_t allocated_blocks; /**< currently allocated blocks */
+  size_t peak_allocated_bytes; /**< peak allocated bytes */
+  size_t alloc_count; /**< number of allocations */
+} jmem_alloc_category_stats_t;
+
+#endif /* JMEM_STATS */
+
 /**
  *  Free region node
  */
@@ -90,6 +146,15 @@ typedef struct mem_pools_chunk
  */
 typedef void (*jmem_free_unused_memory_callback_t) (jmem_free_unused_memory_severity_t);
 
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * An allocation tracking callback routine type (called with the block and its size).
+ */
+typedef void (*jmem_track_callback_t) (void *, size_t);
+
+#endif /* JERRY_HEAP_PROFILER */
+
 /**
  * Get value of pointer from specified non-null compressed pointer value
  */
@@ -128,8 +193,25 @@ typedef void (*jmem_free_unused_memory_callback_t) (jmem_free_unused_memory_seve
     } \
   } while (false);
 
+/**
+ * Description of the memory allocator state stored in a heap image
+ */
+typedef struct
+{
+  uint32_t allocated_size; /**< size of allocated regions */
+  uint32_t area_size; /**< size of the heap area stored in the image */
+  uint32_t first_free_offset; /**< heap area offset of the first free region */
+#ifdef JMEM_STATS
+  jmem_heap_stats_t heap_stats; /**< heap's memory usage statistics */
+  jmem_pools_stats_t pools_stats; /**< pools' memory usage statistics */
+#endif /* JMEM_STATS */
+} jmem_image_info_t;
+
 extern void jmem_init (void);
 extern void jmem_finalize (bool);
+extern size_t jmem_get_image_area_size (void);
+extern void jmem_save_image (jmem_image_info_t *, uint8_t *);
+extern bool jmem_load_image (const jmem_image_info_t *, const uint8_t *);
 
 extern uintptr_t jmem_compress_pointer (const void *);
 extern void *jmem_decompress_pointer (uintptr_t);
@@ -137,9 +219,14 @@ extern void *jmem_decompress_pointer (uintptr_t);
 extern void jmem_register_free_unused_memory_callback (jmem_free_unused_memory_callback_t);
 extern void jmem_unregister_free_unused_memory_callback (jmem_free_unused_memory_callback_t);
 
+#ifdef JERRY_HEAP_PROFILER
+extern void jmem_register_track_callbacks (jmem_track_callback_t, jmem_track_callback_t);
+#endif /* JERRY_HEAP_PROFILER */
+
 #ifdef JMEM_STATS
 extern void jmem_stats_reset_peak (void);
 extern void jmem_stats_print (void);
+extern void jmem_get_alloc_category_stats (jmem_alloc_category_t, jmem_alloc_category_stats_t *);
 #endif /* JMEM_STATS */
 
 /**
@@ -165,6 +165,7 @@ jmem_heap_init (void)
   VALGRIND_NOACCESS_SPACE (JERRY_HEAP_CONTEXT (area), JMEM_HEAP_AREA_SIZE);
 
   JMEM_HEAP_STAT_INIT ();
+  JMEM_TRACK_INIT ();
 } /* jmem_heap_init */
 
 /**
@@ -176,6 +177,169 @@ void jmem_heap_finalize (void)
   VALGRIND_NOACCESS_SPACE (&JERRY_HEAP_CONTEXT (first), sizeof (jmem_heap_t));
 } /* jmem_heap_finalize */
 
+/**
+ * End of list marker of free regions stored in a heap image
+ */
+#define JMEM_HEAP_IMAGE_END_OF_LIST UINT32_MAX
+
+/**
+ * Get the size of the heap area which needs to be stored in a heap image
+ *
+ * Note:
+ *      the free region at the end of the heap is not stored, except its header
+ *
+ * @return size of the heap area
+ */
+size_t
+jmem_heap_get_image_area_size (void)
+{
+  const uint32_t end_of_list_offset = JMEM_HEAP_GET_OFFSET_FROM_ADDR (JMEM_HEAP_END_OF_LIST);
+  jmem_heap_free_t *last_p = &JERRY_HEAP_CONTEXT (first);
+  uint32_t next_offset = JERRY_HEAP_CONTEXT (first).next_offset;
+
+  while (next_offset != end_of_list_offset)
+  {
+    last_p = JMEM_HEAP_GET_ADDR_FROM_OFFSET (next_offset);
+
+    VALGRIND_DEFINED_SPACE (last_p, sizeof (jmem_heap_free_t));
+    next_offset = last_p->next_offset;
+    VALGRIND_NOACCESS_SPACE (last_p, sizeof (jmem_heap_free_t));
+  }
+
+  if (last_p != &JERRY_HEAP_CONTEXT (first))
+  {
+    VALGRIND_DEFINED_SPACE (last_p, sizeof (jmem_heap_free_t));
+    uint8_t *region_end_p = (uint8_t *) jmem_heap_get_region_end (last_p);
+    VALGRIND_NOACCESS_SPACE (last_p, sizeof (jmem_heap_free_t));
+
+    if (region_end_p == JERRY_HEAP_CONTEXT (area) + JMEM_HEAP_AREA_SIZE)
+    {
+      return (size_t) ((uint8_t *) last_p - JERRY_HEAP_CONTEXT (area)) + sizeof (jmem_heap_free_t);
+    }
+  }
+
+  return JMEM_HEAP_AREA_SIZE;
+} /* jmem_heap_get_image_area_size */
+
+/**
+ * Copy the heap area into a heap image
+ *
+ * The free region list is stored with heap area offsets, so the
+ * image does not depend on the address of the heap.
+ *
+ * @return heap area offset of the first free region
+ */
+uint32_t
+jmem_heap_save_image_area (uint8_t *area_image_p, /**< [out] heap area of the image */
+                           size_t area_size) /**< size of the heap area,
+                                              *   see also: jmem_heap_get_image_area_size */
+{
+  JERRY_ASSERT (area_size <= JMEM_HEAP_AREA_SIZE);
+
+  VALGRIND_DEFINED_SPACE (JERRY_HEAP_CONTEXT (area), area_size);
+  memcpy (area_image_p, JERRY_HEAP_CONTEXT (area), area_size);
+  VALGRIND_NOACCESS_SPACE (JERRY_HEAP_CONTEXT (area), area_size);
+
+  const uint32_t end_of_list_offset = JMEM_HEAP_GET_OFFSET_FROM_ADDR (JMEM_HEAP_END_OF_LIST);
+  uint32_t next_offset = JERRY_HEAP_CONTEXT (first).next_offset;
+  uint32_t first_offset = JMEM_HEAP_IMAGE_END_OF_LIST;
+  uint32_t *image_next_offset_p = &first_offset;
+
+  while (next_offset != end_of_list_offset)
+  {
+    jmem_heap_free_t *current_p = JMEM_HEAP_GET_ADDR_FROM_OFFSET (next_offset);
+    uint32_t offset = (uint32_t) ((uint8_t *) current_p - JERRY_HEAP_CONTEXT (area));
+    JERRY_ASSERT (offset + sizeof (jmem_heap_free_t) <= area_size);
+
+    *image_next_offset_p = offset;
+
+    jmem_heap_free_t *region_image_p = (jmem_heap_free_t *) (area_image_p + offset);
+    region_image_p->next_offset = JMEM_HEAP_IMAGE_END_OF_LIST;
+    image_next_offset_p = &region_image_p->next_offset;
+
+    VALGRIND_DEFINED_SPACE (current_p, sizeof (jmem_heap_free_t));
+    next_offset = current_p->next_offset;
+    VALGRIND_NOACCESS_SPACE (current_p, sizeof (jmem_heap_free_t));
+  }
+
+  return first_offset;
+} /* jmem_heap_save_image_area */
+
+/**
+ * Initialize the heap from the heap area of a heap image
+ *
+ * Note:
+ *      the free region list of the image is validated, since it is used
+ *      by the allocator: each region must be aligned, it must be inside the
+ *      heap area and the regions must be sorted by their address
+ *
+ * @return true - if the heap is initialized,
+ *         false - if the free region list of the image is invalid
+ */
+bool
+jmem_heap_load_image_area (const uint8_t *area_image_p, /**< heap area of the image */
+                           size_t area_size, /**< size of the heap area */
+                           uint32_t first_offset, /**< heap area offset of the first free region */
+                           size_t allocated_size) /**< size of allocated regions */
+{
+  JERRY_ASSERT (area_size <= JMEM_HEAP_AREA_SIZE);
+
+  if (allocated_size > JMEM_HEAP_AREA_SIZE)
+  {
+    return false;
+  }
+
+  memcpy (JERRY_HEAP_CONTEXT (area), area_image_p, area_size);
+
+  uint32_t *next_offset_p = &JERRY_HEAP_CONTEXT (first).next_offset;
+  uint32_t offset = first_offset;
+  size_t region_end = 0;
+
+  JERRY_HEAP_CONTEXT (first).size = 0;
+
+  while (offset != JMEM_HEAP_IMAGE_END_OF_LIST)
+  {
+    if (offset % JMEM_ALIGNMENT != 0
+        || offset < region_end
+        || offset + sizeof (jmem_heap_free_t) > area_size)
+    {
+      return false;
+    }
+
+    jmem_heap_free_t *region_p = (jmem_heap_free_t *) (JERRY_HEAP_CONTEXT (area) + offset);
+
+    if (region_p->size < sizeof (jmem_heap_free_t)
+        || region_p->size % JMEM_ALIGNMENT != 0
+        || region_p->size > JMEM_HEAP_AREA_SIZE - offset)
+    {
+      return false;
+    }
+
+    /* The regions do not overlap, so the offsets are strictly increasing. */
+    region_end = offset + region_p->size;
+
+    *next_offset_p = JMEM_HEAP_GET_OFFSET_FROM_ADDR (region_p);
+    offset = region_p->next_offset;
+    next_offset_p = &region_p->next_offset;
+  }
+
+  *next_offset_p = JMEM_HEAP_GET_OFFSET_FROM_ADDR (JMEM_HEAP_END_OF_LIST);
+
+  JERRY_CONTEXT (jmem_heap_list_skip_p) = &JERRY_HEAP_CONTEXT (first);
+  JERRY_CONTEXT (jmem_heap_allocated_size) = allocated_size;
+  JERRY_CONTEXT (jmem_heap_limit) = CONFIG_MEM_HEAP_DESIRED_LIMIT;
+
+  while (JERRY_CONTEXT (jmem_heap_allocated_size) >= JERRY_CONTEXT (jmem_heap_limit))
+  {
+    JERRY_CONTEXT (jmem_heap_limit) += CONFIG_MEM_HEAP_DESIRED_LIMIT;
+  }
+
+  JMEM_HEAP_STAT_INIT ();
+  JMEM_TRACK_INIT ();
+
+  return true;
+} /* jmem_heap_load_image_area */
+
 /**
  * Allocation of memory region.
  *
@@ -308,6 +472,13 @@ void *jmem_heap_alloc_block_internal (const size_t size)
   VALGRIND_UNDEFINED_SPACE (data_space_p, size);
   JMEM_HEAP_STAT_ALLOC (size);
 
+#ifdef JERRY_RUNTIME_STATS
+  if (JERRY_CONTEXT (jmem_heap_allocated_size) > JERRY_CONTEXT (jmem_heap_peak_allocated_size))
+  {
+    JERRY_CONTEXT (jmem_heap_peak_allocated_size) = JERRY_CONTEXT (jmem_heap_allocated_size);
+  }
+#endif /* JERRY_RUNTIME_STATS */
+
   return (void *) data_space_p;
 } /* jmem_heap_finalize */
 
@@ -348,6 +519,7 @@ jmem_heap_gc_and_alloc_block (const size_t size,      /**< required memory size
   if (likely (data_space_p != NULL))
   {
     VALGRIND_FREYA_MALLOCLIKE_SPACE (data_space_p, size);
+    JMEM_TRACK_ALLOC (data_space_p, size);
     return data_space_p;
   }
 
@@ -362,6 +534,7 @@ jmem_heap_gc_and_alloc_block (const size_t size,      /**< required memory size
     if (likely (data_space_p != NULL))
     {
       VALGRIND_FREYA_MALLOCLIKE_SPACE (data_space_p, size);
+      JMEM_TRACK_ALLOC (data_space_p, size);
       return data_space_p;
     }
   }
@@ -373,6 +546,7 @@ jmem_heap_gc_and_alloc_block (const size_t size,      /**< required memory size
     jerry_fatal (ERR_OUT_OF_MEMORY);
   }
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_OTHER);
   return data_space_p;
 } /* jmem_heap_gc_and_alloc_block */
 
@@ -444,6 +618,7 @@ jmem_heap_free_block (void *ptr, /**< pointer to beginning of data space of the
 
   VALGRIND_FREYA_FREELIKE_SPACE (ptr);
   VALGRIND_NOACCESS_SPACE (ptr, size);
+  JMEM_TRACK_FREE (ptr, size);
   JMEM_HEAP_STAT_FREE_ITER ();
 
   jmem_heap_free_t *block_p = (jmem_heap_free_t *) ptr;
@@ -661,12 +836,12 @@ jmem_heap_stats_print (void)
                   heap_stats->waste_bytes,
                   heap_stats->peak_allocated_bytes,
                   heap_stats->peak_waste_bytes,
-                  heap_stats->skip_count / heap_stats->nonskip_count,
-                  heap_stats->skip_count % heap_stats->nonskip_count * 10000 / heap_stats->nonskip_count,
-                  heap_stats->alloc_iter_count / heap_stats->alloc_count,
-                  heap_stats->alloc_iter_count % heap_stats->alloc_count * 10000 / heap_stats->alloc_count,
-                  heap_stats->free_iter_count / heap_stats->free_count,
-                  heap_stats->free_iter_count % heap_stats->free_count * 10000 / heap_stats->free_count);
+                  JMEM_STATS_RATIO_INTEGER (heap_stats->skip_count, heap_stats->nonskip_count),
+                  JMEM_STATS_RATIO_FRACTION (heap_stats->skip_count, heap_stats->nonskip_count),
+                  JMEM_STATS_RATIO_INTEGER (heap_stats->alloc_iter_count, heap_stats->alloc_count),
+                  JMEM_STATS_RATIO_FRACTION (heap_stats->alloc_iter_count, heap_stats->alloc_count),
+                  JMEM_STATS_RATIO_INTEGER (heap_stats->free_iter_count, heap_stats->free_count),
+                  JMEM_STATS_RATIO_FRACTION (heap_stats->free_iter_count, heap_stats->free_count));
 } /* jmem_heap_stats_print */
 
 /**
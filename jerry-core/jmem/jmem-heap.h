@@ -31,6 +31,9 @@
 
 extern void jmem_heap_init (void);
 extern void jmem_heap_finalize (void);
+extern size_t jmem_heap_get_image_area_size (void);
+extern uint32_t jmem_heap_save_image_area (uint8_t *, size_t);
+extern bool jmem_heap_load_image_area (const uint8_t *, size_t, uint32_t, size_t);
 extern void *jmem_heap_alloc_block (const size_t);
 extern void *jmem_heap_alloc_block_null_on_error (const size_t);
 extern void jmem_heap_free_block (void *, const size_t);
@@ -116,6 +116,7 @@ jmem_pools_alloc (void)
 
     VALGRIND_UNDEFINED_SPACE (chunk_p, JMEM_POOL_CHUNK_SIZE);
 
+    JMEM_TRACK_ALLOC ((void *) chunk_p, JMEM_POOL_CHUNK_SIZE);
     return (void *) chunk_p;
   }
   else
@@ -133,6 +134,8 @@ jmem_pools_free (void *chunk_p) /**< pointer to the chunk */
 {
   jmem_pools_chunk_t *const chunk_to_free_p = (jmem_pools_chunk_t *) chunk_p;
 
+  JMEM_TRACK_FREE (chunk_p, JMEM_POOL_CHUNK_SIZE);
+
   VALGRIND_DEFINED_SPACE (chunk_to_free_p, JMEM_POOL_CHUNK_SIZE);
 
   chunk_to_free_p->next_p = JERRY_CONTEXT (jmem_free_chunk_p);
@@ -201,8 +204,8 @@ jmem_pools_stats_print (void)
                   pools_stats->pools_count,
                   pools_stats->peak_pools_count,
                   pools_stats->free_chunks,
-                  pools_stats->reused_count / pools_stats->new_alloc_count,
-                  pools_stats->reused_count % pools_stats->new_alloc_count * 10000 / pools_stats->new_alloc_count);
+                  JMEM_STATS_RATIO_INTEGER (pools_stats->reused_count, pools_stats->new_alloc_count),
+                  JMEM_STATS_RATIO_FRACTION (pools_stats->reused_count, pools_stats->new_alloc_count));
 } /* jmem_pools_stats_print */
 
 /**
@@ -24,6 +24,10 @@
 #define JERRY_INTERNAL
 #include "jerry-internal.h"
 
+#ifdef JERRY_HEAP_PROFILER
+#include "vm-heap-profiler.h"
+#endif /* JERRY_HEAP_PROFILER */
+
 /*
  * Exit with specified status code.
  *
@@ -59,6 +63,14 @@ jerry_fatal (jerry_fatal_code_t code) /**< status code */
   }
 #endif /* !JERRY_NDEBUG */
 
+#ifdef JERRY_HEAP_PROFILER
+  if (code == ERR_OUT_OF_MEMORY)
+  {
+    /* The allocation sites of the live blocks show what exhausted the heap. */
+    vm_heap_profiler_print ();
+  }
+#endif /* JERRY_HEAP_PROFILER */
+
   jerry_port_fatal (code);
 
   /* to make compiler happy for some RTOS: 'control reaches end of non-void function' */
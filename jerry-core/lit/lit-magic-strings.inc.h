@@ -255,4 +255,5 @@ LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING__EMPTY, "")
  * Implementation-defined magic strings
  */
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_JERRY_UL, "Jerry")
+LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING_PERFORMANCE, "performance")
 LIT_MAGIC_STRING_DEF (LIT_MAGIC_STRING__FUNCTION_TO_STRING, "function(){/* ecmascript */}")
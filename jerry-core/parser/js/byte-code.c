@@ -47,7 +47,7 @@ const uint8_t cbc_ext_flags[] =
 
 #undef CBC_OPCODE
 
-#ifdef PARSER_DUMP_BYTE_CODE
+#if defined (PARSER_DUMP_BYTE_CODE) || defined (JERRY_VM_OPCODE_STATS)
 
 #define CBC_OPCODE(arg1, arg2, arg3, arg4) #arg1,
 
@@ -69,7 +69,7 @@ const char * const cbc_ext_names[] =
 
 #undef CBC_OPCODE
 
-#endif /* PARSER_DUMP_BYTE_CODE */
+#endif /* PARSER_DUMP_BYTE_CODE || JERRY_VM_OPCODE_STATS */
 
 /**
  * @}
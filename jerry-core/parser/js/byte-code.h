@@ -17,6 +17,8 @@
 #ifndef BYTE_CODE_H
 #define BYTE_CODE_H
 
+#include "common.h"
+
 /** \addtogroup parser Parser
  * @{
  *
@@ -634,6 +636,73 @@ typedef struct
   uint16_t literal_end;             /**< end position of the literal group */
 } cbc_uint16_arguments_t;
 
+/**
+ * Function whose body is compiled on its first call.
+ *
+ * The source code of the function starts after the function keyword
+ * (or after the name of a function statement) and it is not copied:
+ * it must be kept until the function is compiled.
+ */
+typedef struct
+{
+  ecma_compiled_code_t header;      /**< compiled code header */
+  uint16_t argument_end;            /**< number of arguments expected by the function */
+  uint32_t status_flags;            /**< parser status flags of the function */
+  uint32_t line;                    /**< line of the function source */
+  uint32_t column;                  /**< column of the function source */
+  uint32_t source_size;             /**< size of the function source */
+  const uint8_t *source_p;          /**< function source */
+  jmem_cpointer_t bytecode_cp;      /**< compiled byte code (JMEM_CP_NULL before the first call) */
+#ifdef JERRY_LINE_INFO
+  jmem_cpointer_t name_cp;          /**< name of the function (JMEM_CP_NULL if it is anonymous) */
+#endif /* JERRY_LINE_INFO */
+} cbc_lazy_function_t;
+
+/**
+ * Function whose byte code is loaded from a snapshot on its first call.
+ *
+ * The snapshot is not copied: it must be kept until jerry_cleanup.
+ */
+typedef struct
+{
+  ecma_compiled_code_t header;      /**< compiled code header */
+  uint16_t argument_end;            /**< number of arguments expected by the function */
+  uint16_t offset;                  /**< offset of the byte code in the snapshot >> JMEM_ALIGNMENT_LOG */
+  jmem_cpointer_t loader_cp;        /**< snapshot loader shared by the functions of the snapshot */
+  jmem_cpointer_t bytecode_cp;      /**< loaded byte code (JMEM_CP_NULL before the first call) */
+} cbc_snapshot_function_t;
+
+/**
+ * Line info entry: the instructions starting from the byte code offset
+ * (relative to the first instruction) belong to the source line.
+ */
+typedef struct
+{
+  uint32_t offset;                  /**< byte code offset */
+  uint32_t line;                    /**< source line */
+} cbc_line_info_entry_t;
+
+/**
+ * Line info of a compiled code, which is stored at the end of the byte code block
+ * when CBC_CODE_FLAGS_HAS_LINE_INFO is set. It is preceded by its entries, which
+ * are sorted by their byte code offset.
+ */
+typedef struct
+{
+  uint32_t size;                    /**< size of the line info including its entries */
+  uint32_t entry_count;             /**< number of entries */
+  uint32_t line;                    /**< first line of a function (0 for global and eval code) */
+  jmem_cpointer_t name_cp;          /**< name of a function (JMEM_CP_NULL if it is anonymous) */
+} cbc_line_info_t;
+
+/**
+ * Get the line info of a compiled code.
+ */
+#define CBC_GET_LINE_INFO(compiled_code_p) \
+  ((const cbc_line_info_t *) (((const uint8_t *) (compiled_code_p)) \
+                              + (((size_t) (compiled_code_p)->size) << JMEM_ALIGNMENT_LOG) \
+                              - sizeof (cbc_line_info_t)))
+
 /* When CBC_CODE_FLAGS_FULL_LITERAL_ENCODING
  * is not set the small encoding is used. */
 #define CBC_CODE_FLAGS_FUNCTION 0x01
@@ -642,6 +711,9 @@ typedef struct
 #define CBC_CODE_FLAGS_STRICT_MODE 0x08
 #define CBC_CODE_FLAGS_ARGUMENTS_NEEDED 0x10
 #define CBC_CODE_FLAGS_LEXICAL_ENV_NOT_NEEDED 0x20
+#define CBC_CODE_FLAGS_LAZY_FUNCTION 0x40
+#define CBC_CODE_FLAGS_SNAPSHOT_FUNCTION 0x80
+#define CBC_CODE_FLAGS_HAS_LINE_INFO 0x100
 
 #define CBC_OPCODE(arg1, arg2, arg3, arg4) arg1,
 
@@ -669,15 +741,15 @@ typedef enum
 extern const uint8_t cbc_flags[];
 extern const uint8_t cbc_ext_flags[];
 
-#ifdef PARSER_DUMP_BYTE_CODE
+#if defined (PARSER_DUMP_BYTE_CODE) || defined (JERRY_VM_OPCODE_STATS)
 
 /**
- * Opcode names for debugging.
+ * Opcode names for debugging and opcode statistics.
  */
 extern const char * const cbc_names[];
 extern const char * const cbc_ext_names[];
 
-#endif /* PARSER_DUMP_BYTE_CODE */
+#endif /* PARSER_DUMP_BYTE_CODE || JERRY_VM_OPCODE_STATS */
 
 /**
  * @}
@@ -0,0 +1,208 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-helpers.h"
+#include "jcontext.h"
+#include "js-parser-internal.h"
+
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+
+/** \addtogroup parser Parser
+ * @{
+ *
+ * \addtogroup jsparser JavaScript
+ * @{
+ *
+ * \addtogroup jsparser_cache Compiled code cache
+ * @{
+ */
+
+/**
+ * Check whether a source code can be stored in the compiled code cache.
+ *
+ * @return true - if the source can be cached
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+parser_code_cache_is_cacheable (size_t size) /**< size of the source code */
+{
+  return size > 0 && size <= CONFIG_PARSER_CODE_CACHE_MAX_SOURCE_SIZE;
+} /* parser_code_cache_is_cacheable */
+
+/**
+ * Remove an entry from the compiled code cache.
+ */
+static void
+parser_code_cache_remove (uint32_t index) /**< index of the entry */
+{
+  parser_code_cache_entry_t *entry_p = JERRY_CONTEXT (parser_code_cache)[index];
+
+  JERRY_ASSERT (entry_p != NULL);
+
+  JERRY_CONTEXT (parser_code_cache)[index] = NULL;
+
+  ecma_bytecode_deref (entry_p->bytecode_p);
+  jmem_heap_free_block (entry_p, sizeof (parser_code_cache_entry_t) + entry_p->source_size);
+} /* parser_code_cache_remove */
+
+/**
+ * Search a source code in the compiled code cache.
+ *
+ * Note:
+ *      the reference counter of the returned byte code is increased
+ *
+ * @return byte code of the source - if it is found
+ *         NULL - otherwise
+ */
+ecma_compiled_code_t *
+parser_code_cache_find (const uint8_t *source_p, /**< source code */
+                        size_t size, /**< size of the source code */
+                        uint16_t flags) /**< compilation options */
+{
+  if (!parser_code_cache_is_cacheable (size))
+  {
+    return NULL;
+  }
+
+  lit_string_hash_t hash = lit_utf8_string_calc_hash (source_p, (lit_utf8_size_t) size);
+
+  for (uint32_t i = 0; i < CONFIG_PARSER_CODE_CACHE_SIZE; i++)
+  {
+    parser_code_cache_entry_t *entry_p = JERRY_CONTEXT (parser_code_cache)[i];
+
+    if (entry_p != NULL
+        && entry_p->hash == hash
+        && entry_p->source_size == size
+        && entry_p->flags == flags
+        && memcmp (entry_p + 1, source_p, size) == 0)
+    {
+      entry_p->last_used = ++JERRY_CONTEXT (parser_code_cache_counter);
+      JERRY_CONTEXT (parser_code_cache_stats).hits++;
+
+      ecma_bytecode_ref (entry_p->bytecode_p);
+      return entry_p->bytecode_p;
+    }
+  }
+
+  JERRY_CONTEXT (parser_code_cache_stats).misses++;
+  return NULL;
+} /* parser_code_cache_find */
+
+/**
+ * Store a compiled source code in the compiled code cache. When the cache
+ * is full, the least recently used entry is replaced.
+ *
+ * Note:
+ *      the entry is not created if there is not enough memory
+ */
+void
+parser_code_cache_insert (const uint8_t *source_p, /**< source code */
+                          size_t size, /**< size of the source code */
+                          uint16_t flags, /**< compilation options */
+                          ecma_compiled_code_t *bytecode_p) /**< byte code of the source */
+{
+  if (!parser_code_cache_is_cacheable (size))
+  {
+    return;
+  }
+
+  /* The allocation may release entries of the cache, so the
+   * target entry can only be selected after it. */
+  size_t entry_size = sizeof (parser_code_cache_entry_t) + size;
+  parser_code_cache_entry_t *entry_p;
+  entry_p = (parser_code_cache_entry_t *) jmem_heap_alloc_block_null_on_error (entry_size);
+
+  if (entry_p == NULL)
+  {
+    return;
+  }
+
+  uint32_t index = 0;
+
+  for (uint32_t i = 0; i < CONFIG_PARSER_CODE_CACHE_SIZE; i++)
+  {
+    parser_code_cache_entry_t *current_p = JERRY_CONTEXT (parser_code_cache)[i];
+
+    if (current_p == NULL)
+    {
+      index = i;
+      break;
+    }
+
+    if (current_p->last_used < JERRY_CONTEXT (parser_code_cache)[index]->last_used)
+    {
+      index = i;
+    }
+  }
+
+  if (JERRY_CONTEXT (parser_code_cache)[index] != NULL)
+  {
+    parser_code_cache_remove (index);
+    JERRY_CONTEXT (parser_code_cache_stats).evictions++;
+  }
+
+  ecma_bytecode_ref (bytecode_p);
+
+  entry_p->bytecode_p = bytecode_p;
+  entry_p->source_size = (uint32_t) size;
+  entry_p->last_used = ++JERRY_CONTEXT (parser_code_cache_counter);
+  entry_p->hash = lit_utf8_string_calc_hash (source_p, (lit_utf8_size_t) size);
+  entry_p->flags = flags;
+  memcpy (entry_p + 1, source_p, size);
+
+  JERRY_CONTEXT (parser_code_cache)[index] = entry_p;
+} /* parser_code_cache_insert */
+
+/**
+ * Release those entries of the compiled code cache, whose
+ * byte code is not used by any function or running code.
+ */
+void
+parser_code_cache_release_unused (void)
+{
+  for (uint32_t i = 0; i < CONFIG_PARSER_CODE_CACHE_SIZE; i++)
+  {
+    parser_code_cache_entry_t *entry_p = JERRY_CONTEXT (parser_code_cache)[i];
+
+    if (entry_p != NULL && entry_p->bytecode_p->refs == 1)
+    {
+      parser_code_cache_remove (i);
+      JERRY_CONTEXT (parser_code_cache_stats).releases++;
+    }
+  }
+} /* parser_code_cache_release_unused */
+
+/**
+ * Remove all entries of the compiled code cache.
+ */
+void
+parser_code_cache_free (void)
+{
+  for (uint32_t i = 0; i < CONFIG_PARSER_CODE_CACHE_SIZE; i++)
+  {
+    if (JERRY_CONTEXT (parser_code_cache)[i] != NULL)
+    {
+      parser_code_cache_remove (i);
+    }
+  }
+} /* parser_code_cache_free */
+
+/**
+ * @}
+ * @}
+ * @}
+ */
+
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
@@ -52,6 +52,7 @@
 #define PARSER_ARGUMENTS_NOT_NEEDED           0x04000u
 #define PARSER_LEXICAL_ENV_NEEDED             0x08000u
 #define PARSER_HAS_LATE_LIT_INIT              0x10000u
+#define PARSER_LAZY_FUNCTIONS                 0x20000u
 
 /* Expression parsing flags. */
 #define PARSE_EXPR                            0x00
@@ -200,6 +201,21 @@ typedef struct parser_branch_node_t
   parser_branch_t branch;                     /**< branch */
 } parser_branch_node_t;
 
+#ifdef JERRY_LINE_INFO
+
+/**
+ * Line info mark: the instruction which starts at the
+ * byte code stream position belongs to the source line.
+ */
+typedef struct
+{
+  parser_mem_page_t *page_p;                  /**< page of the byte code stream (NULL before the first page) */
+  uint32_t position;                          /**< position in the page */
+  parser_line_counter_t line;                 /**< source line */
+} parser_line_info_t;
+
+#endif /* JERRY_LINE_INFO */
+
 /**
  * Those members of a context which needs
  * to be saved when a sub-function is parsed.
@@ -223,6 +239,13 @@ typedef struct parser_saved_context_t
   uint32_t byte_code_size;                    /**< byte code size for branches */
   parser_mem_data_t literal_pool_data;        /**< literal list */
 
+#ifdef JERRY_LINE_INFO
+  parser_mem_data_t line_info_data;           /**< line info list */
+  parser_line_counter_t line_info_last_line;  /**< last line stored in the line info list */
+  parser_line_counter_t function_line;        /**< first line of the function */
+  jmem_cpointer_t function_name_cp;           /**< name of the function */
+#endif /* JERRY_LINE_INFO */
+
 #ifdef PARSER_DEBUG
   uint16_t context_stack_depth;               /**< current context stack depth */
 #endif /* PARSER_DEBUG */
@@ -271,6 +294,15 @@ typedef struct
   parser_mem_page_t *free_page_p;             /**< space for fast allocation */
   uint8_t stack_top_uint8;                    /**< top byte stored on the stack */
 
+#ifdef JERRY_LINE_INFO
+  /* Line info members. */
+  parser_list_t line_info;                    /**< line info list */
+  parser_line_counter_t line_info_last_line;  /**< last line stored in the line info list */
+  parser_line_counter_t function_line;        /**< first line of the current function */
+  jmem_cpointer_t function_name_cp;           /**< name of the current function
+                                               *   (JMEM_CP_NULL if it is anonymous) */
+#endif /* JERRY_LINE_INFO */
+
 #ifdef PARSER_DEBUG
   /* Variables for debugging / logging. */
   uint16_t context_stack_depth;               /**< current context stack depth */
@@ -335,6 +367,10 @@ void parser_set_branch_to_current_position (parser_context_t *, parser_branch_t
 void parser_set_breaks_to_current_position (parser_context_t *, parser_branch_node_t *);
 void parser_set_continues_to_current_position (parser_context_t *, parser_branch_node_t *);
 
+#ifdef JERRY_LINE_INFO
+void parser_add_line_info (parser_context_t *);
+#endif /* JERRY_LINE_INFO */
+
 /* Convenience macros. */
 #define parser_emit_cbc_ext(context_p, opcode) \
   parser_emit_cbc ((context_p), PARSER_TO_EXT_OPCODE (opcode))
@@ -368,6 +404,21 @@ void parser_scan_until (parser_context_t *, lexer_range_t *, lexer_token_type_t)
 ecma_compiled_code_t *parser_parse_function (parser_context_t *, uint32_t);
 void parser_free_jumps (parser_stack_iterator_t);
 
+/* Compiled code cache. */
+
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+
+/**
+ * Compilation options stored in the compiled code cache.
+ */
+#define PARSER_CODE_CACHE_IS_STRICT 0x1u
+#define PARSER_CODE_CACHE_LAZY_FUNCTIONS 0x2u
+
+ecma_compiled_code_t *parser_code_cache_find (const uint8_t *, size_t, uint16_t);
+void parser_code_cache_insert (const uint8_t *, size_t, uint16_t, ecma_compiled_code_t *);
+
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
 /* Error management. */
 
 void parser_raise_error (parser_context_t *, parser_error_t);
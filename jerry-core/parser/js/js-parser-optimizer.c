@@ -0,0 +1,2231 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-helpers.h"
+#include "ecma-literal-storage.h"
+#include "ecma-number-arithmetic.h"
+#include "jcontext.h"
+#include "js-parser-internal.h"
+
+#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+
+/** \addtogroup parser Parser
+ * @{
+ *
+ * \addtogroup jsparser JavaScript
+ * @{
+ *
+ * \addtogroup jsparser_optimizer Byte code optimizer
+ * @{
+ *
+ * The optimizer rewrites the byte code of a compiled function before it is
+ * stored in a snapshot. Since snapshots are generated ahead of time, the
+ * time spent here is not paid by the devices which execute them.
+ *
+ * The byte code is decoded into an instruction array, which is simplified by
+ * constant folding, dead branch elimination, peephole fusion of literal
+ * arguments, jump threading and unreachable code removal. Afterwards unused
+ * registers and literals are dropped, constants are reordered by use count,
+ * and the instructions are encoded again with the shortest branch offsets.
+ */
+
+/**
+ * Maximum number of constants created by the optimizer for a function.
+ */
+#define PARSER_OPT_MAXIMUM_NEW_LITERALS 64
+
+/**
+ * Maximum number of optimization rounds.
+ */
+#define PARSER_OPT_MAXIMUM_ROUNDS 8
+
+/**
+ * Maximum number of jumps followed by jump threading.
+ */
+#define PARSER_OPT_MAXIMUM_JUMP_CHAIN 16
+
+/**
+ * Instruction is removed.
+ */
+#define PARSER_OPT_REMOVED 0x01
+
+/**
+ * Instruction is the target of a branch.
+ */
+#define PARSER_OPT_TARGET 0x02
+
+/**
+ * Instruction is reachable.
+ */
+#define PARSER_OPT_REACHABLE 0x04
+
+/**
+ * Literal index of removed literals.
+ */
+#define PARSER_OPT_NO_LITERAL 0xffff
+
+/**
+ * Decoded instruction.
+ */
+typedef struct
+{
+  uint32_t offset;                          /**< byte code offset of the original instruction */
+  uint32_t argument;                        /**< branch: index of the target instruction,
+                                             *   CBC_INITIALIZE_VARS: index of the first initial value */
+  uint16_t literals[3];                     /**< literal arguments */
+  uint16_t opcode;                          /**< opcode (branch opcodes are stored as their forward,
+                                             *   one byte offset variant) */
+  uint8_t literal_count;                    /**< number of literal arguments */
+  uint8_t byte_arg;                         /**< byte argument */
+  uint8_t branch_length;                    /**< length of the branch offset (0 for non-branches) */
+  uint8_t flags;                            /**< PARSER_OPT_* flags */
+} parser_opt_instr_t;
+
+/**
+ * Types of constant values.
+ */
+typedef enum
+{
+  PARSER_OPT_VALUE_UNDEFINED,               /**< undefined */
+  PARSER_OPT_VALUE_BOOLEAN,                 /**< boolean */
+  PARSER_OPT_VALUE_NUMBER,                  /**< number */
+  PARSER_OPT_VALUE_STRING,                  /**< string stored in the literal storage */
+} parser_opt_value_type_t;
+
+/**
+ * Constant value.
+ */
+typedef struct
+{
+  parser_opt_value_type_t type;             /**< value type */
+  bool boolean;                             /**< value of booleans */
+  ecma_number_t number;                     /**< value of numbers */
+  jmem_cpointer_t string_cp;                /**< value of strings */
+} parser_opt_value_t;
+
+/**
+ * Optimizer context.
+ */
+typedef struct
+{
+  parser_opt_instr_t *instrs_p;             /**< instructions */
+  uint32_t instr_count;                     /**< number of instructions */
+  uint16_t *init_values_p;                  /**< initial values of CBC_INITIALIZE_VARS instructions */
+  uint32_t init_value_count;                /**< number of initial values */
+  const jmem_cpointer_t *literal_table_p;   /**< literal table of the original byte code */
+  jmem_cpointer_t new_literals[PARSER_OPT_MAXIMUM_NEW_LITERALS]; /**< constants created by the optimizer,
+                                                                  *   their indicies start from literal_end */
+  uint16_t new_literal_count;               /**< number of constants created by the optimizer */
+  uint16_t stack_limit;                     /**< maximum number of values stored on the stack */
+  uint16_t argument_end;                    /**< end position of the argument group */
+  uint16_t register_end;                    /**< end position of the register group */
+  uint16_t ident_end;                       /**< end position of the identifier group */
+  uint16_t const_literal_end;               /**< end position of the const literal group */
+  uint16_t literal_end;                     /**< end position of the literal group */
+} parser_opt_context_t;
+
+/**
+ * Decode a literal index.
+ *
+ * @return byte code position after the literal index
+ */
+static const uint8_t *
+parser_opt_decode_literal (const uint8_t *byte_code_p, /**< byte code position */
+                           uint16_t encoding_flags, /**< status flags of the byte code */
+                           uint16_t *literal_index_p) /**< [out] literal index */
+{
+  uint32_t literal_index = *byte_code_p++;
+
+  if (!(encoding_flags & CBC_CODE_FLAGS_FULL_LITERAL_ENCODING))
+  {
+    if (literal_index >= CBC_MAXIMUM_BYTE_VALUE)
+    {
+      literal_index = CBC_MAXIMUM_BYTE_VALUE + *byte_code_p++;
+    }
+  }
+  else if (literal_index & CBC_HIGHEST_BIT_MASK)
+  {
+    literal_index = ((literal_index & CBC_LOWER_SEVEN_BIT_MASK) << 8) | *byte_code_p++;
+  }
+
+  *literal_index_p = (uint16_t) literal_index;
+  return byte_code_p;
+} /* parser_opt_decode_literal */
+
+/**
+ * Get the forward variant of a backward branch.
+ *
+ * @return forward opcode - if the branch has a forward variant
+ *         the original opcode - otherwise
+ */
+static uint16_t
+parser_opt_get_forward_opcode (uint16_t opcode) /**< branch opcode */
+{
+  switch (opcode)
+  {
+    case CBC_JUMP_BACKWARD:
+    {
+      return CBC_JUMP_FORWARD;
+    }
+    case CBC_BRANCH_IF_TRUE_BACKWARD:
+    {
+      return CBC_BRANCH_IF_TRUE_FORWARD;
+    }
+    case CBC_BRANCH_IF_FALSE_BACKWARD:
+    {
+      return CBC_BRANCH_IF_FALSE_FORWARD;
+    }
+    default:
+    {
+      return opcode;
+    }
+  }
+} /* parser_opt_get_forward_opcode */
+
+/**
+ * Get the backward variant of a forward branch.
+ *
+ * @return backward opcode - if the branch has a backward variant
+ *         CBC_EXT_OPCODE - otherwise
+ */
+static uint16_t
+parser_opt_get_backward_opcode (uint16_t opcode) /**< branch opcode */
+{
+  switch (opcode)
+  {
+    case CBC_JUMP_FORWARD:
+    {
+      return CBC_JUMP_BACKWARD;
+    }
+    case CBC_BRANCH_IF_TRUE_FORWARD:
+    {
+      return CBC_BRANCH_IF_TRUE_BACKWARD;
+    }
+    case CBC_BRANCH_IF_FALSE_FORWARD:
+    {
+      return CBC_BRANCH_IF_FALSE_BACKWARD;
+    }
+    default:
+    {
+      return CBC_EXT_OPCODE;
+    }
+  }
+} /* parser_opt_get_backward_opcode */
+
+/**
+ * Checks whether the execution never continues with the next instruction.
+ *
+ * @return true - if the instruction does not fall through
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+parser_opt_is_terminator (uint16_t opcode) /**< opcode */
+{
+  return (opcode == CBC_JUMP_FORWARD
+          || opcode == CBC_JUMP_FORWARD_EXIT_CONTEXT
+          || opcode == CBC_THROW
+          || PARSER_OPCODE_IS_RETURN (opcode));
+} /* parser_opt_is_terminator */
+
+/**
+ * Decode an instruction.
+ *
+ * Note:
+ *      the argument of branches is set to the byte code offset of the target
+ *
+ * @return byte code offset after the instruction - if the instruction is valid
+ *         0 - otherwise
+ */
+static uint32_t
+parser_opt_decode_instr (const uint8_t *byte_code_start_p, /**< start of the byte code */
+                         uint32_t code_size, /**< size of the byte code */
+                         uint16_t encoding_flags, /**< status flags of the byte code */
+                         uint32_t offset, /**< offset of the instruction */
+                         parser_opt_instr_t *instr_p, /**< [out] decoded instruction */
+                         uint16_t *init_values_p) /**< [out] initial values of CBC_INITIALIZE_VARS
+                                                   *         (can be NULL) */
+{
+  const uint8_t *byte_code_p = byte_code_start_p + offset;
+  uint16_t opcode = *byte_code_p++;
+  uint8_t flags;
+
+  if (opcode == CBC_EXT_OPCODE)
+  {
+    opcode = PARSER_TO_EXT_OPCODE (*byte_code_p++);
+    flags = cbc_ext_flags[PARSER_GET_EXT_OPCODE (opcode)];
+  }
+  else
+  {
+    if (opcode == CBC_SET_BYTECODE_PTR || opcode == CBC_END)
+    {
+      return 0;
+    }
+
+    flags = cbc_flags[opcode];
+  }
+
+  instr_p->offset = offset;
+  instr_p->argument = 0;
+  instr_p->opcode = opcode;
+  instr_p->literal_count = 0;
+  instr_p->byte_arg = 0;
+  instr_p->branch_length = 0;
+  instr_p->flags = 0;
+
+  if (flags & (CBC_HAS_LITERAL_ARG | CBC_HAS_LITERAL_ARG2))
+  {
+    uint8_t literal_count = 1;
+
+    if (flags & CBC_HAS_LITERAL_ARG2)
+    {
+      literal_count = (flags & CBC_HAS_LITERAL_ARG) ? 2 : 3;
+    }
+
+    for (uint8_t i = 0; i < literal_count; i++)
+    {
+      byte_code_p = parser_opt_decode_literal (byte_code_p, encoding_flags, instr_p->literals + i);
+    }
+
+    instr_p->literal_count = literal_count;
+  }
+
+  if (opcode == CBC_INITIALIZE_VARS)
+  {
+    if (instr_p->literals[1] < instr_p->literals[0])
+    {
+      return 0;
+    }
+
+    uint32_t value_count = (uint32_t) (instr_p->literals[1] - instr_p->literals[0]) + 1;
+    uint16_t value;
+
+    for (uint32_t i = 0; i < value_count; i++)
+    {
+      byte_code_p = parser_opt_decode_literal (byte_code_p,
+                                               encoding_flags,
+                                               init_values_p != NULL ? init_values_p + i : &value);
+    }
+
+    instr_p->argument = value_count;
+  }
+
+  if (flags & CBC_HAS_BYTE_ARG)
+  {
+    instr_p->byte_arg = *byte_code_p++;
+  }
+
+  if (flags & CBC_HAS_BRANCH_ARG)
+  {
+    uint8_t branch_length = (uint8_t) CBC_BRANCH_OFFSET_LENGTH (opcode);
+    uint32_t distance = 0;
+
+    for (uint8_t i = 0; i < branch_length; i++)
+    {
+      distance = (distance << 8) | *byte_code_p++;
+    }
+
+    if (CBC_BRANCH_IS_FORWARD (flags))
+    {
+      instr_p->argument = offset + distance;
+    }
+    else
+    {
+      if (distance > offset)
+      {
+        return 0;
+      }
+
+      instr_p->argument = offset - distance;
+    }
+
+    instr_p->branch_length = branch_length;
+    instr_p->opcode = parser_opt_get_forward_opcode ((uint16_t) (opcode - (branch_length - 1)));
+
+    if (instr_p->argument >= code_size)
+    {
+      return 0;
+    }
+  }
+
+  uint32_t next_offset = (uint32_t) (byte_code_p - byte_code_start_p);
+  return (next_offset <= code_size) ? next_offset : 0;
+} /* parser_opt_decode_instr */
+
+/**
+ * Get the first non-removed instruction starting from an index.
+ *
+ * @return instruction index (instr_count if there is no such instruction)
+ */
+static inline uint32_t __attr_always_inline___
+parser_opt_live (const parser_opt_context_t *context_p, /**< context */
+                 uint32_t index) /**< instruction index */
+{
+  while (index < context_p->instr_count && (context_p->instrs_p[index].flags & PARSER_OPT_REMOVED))
+  {
+    index++;
+  }
+
+  return index;
+} /* parser_opt_live */
+
+/**
+ * Get the next non-removed instruction.
+ *
+ * @return instruction index (instr_count if there is no such instruction)
+ */
+static inline uint32_t __attr_always_inline___
+parser_opt_next (const parser_opt_context_t *context_p, /**< context */
+                 uint32_t index) /**< instruction index */
+{
+  return parser_opt_live (context_p, index + 1);
+} /* parser_opt_next */
+
+/**
+ * Remove an instruction. Branches to the instruction continue
+ * with the next instruction, which becomes a branch target.
+ */
+static void
+parser_opt_remove (parser_opt_context_t *context_p, /**< context */
+                   uint32_t index) /**< instruction index */
+{
+  parser_opt_instr_t *instr_p = context_p->instrs_p + index;
+
+  instr_p->flags |= PARSER_OPT_REMOVED;
+
+  if (instr_p->flags & PARSER_OPT_TARGET)
+  {
+    uint32_t next_index = parser_opt_next (context_p, index);
+
+    if (next_index < context_p->instr_count)
+    {
+      context_p->instrs_p[next_index].flags |= PARSER_OPT_TARGET;
+    }
+  }
+} /* parser_opt_remove */
+
+/**
+ * Recompute the branch targets.
+ */
+static void
+parser_opt_update_targets (parser_opt_context_t *context_p) /**< context */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+
+  for (uint32_t i = 0; i < context_p->instr_count; i++)
+  {
+    instrs_p[i].flags &= (uint8_t) ~PARSER_OPT_TARGET;
+  }
+
+  for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+  {
+    if (instrs_p[i].branch_length > 0)
+    {
+      uint32_t target = parser_opt_live (context_p, instrs_p[i].argument);
+
+      JERRY_ASSERT (target < context_p->instr_count);
+
+      instrs_p[i].argument = target;
+      instrs_p[target].flags |= PARSER_OPT_TARGET;
+    }
+  }
+} /* parser_opt_update_targets */
+
+/**
+ * Checks whether a literal index refers to a constant literal.
+ *
+ * @return true - if the literal is a constant
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+parser_opt_is_const_literal (const parser_opt_context_t *context_p, /**< context */
+                             uint16_t literal_index) /**< literal index */
+{
+  return ((literal_index >= context_p->ident_end && literal_index < context_p->const_literal_end)
+          || literal_index >= context_p->literal_end);
+} /* parser_opt_is_const_literal */
+
+/**
+ * Get the value of a constant literal.
+ *
+ * @return true - if the literal is a constant
+ *         false - otherwise
+ */
+static bool
+parser_opt_get_literal_value (const parser_opt_context_t *context_p, /**< context */
+                              uint16_t literal_index, /**< literal index */
+                              parser_opt_value_t *value_p) /**< [out] value */
+{
+  jmem_cpointer_t literal_cp;
+
+  if (literal_index >= context_p->ident_end && literal_index < context_p->const_literal_end)
+  {
+    literal_cp = context_p->literal_table_p[literal_index];
+  }
+  else if (literal_index >= context_p->literal_end)
+  {
+    literal_cp = context_p->new_literals[literal_index - context_p->literal_end];
+  }
+  else
+  {
+    return false;
+  }
+
+  ecma_string_t *literal_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, literal_cp);
+
+  if (ECMA_STRING_GET_CONTAINER (literal_p) == ECMA_STRING_LITERAL_NUMBER)
+  {
+    value_p->type = PARSER_OPT_VALUE_NUMBER;
+    value_p->number = ecma_get_number_from_value (literal_p->u.lit_number);
+  }
+  else
+  {
+    value_p->type = PARSER_OPT_VALUE_STRING;
+    value_p->string_cp = literal_cp;
+  }
+
+  return true;
+} /* parser_opt_get_literal_value */
+
+/**
+ * Get the value pushed by an instruction.
+ *
+ * @return true - if the instruction pushes a constant value
+ *         false - otherwise
+ */
+static bool
+parser_opt_get_push_value (const parser_opt_context_t *context_p, /**< context */
+                           const parser_opt_instr_t *instr_p, /**< instruction */
+                           parser_opt_value_t *value_p) /**< [out] value */
+{
+  switch (instr_p->opcode)
+  {
+    case CBC_PUSH_UNDEFINED:
+    {
+      value_p->type = PARSER_OPT_VALUE_UNDEFINED;
+      return true;
+    }
+    case CBC_PUSH_TRUE:
+    case CBC_PUSH_FALSE:
+    {
+      value_p->type = PARSER_OPT_VALUE_BOOLEAN;
+      value_p->boolean = (instr_p->opcode == CBC_PUSH_TRUE);
+      return true;
+    }
+    case CBC_PUSH_NUMBER_0:
+    {
+      value_p->type = PARSER_OPT_VALUE_NUMBER;
+      value_p->number = 0;
+      return true;
+    }
+    case CBC_PUSH_NUMBER_POS_BYTE:
+    {
+      value_p->type = PARSER_OPT_VALUE_NUMBER;
+      value_p->number = (ecma_number_t) (instr_p->byte_arg + 1);
+      return true;
+    }
+    case CBC_PUSH_NUMBER_NEG_BYTE:
+    {
+      value_p->type = PARSER_OPT_VALUE_NUMBER;
+      value_p->number = -((ecma_number_t) (instr_p->byte_arg + 1));
+      return true;
+    }
+    case CBC_PUSH_LITERAL:
+    {
+      return parser_opt_get_literal_value (context_p, instr_p->literals[0], value_p);
+    }
+    default:
+    {
+      return false;
+    }
+  }
+} /* parser_opt_get_push_value */
+
+/**
+ * Find a constant literal or append it to the new literals.
+ *
+ * @return true - if the literal has an index
+ *         false - otherwise (too many new literals)
+ */
+static bool
+parser_opt_find_or_add_literal (parser_opt_context_t *context_p, /**< context */
+                                jmem_cpointer_t literal_cp, /**< literal */
+                                uint16_t *literal_index_p) /**< [out] literal index */
+{
+  for (uint32_t i = context_p->ident_end; i < context_p->const_literal_end; i++)
+  {
+    if (context_p->literal_table_p[i] == literal_cp)
+    {
+      *literal_index_p = (uint16_t) i;
+      return true;
+    }
+  }
+
+  for (uint32_t i = 0; i < context_p->new_literal_count; i++)
+  {
+    if (context_p->new_literals[i] == literal_cp)
+    {
+      *literal_index_p = (uint16_t) (context_p->literal_end + i);
+      return true;
+    }
+  }
+
+  if (context_p->new_literal_count >= PARSER_OPT_MAXIMUM_NEW_LITERALS
+      || context_p->literal_end + context_p->new_literal_count >= PARSER_MAXIMUM_NUMBER_OF_LITERALS)
+  {
+    return false;
+  }
+
+  *literal_index_p = (uint16_t) (context_p->literal_end + context_p->new_literal_count);
+  context_p->new_literals[context_p->new_literal_count++] = literal_cp;
+  return true;
+} /* parser_opt_find_or_add_literal */
+
+/**
+ * Replace an instruction with an instruction which pushes a constant value.
+ *
+ * @return true - if the instruction is replaced
+ *         false - otherwise (the value cannot be represented)
+ */
+static bool
+parser_opt_set_push_value (parser_opt_context_t *context_p, /**< context */
+                           parser_opt_instr_t *instr_p, /**< instruction */
+                           const parser_opt_value_t *value_p) /**< value */
+{
+  uint16_t opcode = CBC_PUSH_LITERAL;
+  uint16_t literal_index = PARSER_OPT_NO_LITERAL;
+  uint8_t byte_arg = 0;
+
+  switch (value_p->type)
+  {
+    case PARSER_OPT_VALUE_UNDEFINED:
+    {
+      opcode = CBC_PUSH_UNDEFINED;
+      break;
+    }
+    case PARSER_OPT_VALUE_BOOLEAN:
+    {
+      opcode = value_p->boolean ? CBC_PUSH_TRUE : CBC_PUSH_FALSE;
+      break;
+    }
+    case PARSER_OPT_VALUE_NUMBER:
+    {
+      ecma_number_t number = value_p->number;
+
+      if (!ecma_number_is_nan (number) && ecma_number_is_zero (number) && ecma_number_is_negative (number))
+      {
+        /* Negative zero has no byte code representation. */
+        return false;
+      }
+
+      if (number >= -CBC_PUSH_NUMBER_BYTE_RANGE_END
+          && number <= CBC_PUSH_NUMBER_BYTE_RANGE_END
+          && (ecma_number_t) (int32_t) number == number)
+      {
+        int32_t integer = (int32_t) number;
+
+        if (integer == 0)
+        {
+          opcode = CBC_PUSH_NUMBER_0;
+        }
+        else if (integer > 0)
+        {
+          opcode = CBC_PUSH_NUMBER_POS_BYTE;
+          byte_arg = (uint8_t) (integer - 1);
+        }
+        else
+        {
+          opcode = CBC_PUSH_NUMBER_NEG_BYTE;
+          byte_arg = (uint8_t) (-integer - 1);
+        }
+        break;
+      }
+
+      if (!parser_opt_find_or_add_literal (context_p, ecma_find_or_create_literal_number (number), &literal_index))
+      {
+        return false;
+      }
+      break;
+    }
+    default:
+    {
+      JERRY_ASSERT (value_p->type == PARSER_OPT_VALUE_STRING);
+
+      if (!parser_opt_find_or_add_literal (context_p, value_p->string_cp, &literal_index))
+      {
+        return false;
+      }
+      break;
+    }
+  }
+
+  instr_p->opcode = opcode;
+  instr_p->literals[0] = literal_index;
+  instr_p->literal_count = (uint8_t) ((literal_index != PARSER_OPT_NO_LITERAL) ? 1 : 0);
+  instr_p->byte_arg = byte_arg;
+  instr_p->branch_length = 0;
+  return true;
+} /* parser_opt_set_push_value */
+
+/**
+ * Convert a constant value to boolean.
+ *
+ * @return boolean value
+ */
+static bool
+parser_opt_to_boolean (const parser_opt_value_t *value_p) /**< value */
+{
+  switch (value_p->type)
+  {
+    case PARSER_OPT_VALUE_UNDEFINED:
+    {
+      return false;
+    }
+    case PARSER_OPT_VALUE_BOOLEAN:
+    {
+      return value_p->boolean;
+    }
+    case PARSER_OPT_VALUE_NUMBER:
+    {
+      return !ecma_number_is_nan (value_p->number) && !ecma_number_is_zero (value_p->number);
+    }
+    default:
+    {
+      JERRY_ASSERT (value_p->type == PARSER_OPT_VALUE_STRING);
+      return !ecma_string_is_empty (JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, value_p->string_cp));
+    }
+  }
+} /* parser_opt_to_boolean */
+
+/**
+ * Evaluate an unary operation on a constant value.
+ *
+ * @return true - if the result is computed
+ *         false - otherwise
+ */
+static bool
+parser_opt_fold_unary (uint16_t opcode, /**< unary opcode (stack form) */
+                       const parser_opt_value_t *value_p, /**< operand */
+                       parser_opt_value_t *result_p) /**< [out] result */
+{
+  if (opcode == CBC_LOGICAL_NOT)
+  {
+    result_p->type = PARSER_OPT_VALUE_BOOLEAN;
+    result_p->boolean = !parser_opt_to_boolean (value_p);
+    return true;
+  }
+
+  if (opcode == CBC_VOID)
+  {
+    result_p->type = PARSER_OPT_VALUE_UNDEFINED;
+    return true;
+  }
+
+  if (value_p->type != PARSER_OPT_VALUE_NUMBER)
+  {
+    return false;
+  }
+
+  result_p->type = PARSER_OPT_VALUE_NUMBER;
+
+  switch (opcode)
+  {
+    case CBC_PLUS:
+    {
+      result_p->number = value_p->number;
+      return true;
+    }
+    case CBC_NEGATE:
+    {
+      result_p->number = -value_p->number;
+      return true;
+    }
+    case CBC_BIT_NOT:
+    {
+      result_p->number = (ecma_number_t) ((int32_t) ~ecma_number_to_uint32 (value_p->number));
+      return true;
+    }
+    default:
+    {
+      return false;
+    }
+  }
+} /* parser_opt_fold_unary */
+
+/**
+ * Concatenate two constant strings.
+ *
+ * @return true - if the result is computed
+ *         false - otherwise
+ */
+static bool
+parser_opt_concat_strings (jmem_cpointer_t left_cp, /**< left string */
+                           jmem_cpointer_t right_cp, /**< right string */
+                           parser_opt_value_t *result_p) /**< [out] result */
+{
+  ecma_string_t *left_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, left_cp);
+  ecma_string_t *right_p = JMEM_CP_GET_NON_NULL_POINTER (ecma_string_t, right_cp);
+
+  if (ecma_string_get_size (left_p) + ecma_string_get_size (right_p) > PARSER_MAXIMUM_STRING_LENGTH)
+  {
+    return false;
+  }
+
+  ecma_string_t *string_p = ecma_concat_ecma_strings (left_p, right_p);
+
+  ECMA_STRING_TO_UTF8_STRING (string_p, string_buffer_p, string_buffer_size);
+
+  result_p->type = PARSER_OPT_VALUE_STRING;
+  result_p->string_cp = ecma_find_or_create_literal_string (string_buffer_p, string_buffer_size);
+
+  ECMA_FINALIZE_UTF8_STRING (string_buffer_p, string_buffer_size);
+
+  ecma_deref_ecma_string (string_p);
+  return true;
+} /* parser_opt_concat_strings */
+
+/**
+ * Evaluate a binary operation on constant values.
+ *
+ * @return true - if the result is computed
+ *         false - otherwise
+ */
+static bool
+parser_opt_fold_binary (uint16_t opcode, /**< binary opcode (stack form) */
+                        const parser_opt_value_t *left_p, /**< left operand */
+                        const parser_opt_value_t *right_p, /**< right operand */
+                        parser_opt_value_t *result_p) /**< [out] result */
+{
+  if (opcode == CBC_ADD
+      && left_p->type == PARSER_OPT_VALUE_STRING
+      && right_p->type == PARSER_OPT_VALUE_STRING)
+  {
+    return parser_opt_concat_strings (left_p->string_cp, right_p->string_cp, result_p);
+  }
+
+  if (left_p->type != PARSER_OPT_VALUE_NUMBER || right_p->type != PARSER_OPT_VALUE_NUMBER)
+  {
+    return false;
+  }
+
+  ecma_number_t left = left_p->number;
+  ecma_number_t right = right_p->number;
+  uint32_t shift = ecma_number_to_uint32 (right) & 0x1f;
+
+  result_p->type = PARSER_OPT_VALUE_NUMBER;
+
+  switch (opcode)
+  {
+    case CBC_BIT_OR:
+    {
+      result_p->number = (ecma_number_t) ((int32_t) (ecma_number_to_uint32 (left) | ecma_number_to_uint32 (right)));
+      return true;
+    }
+    case CBC_BIT_XOR:
+    {
+      result_p->number = (ecma_number_t) ((int32_t) (ecma_number_to_uint32 (left) ^ ecma_number_to_uint32 (right)));
+      return true;
+    }
+    case CBC_BIT_AND:
+    {
+      result_p->number = (ecma_number_t) ((int32_t) (ecma_number_to_uint32 (left) & ecma_number_to_uint32 (right)));
+      return true;
+    }
+    case CBC_LEFT_SHIFT:
+    {
+      result_p->number = (ecma_number_t) ((int32_t) (ecma_number_to_uint32 (left) << shift));
+      return true;
+    }
+    case CBC_RIGHT_SHIFT:
+    {
+      result_p->number = (ecma_number_t) (ecma_number_to_int32 (left) >> shift);
+      return true;
+    }
+    case CBC_UNS_RIGHT_SHIFT:
+    {
+      result_p->number = (ecma_number_t) (ecma_number_to_uint32 (left) >> shift);
+      return true;
+    }
+    case CBC_ADD:
+    {
+      result_p->number = left + right;
+      return true;
+    }
+    case CBC_SUBTRACT:
+    {
+      result_p->number = left - right;
+      return true;
+    }
+    case CBC_MULTIPLY:
+    {
+      result_p->number = left * right;
+      return true;
+    }
+    case CBC_DIVIDE:
+    {
+      result_p->number = left / right;
+      return true;
+    }
+    case CBC_MODULO:
+    {
+      result_p->number = ecma_op_number_remainder (left, right);
+      return true;
+    }
+    default:
+    {
+      break;
+    }
+  }
+
+  result_p->type = PARSER_OPT_VALUE_BOOLEAN;
+
+  switch (opcode)
+  {
+    case CBC_EQUAL:
+    case CBC_STRICT_EQUAL:
+    {
+      result_p->boolean = (left == right);
+      return true;
+    }
+    case CBC_NOT_EQUAL:
+    case CBC_STRICT_NOT_EQUAL:
+    {
+      result_p->boolean = !(left == right);
+      return true;
+    }
+    case CBC_LESS:
+    {
+      result_p->boolean = (left < right);
+      return true;
+    }
+    case CBC_GREATER:
+    {
+      result_p->boolean = (left > right);
+      return true;
+    }
+    case CBC_LESS_EQUAL:
+    {
+      result_p->boolean = (left <= right);
+      return true;
+    }
+    case CBC_GREATER_EQUAL:
+    {
+      result_p->boolean = (left >= right);
+      return true;
+    }
+    default:
+    {
+      return false;
+    }
+  }
+} /* parser_opt_fold_binary */
+
+/**
+ * Checks whether an opcode is the stack form of an unary operation.
+ *
+ * @return true - if the opcode is an unary operation
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+parser_opt_is_unary (uint16_t opcode) /**< opcode */
+{
+  return opcode >= CBC_PLUS && opcode <= CBC_VOID_LITERAL && ((opcode - CBC_PLUS) % 2) == 0;
+} /* parser_opt_is_unary */
+
+/**
+ * Checks whether an opcode is the stack form of a binary operation.
+ *
+ * @return true - if the opcode is a binary operation
+ *         false - otherwise
+ */
+static inline bool __attr_always_inline___
+parser_opt_is_binary (uint16_t opcode) /**< opcode */
+{
+  return opcode >= CBC_BIT_OR && opcode <= CBC_MODULO_TWO_LITERALS && ((opcode - CBC_BIT_OR) % 3) == 0;
+} /* parser_opt_is_binary */
+
+/**
+ * Change an instruction to an operation with literal arguments.
+ */
+static void
+parser_opt_set_literal_instr (parser_opt_instr_t *instr_p, /**< instruction */
+                              uint16_t opcode, /**< new opcode */
+                              uint16_t first_literal, /**< first literal argument */
+                              uint16_t second_literal, /**< second literal argument */
+                              uint16_t third_literal) /**< third literal argument */
+{
+  instr_p->opcode = opcode;
+  instr_p->literals[0] = first_literal;
+  instr_p->literals[1] = second_literal;
+  instr_p->literals[2] = third_literal;
+  instr_p->literal_count = 1;
+
+  if (second_literal != PARSER_OPT_NO_LITERAL)
+  {
+    instr_p->literal_count = (uint8_t) ((third_literal != PARSER_OPT_NO_LITERAL) ? 3 : 2);
+  }
+  instr_p->byte_arg = 0;
+  instr_p->branch_length = 0;
+} /* parser_opt_set_literal_instr */
+
+/**
+ * Merge literal pushes into the literal arguments of the next instruction.
+ * Literal pairs, which are not constants, are already merged by the parser.
+ *
+ * @return true - if the instructions are merged
+ *         false - otherwise
+ */
+static bool
+parser_opt_merge_literals (parser_opt_context_t *context_p, /**< context */
+                           uint32_t index, /**< instruction index */
+                           uint32_t next_index) /**< next instruction index */
+{
+  parser_opt_instr_t *instr_p = context_p->instrs_p + index;
+  parser_opt_instr_t *next_p = context_p->instrs_p + next_index;
+  uint16_t next_opcode = next_p->opcode;
+
+  if (instr_p->opcode == CBC_PUSH_LITERAL)
+  {
+    uint16_t literal_index = instr_p->literals[0];
+    bool is_const = parser_opt_is_const_literal (context_p, literal_index);
+
+    if (next_opcode == CBC_PUSH_LITERAL
+        && (is_const || parser_opt_is_const_literal (context_p, next_p->literals[0])))
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    CBC_PUSH_TWO_LITERALS,
+                                    literal_index,
+                                    next_p->literals[0],
+                                    PARSER_OPT_NO_LITERAL);
+    }
+    else if (parser_opt_is_binary (next_opcode) && is_const)
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    (uint16_t) (next_opcode + CBC_BINARY_WITH_LITERAL),
+                                    literal_index,
+                                    PARSER_OPT_NO_LITERAL,
+                                    PARSER_OPT_NO_LITERAL);
+    }
+    else if (parser_opt_is_binary ((uint16_t) (next_opcode - CBC_BINARY_WITH_LITERAL))
+             && (is_const || parser_opt_is_const_literal (context_p, next_p->literals[0])))
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    (uint16_t) (next_opcode - CBC_BINARY_WITH_LITERAL + CBC_BINARY_WITH_TWO_LITERALS),
+                                    literal_index,
+                                    next_p->literals[0],
+                                    PARSER_OPT_NO_LITERAL);
+    }
+    else if (parser_opt_is_unary (next_opcode) && is_const)
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    (uint16_t) (next_opcode + 1),
+                                    literal_index,
+                                    PARSER_OPT_NO_LITERAL,
+                                    PARSER_OPT_NO_LITERAL);
+    }
+    else if (next_opcode >= CBC_ASSIGN_SET_IDENT && next_opcode <= CBC_ASSIGN_SET_IDENT_BLOCK && is_const)
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    (uint16_t) (next_opcode - CBC_ASSIGN_SET_IDENT + CBC_ASSIGN_LITERAL_SET_IDENT),
+                                    literal_index,
+                                    next_p->literals[0],
+                                    PARSER_OPT_NO_LITERAL);
+    }
+    else if (next_opcode == CBC_RETURN && is_const)
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    CBC_RETURN_WITH_LITERAL,
+                                    literal_index,
+                                    PARSER_OPT_NO_LITERAL,
+                                    PARSER_OPT_NO_LITERAL);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  else if (instr_p->opcode == CBC_PUSH_TWO_LITERALS)
+  {
+    bool is_const = (parser_opt_is_const_literal (context_p, instr_p->literals[0])
+                     || parser_opt_is_const_literal (context_p, instr_p->literals[1]));
+
+    if (next_opcode == CBC_PUSH_LITERAL && parser_opt_is_const_literal (context_p, next_p->literals[0]))
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    CBC_PUSH_THREE_LITERALS,
+                                    instr_p->literals[0],
+                                    instr_p->literals[1],
+                                    next_p->literals[0]);
+    }
+    else if (parser_opt_is_binary (next_opcode) && is_const)
+    {
+      parser_opt_set_literal_instr (instr_p,
+                                    (uint16_t) (next_opcode + CBC_BINARY_WITH_TWO_LITERALS),
+                                    instr_p->literals[0],
+                                    instr_p->literals[1],
+                                    PARSER_OPT_NO_LITERAL);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  else
+  {
+    return false;
+  }
+
+  parser_opt_remove (context_p, next_index);
+  return true;
+} /* parser_opt_merge_literals */
+
+/**
+ * Simplify a constant condition followed by a conditional branch.
+ *
+ * @return true - if the branch is simplified
+ *         false - otherwise
+ */
+static bool
+parser_opt_fold_branch (parser_opt_context_t *context_p, /**< context */
+                        uint32_t index, /**< index of the instruction which pushes the condition */
+                        uint32_t next_index, /**< index of the branch */
+                        const parser_opt_value_t *value_p) /**< value of the condition */
+{
+  parser_opt_instr_t *next_p = context_p->instrs_p + next_index;
+  uint16_t next_opcode = next_p->opcode;
+  bool is_logical = (next_opcode == CBC_BRANCH_IF_LOGICAL_TRUE || next_opcode == CBC_BRANCH_IF_LOGICAL_FALSE);
+
+  if (next_opcode != CBC_BRANCH_IF_TRUE_FORWARD
+      && next_opcode != CBC_BRANCH_IF_FALSE_FORWARD
+      && !is_logical)
+  {
+    return false;
+  }
+
+  bool is_taken = parser_opt_to_boolean (value_p);
+
+  if (next_opcode == CBC_BRANCH_IF_FALSE_FORWARD || next_opcode == CBC_BRANCH_IF_LOGICAL_FALSE)
+  {
+    is_taken = !is_taken;
+  }
+
+  if (!is_taken)
+  {
+    /* The value is popped in both cases. */
+    parser_opt_remove (context_p, next_index);
+    parser_opt_remove (context_p, index);
+    return true;
+  }
+
+  /* Logical branches keep the value on the stack when they are taken. */
+  if (!is_logical)
+  {
+    parser_opt_remove (context_p, index);
+  }
+
+  next_p->opcode = CBC_JUMP_FORWARD;
+  return true;
+} /* parser_opt_fold_branch */
+
+/**
+ * Apply constant folding and literal merging on an instruction
+ * and the instructions following it.
+ *
+ * @return true - if the instructions are changed
+ *         false - otherwise
+ */
+static bool
+parser_opt_fold (parser_opt_context_t *context_p, /**< context */
+                 uint32_t index) /**< instruction index */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+  parser_opt_instr_t *instr_p = instrs_p + index;
+  uint16_t opcode = instr_p->opcode;
+  parser_opt_value_t value;
+  parser_opt_value_t right_value;
+  parser_opt_value_t result;
+
+  /* Operations with constant literal arguments. */
+  if (parser_opt_is_unary ((uint16_t) (opcode - 1)))
+  {
+    return (parser_opt_get_literal_value (context_p, instr_p->literals[0], &value)
+            && parser_opt_fold_unary ((uint16_t) (opcode - 1), &value, &result)
+            && parser_opt_set_push_value (context_p, instr_p, &result));
+  }
+
+  if (parser_opt_is_binary ((uint16_t) (opcode - CBC_BINARY_WITH_TWO_LITERALS)))
+  {
+    uint16_t binary_opcode = (uint16_t) (opcode - CBC_BINARY_WITH_TWO_LITERALS);
+
+    return (parser_opt_get_literal_value (context_p, instr_p->literals[0], &value)
+            && parser_opt_get_literal_value (context_p, instr_p->literals[1], &right_value)
+            && parser_opt_fold_binary (binary_opcode, &value, &right_value, &result)
+            && parser_opt_set_push_value (context_p, instr_p, &result));
+  }
+
+  /* Operations on the values pushed by the instruction. The following
+   * instructions cannot be changed when they are branch targets. */
+  uint32_t next_index = parser_opt_next (context_p, index);
+
+  if (next_index >= context_p->instr_count
+      || (instrs_p[next_index].flags & PARSER_OPT_TARGET))
+  {
+    return false;
+  }
+
+  parser_opt_instr_t *next_p = instrs_p + next_index;
+  uint16_t next_opcode = next_p->opcode;
+
+  if (!parser_opt_get_push_value (context_p, instr_p, &value))
+  {
+    if (opcode == CBC_PUSH_TWO_LITERALS
+        && parser_opt_is_binary (next_opcode)
+        && parser_opt_get_literal_value (context_p, instr_p->literals[0], &value)
+        && parser_opt_get_literal_value (context_p, instr_p->literals[1], &right_value)
+        && parser_opt_fold_binary (next_opcode, &value, &right_value, &result)
+        && parser_opt_set_push_value (context_p, instr_p, &result))
+    {
+      parser_opt_remove (context_p, next_index);
+      return true;
+    }
+
+    return parser_opt_merge_literals (context_p, index, next_index);
+  }
+
+  if (parser_opt_is_unary (next_opcode))
+  {
+    if (parser_opt_fold_unary (next_opcode, &value, &result)
+        && parser_opt_set_push_value (context_p, instr_p, &result))
+    {
+      parser_opt_remove (context_p, next_index);
+      return true;
+    }
+  }
+  else if (parser_opt_is_binary ((uint16_t) (next_opcode - CBC_BINARY_WITH_LITERAL)))
+  {
+    if (parser_opt_get_literal_value (context_p, next_p->literals[0], &right_value)
+        && parser_opt_fold_binary ((uint16_t) (next_opcode - CBC_BINARY_WITH_LITERAL), &value, &right_value, &result)
+        && parser_opt_set_push_value (context_p, instr_p, &result))
+    {
+      parser_opt_remove (context_p, next_index);
+      return true;
+    }
+  }
+  else if (parser_opt_get_push_value (context_p, next_p, &right_value))
+  {
+    uint32_t last_index = parser_opt_next (context_p, next_index);
+
+    if (last_index < context_p->instr_count
+        && !(instrs_p[last_index].flags & PARSER_OPT_TARGET)
+        && parser_opt_is_binary (instrs_p[last_index].opcode)
+        && parser_opt_fold_binary (instrs_p[last_index].opcode, &value, &right_value, &result)
+        && parser_opt_set_push_value (context_p, instr_p, &result))
+    {
+      parser_opt_remove (context_p, next_index);
+      parser_opt_remove (context_p, last_index);
+      return true;
+    }
+  }
+  else if (parser_opt_fold_branch (context_p, index, next_index, &value))
+  {
+    return true;
+  }
+
+  return parser_opt_merge_literals (context_p, index, next_index);
+} /* parser_opt_fold */
+
+/**
+ * Redirect branches, which target unconditional jumps, to the final
+ * destination and remove jumps to the next instruction.
+ *
+ * @return true - if the instructions are changed
+ *         false - otherwise
+ */
+static bool
+parser_opt_thread_jumps (parser_opt_context_t *context_p) /**< context */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+  bool is_changed = false;
+
+  for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+  {
+    parser_opt_instr_t *instr_p = instrs_p + i;
+    uint16_t opcode = instr_p->opcode;
+
+    /* Context branches are bound to the structure of their statements. */
+    if (instr_p->branch_length == 0
+        || !PARSER_IS_BASIC_OPCODE (opcode)
+        || opcode == CBC_JUMP_FORWARD_EXIT_CONTEXT)
+    {
+      continue;
+    }
+
+    bool is_reversible = (parser_opt_get_backward_opcode (opcode) != CBC_EXT_OPCODE);
+    uint32_t target = parser_opt_live (context_p, instr_p->argument);
+
+    for (uint32_t chain = 0; chain < PARSER_OPT_MAXIMUM_JUMP_CHAIN; chain++)
+    {
+      if (target == i || instrs_p[target].opcode != CBC_JUMP_FORWARD)
+      {
+        break;
+      }
+
+      uint32_t new_target = parser_opt_live (context_p, instrs_p[target].argument);
+
+      if (new_target == target || (!is_reversible && new_target <= i))
+      {
+        break;
+      }
+
+      target = new_target;
+    }
+
+    if (target != instr_p->argument)
+    {
+      instr_p->argument = target;
+      is_changed = true;
+    }
+
+    if (target == parser_opt_next (context_p, i))
+    {
+      if (opcode == CBC_JUMP_FORWARD)
+      {
+        parser_opt_remove (context_p, i);
+        is_changed = true;
+      }
+      else if (opcode == CBC_BRANCH_IF_TRUE_FORWARD || opcode == CBC_BRANCH_IF_FALSE_FORWARD)
+      {
+        instr_p->opcode = CBC_POP;
+        instr_p->branch_length = 0;
+        is_changed = true;
+      }
+    }
+  }
+
+  return is_changed;
+} /* parser_opt_thread_jumps */
+
+/**
+ * Remove the instructions, which cannot be reached from the first instruction.
+ *
+ * @return true - if instructions are removed
+ *         false - otherwise
+ */
+static bool
+parser_opt_remove_unreachable (parser_opt_context_t *context_p, /**< context */
+                               uint32_t *worklist_p) /**< work list (instr_count entries) */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+  uint32_t worklist_top = 0;
+  bool is_changed = false;
+
+  for (uint32_t i = 0; i < context_p->instr_count; i++)
+  {
+    instrs_p[i].flags &= (uint8_t) ~PARSER_OPT_REACHABLE;
+  }
+
+  worklist_p[worklist_top++] = parser_opt_live (context_p, 0);
+
+  while (worklist_top > 0)
+  {
+    uint32_t index = worklist_p[--worklist_top];
+
+    while (index < context_p->instr_count && !(instrs_p[index].flags & PARSER_OPT_REACHABLE))
+    {
+      parser_opt_instr_t *instr_p = instrs_p + index;
+
+      instr_p->flags |= PARSER_OPT_REACHABLE;
+
+      if (instr_p->branch_length > 0)
+      {
+        uint32_t target = parser_opt_live (context_p, instr_p->argument);
+
+        if (!(instrs_p[target].flags & PARSER_OPT_REACHABLE))
+        {
+          JERRY_ASSERT (worklist_top < context_p->instr_count);
+          worklist_p[worklist_top++] = target;
+        }
+      }
+
+      if (parser_opt_is_terminator (instr_p->opcode))
+      {
+        break;
+      }
+
+      index = parser_opt_next (context_p, index);
+    }
+  }
+
+  for (uint32_t i = 0; i < context_p->instr_count; i++)
+  {
+    if (!(instrs_p[i].flags & (PARSER_OPT_REMOVED | PARSER_OPT_REACHABLE)))
+    {
+      instrs_p[i].flags |= PARSER_OPT_REMOVED;
+      is_changed = true;
+    }
+  }
+
+  return is_changed;
+} /* parser_opt_remove_unreachable */
+
+/**
+ * Collect the reachable instructions of a byte code.
+ *
+ * @return true - if the byte code is valid
+ *         false - otherwise
+ */
+static bool
+parser_opt_scan (const uint8_t *byte_code_start_p, /**< start of the byte code */
+                 uint32_t code_size, /**< size of the byte code */
+                 uint16_t encoding_flags, /**< status flags of the byte code */
+                 uint8_t *instr_starts_p, /**< [out] bitmap of the instruction starts */
+                 uint32_t *worklist_p, /**< work list */
+                 uint32_t worklist_size, /**< number of work list entries */
+                 uint32_t *instr_count_p, /**< [out] number of instructions */
+                 uint32_t *init_value_count_p) /**< [out] number of CBC_INITIALIZE_VARS values */
+{
+  uint32_t worklist_top = 0;
+  parser_opt_instr_t instr;
+
+  worklist_p[worklist_top++] = 0;
+
+  while (worklist_top > 0)
+  {
+    uint32_t offset = worklist_p[--worklist_top];
+
+    while (!(instr_starts_p[offset >> 3] & (1u << (offset & 0x7))))
+    {
+      instr_starts_p[offset >> 3] |= (uint8_t) (1u << (offset & 0x7));
+      (*instr_count_p)++;
+
+      uint32_t next_offset = parser_opt_decode_instr (byte_code_start_p,
+                                                      code_size,
+                                                      encoding_flags,
+                                                      offset,
+                                                      &instr,
+                                                      NULL);
+
+      if (next_offset == 0)
+      {
+        return false;
+      }
+
+      if (instr.opcode == CBC_INITIALIZE_VARS)
+      {
+        *init_value_count_p += instr.argument;
+      }
+
+      if (instr.branch_length > 0
+          && !(instr_starts_p[instr.argument >> 3] & (1u << (instr.argument & 0x7))))
+      {
+        if (worklist_top >= worklist_size)
+        {
+          return false;
+        }
+
+        worklist_p[worklist_top++] = instr.argument;
+      }
+
+      if (parser_opt_is_terminator (instr.opcode))
+      {
+        break;
+      }
+
+      if (next_offset >= code_size)
+      {
+        /* The execution cannot run off the end of the byte code. */
+        return false;
+      }
+
+      offset = next_offset;
+    }
+  }
+
+  return true;
+} /* parser_opt_scan */
+
+/**
+ * Decode the instructions marked by parser_opt_scan.
+ *
+ * @return true - if the byte code is valid
+ *         false - otherwise
+ */
+static bool
+parser_opt_decode (parser_opt_context_t *context_p, /**< context */
+                   const uint8_t *byte_code_start_p, /**< start of the byte code */
+                   uint32_t code_size, /**< size of the byte code */
+                   uint16_t encoding_flags, /**< status flags of the byte code */
+                   const uint8_t *instr_starts_p) /**< bitmap of the instruction starts */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+  uint32_t instr_count = 0;
+  uint32_t init_value_count = 0;
+  uint32_t end_offset = 0;
+
+  for (uint32_t offset = 0; offset < code_size; offset++)
+  {
+    if (!(instr_starts_p[offset >> 3] & (1u << (offset & 0x7))))
+    {
+      continue;
+    }
+
+    if (offset < end_offset)
+    {
+      /* Overlapping instructions. */
+      return false;
+    }
+
+    parser_opt_instr_t *instr_p = instrs_p + instr_count;
+
+    end_offset = parser_opt_decode_instr (byte_code_start_p,
+                                          code_size,
+                                          encoding_flags,
+                                          offset,
+                                          instr_p,
+                                          context_p->init_values_p + init_value_count);
+    JERRY_ASSERT (end_offset != 0);
+
+    if (instr_p->opcode == CBC_INITIALIZE_VARS)
+    {
+      uint32_t value_count = instr_p->argument;
+
+      instr_p->argument = init_value_count;
+      init_value_count += value_count;
+    }
+
+    instr_count++;
+  }
+
+  JERRY_ASSERT (instr_count == context_p->instr_count && init_value_count == context_p->init_value_count);
+
+  /* Convert the target offsets of branches to instruction indicies. */
+  for (uint32_t i = 0; i < instr_count; i++)
+  {
+    if (instrs_p[i].branch_length == 0)
+    {
+      continue;
+    }
+
+    uint32_t target_offset = instrs_p[i].argument;
+    uint32_t start = 0;
+    uint32_t end = instr_count;
+
+    while (start < end)
+    {
+      uint32_t middle = (start + end) / 2;
+
+      if (instrs_p[middle].offset < target_offset)
+      {
+        start = middle + 1;
+      }
+      else
+      {
+        end = middle;
+      }
+    }
+
+    JERRY_ASSERT (start < instr_count && instrs_p[start].offset == target_offset);
+    instrs_p[i].argument = start;
+  }
+
+  return true;
+} /* parser_opt_decode */
+
+/**
+ * Remove the unused registers and literals, and reorder the constant
+ * literals by their number of uses.
+ *
+ * @return true - if the literals are compacted
+ *         false - otherwise (out of memory)
+ */
+static bool
+parser_opt_compact_literals (parser_opt_context_t *context_p, /**< context */
+                             uint16_t *literal_map_p) /**< [out] map from old to new literal indicies
+                                                       *   (literal_end + new_literal_count entries) */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+  uint32_t literal_count = (uint32_t) context_p->literal_end + context_p->new_literal_count;
+  uint32_t *uses_p = (uint32_t *) jmem_heap_alloc_block_null_on_error (literal_count * sizeof (uint32_t));
+
+  if (uses_p == NULL)
+  {
+    return false;
+  }
+
+  memset (uses_p, 0, literal_count * sizeof (uint32_t));
+
+  /* Arguments are always kept. */
+  for (uint32_t i = 0; i < context_p->argument_end; i++)
+  {
+    uses_p[i]++;
+  }
+
+  for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+  {
+    parser_opt_instr_t *instr_p = instrs_p + i;
+
+    if (instr_p->opcode == CBC_DEFINE_VARS)
+    {
+      for (uint32_t j = context_p->register_end; j <= instr_p->literals[0]; j++)
+      {
+        uses_p[j]++;
+      }
+      continue;
+    }
+
+    if (instr_p->opcode == CBC_INITIALIZE_VARS)
+    {
+      for (uint32_t j = instr_p->literals[0]; j <= instr_p->literals[1]; j++)
+      {
+        uses_p[j]++;
+        uses_p[context_p->init_values_p[instr_p->argument + j - instr_p->literals[0]]]++;
+      }
+      continue;
+    }
+
+    for (uint32_t j = 0; j < instr_p->literal_count; j++)
+    {
+      uses_p[instr_p->literals[j]]++;
+    }
+  }
+
+  uint32_t register_end = context_p->register_end;
+  uint32_t ident_end = context_p->ident_end;
+  uint32_t const_literal_end = context_p->const_literal_end;
+  uint32_t literal_end = context_p->literal_end;
+  uint32_t new_index = 0;
+
+  for (uint32_t i = 0; i < ident_end; i++)
+  {
+    if (i == register_end)
+    {
+      context_p->register_end = (uint16_t) new_index;
+    }
+
+    literal_map_p[i] = (uint16_t) ((uses_p[i] > 0) ? new_index++ : PARSER_OPT_NO_LITERAL);
+  }
+
+  if (register_end == ident_end)
+  {
+    context_p->register_end = (uint16_t) new_index;
+  }
+
+  context_p->stack_limit = (uint16_t) (context_p->stack_limit - (register_end - context_p->register_end));
+  context_p->ident_end = (uint16_t) new_index;
+
+  /* Constants created by the optimizer are appended to the constant group. */
+  uint32_t const_start = new_index;
+
+  for (uint32_t i = ident_end; i < literal_count; i++)
+  {
+    bool is_const = (i < const_literal_end || i >= literal_end);
+
+    literal_map_p[i] = PARSER_OPT_NO_LITERAL;
+
+    if (is_const && uses_p[i] > 0)
+    {
+      literal_map_p[i] = (uint16_t) new_index++;
+    }
+  }
+
+  uint32_t const_count = new_index - const_start;
+
+  /* When the literal indicies do not fit into one byte, the constants
+   * are ordered by their number of uses, so the frequently used ones
+   * get the short encodings. */
+  if (literal_count > CBC_MAXIMUM_BYTE_VALUE && const_count > 1)
+  {
+    uint16_t *order_p = (uint16_t *) jmem_heap_alloc_block_null_on_error (const_count * sizeof (uint16_t));
+
+    if (order_p == NULL)
+    {
+      jmem_heap_free_block (uses_p, literal_count * sizeof (uint32_t));
+      return false;
+    }
+
+    uint32_t count = 0;
+
+    /* Stable insertion sort. */
+    for (uint32_t i = ident_end; i < literal_count; i++)
+    {
+      if (literal_map_p[i] == PARSER_OPT_NO_LITERAL || (i >= const_literal_end && i < literal_end))
+      {
+        continue;
+      }
+
+      uint32_t position = count++;
+
+      while (position > 0 && uses_p[order_p[position - 1]] < uses_p[i])
+      {
+        order_p[position] = order_p[position - 1];
+        position--;
+      }
+
+      order_p[position] = (uint16_t) i;
+    }
+
+    JERRY_ASSERT (count == const_count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+      literal_map_p[order_p[i]] = (uint16_t) (const_start + i);
+    }
+
+    jmem_heap_free_block (order_p, const_count * sizeof (uint16_t));
+  }
+
+  context_p->const_literal_end = (uint16_t) new_index;
+
+  for (uint32_t i = const_literal_end; i < literal_end; i++)
+  {
+    if (uses_p[i] > 0)
+    {
+      literal_map_p[i] = (uint16_t) new_index++;
+    }
+  }
+
+  context_p->literal_end = (uint16_t) new_index;
+
+  jmem_heap_free_block (uses_p, literal_count * sizeof (uint32_t));
+  return true;
+} /* parser_opt_compact_literals */
+
+/**
+ * Get the encoded size of a literal index.
+ *
+ * @return size in bytes
+ */
+static inline uint32_t __attr_always_inline___
+parser_opt_literal_size (uint16_t literal_index, /**< literal index */
+                         bool is_full_encoding) /**< full literal encoding is used */
+{
+  if (!is_full_encoding)
+  {
+    return (literal_index < CBC_MAXIMUM_BYTE_VALUE) ? 1 : 2;
+  }
+
+  return (literal_index <= CBC_LOWER_SEVEN_BIT_MASK) ? 1 : 2;
+} /* parser_opt_literal_size */
+
+/**
+ * Encode a literal index.
+ *
+ * @return byte code position after the literal index
+ */
+static uint8_t *
+parser_opt_encode_literal (uint8_t *byte_code_p, /**< byte code position */
+                           uint16_t literal_index, /**< literal index */
+                           bool is_full_encoding) /**< full literal encoding is used */
+{
+  if (!is_full_encoding)
+  {
+    if (literal_index < CBC_MAXIMUM_BYTE_VALUE)
+    {
+      *byte_code_p++ = (uint8_t) literal_index;
+    }
+    else
+    {
+      *byte_code_p++ = CBC_MAXIMUM_BYTE_VALUE;
+      *byte_code_p++ = (uint8_t) (literal_index - CBC_MAXIMUM_BYTE_VALUE);
+    }
+  }
+  else if (literal_index <= CBC_LOWER_SEVEN_BIT_MASK)
+  {
+    *byte_code_p++ = (uint8_t) literal_index;
+  }
+  else
+  {
+    *byte_code_p++ = (uint8_t) ((literal_index >> 8) | CBC_HIGHEST_BIT_MASK);
+    *byte_code_p++ = (uint8_t) (literal_index & 0xff);
+  }
+
+  return byte_code_p;
+} /* parser_opt_encode_literal */
+
+/**
+ * Get the encoded size of an instruction.
+ *
+ * @return size in bytes
+ */
+static uint32_t
+parser_opt_instr_size (const parser_opt_context_t *context_p, /**< context */
+                       const parser_opt_instr_t *instr_p, /**< instruction */
+                       bool is_full_encoding) /**< full literal encoding is used */
+{
+  uint32_t size = PARSER_IS_BASIC_OPCODE (instr_p->opcode) ? 1 : 2;
+
+  for (uint32_t i = 0; i < instr_p->literal_count; i++)
+  {
+    size += parser_opt_literal_size (instr_p->literals[i], is_full_encoding);
+  }
+
+  if (instr_p->opcode == CBC_INITIALIZE_VARS)
+  {
+    uint32_t value_end = instr_p->argument + (uint32_t) (instr_p->literals[1] - instr_p->literals[0]) + 1;
+
+    for (uint32_t i = instr_p->argument; i < value_end; i++)
+    {
+      size += parser_opt_literal_size (context_p->init_values_p[i], is_full_encoding);
+    }
+  }
+
+  if (PARSER_GET_FLAGS (instr_p->opcode) & CBC_HAS_BYTE_ARG)
+  {
+    size++;
+  }
+
+  return size + instr_p->branch_length;
+} /* parser_opt_instr_size */
+
+/**
+ * Compute the offsets of the instructions. Branch offsets are encoded
+ * on the smallest number of bytes which can hold them.
+ *
+ * @return size of the byte code
+ */
+static uint32_t
+parser_opt_layout (parser_opt_context_t *context_p, /**< context */
+                   bool is_full_encoding) /**< full literal encoding is used */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+  uint32_t code_size;
+  bool is_changed;
+
+  for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+  {
+    if (instrs_p[i].branch_length > 0)
+    {
+      instrs_p[i].branch_length = 1;
+    }
+  }
+
+  /* Branch offsets only grow, so the iteration terminates. */
+  do
+  {
+    code_size = 0;
+
+    for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+    {
+      instrs_p[i].offset = code_size;
+      code_size += parser_opt_instr_size (context_p, instrs_p + i, is_full_encoding);
+    }
+
+    is_changed = false;
+
+    for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+    {
+      parser_opt_instr_t *instr_p = instrs_p + i;
+
+      if (instr_p->branch_length == 0)
+      {
+        continue;
+      }
+
+      uint32_t target_offset = instrs_p[instr_p->argument].offset;
+      uint32_t distance = (instr_p->argument > i) ? (target_offset - instr_p->offset)
+                                                  : (instr_p->offset - target_offset);
+      uint8_t branch_length = 1;
+
+      if (distance > 0xffff)
+      {
+        branch_length = 3;
+      }
+      else if (distance > 0xff)
+      {
+        branch_length = 2;
+      }
+
+      if (branch_length > instr_p->branch_length)
+      {
+        instr_p->branch_length = branch_length;
+        is_changed = true;
+      }
+    }
+  }
+  while (is_changed);
+
+  return code_size;
+} /* parser_opt_layout */
+
+/**
+ * Encode the instructions.
+ */
+static void
+parser_opt_encode (const parser_opt_context_t *context_p, /**< context */
+                   uint8_t *byte_code_p, /**< byte code buffer */
+                   bool is_full_encoding) /**< full literal encoding is used */
+{
+  const parser_opt_instr_t *instrs_p = context_p->instrs_p;
+
+  for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+  {
+    const parser_opt_instr_t *instr_p = instrs_p + i;
+    uint16_t opcode = instr_p->opcode;
+    uint32_t distance = 0;
+
+    if (instr_p->branch_length > 0)
+    {
+      uint32_t target_offset = instrs_p[instr_p->argument].offset;
+
+      if (instr_p->argument > i)
+      {
+        distance = target_offset - instr_p->offset;
+      }
+      else
+      {
+        distance = instr_p->offset - target_offset;
+
+        if (parser_opt_get_backward_opcode (opcode) != CBC_EXT_OPCODE)
+        {
+          opcode = parser_opt_get_backward_opcode (opcode);
+        }
+      }
+
+      JERRY_ASSERT ((instr_p->argument > i) == (CBC_BRANCH_IS_FORWARD (PARSER_GET_FLAGS (opcode)) != 0));
+
+      opcode = (uint16_t) (opcode + instr_p->branch_length - 1);
+    }
+
+    if (PARSER_IS_BASIC_OPCODE (opcode))
+    {
+      *byte_code_p++ = (uint8_t) opcode;
+    }
+    else
+    {
+      *byte_code_p++ = CBC_EXT_OPCODE;
+      *byte_code_p++ = (uint8_t) PARSER_GET_EXT_OPCODE (opcode);
+    }
+
+    for (uint32_t j = 0; j < instr_p->literal_count; j++)
+    {
+      byte_code_p = parser_opt_encode_literal (byte_code_p, instr_p->literals[j], is_full_encoding);
+    }
+
+    if (opcode == CBC_INITIALIZE_VARS)
+    {
+      uint32_t value_end = instr_p->argument + (uint32_t) (instr_p->literals[1] - instr_p->literals[0]) + 1;
+
+      for (uint32_t j = instr_p->argument; j < value_end; j++)
+      {
+        byte_code_p = parser_opt_encode_literal (byte_code_p, context_p->init_values_p[j], is_full_encoding);
+      }
+    }
+
+    if (PARSER_GET_FLAGS (opcode) & CBC_HAS_BYTE_ARG)
+    {
+      *byte_code_p++ = instr_p->byte_arg;
+    }
+
+    for (uint32_t j = instr_p->branch_length; j > 0; j--)
+    {
+      *byte_code_p++ = (uint8_t) (distance >> ((j - 1) * 8));
+    }
+  }
+} /* parser_opt_encode */
+
+/**
+ * Optimize the decoded instructions and encode the result.
+ *
+ * @return optimized byte code - if it is not larger than the original
+ *         NULL - otherwise
+ */
+static ecma_compiled_code_t *
+parser_opt_run (parser_opt_context_t *context_p, /**< context */
+                const ecma_compiled_code_t *compiled_code_p, /**< original byte code */
+                uint32_t *worklist_p, /**< work list (instr_count entries) */
+                uint16_t *literal_map_p) /**< literal map (literal_end + PARSER_OPT_MAXIMUM_NEW_LITERALS entries) */
+{
+  parser_opt_instr_t *instrs_p = context_p->instrs_p;
+  const jmem_cpointer_t *literal_table_p = context_p->literal_table_p;
+
+  for (uint32_t round = 0; round < PARSER_OPT_MAXIMUM_ROUNDS; round++)
+  {
+    bool is_changed = false;
+
+    parser_opt_update_targets (context_p);
+
+    for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+    {
+      while (!(instrs_p[i].flags & PARSER_OPT_REMOVED) && parser_opt_fold (context_p, i))
+      {
+        is_changed = true;
+      }
+    }
+
+    is_changed |= parser_opt_thread_jumps (context_p);
+    is_changed |= parser_opt_remove_unreachable (context_p, worklist_p);
+
+    if (!is_changed)
+    {
+      break;
+    }
+  }
+
+  uint32_t old_literal_end = context_p->literal_end;
+  uint32_t new_literal_count = context_p->new_literal_count;
+
+  if (!parser_opt_compact_literals (context_p, literal_map_p))
+  {
+    return NULL;
+  }
+
+  for (uint32_t i = parser_opt_live (context_p, 0); i < context_p->instr_count; i = parser_opt_next (context_p, i))
+  {
+    parser_opt_instr_t *instr_p = instrs_p + i;
+
+    for (uint32_t j = 0; j < instr_p->literal_count; j++)
+    {
+      JERRY_ASSERT (literal_map_p[instr_p->literals[j]] != PARSER_OPT_NO_LITERAL);
+      instr_p->literals[j] = literal_map_p[instr_p->literals[j]];
+    }
+
+    if (instr_p->opcode == CBC_INITIALIZE_VARS)
+    {
+      uint32_t value_end = instr_p->argument + (uint32_t) (instr_p->literals[1] - instr_p->literals[0]) + 1;
+
+      for (uint32_t j = instr_p->argument; j < value_end; j++)
+      {
+        JERRY_ASSERT (literal_map_p[context_p->init_values_p[j]] != PARSER_OPT_NO_LITERAL);
+        context_p->init_values_p[j] = literal_map_p[context_p->init_values_p[j]];
+      }
+    }
+  }
+
+  parser_opt_update_targets (context_p);
+
+  bool is_full_encoding = (context_p->literal_end > CBC_MAXIMUM_SMALL_VALUE);
+  bool needs_uint16_arguments = (context_p->stack_limit > CBC_MAXIMUM_BYTE_VALUE
+                                 || context_p->literal_end > CBC_MAXIMUM_BYTE_VALUE);
+  uint32_t code_size = parser_opt_layout (context_p, is_full_encoding);
+
+  size_t header_size = needs_uint16_arguments ? sizeof (cbc_uint16_arguments_t) : sizeof (cbc_uint8_arguments_t);
+  size_t total_size = JERRY_ALIGNUP (header_size + context_p->literal_end * sizeof (jmem_cpointer_t) + code_size,
+                                     JMEM_ALIGNMENT);
+
+  if (total_size > (((size_t) compiled_code_p->size) << JMEM_ALIGNMENT_LOG))
+  {
+    return NULL;
+  }
+
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_BYTE_CODE);
+  ecma_compiled_code_t *result_p = (ecma_compiled_code_t *) jmem_heap_alloc_block_null_on_error (total_size);
+
+  if (result_p == NULL)
+  {
+    return NULL;
+  }
+
+  memset (result_p, 0, total_size);
+
+  result_p->size = (uint16_t) (total_size >> JMEM_ALIGNMENT_LOG);
+  result_p->refs = 1;
+  result_p->status_flags = (uint16_t) (compiled_code_p->status_flags
+                                       & ~(CBC_CODE_FLAGS_UINT16_ARGUMENTS
+                                           | CBC_CODE_FLAGS_FULL_LITERAL_ENCODING
+                                           | CBC_CODE_FLAGS_HAS_LINE_INFO));
+
+  if (needs_uint16_arguments)
+  {
+    cbc_uint16_arguments_t *args_p = (cbc_uint16_arguments_t *) result_p;
+
+    args_p->stack_limit = context_p->stack_limit;
+    args_p->argument_end = context_p->argument_end;
+    args_p->register_end = context_p->register_end;
+    args_p->ident_end = context_p->ident_end;
+    args_p->const_literal_end = context_p->const_literal_end;
+    args_p->literal_end = context_p->literal_end;
+
+    result_p->status_flags |= CBC_CODE_FLAGS_UINT16_ARGUMENTS;
+  }
+  else
+  {
+    cbc_uint8_arguments_t *args_p = (cbc_uint8_arguments_t *) result_p;
+
+    args_p->stack_limit = (uint8_t) context_p->stack_limit;
+    args_p->argument_end = (uint8_t) context_p->argument_end;
+    args_p->register_end = (uint8_t) context_p->register_end;
+    args_p->ident_end = (uint8_t) context_p->ident_end;
+    args_p->const_literal_end = (uint8_t) context_p->const_literal_end;
+    args_p->literal_end = (uint8_t) context_p->literal_end;
+  }
+
+  if (is_full_encoding)
+  {
+    result_p->status_flags |= CBC_CODE_FLAGS_FULL_LITERAL_ENCODING;
+  }
+
+  jmem_cpointer_t *new_literal_table_p = (jmem_cpointer_t *) (((uint8_t *) result_p) + header_size);
+
+  for (uint32_t i = 0; i < old_literal_end + new_literal_count; i++)
+  {
+    if (literal_map_p[i] != PARSER_OPT_NO_LITERAL)
+    {
+      new_literal_table_p[literal_map_p[i]] = ((i < old_literal_end) ? literal_table_p[i]
+                                                                     : context_p->new_literals[i - old_literal_end]);
+    }
+  }
+
+  parser_opt_encode (context_p, (uint8_t *) (new_literal_table_p + context_p->literal_end), is_full_encoding);
+  return result_p;
+} /* parser_opt_run */
+
+/**
+ * Free a work buffer of the optimizer.
+ */
+static void
+parser_opt_free (void *buffer_p, /**< buffer (can be NULL) */
+                 size_t size) /**< size of the buffer */
+{
+  if (buffer_p != NULL)
+  {
+    jmem_heap_free_block (buffer_p, size);
+  }
+} /* parser_opt_free */
+
+/**
+ * Optimize the byte code of a function for snapshot generation.
+ *
+ * Note:
+ *      the literals of the returned byte code are not referenced: it is only
+ *      valid while the original byte code is alive, and it must be released
+ *      by jmem_heap_free_block rather than ecma_bytecode_deref
+ *
+ * @return optimized copy of the byte code - if it is smaller than the original
+ *         NULL - otherwise (regular expressions, lazy functions, or the optimization failed)
+ */
+ecma_compiled_code_t *
+parser_optimize_byte_code (const ecma_compiled_code_t *compiled_code_p) /**< byte code */
+{
+  uint16_t status_flags = compiled_code_p->status_flags;
+
+  if (!(status_flags & CBC_CODE_FLAGS_FUNCTION)
+      || (status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION))
+  {
+    return NULL;
+  }
+
+  parser_opt_context_t context;
+  size_t header_size;
+
+  if (status_flags & CBC_CODE_FLAGS_UINT16_ARGUMENTS)
+  {
+    const cbc_uint16_arguments_t *args_p = (const cbc_uint16_arguments_t *) compiled_code_p;
+
+    context.stack_limit = args_p->stack_limit;
+    context.argument_end = args_p->argument_end;
+    context.register_end = args_p->register_end;
+    context.ident_end = args_p->ident_end;
+    context.const_literal_end = args_p->const_literal_end;
+    context.literal_end = args_p->literal_end;
+    header_size = sizeof (cbc_uint16_arguments_t);
+  }
+  else
+  {
+    const cbc_uint8_arguments_t *args_p = (const cbc_uint8_arguments_t *) compiled_code_p;
+
+    context.stack_limit = args_p->stack_limit;
+    context.argument_end = args_p->argument_end;
+    context.register_end = args_p->register_end;
+    context.ident_end = args_p->ident_end;
+    context.const_literal_end = args_p->const_literal_end;
+    context.literal_end = args_p->literal_end;
+    header_size = sizeof (cbc_uint8_arguments_t);
+  }
+
+  context.literal_table_p = (const jmem_cpointer_t *) (((const uint8_t *) compiled_code_p) + header_size);
+  context.new_literal_count = 0;
+  context.instr_count = 0;
+  context.init_value_count = 0;
+
+  const uint8_t *byte_code_start_p = (const uint8_t *) (context.literal_table_p + context.literal_end);
+  uint32_t code_size = (uint32_t) ((((size_t) compiled_code_p->size) << JMEM_ALIGNMENT_LOG)
+                                   - header_size
+                                   - context.literal_end * sizeof (jmem_cpointer_t));
+
+  if (code_size == 0)
+  {
+    return NULL;
+  }
+
+  /* Collect the reachable instructions. Padding bytes after the last
+   * instruction have undefined content, so they are never decoded. */
+  size_t instr_starts_size = (code_size + 7) / 8;
+  size_t scan_worklist_size = (code_size / 2 + 1) * sizeof (uint32_t);
+  uint8_t *instr_starts_p = (uint8_t *) jmem_heap_alloc_block_null_on_error (instr_starts_size);
+  uint32_t *scan_worklist_p = (uint32_t *) jmem_heap_alloc_block_null_on_error (scan_worklist_size);
+  bool is_valid = false;
+
+  if (instr_starts_p != NULL && scan_worklist_p != NULL)
+  {
+    memset (instr_starts_p, 0, instr_starts_size);
+    is_valid = parser_opt_scan (byte_code_start_p,
+                                code_size,
+                                status_flags,
+                                instr_starts_p,
+                                scan_worklist_p,
+                                code_size / 2 + 1,
+                                &context.instr_count,
+                                &context.init_value_count);
+  }
+
+  parser_opt_free (scan_worklist_p, scan_worklist_size);
+
+  size_t instrs_size = context.instr_count * sizeof (parser_opt_instr_t);
+  size_t init_values_size = context.init_value_count * sizeof (uint16_t);
+  size_t worklist_size = context.instr_count * sizeof (uint32_t);
+  size_t literal_map_size = ((size_t) context.literal_end + PARSER_OPT_MAXIMUM_NEW_LITERALS) * sizeof (uint16_t);
+  uint32_t *worklist_p = NULL;
+  uint16_t *literal_map_p = NULL;
+  ecma_compiled_code_t *result_p = NULL;
+
+  context.instrs_p = NULL;
+  context.init_values_p = NULL;
+
+  if (is_valid)
+  {
+    context.instrs_p = (parser_opt_instr_t *) jmem_heap_alloc_block_null_on_error (instrs_size);
+    worklist_p = (uint32_t *) jmem_heap_alloc_block_null_on_error (worklist_size);
+    literal_map_p = (uint16_t *) jmem_heap_alloc_block_null_on_error (literal_map_size);
+
+    if (init_values_size > 0)
+    {
+      context.init_values_p = (uint16_t *) jmem_heap_alloc_block_null_on_error (init_values_size);
+    }
+
+    if (context.instrs_p != NULL
+        && worklist_p != NULL
+        && literal_map_p != NULL
+        && (init_values_size == 0 || context.init_values_p != NULL)
+        && parser_opt_decode (&context, byte_code_start_p, code_size, status_flags, instr_starts_p))
+    {
+      result_p = parser_opt_run (&context, compiled_code_p, worklist_p, literal_map_p);
+    }
+  }
+
+  parser_opt_free (instr_starts_p, instr_starts_size);
+  parser_opt_free (context.instrs_p, instrs_size);
+  parser_opt_free (context.init_values_p, init_values_size);
+  parser_opt_free (worklist_p, worklist_size);
+  parser_opt_free (literal_map_p, literal_map_size);
+
+  return result_p;
+} /* parser_optimize_byte_code */
+
+/**
+ * @}
+ * @}
+ * @}
+ */
+
+#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
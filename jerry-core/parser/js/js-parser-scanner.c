@@ -295,7 +295,9 @@ parser_scan_primary_expression_end (parser_context_t *context_p, /**< context */
   /* Check whether we can enter to statement mode. */
   if (stack_top != SCAN_STACK_BLOCK_STATEMENT
       && stack_top != SCAN_STACK_BLOCK_EXPRESSION
-      && !(stack_top == SCAN_STACK_HEAD && end_type == LEXER_SCAN_SWITCH))
+      && stack_top != SCAN_STACK_BLOCK_PROPERTY
+      && !(stack_top == SCAN_STACK_HEAD
+           && (end_type == LEXER_SCAN_SWITCH || end_type == LEXER_SCAN_FUNCTION_BODY)))
   {
     parser_raise_error (context_p, PARSER_ERR_INVALID_EXPRESSION);
   }
@@ -380,7 +382,8 @@ parser_scan_statement (parser_context_t *context_p, /**< context */
     {
       lexer_next_token (context_p);
       if (!context_p->token.was_newline
-          && context_p->token.type != LEXER_SEMICOLON)
+          && context_p->token.type != LEXER_SEMICOLON
+          && context_p->token.type != LEXER_RIGHT_BRACE)
       {
         *mode = SCAN_MODE_PRIMARY_EXPRESSION;
       }
@@ -498,6 +501,10 @@ parser_scan_until (parser_context_t *context_p, /**< context */
     end_type_b = LEXER_SCAN_SWITCH;
     mode = SCAN_MODE_STATEMENT;
   }
+  else if (end_type == LEXER_SCAN_FUNCTION_BODY)
+  {
+    mode = SCAN_MODE_STATEMENT;
+  }
   else
   {
     lexer_next_token (context_p);
@@ -577,6 +584,14 @@ parser_scan_until (parser_context_t *context_p, /**< context */
           return;
         }
 
+        if (end_type == LEXER_SCAN_FUNCTION_BODY
+            && stack_top == SCAN_STACK_HEAD
+            && type == LEXER_RIGHT_BRACE)
+        {
+          parser_stack_pop_uint8 (context_p);
+          return;
+        }
+
         if (parser_scan_statement (context_p, type, stack_top, &mode))
         {
           continue;
@@ -1645,6 +1645,17 @@ parser_parse_statements (parser_context_t *context_p) /**< context */
     JERRY_ASSERT (context_p->stack_depth == context_p->context_stack_depth);
 #endif /* PARSER_DEBUG */
 
+#ifdef JERRY_LINE_INFO
+    if (context_p->token.line != context_p->line_info_last_line
+        && context_p->token.type != LEXER_SEMICOLON
+        && context_p->token.type != LEXER_RIGHT_BRACE
+        && context_p->token.type != LEXER_EXPRESSION_START
+        && context_p->token.type != LEXER_EOS)
+    {
+      parser_add_line_info (context_p);
+    }
+#endif /* JERRY_LINE_INFO */
+
     switch (context_p->token.type)
     {
       case LEXER_SEMICOLON:
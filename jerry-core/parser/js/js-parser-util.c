@@ -640,6 +640,28 @@ parser_set_continues_to_current_position (parser_context_t *context_p, /**< cont
   }
 } /* parser_set_continues_to_current_position */
 
+#ifdef JERRY_LINE_INFO
+
+/**
+ * Mark the current byte code position as the start of the current source line
+ */
+void
+parser_add_line_info (parser_context_t *context_p) /**< context */
+{
+  parser_flush_cbc (context_p);
+
+  parser_line_info_t *line_info_p;
+  line_info_p = (parser_line_info_t *) parser_list_append (context_p, &context_p->line_info);
+
+  line_info_p->page_p = context_p->byte_code.last_p;
+  line_info_p->position = context_p->byte_code.last_position;
+  line_info_p->line = context_p->token.line;
+
+  context_p->line_info_last_line = context_p->token.line;
+} /* parser_add_line_info */
+
+#endif /* JERRY_LINE_INFO */
+
 /**
  * Returns with the striong representation of the error
  */
@@ -17,7 +17,10 @@
 #include "ecma-exceptions.h"
 #include "ecma-helpers.h"
 #include "ecma-literal-storage.h"
+#include "jcontext.h"
 #include "js-parser-internal.h"
+#include "vm-runtime-stats.h"
+#include "vm-trace.h"
 
 #ifdef PARSER_DUMP_BYTE_CODE
 static int parser_show_instrs = PARSER_FALSE;
@@ -1239,6 +1242,37 @@ parse_print_final_cbc (ecma_compiled_code_t *compiled_code_p, /**< compiled code
     } \
   } while (0)
 
+#ifdef JERRY_LINE_INFO
+
+/**
+ * Append an entry to the line info of a compiled code.
+ */
+static void
+parser_line_info_append_entry (cbc_line_info_entry_t *entries_p, /**< line info entries */
+                               uint32_t *entry_count_p, /**< [in, out] number of entries */
+                               uint32_t offset, /**< byte code offset */
+                               parser_line_counter_t line) /**< source line */
+{
+  uint32_t entry_count = *entry_count_p;
+
+  /* A later mark at the same offset overrides the previous one. */
+  if (entry_count > 0 && entries_p[entry_count - 1].offset == offset)
+  {
+    entry_count--;
+  }
+
+  if (entry_count == 0 || entries_p[entry_count - 1].line != line)
+  {
+    entries_p[entry_count].offset = offset;
+    entries_p[entry_count].line = line;
+    entry_count++;
+  }
+
+  *entry_count_p = entry_count;
+} /* parser_line_info_append_entry */
+
+#endif /* JERRY_LINE_INFO */
+
 /**
  * Post processing main function.
  *
@@ -1266,6 +1300,14 @@ parser_post_processing (parser_context_t *context_p) /**< context */
   ecma_compiled_code_t *compiled_code_p;
   jmem_cpointer_t *literal_pool_p;
   uint8_t *dst_p;
+#ifdef JERRY_LINE_INFO
+  parser_list_iterator_t line_info_iterator;
+  parser_line_info_t *line_info_p;
+  cbc_line_info_t *line_info_header_p;
+  cbc_line_info_entry_t *line_info_entries_p;
+  uint32_t line_info_count;
+  size_t line_info_size;
+#endif /* JERRY_LINE_INFO */
 
   if ((size_t) context_p->stack_limit + (size_t) context_p->register_count > PARSER_MAXIMUM_STACK_LIMIT)
   {
@@ -1464,6 +1506,28 @@ parser_post_processing (parser_context_t *context_p) /**< context */
   total_size += length + context_p->literal_count * sizeof (jmem_cpointer_t);
   total_size = JERRY_ALIGNUP (total_size, JMEM_ALIGNMENT);
 
+#ifdef JERRY_LINE_INFO
+  /* The marks which point to the end of a page belong to the first byte of the next page. */
+  line_info_count = 0;
+  parser_list_iterator_init (&context_p->line_info, &line_info_iterator);
+
+  while ((line_info_p = (parser_line_info_t *) parser_list_iterator_next (&line_info_iterator)) != NULL)
+  {
+    if (line_info_p->position >= PARSER_CBC_STREAM_PAGE_SIZE)
+    {
+      line_info_p->page_p = (line_info_p->page_p != NULL ? line_info_p->page_p->next_p
+                                                        : context_p->byte_code.first_p);
+      line_info_p->position = 0;
+    }
+    line_info_count++;
+  }
+
+  line_info_size = JERRY_ALIGNUP (sizeof (cbc_line_info_t) + line_info_count * sizeof (cbc_line_info_entry_t),
+                                  JMEM_ALIGNMENT);
+  total_size += line_info_size;
+#endif /* JERRY_LINE_INFO */
+
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_BYTE_CODE);
   compiled_code_p = (ecma_compiled_code_t *) parser_malloc (context_p, total_size);
 
   byte_code_p = (uint8_t *) compiled_code_p;
@@ -1538,6 +1602,15 @@ parser_post_processing (parser_context_t *context_p) /**< context */
   offset = 0;
   real_offset = 0;
 
+#ifdef JERRY_LINE_INFO
+  line_info_header_p = (cbc_line_info_t *) (((uint8_t *) compiled_code_p) + total_size - sizeof (cbc_line_info_t));
+  line_info_entries_p = (cbc_line_info_entry_t *) (((uint8_t *) compiled_code_p) + total_size - line_info_size);
+  line_info_count = 0;
+
+  parser_list_iterator_init (&context_p->line_info, &line_info_iterator);
+  line_info_p = (parser_line_info_t *) parser_list_iterator_next (&line_info_iterator);
+#endif /* JERRY_LINE_INFO */
+
   while (page_p != last_page_p || offset < last_position)
   {
     uint8_t flags;
@@ -1546,6 +1619,19 @@ parser_post_processing (parser_context_t *context_p) /**< context */
     cbc_opcode_t opcode;
     size_t branch_offset_length;
 
+#ifdef JERRY_LINE_INFO
+    while (line_info_p != NULL
+           && line_info_p->page_p == page_p
+           && line_info_p->position == offset)
+    {
+      parser_line_info_append_entry (line_info_entries_p,
+                                     &line_info_count,
+                                     (uint32_t) (dst_p - byte_code_p),
+                                     line_info_p->line);
+      line_info_p = (parser_line_info_t *) parser_list_iterator_next (&line_info_iterator);
+    }
+#endif /* JERRY_LINE_INFO */
+
     opcode_p = dst_p;
     branch_mark_p = page_p->bytes + offset;
     opcode = (cbc_opcode_t) (*branch_mark_p);
@@ -1670,6 +1756,25 @@ parser_post_processing (parser_context_t *context_p) /**< context */
     }
   }
 
+#ifdef JERRY_LINE_INFO
+  /* The remaining marks belong to statements without byte code at the end of the function. */
+  while (line_info_p != NULL)
+  {
+    parser_line_info_append_entry (line_info_entries_p,
+                                   &line_info_count,
+                                   (uint32_t) (dst_p - byte_code_p),
+                                   line_info_p->line);
+    line_info_p = (parser_line_info_t *) parser_list_iterator_next (&line_info_iterator);
+  }
+
+  line_info_header_p->size = (uint32_t) line_info_size;
+  line_info_header_p->entry_count = line_info_count;
+  line_info_header_p->line = context_p->function_line;
+  line_info_header_p->name_cp = context_p->function_name_cp;
+
+  compiled_code_p->status_flags |= CBC_CODE_FLAGS_HAS_LINE_INFO;
+#endif /* JERRY_LINE_INFO */
+
   if (!(context_p->status_flags & PARSER_NO_END_LABEL))
   {
     *dst_p++ = CBC_RETURN_WITH_BLOCK;
@@ -1807,6 +1912,9 @@ static ecma_compiled_code_t *
 parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
                      size_t size, /**< size of the source code */
                      int strict_mode, /**< strict mode */
+                     int lazy_functions, /**< compile inner functions on their first call */
+                     const cbc_lazy_function_t *lazy_function_p, /**< lazy function whose source is
+                                                                  *   compiled (NULL for scripts) */
                      parser_error_location *error_location) /**< error location */
 {
   parser_context_t context;
@@ -1831,11 +1939,22 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
     context.status_flags |= PARSER_IS_STRICT;
   }
 
+  if (lazy_functions && lazy_function_p == NULL)
+  {
+    context.status_flags |= PARSER_LAZY_FUNCTIONS;
+  }
+
   context.source_p = source_p;
   context.source_end_p = source_p + size;
   context.line = 1;
   context.column = 1;
 
+  if (lazy_function_p != NULL)
+  {
+    context.line = lazy_function_p->line;
+    context.column = lazy_function_p->column;
+  }
+
   context.last_cbc_opcode = PARSER_CBC_UNAVAILABLE;
 
   context.argument_count = 0;
@@ -1849,6 +1968,15 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
                     (uint32_t) ((128 - sizeof (void *)) / sizeof (lexer_literal_t)));
   parser_stack_init (&context);
 
+#ifdef JERRY_LINE_INFO
+  parser_list_init (&context.line_info,
+                    sizeof (parser_line_info_t),
+                    (uint32_t) ((128 - sizeof (void *)) / sizeof (parser_line_info_t)));
+  context.line_info_last_line = 0;
+  context.function_line = 0;
+  context.function_name_cp = JMEM_CP_NULL;
+#endif /* JERRY_LINE_INFO */
+
 #ifdef PARSER_DEBUG
   context.context_stack_depth = 0;
 #endif /* PARSER_DEBUG */
@@ -1868,12 +1996,39 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
     /* Pushing a dummy value ensures the stack is never empty.
      * This simplifies the stack management routines. */
     parser_stack_push_uint8 (&context, CBC_MAXIMUM_BYTE_VALUE);
-    /* The next token must always be present to make decisions
-     * in the parser. Therefore when a token is consumed, the
-     * lexer_next_token() must be immediately called. */
-    lexer_next_token (&context);
 
-    parser_parse_statements (&context);
+    if (lazy_function_p != NULL)
+    {
+      /* Only the function is parsed, which restores the context after
+       * parsing. The lazy mode is not inherited from the context, since
+       * the function itself must be compiled. */
+      uint32_t status_flags = lazy_function_p->status_flags;
+
+      if (lazy_functions)
+      {
+        status_flags |= PARSER_LAZY_FUNCTIONS;
+      }
+
+#ifdef JERRY_LINE_INFO
+      /* The name of the function is not part of its source. */
+      context.token.type = LEXER_EOS;
+      context.function_name_cp = lazy_function_p->name_cp;
+#endif /* JERRY_LINE_INFO */
+
+      compiled_code = parser_parse_function (&context, status_flags);
+      JERRY_ASSERT (context.token.type == LEXER_RIGHT_BRACE);
+    }
+    else
+    {
+      /* The next token must always be present to make decisions
+       * in the parser. Therefore when a token is consumed, the
+       * lexer_next_token() must be immediately called. */
+      lexer_next_token (&context);
+
+      VM_TRACE_BEGIN ();
+      parser_parse_statements (&context);
+      VM_TRACE_END (VM_TRACE_EVENT_PARSE_STATEMENTS, 0, 0, 0);
+    }
 
     /* When the parsing is successful, only the
      * dummy value can be remained on the stack. */
@@ -1887,9 +2042,19 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
     JERRY_ASSERT (context.last_cbc_opcode == PARSER_CBC_UNAVAILABLE);
     JERRY_ASSERT (context.allocated_buffer_p == NULL);
 
-    compiled_code = parser_post_processing (&context);
+    if (lazy_function_p == NULL)
+    {
+      VM_TRACE_BEGIN ();
+      compiled_code = parser_post_processing (&context);
+      VM_TRACE_END (VM_TRACE_EVENT_PARSE_POST_PROCESSING, 0, 0, 0);
+    }
+
     parser_list_free (&context.literal_pool);
 
+#ifdef JERRY_LINE_INFO
+    parser_list_free (&context.line_info);
+#endif /* JERRY_LINE_INFO */
+
 #ifdef PARSER_DUMP_BYTE_CODE
     if (context.is_show_opcodes)
     {
@@ -1922,6 +2087,10 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
     compiled_code = NULL;
     parser_free_literals (&context.literal_pool);
     parser_cbc_stream_free (&context.byte_code);
+
+#ifdef JERRY_LINE_INFO
+    parser_list_free (&context.line_info);
+#endif /* JERRY_LINE_INFO */
   }
   PARSER_TRY_END
 
@@ -1937,6 +2106,66 @@ parser_parse_source (const uint8_t *source_p, /**< valid UTF-8 source code */
   return compiled_code;
 } /* parser_parse_source */
 
+/**
+ * Pre-scan the body of a function and create a lazy function
+ * which is compiled when it is called the first time.
+ *
+ * @return lazy function
+ */
+static ecma_compiled_code_t *
+parser_scan_function_body (parser_context_t *context_p, /**< context */
+                           const uint8_t *source_p, /**< start of the function source */
+                           parser_line_counter_t line, /**< line of the function source */
+                           parser_line_counter_t column, /**< column of the function source */
+                           uint32_t status_flags) /**< status flags of the function */
+{
+  lexer_range_t range;
+
+  if ((context_p->status_flags & PARSER_IS_STRICT)
+      && (context_p->status_flags & PARSER_HAS_NON_STRICT_ARG))
+  {
+    parser_raise_error (context_p, PARSER_ERR_NON_STRICT_ARG_DEFINITION);
+  }
+
+  parser_scan_until (context_p, &range, LEXER_SCAN_FUNCTION_BODY);
+  JERRY_ASSERT (context_p->token.type == LEXER_RIGHT_BRACE);
+
+  size_t total_size = JERRY_ALIGNUP (sizeof (cbc_lazy_function_t), JMEM_ALIGNMENT);
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_BYTE_CODE);
+  cbc_lazy_function_t *lazy_function_p = (cbc_lazy_function_t *) parser_malloc (context_p, total_size);
+
+  lazy_function_p->header.size = (uint16_t) (total_size >> JMEM_ALIGNMENT_LOG);
+  lazy_function_p->header.refs = 1;
+  lazy_function_p->header.status_flags = CBC_CODE_FLAGS_FUNCTION | CBC_CODE_FLAGS_LAZY_FUNCTION;
+
+  if (context_p->status_flags & PARSER_IS_STRICT)
+  {
+    lazy_function_p->header.status_flags |= CBC_CODE_FLAGS_STRICT_MODE;
+  }
+
+  lazy_function_p->argument_end = context_p->argument_count;
+  lazy_function_p->status_flags = status_flags;
+  lazy_function_p->line = line;
+  lazy_function_p->column = column;
+  lazy_function_p->source_size = (uint32_t) (context_p->source_p - source_p);
+  lazy_function_p->source_p = source_p;
+  lazy_function_p->bytecode_cp = JMEM_CP_NULL;
+#ifdef JERRY_LINE_INFO
+  lazy_function_p->name_cp = context_p->function_name_cp;
+#endif /* JERRY_LINE_INFO */
+
+#ifdef PARSER_DUMP_BYTE_CODE
+  if (context_p->is_show_opcodes)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                    "  Lazy function: %d bytes of source\n",
+                    (int) lazy_function_p->source_size);
+  }
+#endif /* PARSER_DUMP_BYTE_CODE */
+
+  return (ecma_compiled_code_t *) lazy_function_p;
+} /* parser_scan_function_body */
+
 /**
  * Parse function code
  *
@@ -1948,6 +2177,9 @@ parser_parse_function (parser_context_t *context_p, /**< context */
 {
   parser_saved_context_t saved_context;
   ecma_compiled_code_t *compiled_code_p;
+  const uint8_t *source_start_p = context_p->source_p;
+  parser_line_counter_t source_line = context_p->line;
+  parser_line_counter_t source_column = context_p->column;
 
   JERRY_ASSERT (context_p->last_cbc_opcode == PARSER_CBC_UNAVAILABLE);
 
@@ -1967,6 +2199,13 @@ parser_parse_function (parser_context_t *context_p, /**< context */
   saved_context.byte_code_size = context_p->byte_code_size;
   saved_context.literal_pool_data = context_p->literal_pool.data;
 
+#ifdef JERRY_LINE_INFO
+  saved_context.line_info_data = context_p->line_info.data;
+  saved_context.line_info_last_line = context_p->line_info_last_line;
+  saved_context.function_line = context_p->function_line;
+  saved_context.function_name_cp = context_p->function_name_cp;
+#endif /* JERRY_LINE_INFO */
+
 #ifdef PARSER_DEBUG
   saved_context.context_stack_depth = context_p->context_stack_depth;
 #endif /* PARSER_DEBUG */
@@ -1975,7 +2214,7 @@ parser_parse_function (parser_context_t *context_p, /**< context */
 
   JERRY_ASSERT (status_flags & PARSER_IS_FUNCTION);
 
-  context_p->status_flags &= PARSER_IS_STRICT;
+  context_p->status_flags &= PARSER_IS_STRICT | PARSER_LAZY_FUNCTIONS;
   context_p->status_flags |= status_flags;
   context_p->stack_depth = 0;
   context_p->stack_limit = 0;
@@ -1990,6 +2229,28 @@ parser_parse_function (parser_context_t *context_p, /**< context */
   context_p->byte_code_size = 0;
   parser_list_reset (&context_p->literal_pool);
 
+#ifdef JERRY_LINE_INFO
+  parser_list_reset (&context_p->line_info);
+  context_p->line_info_last_line = 0;
+  context_p->function_line = source_line;
+
+  /* The current token is the name of function statements and property accessors.
+   * Lazy functions are compiled with an end of source token, and their name is
+   * set by parser_parse_source. */
+  if (context_p->token.type == LEXER_LITERAL
+      && (context_p->token.lit_location.type == LEXER_IDENT_LITERAL
+          || context_p->token.lit_location.type == LEXER_STRING_LITERAL)
+      && !context_p->token.lit_location.has_escape)
+  {
+    context_p->function_name_cp = ecma_find_or_create_literal_string (context_p->token.lit_location.char_p,
+                                                                      context_p->token.lit_location.length);
+  }
+  else if (context_p->token.type != LEXER_EOS)
+  {
+    context_p->function_name_cp = JMEM_CP_NULL;
+  }
+#endif /* JERRY_LINE_INFO */
+
 #ifdef PARSER_DEBUG
   context_p->context_stack_depth = 0;
 #endif /* PARSER_DEBUG */
@@ -2025,6 +2286,14 @@ parser_parse_function (parser_context_t *context_p, /**< context */
       context_p->status_flags |= PARSER_HAS_NON_STRICT_ARG;
     }
 
+#ifdef JERRY_LINE_INFO
+    if (!context_p->token.lit_location.has_escape)
+    {
+      context_p->function_name_cp = ecma_find_or_create_literal_string (context_p->token.lit_location.char_p,
+                                                                        context_p->token.lit_location.length);
+    }
+#endif /* JERRY_LINE_INFO */
+
     lexer_next_token (context_p);
   }
 
@@ -2154,8 +2423,33 @@ parser_parse_function (parser_context_t *context_p, /**< context */
   }
 
   lexer_next_token (context_p);
-  parser_parse_statements (context_p);
-  compiled_code_p = parser_post_processing (context_p);
+
+  /* The body of inner functions is only scanned in lazy mode. Functions starting
+   * with a directive are compiled immediately, since a "use strict" directive
+   * affects the function object. */
+  if ((saved_context.status_flags & PARSER_LAZY_FUNCTIONS)
+      && (context_p->token.type != LEXER_LITERAL
+          || context_p->token.lit_location.type != LEXER_STRING_LITERAL))
+  {
+    compiled_code_p = parser_scan_function_body (context_p,
+                                                 source_start_p,
+                                                 source_line,
+                                                 source_column,
+                                                 status_flags);
+
+    parser_free_literals (&context_p->literal_pool);
+    parser_cbc_stream_free (&context_p->byte_code);
+  }
+  else
+  {
+    parser_parse_statements (context_p);
+    compiled_code_p = parser_post_processing (context_p);
+    parser_list_free (&context_p->literal_pool);
+  }
+
+#ifdef JERRY_LINE_INFO
+  parser_list_free (&context_p->line_info);
+#endif /* JERRY_LINE_INFO */
 
 #ifdef PARSER_DUMP_BYTE_CODE
   if (context_p->is_show_opcodes)
@@ -2164,8 +2458,6 @@ parser_parse_function (parser_context_t *context_p, /**< context */
   }
 #endif /* PARSER_DUMP_BYTE_CODE */
 
-  parser_list_free (&context_p->literal_pool);
-
   /* Restore private part of the context. */
 
   JERRY_ASSERT (context_p->last_cbc_opcode == PARSER_CBC_UNAVAILABLE);
@@ -2184,6 +2476,13 @@ parser_parse_function (parser_context_t *context_p, /**< context */
   context_p->byte_code_size = saved_context.byte_code_size;
   context_p->literal_pool.data = saved_context.literal_pool_data;
 
+#ifdef JERRY_LINE_INFO
+  context_p->line_info.data = saved_context.line_info_data;
+  context_p->line_info_last_line = saved_context.line_info_last_line;
+  context_p->function_line = saved_context.function_line;
+  context_p->function_name_cp = saved_context.function_name_cp;
+#endif /* JERRY_LINE_INFO */
+
 #ifdef PARSER_DEBUG
   context_p->context_stack_depth = saved_context.context_stack_depth;
 #endif /* PARSER_DEBUG */
@@ -2212,6 +2511,11 @@ parser_raise_error (parser_context_t *context_p, /**< context */
     parser_free_literals (&context_p->literal_pool);
     context_p->literal_pool.data = saved_context_p->literal_pool_data;
 
+#ifdef JERRY_LINE_INFO
+    parser_list_free (&context_p->line_info);
+    context_p->line_info.data = saved_context_p->line_info_data;
+#endif /* JERRY_LINE_INFO */
+
     if (saved_context_p->last_statement.current_p != NULL)
     {
       parser_free_jumps (saved_context_p->last_statement);
@@ -2243,6 +2547,7 @@ parser_set_show_instrs (int show_instrs) /**< flag indicating whether to dump by
  * Parse EcamScript source code
  *
  * Note:
+ *      short sources are looked up in the compiled code cache first
  *      returned value must be freed with ecma_free_value
  *
  * @return true - if success
@@ -2252,19 +2557,80 @@ ecma_value_t
 parser_parse_script (const uint8_t *source_p, /**< source code */
                      size_t size, /**< size of the source code */
                      bool is_strict, /**< strict mode */
+                     bool is_lazy, /**< compile functions on their first call */
                      ecma_compiled_code_t **bytecode_data_p) /**< [out] JS bytecode */
 {
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+  uint16_t cache_flags = (uint16_t) ((is_strict ? PARSER_CODE_CACHE_IS_STRICT : 0)
+                                     | (is_lazy ? PARSER_CODE_CACHE_LAZY_FUNCTIONS : 0));
+
+  *bytecode_data_p = parser_code_cache_find (source_p, size, cache_flags);
+
+  if (*bytecode_data_p != NULL)
+  {
+    return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+  }
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
   parser_error_location parse_error;
-  *bytecode_data_p = parser_parse_source (source_p, size, is_strict, &parse_error);
+
+  VM_RUNTIME_STATS_ENTER (VM_RUNTIME_PHASE_PARSE);
+  VM_TRACE_BEGIN ();
+  *bytecode_data_p = parser_parse_source (source_p, size, is_strict, is_lazy, NULL, &parse_error);
+  VM_TRACE_END (VM_TRACE_EVENT_PARSE, size, 0, 0);
+  VM_RUNTIME_STATS_LEAVE ();
 
   if (!*bytecode_data_p)
   {
     return ecma_raise_syntax_error (parser_error_to_string (parse_error.error));
   }
 
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+  parser_code_cache_insert (source_p, size, cache_flags, *bytecode_data_p);
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
   return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
 } /* parser_parse_script */
 
+/**
+ * Compile a function whose body was only pre-scanned by parser_parse_script
+ *
+ * Note:
+ *      returned value must be freed with ecma_free_value
+ *
+ * @return true - if success
+ *         syntax error - otherwise
+ */
+ecma_value_t
+parser_compile_lazy_function (const ecma_compiled_code_t *lazy_code_p, /**< lazy function */
+                              ecma_compiled_code_t **bytecode_data_p) /**< [out] JS bytecode */
+{
+  JERRY_ASSERT (lazy_code_p->status_flags & CBC_CODE_FLAGS_LAZY_FUNCTION);
+
+  const cbc_lazy_function_t *lazy_function_p = (const cbc_lazy_function_t *) lazy_code_p;
+  bool is_strict = (lazy_code_p->status_flags & CBC_CODE_FLAGS_STRICT_MODE) != 0;
+
+  parser_error_location parse_error;
+
+  VM_RUNTIME_STATS_ENTER (VM_RUNTIME_PHASE_PARSE);
+  VM_TRACE_BEGIN ();
+  *bytecode_data_p = parser_parse_source (lazy_function_p->source_p,
+                                          lazy_function_p->source_size,
+                                          is_strict,
+                                          true,
+                                          lazy_function_p,
+                                          &parse_error);
+  VM_TRACE_END (VM_TRACE_EVENT_PARSE_LAZY_FUNCTION, lazy_function_p->source_size, 0, 0);
+  VM_RUNTIME_STATS_LEAVE ();
+
+  if (!*bytecode_data_p)
+  {
+    return ecma_raise_syntax_error (parser_error_to_string (parse_error.error));
+  }
+
+  return ecma_make_simple_value (ECMA_SIMPLE_VALUE_TRUE);
+} /* parser_compile_lazy_function */
+
 /**
  * @}
  * @}
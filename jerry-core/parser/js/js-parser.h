@@ -128,8 +128,35 @@ typedef struct
   parser_line_counter_t column;                       /**< column where the error occured */
 } parser_error_location;
 
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+
+/**
+ * Entry of the compiled code cache
+ *
+ * The source code is stored after this structure.
+ */
+typedef struct
+{
+  ecma_compiled_code_t *bytecode_p;                   /**< compiled code (the cache holds a reference) */
+  uint32_t source_size;                               /**< size of the source code */
+  uint32_t last_used;                                 /**< value of the look-up counter when the entry
+                                                       *   was created or found last time */
+  lit_string_hash_t hash;                             /**< hash of the source code */
+  uint16_t flags;                                     /**< compilation options */
+} parser_code_cache_entry_t;
+
+extern void parser_code_cache_release_unused (void);
+extern void parser_code_cache_free (void);
+
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
 /* Note: source must be a valid UTF-8 string */
-extern ecma_value_t parser_parse_script (const uint8_t *, size_t, bool, ecma_compiled_code_t **);
+extern ecma_value_t parser_parse_script (const uint8_t *, size_t, bool, bool, ecma_compiled_code_t **);
+extern ecma_value_t parser_compile_lazy_function (const ecma_compiled_code_t *, ecma_compiled_code_t **);
+
+#ifdef JERRY_ENABLE_SNAPSHOT_SAVE
+extern ecma_compiled_code_t *parser_optimize_byte_code (const ecma_compiled_code_t *);
+#endif /* JERRY_ENABLE_SNAPSHOT_SAVE */
 
 const char *parser_error_to_string (parser_error_t);
 
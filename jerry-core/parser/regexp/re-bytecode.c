@@ -15,6 +15,7 @@
  */
 
 #include "ecma-globals.h"
+#include "jcontext.h"
 #include "re-bytecode.h"
 
 #ifndef CONFIG_DISABLE_REGEXP_BUILTIN
@@ -54,6 +55,7 @@ re_realloc_regexp_bytecode_block (re_bytecode_ctx_t *bc_ctx_p) /**< RegExp bytec
   JERRY_ASSERT (bc_ctx_p->current_p >= bc_ctx_p->block_start_p);
   size_t current_ptr_offset = (size_t) (bc_ctx_p->current_p - bc_ctx_p->block_start_p);
 
+  JMEM_SET_ALLOC_CATEGORY (JMEM_ALLOC_CATEGORY_REGEXP_BYTE_CODE);
   uint8_t *new_block_start_p = (uint8_t *) jmem_heap_alloc_block (new_block_size);
   if (bc_ctx_p->current_p)
   {
@@ -40,7 +40,7 @@ typedef const uint8_t *vm_instr_counter_t;
 /**
  * Context of interpreter, related to a JS stack frame
  */
-typedef struct
+typedef struct vm_frame_ctx_t
 {
   const ecma_compiled_code_t *bytecode_header_p;      /**< currently executed byte-code data */
   uint8_t *byte_code_p;                               /**< current byte code pointer */
@@ -54,6 +54,9 @@ typedef struct
   uint16_t context_depth;                             /**< current context depth */
   uint8_t is_eval_code;                               /**< eval mode flag */
   uint8_t call_operation;                             /**< perform a call or construct operation */
+#ifdef JERRY_CPU_PROFILER
+  struct vm_frame_ctx_t *prev_context_p;              /**< previous frame context */
+#endif /* JERRY_CPU_PROFILER */
 } vm_frame_ctx_t;
 
 /**
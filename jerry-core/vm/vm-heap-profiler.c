@@ -0,0 +1,568 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-helpers.h"
+#include "byte-code.h"
+#include "jcontext.h"
+#include "lit-char-helpers.h"
+#include "vm.h"
+#include "vm-heap-profiler.h"
+
+#ifdef JERRY_HEAP_PROFILER
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_heap_profiler Heap profiler
+ * @{
+ *
+ * Each allocated block is attributed to an allocation site, which is the source line
+ * executed by the innermost JavaScript frame together with the category of the block.
+ * The site of a block is stored in a side table indexed by the first heap unit of the
+ * block, so the blocks themselves are not changed. The timeline is clocked by the
+ * number of allocated bytes, since the engine has no notion of time.
+ */
+
+JERRY_STATIC_ASSERT ((JERRY_HEAP_PROFILER_SITE_TABLE_SIZE & (JERRY_HEAP_PROFILER_SITE_TABLE_SIZE - 1)) == 0
+                     && JERRY_HEAP_PROFILER_SITE_TABLE_SIZE < UINT16_MAX,
+                     heap_profiler_site_table_size_must_be_a_power_of_2_less_than_65536);
+
+JERRY_STATIC_ASSERT ((JERRY_HEAP_PROFILER_TIMELINE_SIZE % 2) == 0 && JERRY_HEAP_PROFILER_TIMELINE_SIZE > 0,
+                     heap_profiler_timeline_size_must_be_even);
+
+/**
+ * Maximum number of used entries in the site table
+ */
+#define VM_HEAP_PROFILER_MAX_SITES (JERRY_HEAP_PROFILER_SITE_TABLE_SIZE / 4 * 3)
+
+/**
+ * Size of the line buffer used when the report is written to the log
+ */
+#define VM_HEAP_PROFILER_LINE_SIZE 128
+
+/**
+ * Output of the report.
+ */
+typedef struct
+{
+  lit_utf8_byte_t *buffer_p; /**< output buffer (NULL if the lines are written to the log) */
+  size_t buffer_size; /**< size of the output buffer */
+  size_t position; /**< current position in the output buffer */
+  bool is_full; /**< the output buffer is too small */
+  lit_utf8_byte_t line[VM_HEAP_PROFILER_LINE_SIZE]; /**< current line (if the lines are written to the log) */
+} vm_heap_profiler_output_t;
+
+/**
+ * Initialize the heap profiler: the allocation sites and the timeline are discarded.
+ */
+void
+vm_heap_profiler_init (void)
+{
+  memset (&jerry_global_heap_profiler, 0, sizeof (jerry_heap_profiler_t));
+
+  JERRY_HEAP_PROFILER_CONTEXT (timeline_interval) = CONFIG_HEAP_PROFILER_TIMELINE_INTERVAL;
+  JERRY_HEAP_PROFILER_CONTEXT (next_timeline_entry) = CONFIG_HEAP_PROFILER_TIMELINE_INTERVAL;
+} /* vm_heap_profiler_init */
+
+/**
+ * Copy the name of a function into a site (the name is truncated to a character boundary if it is too long).
+ */
+static void
+vm_heap_profiler_copy_name (jerry_heap_profiler_site_t *site_p, /**< site */
+                            jmem_cpointer_t name_cp) /**< name of the function */
+{
+  site_p->name_size = 0;
+
+  if (name_cp == JMEM_CP_NULL)
+  {
+    return;
+  }
+
+  ecma_string_t *name_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, name_cp);
+  lit_utf8_size_t name_size = ecma_string_get_size (name_p);
+
+  if (name_size <= JERRY_HEAP_PROFILER_NAME_SIZE)
+  {
+    ecma_string_to_utf8_bytes (name_p, site_p->name, name_size);
+    site_p->name_size = (uint8_t) name_size;
+    return;
+  }
+
+  bool is_ascii;
+  const lit_utf8_byte_t *chars_p = ecma_string_raw_chars (name_p, &name_size, &is_ascii);
+
+  if (chars_p == NULL)
+  {
+    return;
+  }
+
+  name_size = JERRY_HEAP_PROFILER_NAME_SIZE;
+
+  while (name_size > 0 && (chars_p[name_size] & LIT_UTF8_EXTRA_BYTE_MASK) == LIT_UTF8_EXTRA_BYTE_MARKER)
+  {
+    name_size--;
+  }
+
+  memcpy (site_p->name, chars_p, name_size);
+  site_p->name_size = (uint8_t) name_size;
+} /* vm_heap_profiler_copy_name */
+
+/**
+ * Find or create the site of an allocation of the given category.
+ *
+ * @return index of the site plus one
+ *         0 - if the site table is full
+ */
+static uint16_t
+vm_heap_profiler_get_site (uint8_t category) /**< category of the allocated block */
+{
+  const vm_frame_ctx_t *frame_ctx_p = JERRY_CONTEXT (vm_top_context_p);
+  jmem_cpointer_t name_cp = JMEM_CP_NULL;
+  uint32_t function_line = VM_HEAP_PROFILER_NO_FRAME;
+  uint32_t line = 0;
+
+  if (frame_ctx_p != NULL)
+  {
+    const ecma_compiled_code_t *bytecode_p = frame_ctx_p->bytecode_header_p;
+
+    function_line = VM_HEAP_PROFILER_NO_LINE_INFO;
+
+    if (bytecode_p->status_flags & CBC_CODE_FLAGS_HAS_LINE_INFO)
+    {
+      const cbc_line_info_t *line_info_p = CBC_GET_LINE_INFO (bytecode_p);
+
+      name_cp = line_info_p->name_cp;
+      function_line = line_info_p->line;
+      line = vm_get_current_line (frame_ctx_p);
+    }
+  }
+
+  uint32_t hash = ((uint32_t) name_cp * 31u) ^ (function_line * 2654435761u) ^ (line * 40503u) ^ category;
+  uint32_t index = (hash ^ (hash >> 16)) & (JERRY_HEAP_PROFILER_SITE_TABLE_SIZE - 1);
+
+  while (true)
+  {
+    jerry_heap_profiler_site_t *site_p = JERRY_HEAP_PROFILER_CONTEXT (sites) + index;
+
+    if (!site_p->is_used)
+    {
+      if (JERRY_HEAP_PROFILER_CONTEXT (site_count) >= VM_HEAP_PROFILER_MAX_SITES)
+      {
+        return 0;
+      }
+
+      site_p->is_used = true;
+      site_p->name_cp = name_cp;
+      site_p->function_line = function_line;
+      site_p->line = line;
+      site_p->category = category;
+      vm_heap_profiler_copy_name (site_p, name_cp);
+
+      JERRY_HEAP_PROFILER_CONTEXT (site_count)++;
+      return (uint16_t) (index + 1);
+    }
+
+    if (site_p->name_cp == name_cp
+        && site_p->function_line == function_line
+        && site_p->line == line
+        && site_p->category == category)
+    {
+      return (uint16_t) (index + 1);
+    }
+
+    index = (index + 1) & (JERRY_HEAP_PROFILER_SITE_TABLE_SIZE - 1);
+  }
+} /* vm_heap_profiler_get_site */
+
+/**
+ * Get the side table entry of a heap block.
+ *
+ * @return pointer to the site of the block plus one
+ */
+static inline uint16_t * __attr_always_inline___
+vm_heap_profiler_get_block_site (void *block_p) /**< heap block */
+{
+  size_t unit = (size_t) ((uint8_t *) block_p - JERRY_HEAP_CONTEXT (area)) >> JMEM_ALIGNMENT_LOG;
+
+  JERRY_ASSERT (unit < JMEM_HEAP_AREA_SIZE / JMEM_ALIGNMENT);
+  return JERRY_HEAP_PROFILER_CONTEXT (block_sites) + unit;
+} /* vm_heap_profiler_get_block_site */
+
+/**
+ * Append an entry to the timeline, dropping every second entry if the timeline is full.
+ */
+static void
+vm_heap_profiler_add_timeline_entry (void)
+{
+  if (JERRY_HEAP_PROFILER_CONTEXT (timeline_count) == JERRY_HEAP_PROFILER_TIMELINE_SIZE)
+  {
+    jerry_heap_profiler_timeline_entry_t *timeline_p = JERRY_HEAP_PROFILER_CONTEXT (timeline);
+
+    for (uint32_t i = 0; i < JERRY_HEAP_PROFILER_TIMELINE_SIZE / 2; i++)
+    {
+      timeline_p[i] = timeline_p[2 * i + 1];
+    }
+
+    JERRY_HEAP_PROFILER_CONTEXT (timeline_count) = JERRY_HEAP_PROFILER_TIMELINE_SIZE / 2;
+    JERRY_HEAP_PROFILER_CONTEXT (next_timeline_entry) += JERRY_HEAP_PROFILER_CONTEXT (timeline_interval);
+    JERRY_HEAP_PROFILER_CONTEXT (timeline_interval) *= 2;
+
+    if (JERRY_HEAP_PROFILER_CONTEXT (allocated_bytes) < JERRY_HEAP_PROFILER_CONTEXT (next_timeline_entry))
+    {
+      return;
+    }
+  }
+
+  jerry_heap_profiler_timeline_entry_t *entry_p;
+  entry_p = JERRY_HEAP_PROFILER_CONTEXT (timeline) + JERRY_HEAP_PROFILER_CONTEXT (timeline_count);
+
+  entry_p->allocated_bytes = JERRY_HEAP_PROFILER_CONTEXT (allocated_bytes);
+  memcpy (entry_p->live_bytes, JERRY_HEAP_PROFILER_CONTEXT (live_bytes), sizeof (entry_p->live_bytes));
+  JERRY_HEAP_PROFILER_CONTEXT (timeline_count)++;
+
+  do
+  {
+    JERRY_HEAP_PROFILER_CONTEXT (next_timeline_entry) += JERRY_HEAP_PROFILER_CONTEXT (timeline_interval);
+  }
+  while (JERRY_HEAP_PROFILER_CONTEXT (allocated_bytes) >= JERRY_HEAP_PROFILER_CONTEXT (next_timeline_entry));
+} /* vm_heap_profiler_add_timeline_entry */
+
+/**
+ * Record an allocated block. The category of the block is the one set by the
+ * last JMEM_SET_ALLOC_CATEGORY.
+ */
+void
+vm_heap_profiler_alloc (void *block_p, /**< allocated block */
+                        size_t size) /**< size of the block */
+{
+  uint8_t category = JERRY_CONTEXT (jmem_alloc_category);
+
+  size = JERRY_ALIGNUP (size, JMEM_ALIGNMENT);
+
+  uint16_t site = vm_heap_profiler_get_site (category);
+  *vm_heap_profiler_get_block_site (block_p) = site;
+
+  JERRY_HEAP_PROFILER_CONTEXT (allocated_bytes) += size;
+
+  if (site == 0)
+  {
+    JERRY_HEAP_PROFILER_CONTEXT (untracked_bytes) += size;
+  }
+  else
+  {
+    jerry_heap_profiler_site_t *site_p = JERRY_HEAP_PROFILER_CONTEXT (sites) + site - 1;
+
+    site_p->allocated_bytes += size;
+    site_p->allocated_blocks++;
+    site_p->live_bytes += (uint32_t) size;
+    site_p->live_blocks++;
+    JERRY_HEAP_PROFILER_CONTEXT (live_bytes)[category] += (uint32_t) size;
+  }
+
+  if (JERRY_HEAP_PROFILER_CONTEXT (allocated_bytes) >= JERRY_HEAP_PROFILER_CONTEXT (next_timeline_entry))
+  {
+    vm_heap_profiler_add_timeline_entry ();
+  }
+} /* vm_heap_profiler_alloc */
+
+/**
+ * Record a freed block.
+ */
+void
+vm_heap_profiler_free (void *block_p, /**< freed block */
+                       size_t size) /**< size of the block */
+{
+  uint16_t *block_site_p = vm_heap_profiler_get_block_site (block_p);
+  uint16_t site = *block_site_p;
+
+  if (site == 0)
+  {
+    /* Untracked block, e.g. loaded from a heap image or a pool chunk which is already freed. */
+    return;
+  }
+
+  *block_site_p = 0;
+  size = JERRY_ALIGNUP (size, JMEM_ALIGNMENT);
+
+  jerry_heap_profiler_site_t *site_p = JERRY_HEAP_PROFILER_CONTEXT (sites) + site - 1;
+
+  JERRY_ASSERT (site_p->live_bytes >= size && site_p->live_blocks > 0);
+
+  site_p->live_bytes -= (uint32_t) size;
+  site_p->live_blocks--;
+  JERRY_HEAP_PROFILER_CONTEXT (live_bytes)[site_p->category] -= (uint32_t) size;
+} /* vm_heap_profiler_free */
+
+/**
+ * Write the current line of the report to the log.
+ */
+static void
+vm_heap_profiler_flush_line (vm_heap_profiler_output_t *output_p) /**< output */
+{
+  output_p->line[output_p->position] = LIT_CHAR_NULL;
+  jerry_port_log (JERRY_LOG_LEVEL_ERROR, "%s", (const char *) output_p->line);
+  output_p->position = 0;
+} /* vm_heap_profiler_flush_line */
+
+/**
+ * Append bytes to the report.
+ */
+static void
+vm_heap_profiler_write (vm_heap_profiler_output_t *output_p, /**< output */
+                        const lit_utf8_byte_t *data_p, /**< data */
+                        size_t size) /**< size of the data */
+{
+  if (output_p->buffer_p == NULL)
+  {
+    /* Too long lines are truncated. */
+    for (size_t i = 0; i < size; i++)
+    {
+      if (output_p->position < VM_HEAP_PROFILER_LINE_SIZE - 2 || data_p[i] == LIT_CHAR_LF)
+      {
+        output_p->line[output_p->position++] = data_p[i];
+      }
+
+      if (data_p[i] == LIT_CHAR_LF)
+      {
+        vm_heap_profiler_flush_line (output_p);
+      }
+    }
+    return;
+  }
+
+  if (output_p->is_full || output_p->buffer_size - output_p->position < size)
+  {
+    output_p->is_full = true;
+    return;
+  }
+
+  memcpy (output_p->buffer_p + output_p->position, data_p, size);
+  output_p->position += size;
+} /* vm_heap_profiler_write */
+
+/**
+ * Append a zero terminated string to the report.
+ */
+static void
+vm_heap_profiler_write_string (vm_heap_profiler_output_t *output_p, /**< output */
+                               const char *string_p) /**< zero terminated string */
+{
+  vm_heap_profiler_write (output_p, (const lit_utf8_byte_t *) string_p, strlen (string_p));
+} /* vm_heap_profiler_write_string */
+
+/**
+ * Append a decimal number followed by a separator to the report.
+ */
+static void
+vm_heap_profiler_write_number (vm_heap_profiler_output_t *output_p, /**< output */
+                               uint64_t value, /**< number */
+                               lit_utf8_byte_t separator) /**< separator */
+{
+  lit_utf8_byte_t digits[21];
+  size_t length = sizeof (digits) - 1;
+
+  digits[length] = separator;
+
+  do
+  {
+    digits[--length] = (lit_utf8_byte_t) ('0' + value % 10);
+    value /= 10;
+  }
+  while (value > 0);
+
+  vm_heap_profiler_write (output_p, digits + length, sizeof (digits) - length);
+} /* vm_heap_profiler_write_number */
+
+/**
+ * Append the source location of a site to the report.
+ */
+static void
+vm_heap_profiler_write_site (vm_heap_profiler_output_t *output_p, /**< output */
+                             const jerry_heap_profiler_site_t *site_p) /**< site */
+{
+  if (site_p->function_line == VM_HEAP_PROFILER_NO_FRAME)
+  {
+    vm_heap_profiler_write_string (output_p, "(native)\n");
+    return;
+  }
+
+  if (site_p->function_line == VM_HEAP_PROFILER_NO_LINE_INFO)
+  {
+    vm_heap_profiler_write_string (output_p, "(unknown)\n");
+    return;
+  }
+
+  if (site_p->name_size > 0)
+  {
+    vm_heap_profiler_write (output_p, site_p->name, site_p->name_size);
+  }
+  else
+  {
+    vm_heap_profiler_write_string (output_p, (site_p->function_line == 0) ? "(program)" : "(anonymous)");
+  }
+
+  vm_heap_profiler_write_string (output_p, ":");
+  vm_heap_profiler_write_number (output_p, site_p->line, LIT_CHAR_LF);
+} /* vm_heap_profiler_write_site */
+
+/**
+ * Checks whether a site should be reported before another one.
+ *
+ * @return true - if the first site has more live bytes, or the same amount of live bytes
+ *                but more allocated bytes than the second one,
+ *         false - otherwise
+ */
+static bool
+vm_heap_profiler_site_precedes (const jerry_heap_profiler_site_t *first_p, /**< first site */
+                                const jerry_heap_profiler_site_t *second_p) /**< second site */
+{
+  if (first_p->live_bytes != second_p->live_bytes)
+  {
+    return first_p->live_bytes > second_p->live_bytes;
+  }
+
+  return first_p->allocated_bytes > second_p->allocated_bytes;
+} /* vm_heap_profiler_site_precedes */
+
+/**
+ * Write the report of the heap profiler.
+ */
+static void
+vm_heap_profiler_write_report (vm_heap_profiler_output_t *output_p) /**< output */
+{
+  const jerry_heap_profiler_site_t *sites_p = JERRY_HEAP_PROFILER_CONTEXT (sites);
+  uint16_t order[VM_HEAP_PROFILER_MAX_SITES];
+  uint32_t site_count = 0;
+
+  /* The sites are sorted by insertion, since the report is rarely written. */
+  for (uint32_t index = 0; index < JERRY_HEAP_PROFILER_SITE_TABLE_SIZE; index++)
+  {
+    if (!sites_p[index].is_used)
+    {
+      continue;
+    }
+
+    uint32_t position = site_count++;
+
+    while (position > 0 && vm_heap_profiler_site_precedes (sites_p + index, sites_p + order[position - 1]))
+    {
+      order[position] = order[position - 1];
+      position--;
+    }
+
+    order[position] = (uint16_t) index;
+  }
+
+  vm_heap_profiler_write_string (output_p, "# live_bytes live_blocks allocated_bytes allocated_blocks category site\n");
+
+  for (uint32_t i = 0; i < site_count && !output_p->is_full; i++)
+  {
+    const jerry_heap_profiler_site_t *site_p = sites_p + order[i];
+
+    vm_heap_profiler_write_number (output_p, site_p->live_bytes, LIT_CHAR_SP);
+    vm_heap_profiler_write_number (output_p, site_p->live_blocks, LIT_CHAR_SP);
+    vm_heap_profiler_write_number (output_p, site_p->allocated_bytes, LIT_CHAR_SP);
+    vm_heap_profiler_write_number (output_p, site_p->allocated_blocks, LIT_CHAR_SP);
+    vm_heap_profiler_write_string (output_p, jmem_get_alloc_category_name ((jmem_alloc_category_t) site_p->category));
+    vm_heap_profiler_write_string (output_p, " ");
+    vm_heap_profiler_write_site (output_p, site_p);
+  }
+
+  vm_heap_profiler_write_string (output_p, "# untracked_bytes ");
+  vm_heap_profiler_write_number (output_p, JERRY_HEAP_PROFILER_CONTEXT (untracked_bytes), LIT_CHAR_LF);
+
+  vm_heap_profiler_write_string (output_p, "# allocated_bytes");
+
+  for (uint32_t category = 0; category < JMEM_ALLOC_CATEGORY__COUNT; category++)
+  {
+    vm_heap_profiler_write_string (output_p, " ");
+    vm_heap_profiler_write_string (output_p, jmem_get_alloc_category_name ((jmem_alloc_category_t) category));
+  }
+
+  vm_heap_profiler_write_string (output_p, "\n");
+
+  const jerry_heap_profiler_timeline_entry_t *timeline_p = JERRY_HEAP_PROFILER_CONTEXT (timeline);
+
+  for (uint32_t i = 0; i < JERRY_HEAP_PROFILER_CONTEXT (timeline_count) && !output_p->is_full; i++)
+  {
+    vm_heap_profiler_write_number (output_p, timeline_p[i].allocated_bytes, LIT_CHAR_SP);
+
+    for (uint32_t category = 0; category < JMEM_ALLOC_CATEGORY__COUNT; category++)
+    {
+      lit_utf8_byte_t separator = (category + 1 < JMEM_ALLOC_CATEGORY__COUNT) ? LIT_CHAR_SP : LIT_CHAR_LF;
+      vm_heap_profiler_write_number (output_p, timeline_p[i].live_bytes[category], separator);
+    }
+  }
+
+  /* The current state closes the timeline. */
+  vm_heap_profiler_write_number (output_p, JERRY_HEAP_PROFILER_CONTEXT (allocated_bytes), LIT_CHAR_SP);
+
+  for (uint32_t category = 0; category < JMEM_ALLOC_CATEGORY__COUNT; category++)
+  {
+    lit_utf8_byte_t separator = (category + 1 < JMEM_ALLOC_CATEGORY__COUNT) ? LIT_CHAR_SP : LIT_CHAR_LF;
+    vm_heap_profiler_write_number (output_p, JERRY_HEAP_PROFILER_CONTEXT (live_bytes)[category], separator);
+  }
+} /* vm_heap_profiler_write_report */
+
+/**
+ * Write the report of the heap profiler: the allocation sites sorted by their live
+ * bytes, followed by the timeline of the live bytes of each category.
+ *
+ * Note:
+ *      the collected data is kept
+ *
+ * @return number of bytes written to the buffer
+ *         0 - if the buffer is too small
+ */
+size_t
+vm_heap_profiler_dump (lit_utf8_byte_t *buffer_p, /**< output buffer */
+                       size_t buffer_size) /**< size of the output buffer */
+{
+  vm_heap_profiler_output_t output;
+
+  JERRY_ASSERT (buffer_p != NULL);
+
+  output.buffer_p = buffer_p;
+  output.buffer_size = buffer_size;
+  output.position = 0;
+  output.is_full = false;
+
+  vm_heap_profiler_write_report (&output);
+
+  return output.is_full ? 0 : output.position;
+} /* vm_heap_profiler_dump */
+
+/**
+ * Print the report of the heap profiler to the log (e.g. when the engine runs out of memory).
+ */
+void
+vm_heap_profiler_print (void)
+{
+  vm_heap_profiler_output_t output;
+
+  output.buffer_p = NULL;
+  output.buffer_size = 0;
+  output.position = 0;
+  output.is_full = false;
+
+  vm_heap_profiler_write_report (&output);
+} /* vm_heap_profiler_print */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* JERRY_HEAP_PROFILER */
@@ -0,0 +1,53 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VM_HEAP_PROFILER_H
+#define VM_HEAP_PROFILER_H
+
+#include "ecma-globals.h"
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_heap_profiler Heap profiler
+ * @{
+ */
+
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * Function line of sites whose byte code has no line info
+ */
+#define VM_HEAP_PROFILER_NO_LINE_INFO UINT32_MAX
+
+/**
+ * Function line of sites where no JavaScript code is running
+ */
+#define VM_HEAP_PROFILER_NO_FRAME (UINT32_MAX - 1)
+
+extern void vm_heap_profiler_init (void);
+extern void vm_heap_profiler_alloc (void *, size_t);
+extern void vm_heap_profiler_free (void *, size_t);
+extern size_t vm_heap_profiler_dump (lit_utf8_byte_t *, size_t);
+extern void vm_heap_profiler_print (void);
+
+#endif /* JERRY_HEAP_PROFILER */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* !VM_HEAP_PROFILER_H */
@@ -0,0 +1,423 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-globals.h"
+#include "byte-code.h"
+#include "jcontext.h"
+#include "vm-opcode-stats.h"
+
+#ifdef JERRY_VM_OPCODE_STATS
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_opcode_stats Opcode statistics
+ * @{
+ *
+ * Every executed instruction is counted by its opcode, and by the pair formed with
+ * the previously executed instruction. The pairs are stored in a fixed size hash table.
+ *
+ * On targets with a time stamp counter the cycles of some instructions are measured as
+ * well: the counter is read when the instruction starts and when the next instruction
+ * starts, so the cycles of called native functions are attributed to the call opcodes.
+ * The intervals between the measurements are random, otherwise the measurements would
+ * always hit the same instructions of loops whose length divides the interval.
+ */
+
+JERRY_STATIC_ASSERT ((JERRY_OPCODE_STATS_PAIR_TABLE_SIZE & (JERRY_OPCODE_STATS_PAIR_TABLE_SIZE - 1)) == 0,
+                     opcode_stats_pair_table_size_must_be_a_power_of_2);
+
+JERRY_STATIC_ASSERT ((CONFIG_VM_OPCODE_STATS_CYCLE_SAMPLE_RATE & (CONFIG_VM_OPCODE_STATS_CYCLE_SAMPLE_RATE - 1)) == 0,
+                     opcode_stats_cycle_sample_rate_must_be_a_power_of_2);
+
+JERRY_STATIC_ASSERT (JERRY_OPCODE_STATS_COUNT * JERRY_OPCODE_STATS_COUNT < UINT32_MAX,
+                     opcode_stats_pair_index_must_fit_into_32_bits);
+
+#if defined (__i386__) || defined (__x86_64__)
+
+/**
+ * The target has a time stamp counter.
+ */
+#define VM_OPCODE_STATS_HAS_CYCLE_COUNTER
+
+/**
+ * Read the time stamp counter.
+ */
+#define VM_OPCODE_STATS_READ_CYCLES() ((uint64_t) __builtin_ia32_rdtsc ())
+
+#endif /* __i386__ || __x86_64__ */
+
+/**
+ * Mask for converting hash values to the indices of the pair table
+ */
+#define VM_OPCODE_STATS_PAIR_MASK (JERRY_OPCODE_STATS_PAIR_TABLE_SIZE - 1)
+
+/**
+ * New pairs are dropped when the pair table has this many used entries
+ */
+#define VM_OPCODE_STATS_PAIR_LIMIT (JERRY_OPCODE_STATS_PAIR_TABLE_SIZE - JERRY_OPCODE_STATS_PAIR_TABLE_SIZE / 4)
+
+/**
+ * Number of opcode pairs printed by vm_opcode_stats_print
+ */
+#define VM_OPCODE_STATS_PRINTED_PAIRS 32
+
+/**
+ * Initialize the opcode statistics: all counters are cleared.
+ */
+void
+vm_opcode_stats_init (void)
+{
+  memset (&jerry_global_opcode_stats, 0, sizeof (jerry_opcode_stats_t));
+  JERRY_OPCODE_STATS_CONTEXT (random_state) = 1;
+} /* vm_opcode_stats_init */
+
+/**
+ * Get the first entry of the pair table which is either the entry of the pair or an unused entry.
+ *
+ * @return pointer to the entry
+ */
+static jerry_opcode_pair_t *
+vm_opcode_stats_find_pair (uint32_t key) /**< index of the pair plus one */
+{
+  uint32_t index = ((key * 2654435761u) >> 16) & VM_OPCODE_STATS_PAIR_MASK;
+
+  /* The table always has unused entries, so the search terminates. */
+  while (true)
+  {
+    jerry_opcode_pair_t *pair_p = JERRY_OPCODE_STATS_CONTEXT (pairs) + index;
+
+    if (pair_p->key == key || pair_p->key == 0)
+    {
+      return pair_p;
+    }
+
+    index = (index + 1) & VM_OPCODE_STATS_PAIR_MASK;
+  }
+} /* vm_opcode_stats_find_pair */
+
+/**
+ * Get the name of an opcode.
+ *
+ * @return name of the opcode
+ */
+static const char *
+vm_opcode_stats_get_name (uint32_t opcode) /**< index of the opcode */
+{
+  if (opcode < CBC_END + 1)
+  {
+    return cbc_names[opcode];
+  }
+
+  return cbc_ext_names[opcode - (CBC_END + 1)];
+} /* vm_opcode_stats_get_name */
+
+/**
+ * Find an opcode by its name.
+ *
+ * @return index of the opcode, if the name is found
+ *         JERRY_OPCODE_STATS_COUNT - otherwise
+ */
+static uint32_t
+vm_opcode_stats_find_opcode (const char *name_p) /**< name of the opcode */
+{
+  uint32_t opcode;
+
+  for (opcode = 0; opcode < JERRY_OPCODE_STATS_COUNT; opcode++)
+  {
+    if (opcode != CBC_EXT_OPCODE && strcmp (vm_opcode_stats_get_name (opcode), name_p) == 0)
+    {
+      break;
+    }
+  }
+
+  return opcode;
+} /* vm_opcode_stats_find_opcode */
+
+/**
+ * Count the execution of an instruction.
+ */
+void
+vm_opcode_stats_record (uint32_t opcode) /**< index of the opcode (the extended opcodes
+                                          *   follow the simple ones) */
+{
+  JERRY_ASSERT (opcode < JERRY_OPCODE_STATS_COUNT);
+
+#ifdef VM_OPCODE_STATS_HAS_CYCLE_COUNTER
+  if (JERRY_OPCODE_STATS_CONTEXT (sampled_opcode) != 0)
+  {
+    uint32_t sampled_opcode = JERRY_OPCODE_STATS_CONTEXT (sampled_opcode) - 1;
+    uint64_t cycles = VM_OPCODE_STATS_READ_CYCLES () - JERRY_OPCODE_STATS_CONTEXT (sample_start);
+
+    JERRY_OPCODE_STATS_CONTEXT (cycles)[sampled_opcode] += cycles;
+    JERRY_OPCODE_STATS_CONTEXT (cycle_samples)[sampled_opcode]++;
+    JERRY_OPCODE_STATS_CONTEXT (sampled_opcode) = 0;
+  }
+#endif /* VM_OPCODE_STATS_HAS_CYCLE_COUNTER */
+
+  JERRY_OPCODE_STATS_CONTEXT (counts)[opcode]++;
+
+  if (JERRY_OPCODE_STATS_CONTEXT (last_opcode) != 0)
+  {
+    uint32_t key = (JERRY_OPCODE_STATS_CONTEXT (last_opcode) - 1) * JERRY_OPCODE_STATS_COUNT + opcode + 1;
+    jerry_opcode_pair_t *pair_p = vm_opcode_stats_find_pair (key);
+
+    if (pair_p->key != 0)
+    {
+      pair_p->count++;
+    }
+    else if (JERRY_OPCODE_STATS_CONTEXT (pair_count) < VM_OPCODE_STATS_PAIR_LIMIT)
+    {
+      pair_p->key = key;
+      pair_p->count = 1;
+      JERRY_OPCODE_STATS_CONTEXT (pair_count)++;
+    }
+    else
+    {
+      JERRY_OPCODE_STATS_CONTEXT (dropped_pairs)++;
+    }
+  }
+
+  JERRY_OPCODE_STATS_CONTEXT (last_opcode) = opcode + 1;
+
+#ifdef VM_OPCODE_STATS_HAS_CYCLE_COUNTER
+  if (JERRY_OPCODE_STATS_CONTEXT (sample_countdown) == 0)
+  {
+    /* Xorshift generator, the average interval is the configured sample rate. */
+    uint32_t random = JERRY_OPCODE_STATS_CONTEXT (random_state);
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    JERRY_OPCODE_STATS_CONTEXT (random_state) = random;
+
+    JERRY_OPCODE_STATS_CONTEXT (sample_countdown) = random & (2 * CONFIG_VM_OPCODE_STATS_CYCLE_SAMPLE_RATE - 1);
+    JERRY_OPCODE_STATS_CONTEXT (sampled_opcode) = opcode + 1;
+    /* The counter is read last, so the bookkeeping above is not measured. */
+    JERRY_OPCODE_STATS_CONTEXT (sample_start) = VM_OPCODE_STATS_READ_CYCLES ();
+  }
+  else
+  {
+    JERRY_OPCODE_STATS_CONTEXT (sample_countdown)--;
+  }
+#endif /* VM_OPCODE_STATS_HAS_CYCLE_COUNTER */
+
+  JERRY_OPCODE_STATS_CONTEXT (instruction_count)++;
+} /* vm_opcode_stats_record */
+
+/**
+ * Notify the opcode statistics that the outermost frame has returned: the
+ * next instruction neither forms a pair with the last one nor ends its measurement.
+ */
+void
+vm_opcode_stats_end_run (void)
+{
+  JERRY_OPCODE_STATS_CONTEXT (last_opcode) = 0;
+  JERRY_OPCODE_STATS_CONTEXT (sampled_opcode) = 0;
+} /* vm_opcode_stats_end_run */
+
+/**
+ * Get the ratio of a counter to the number of executed instructions in hundredths of a percent.
+ *
+ * @return ratio
+ */
+static unsigned int
+vm_opcode_stats_get_ratio (uint64_t count) /**< counter */
+{
+  return (unsigned int) (count * 10000 / JERRY_OPCODE_STATS_CONTEXT (instruction_count));
+} /* vm_opcode_stats_get_ratio */
+
+/**
+ * Print the executed opcodes ordered by their execution counts, and the most frequent opcode pairs.
+ */
+void
+vm_opcode_stats_print (void)
+{
+  uint16_t opcodes[JERRY_OPCODE_STATS_COUNT];
+  uint32_t opcode_count = 0;
+
+  jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                  "Opcode stats:\n"
+                  "  Executed instructions = %llu\n"
+                  "  Opcode pairs = %u\n"
+                  "  Dropped opcode pairs = %llu\n",
+                  (unsigned long long) JERRY_OPCODE_STATS_CONTEXT (instruction_count),
+                  (unsigned int) JERRY_OPCODE_STATS_CONTEXT (pair_count),
+                  (unsigned long long) JERRY_OPCODE_STATS_CONTEXT (dropped_pairs));
+
+  if (JERRY_OPCODE_STATS_CONTEXT (instruction_count) == 0)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_DEBUG, "\n");
+    return;
+  }
+
+  /* Insertion sort of the executed opcodes. */
+  for (uint32_t opcode = 0; opcode < JERRY_OPCODE_STATS_COUNT; opcode++)
+  {
+    uint64_t count = JERRY_OPCODE_STATS_CONTEXT (counts)[opcode];
+
+    if (count == 0)
+    {
+      continue;
+    }
+
+    uint32_t position = opcode_count++;
+
+    while (position > 0 && JERRY_OPCODE_STATS_CONTEXT (counts)[opcodes[position - 1]] < count)
+    {
+      opcodes[position] = opcodes[position - 1];
+      position--;
+    }
+
+    opcodes[position] = (uint16_t) opcode;
+  }
+
+#ifdef VM_OPCODE_STATS_HAS_CYCLE_COUNTER
+  jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                  "\n  %-40s %14s %8s %10s\n",
+                  "Opcode", "Count", "Percent", "Cycles");
+#else /* !VM_OPCODE_STATS_HAS_CYCLE_COUNTER */
+  jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                  "\n  %-40s %14s %8s\n",
+                  "Opcode", "Count", "Percent");
+#endif /* VM_OPCODE_STATS_HAS_CYCLE_COUNTER */
+
+  for (uint32_t i = 0; i < opcode_count; i++)
+  {
+    uint32_t opcode = opcodes[i];
+    uint64_t count = JERRY_OPCODE_STATS_CONTEXT (counts)[opcode];
+    unsigned int ratio = vm_opcode_stats_get_ratio (count);
+
+    jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                    "  %-40s %14llu %5u.%02u",
+                    vm_opcode_stats_get_name (opcode),
+                    (unsigned long long) count,
+                    ratio / 100,
+                    ratio % 100);
+
+#ifdef VM_OPCODE_STATS_HAS_CYCLE_COUNTER
+    uint32_t cycle_samples = JERRY_OPCODE_STATS_CONTEXT (cycle_samples)[opcode];
+
+    if (cycle_samples != 0)
+    {
+      /* Average cycles of the measured executions. */
+      jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                      " %10llu",
+                      (unsigned long long) (JERRY_OPCODE_STATS_CONTEXT (cycles)[opcode] / cycle_samples));
+    }
+    else
+    {
+      jerry_port_log (JERRY_LOG_LEVEL_DEBUG, " %10s", "-");
+    }
+#endif /* VM_OPCODE_STATS_HAS_CYCLE_COUNTER */
+
+    jerry_port_log (JERRY_LOG_LEVEL_DEBUG, "\n");
+  }
+
+  /* Selection of the most frequent pairs. */
+  jerry_opcode_pair_t *top_pairs[VM_OPCODE_STATS_PRINTED_PAIRS];
+  uint32_t top_pair_count = 0;
+
+  for (uint32_t i = 0; i < JERRY_OPCODE_STATS_PAIR_TABLE_SIZE; i++)
+  {
+    jerry_opcode_pair_t *pair_p = JERRY_OPCODE_STATS_CONTEXT (pairs) + i;
+
+    if (pair_p->key == 0
+        || (top_pair_count == VM_OPCODE_STATS_PRINTED_PAIRS
+            && top_pairs[VM_OPCODE_STATS_PRINTED_PAIRS - 1]->count >= pair_p->count))
+    {
+      continue;
+    }
+
+    uint32_t position = top_pair_count;
+
+    if (top_pair_count < VM_OPCODE_STATS_PRINTED_PAIRS)
+    {
+      top_pair_count++;
+    }
+    else
+    {
+      position--;
+    }
+
+    while (position > 0 && top_pairs[position - 1]->count < pair_p->count)
+    {
+      top_pairs[position] = top_pairs[position - 1];
+      position--;
+    }
+
+    top_pairs[position] = pair_p;
+  }
+
+  jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                  "\n  %-40s %-40s %14s %8s\n",
+                  "Opcode", "Next opcode", "Count", "Percent");
+
+  for (uint32_t i = 0; i < top_pair_count; i++)
+  {
+    uint32_t key = top_pairs[i]->key - 1;
+    unsigned int ratio = vm_opcode_stats_get_ratio (top_pairs[i]->count);
+
+    jerry_port_log (JERRY_LOG_LEVEL_DEBUG,
+                    "  %-40s %-40s %14llu %5u.%02u\n",
+                    vm_opcode_stats_get_name (key / JERRY_OPCODE_STATS_COUNT),
+                    vm_opcode_stats_get_name (key % JERRY_OPCODE_STATS_COUNT),
+                    (unsigned long long) top_pairs[i]->count,
+                    ratio / 100,
+                    ratio % 100);
+  }
+
+  jerry_port_log (JERRY_LOG_LEVEL_DEBUG, "\n");
+} /* vm_opcode_stats_print */
+
+/**
+ * Get the execution count of an opcode, or of an opcode pair.
+ *
+ * @return number of executions
+ */
+uint64_t
+vm_opcode_stats_get_count (const char *opcode_name_p, /**< name of the opcode */
+                           const char *next_opcode_name_p) /**< name of the opcode executed after
+                                                            *   the first one, or NULL */
+{
+  uint32_t opcode = vm_opcode_stats_find_opcode (opcode_name_p);
+
+  if (opcode == JERRY_OPCODE_STATS_COUNT)
+  {
+    return 0;
+  }
+
+  if (next_opcode_name_p == NULL)
+  {
+    return JERRY_OPCODE_STATS_CONTEXT (counts)[opcode];
+  }
+
+  uint32_t next_opcode = vm_opcode_stats_find_opcode (next_opcode_name_p);
+
+  if (next_opcode == JERRY_OPCODE_STATS_COUNT)
+  {
+    return 0;
+  }
+
+  jerry_opcode_pair_t *pair_p = vm_opcode_stats_find_pair (opcode * JERRY_OPCODE_STATS_COUNT + next_opcode + 1);
+
+  return (pair_p->key != 0) ? pair_p->count : 0;
+} /* vm_opcode_stats_get_count */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* JERRY_VM_OPCODE_STATS */
@@ -0,0 +1,43 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VM_OPCODE_STATS_H
+#define VM_OPCODE_STATS_H
+
+#include "ecma-globals.h"
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_opcode_stats Opcode statistics
+ * @{
+ */
+
+#ifdef JERRY_VM_OPCODE_STATS
+
+extern void vm_opcode_stats_init (void);
+extern void vm_opcode_stats_record (uint32_t);
+extern void vm_opcode_stats_end_run (void);
+extern void vm_opcode_stats_print (void);
+extern uint64_t vm_opcode_stats_get_count (const char *, const char *);
+
+#endif /* JERRY_VM_OPCODE_STATS */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* !VM_OPCODE_STATS_H */
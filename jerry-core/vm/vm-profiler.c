@@ -0,0 +1,393 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-helpers.h"
+#include "byte-code.h"
+#include "jcontext.h"
+#include "vm.h"
+#include "vm-profiler.h"
+
+#ifdef JERRY_CPU_PROFILER
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_profiler CPU profiler
+ * @{
+ *
+ * A sample is stored as a depth word followed by three words for each frame,
+ * starting from the innermost frame: the name of the function, the first line
+ * of the function (0 for global and eval code) and the currently executed line.
+ * The lines are resolved when the sample is taken, since the byte code of a
+ * function may be freed before the samples are dumped. The name is stored as a
+ * compressed pointer and it is only resolved by the dump: function names are
+ * literals, which are kept alive by the literal storage until the engine is
+ * finalized, and the samples are discarded when the engine is initialized again.
+ */
+
+JERRY_STATIC_ASSERT ((JERRY_CPU_PROFILER_BUFFER_SIZE & (JERRY_CPU_PROFILER_BUFFER_SIZE - 1)) == 0,
+                     cpu_profiler_buffer_size_must_be_a_power_of_2);
+
+/**
+ * Mask for converting the indices of the sample buffer to offsets
+ */
+#define VM_PROFILER_BUFFER_MASK (JERRY_CPU_PROFILER_BUFFER_SIZE - 1)
+
+/**
+ * Depth flag of samples which are already written by the current dump
+ */
+#define VM_PROFILER_CONSUMED 0x80000000u
+
+/**
+ * Function line of frames whose byte code has no line info
+ */
+#define VM_PROFILER_NO_LINE_INFO UINT32_MAX
+
+/**
+ * Get a word of the sample buffer.
+ */
+#define VM_PROFILER_GET(index) \
+  (JERRY_CPU_PROFILER_CONTEXT (buffer)[(index) & VM_PROFILER_BUFFER_MASK])
+
+/**
+ * Output buffer of the dump.
+ */
+typedef struct
+{
+  lit_utf8_byte_t *buffer_p; /**< output buffer */
+  size_t buffer_size; /**< size of the output buffer */
+  size_t position; /**< current position in the output buffer */
+  bool is_full; /**< the output buffer is too small */
+} vm_profiler_output_t;
+
+/**
+ * Initialize the CPU profiler: the profiler is stopped and the samples are discarded.
+ */
+void
+vm_profiler_init (void)
+{
+  JERRY_CPU_PROFILER_CONTEXT (is_running) = false;
+  JERRY_CPU_PROFILER_CONTEXT (write_index) = 0;
+  JERRY_CPU_PROFILER_CONTEXT (read_index) = 0;
+  JERRY_CPU_PROFILER_CONTEXT (dropped_samples) = 0;
+} /* vm_profiler_init */
+
+/**
+ * Start collecting samples.
+ */
+void
+vm_profiler_start (void)
+{
+  JERRY_CPU_PROFILER_CONTEXT (is_running) = true;
+} /* vm_profiler_start */
+
+/**
+ * Stop collecting samples. The collected samples are kept until they are dumped.
+ */
+void
+vm_profiler_stop (void)
+{
+  JERRY_CPU_PROFILER_CONTEXT (is_running) = false;
+} /* vm_profiler_stop */
+
+/**
+ * Store the name and the current line of a frame into the sample buffer.
+ *
+ * @return index after the stored frame
+ */
+static uint32_t
+vm_profiler_store_frame (const vm_frame_ctx_t *frame_ctx_p, /**< frame context */
+                         uint32_t index) /**< index of the frame in the sample buffer */
+{
+  const ecma_compiled_code_t *bytecode_p = frame_ctx_p->bytecode_header_p;
+
+  if (!(bytecode_p->status_flags & CBC_CODE_FLAGS_HAS_LINE_INFO))
+  {
+    VM_PROFILER_GET (index) = JMEM_CP_NULL;
+    VM_PROFILER_GET (index + 1) = VM_PROFILER_NO_LINE_INFO;
+    VM_PROFILER_GET (index + 2) = 0;
+    return index + VM_PROFILER_FRAME_SIZE;
+  }
+
+  const cbc_line_info_t *line_info_p = CBC_GET_LINE_INFO (bytecode_p);
+
+  VM_PROFILER_GET (index) = line_info_p->name_cp;
+  VM_PROFILER_GET (index + 1) = line_info_p->line;
+  VM_PROFILER_GET (index + 2) = vm_get_current_line (frame_ctx_p);
+  return index + VM_PROFILER_FRAME_SIZE;
+} /* vm_profiler_store_frame */
+
+/**
+ * Record the call stack of the currently executed JavaScript code.
+ *
+ * Note:
+ *      the function does not allocate memory and does not change the state of the
+ *      engine, so it can be called from a signal handler which interrupts the engine
+ *      (the sample is dropped if the sample buffer is full)
+ */
+void
+vm_profiler_sample (void)
+{
+  if (!JERRY_CPU_PROFILER_CONTEXT (is_running))
+  {
+    return;
+  }
+
+  const vm_frame_ctx_t *frame_ctx_p = JERRY_CONTEXT (vm_top_context_p);
+
+  if (frame_ctx_p == NULL)
+  {
+    /* No JavaScript code is running. */
+    return;
+  }
+
+  uint32_t depth = 0;
+
+  for (const vm_frame_ctx_t *iterator_p = frame_ctx_p;
+       iterator_p != NULL && depth < CONFIG_CPU_PROFILER_MAX_DEPTH;
+       iterator_p = iterator_p->prev_context_p)
+  {
+    depth++;
+  }
+
+  uint32_t index = JERRY_CPU_PROFILER_CONTEXT (write_index);
+  uint32_t sample_size = 1 + depth * VM_PROFILER_FRAME_SIZE;
+
+  if (index - JERRY_CPU_PROFILER_CONTEXT (read_index) + sample_size > JERRY_CPU_PROFILER_BUFFER_SIZE)
+  {
+    JERRY_CPU_PROFILER_CONTEXT (dropped_samples)++;
+    return;
+  }
+
+  VM_PROFILER_GET (index) = depth;
+  index++;
+
+  while (depth > 0)
+  {
+    index = vm_profiler_store_frame (frame_ctx_p, index);
+    frame_ctx_p = frame_ctx_p->prev_context_p;
+    depth--;
+  }
+
+  JERRY_CPU_PROFILER_CONTEXT (write_index) = index;
+} /* vm_profiler_sample */
+
+/**
+ * Append bytes to the output of the dump.
+ */
+static void
+vm_profiler_write (vm_profiler_output_t *output_p, /**< output buffer */
+                   const lit_utf8_byte_t *data_p, /**< data */
+                   size_t size) /**< size of the data */
+{
+  if (output_p->is_full || output_p->buffer_size - output_p->position < size)
+  {
+    output_p->is_full = true;
+    return;
+  }
+
+  memcpy (output_p->buffer_p + output_p->position, data_p, size);
+  output_p->position += size;
+} /* vm_profiler_write */
+
+/**
+ * Append a zero terminated string to the output of the dump.
+ */
+static void
+vm_profiler_write_string (vm_profiler_output_t *output_p, /**< output buffer */
+                          const char *string_p) /**< zero terminated string */
+{
+  vm_profiler_write (output_p, (const lit_utf8_byte_t *) string_p, strlen (string_p));
+} /* vm_profiler_write_string */
+
+/**
+ * Append a decimal number to the output of the dump.
+ */
+static void
+vm_profiler_write_uint32 (vm_profiler_output_t *output_p, /**< output buffer */
+                          uint32_t value) /**< number */
+{
+  lit_utf8_byte_t digits[10];
+  size_t length = sizeof (digits);
+
+  do
+  {
+    digits[--length] = (lit_utf8_byte_t) ('0' + value % 10);
+    value /= 10;
+  }
+  while (value > 0);
+
+  vm_profiler_write (output_p, digits + length, sizeof (digits) - length);
+} /* vm_profiler_write_uint32 */
+
+/**
+ * Append a frame of a sample to the output of the dump.
+ */
+static void
+vm_profiler_write_frame (vm_profiler_output_t *output_p, /**< output buffer */
+                         uint32_t index) /**< index of the frame in the sample buffer */
+{
+  jmem_cpointer_t name_cp = (jmem_cpointer_t) VM_PROFILER_GET (index);
+  uint32_t function_line = VM_PROFILER_GET (index + 1);
+
+  if (function_line == VM_PROFILER_NO_LINE_INFO)
+  {
+    vm_profiler_write_string (output_p, "(unknown)");
+    return;
+  }
+
+  if (name_cp != JMEM_CP_NULL)
+  {
+    ecma_string_t *name_p = ECMA_GET_NON_NULL_POINTER (ecma_string_t, name_cp);
+    lit_utf8_size_t name_size = ecma_string_get_size (name_p);
+
+    if (output_p->is_full || output_p->buffer_size - output_p->position < name_size)
+    {
+      output_p->is_full = true;
+      return;
+    }
+
+    ecma_string_to_utf8_bytes (name_p, output_p->buffer_p + output_p->position, name_size);
+    output_p->position += name_size;
+  }
+  else
+  {
+    vm_profiler_write_string (output_p, (function_line == 0) ? "(program)" : "(anonymous)");
+  }
+
+  vm_profiler_write_string (output_p, ":");
+  vm_profiler_write_uint32 (output_p, VM_PROFILER_GET (index + 2));
+} /* vm_profiler_write_frame */
+
+/**
+ * Checks whether two samples have the same call stack.
+ *
+ * @return true - if the call stacks are the same,
+ *         false - otherwise
+ */
+static bool
+vm_profiler_compare_samples (uint32_t first_index, /**< index of the first sample */
+                             uint32_t second_index) /**< index of the second sample */
+{
+  uint32_t size = 1 + VM_PROFILER_GET (first_index) * VM_PROFILER_FRAME_SIZE;
+
+  for (uint32_t i = 0; i < size; i++)
+  {
+    if (VM_PROFILER_GET (first_index + i) != VM_PROFILER_GET (second_index + i))
+    {
+      return false;
+    }
+  }
+
+  return true;
+} /* vm_profiler_compare_samples */
+
+/**
+ * Write the collected samples in collapsed stack format: each distinct call stack is
+ * written to a separate line, which contains the frames starting from the outermost
+ * one separated by semicolons, followed by a space and the number of samples.
+ *
+ * Note:
+ *      the written samples are removed from the sample buffer
+ *
+ * @return number of bytes written to the buffer
+ *         0 - if the buffer is too small (the samples are kept in this case)
+ */
+size_t
+vm_profiler_dump (lit_utf8_byte_t *buffer_p, /**< output buffer */
+                  size_t buffer_size) /**< size of the output buffer */
+{
+  vm_profiler_output_t output;
+  uint32_t start_index = JERRY_CPU_PROFILER_CONTEXT (read_index);
+  uint32_t end_index = JERRY_CPU_PROFILER_CONTEXT (write_index);
+
+  output.buffer_p = buffer_p;
+  output.buffer_size = buffer_size;
+  output.position = 0;
+  output.is_full = false;
+
+  for (uint32_t index = start_index; index != end_index && !output.is_full;)
+  {
+    uint32_t depth = VM_PROFILER_GET (index);
+    uint32_t sample_size = 1 + (depth & ~VM_PROFILER_CONSUMED) * VM_PROFILER_FRAME_SIZE;
+
+    if (!(depth & VM_PROFILER_CONSUMED))
+    {
+      uint32_t count = 1;
+
+      /* The identical samples are counted and marked as consumed. */
+      for (uint32_t next_index = index + sample_size; next_index != end_index;)
+      {
+        uint32_t next_depth = VM_PROFILER_GET (next_index);
+
+        if (next_depth == depth && vm_profiler_compare_samples (index, next_index))
+        {
+          VM_PROFILER_GET (next_index) = next_depth | VM_PROFILER_CONSUMED;
+          count++;
+        }
+
+        next_index += 1 + (next_depth & ~VM_PROFILER_CONSUMED) * VM_PROFILER_FRAME_SIZE;
+      }
+
+      for (uint32_t frame = depth; frame > 0; frame--)
+      {
+        vm_profiler_write_frame (&output, index + 1 + (frame - 1) * VM_PROFILER_FRAME_SIZE);
+
+        if (frame > 1)
+        {
+          vm_profiler_write_string (&output, ";");
+        }
+      }
+
+      vm_profiler_write_string (&output, " ");
+      vm_profiler_write_uint32 (&output, count);
+      vm_profiler_write_string (&output, "\n");
+    }
+
+    index += sample_size;
+  }
+
+  uint32_t dropped_samples = JERRY_CPU_PROFILER_CONTEXT (dropped_samples);
+
+  if (dropped_samples > 0)
+  {
+    vm_profiler_write_string (&output, "(dropped) ");
+    vm_profiler_write_uint32 (&output, dropped_samples);
+    vm_profiler_write_string (&output, "\n");
+  }
+
+  if (output.is_full)
+  {
+    for (uint32_t index = start_index; index != end_index;)
+    {
+      uint32_t depth = VM_PROFILER_GET (index) & ~VM_PROFILER_CONSUMED;
+
+      VM_PROFILER_GET (index) = depth;
+      index += 1 + depth * VM_PROFILER_FRAME_SIZE;
+    }
+    return 0;
+  }
+
+  JERRY_CPU_PROFILER_CONTEXT (dropped_samples) -= dropped_samples;
+  JERRY_CPU_PROFILER_CONTEXT (read_index) = end_index;
+  return output.position;
+} /* vm_profiler_dump */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* JERRY_CPU_PROFILER */
@@ -0,0 +1,49 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VM_PROFILER_H
+#define VM_PROFILER_H
+
+#include "ecma-globals.h"
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_profiler CPU profiler
+ * @{
+ */
+
+#ifdef JERRY_CPU_PROFILER
+
+/**
+ * Number of words stored for a frame of a sample (the name of the function,
+ * the first line of the function and the currently executed line)
+ */
+#define VM_PROFILER_FRAME_SIZE 3
+
+extern void vm_profiler_init (void);
+extern void vm_profiler_start (void);
+extern void vm_profiler_stop (void);
+extern void vm_profiler_sample (void);
+extern size_t vm_profiler_dump (lit_utf8_byte_t *, size_t);
+
+#endif /* JERRY_CPU_PROFILER */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* !VM_PROFILER_H */
@@ -0,0 +1,124 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jcontext.h"
+#include "jerry-port.h"
+#include "vm-runtime-stats.h"
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_runtime_stats Runtime statistics
+ * @{
+ *
+ * The engine is always in one of the phases of vm_runtime_phase_t. The parser, the
+ * virtual machine, the garbage collector and the dispatcher of native functions enter
+ * their phase when they start and return to the previous phase when they finish, so
+ * the time of nested phases is not counted twice. The clock is only read when the
+ * phase changes: recursive calls of JavaScript functions only increase a counter.
+ */
+
+#ifdef JERRY_RUNTIME_STATS
+
+/**
+ * Convert a duration of the monotonic clock to milliseconds
+ */
+#define VM_RUNTIME_STATS_NS_TO_MS(time) ((double) (time) / 1000000.0)
+
+/**
+ * Charge the time since the start of the current phase to the current phase, and switch to a new phase.
+ */
+void
+vm_runtime_stats_switch_phase (vm_runtime_phase_t new_phase) /**< new phase */
+{
+  uint64_t current_time = jerry_port_get_monotonic_time ();
+  vm_runtime_phase_t phase = (vm_runtime_phase_t) JERRY_CONTEXT (vm_runtime_phase);
+
+  if (phase != VM_RUNTIME_PHASE_HOST)
+  {
+    uint64_t elapsed_time = current_time - JERRY_CONTEXT (vm_runtime_phase_start_time);
+
+    JERRY_CONTEXT (vm_runtime_phase_times)[phase] += elapsed_time;
+
+    /* A garbage collection never enters another phase, so this is the time of the whole run. */
+    if (phase == VM_RUNTIME_PHASE_GC && elapsed_time > JERRY_CONTEXT (vm_runtime_gc_max_pause))
+    {
+      JERRY_CONTEXT (vm_runtime_gc_max_pause) = elapsed_time;
+    }
+  }
+
+  JERRY_CONTEXT (vm_runtime_phase_start_time) = current_time;
+  JERRY_CONTEXT (vm_runtime_phase) = (uint8_t) new_phase;
+} /* vm_runtime_stats_switch_phase */
+
+#endif /* JERRY_RUNTIME_STATS */
+
+/**
+ * Get the runtime statistics
+ *
+ * Note:
+ *      the times, the counters and the lookup cache statistics are zero
+ *      if the engine is built without the runtime statistics (JERRY_RUNTIME_STATS)
+ */
+void
+vm_runtime_stats_get (jerry_runtime_stats_t *out_stats_p) /**< [out] runtime statistics */
+{
+  memset (out_stats_p, 0, sizeof (jerry_runtime_stats_t));
+
+  out_stats_p->heap_allocated_size = JERRY_CONTEXT (jmem_heap_allocated_size);
+  out_stats_p->heap_peak_allocated_size = JERRY_CONTEXT (jmem_heap_allocated_size);
+  out_stats_p->object_count = JERRY_CONTEXT (ecma_gc_objects_number);
+  out_stats_p->string_count = JERRY_CONTEXT (ecma_strings_number);
+
+#ifdef JERRY_RUNTIME_STATS
+  uint64_t times[VM_RUNTIME_PHASE__COUNT];
+  memcpy (times, JERRY_CONTEXT (vm_runtime_phase_times), sizeof (times));
+
+  /* The time of the current phase is not charged yet when the statistics are queried by a native function. */
+  vm_runtime_phase_t phase = (vm_runtime_phase_t) JERRY_CONTEXT (vm_runtime_phase);
+
+  if (phase != VM_RUNTIME_PHASE_HOST)
+  {
+    times[phase] += jerry_port_get_monotonic_time () - JERRY_CONTEXT (vm_runtime_phase_start_time);
+  }
+
+  const uint64_t *counts_p = JERRY_CONTEXT (vm_runtime_phase_counts);
+
+  out_stats_p->parse_time = VM_RUNTIME_STATS_NS_TO_MS (times[VM_RUNTIME_PHASE_PARSE]);
+  out_stats_p->execution_time = VM_RUNTIME_STATS_NS_TO_MS (times[VM_RUNTIME_PHASE_EXECUTE]);
+  out_stats_p->gc_time = VM_RUNTIME_STATS_NS_TO_MS (times[VM_RUNTIME_PHASE_GC]);
+  out_stats_p->gc_max_pause = VM_RUNTIME_STATS_NS_TO_MS (JERRY_CONTEXT (vm_runtime_gc_max_pause));
+  out_stats_p->native_time = VM_RUNTIME_STATS_NS_TO_MS (times[VM_RUNTIME_PHASE_NATIVE]);
+  out_stats_p->parse_count = counts_p[VM_RUNTIME_PHASE_PARSE];
+  out_stats_p->execution_count = counts_p[VM_RUNTIME_PHASE_EXECUTE];
+  out_stats_p->gc_count = counts_p[VM_RUNTIME_PHASE_GC];
+  out_stats_p->native_call_count = counts_p[VM_RUNTIME_PHASE_NATIVE];
+
+#ifndef CONFIG_ECMA_LCACHE_DISABLE
+  out_stats_p->lcache_hits = JERRY_CONTEXT (ecma_lcache_hits);
+  out_stats_p->lcache_misses = JERRY_CONTEXT (ecma_lcache_misses);
+#endif /* !CONFIG_ECMA_LCACHE_DISABLE */
+
+  if (JERRY_CONTEXT (jmem_heap_peak_allocated_size) > out_stats_p->heap_peak_allocated_size)
+  {
+    out_stats_p->heap_peak_allocated_size = JERRY_CONTEXT (jmem_heap_peak_allocated_size);
+  }
+#endif /* JERRY_RUNTIME_STATS */
+} /* vm_runtime_stats_get */
+
+/**
+ * @}
+ * @}
+ */
@@ -0,0 +1,91 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VM_RUNTIME_STATS_H
+#define VM_RUNTIME_STATS_H
+
+#include "jerry-api.h"
+#include "jrt.h"
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_runtime_stats Runtime statistics
+ * @{
+ */
+
+/**
+ * Phases of the engine whose time is measured by the runtime statistics
+ */
+typedef enum
+{
+  VM_RUNTIME_PHASE_HOST, /**< the engine is not running (not measured) */
+  VM_RUNTIME_PHASE_PARSE, /**< parsing and compiling a source */
+  VM_RUNTIME_PHASE_EXECUTE, /**< executing byte code */
+  VM_RUNTIME_PHASE_GC, /**< garbage collection */
+  VM_RUNTIME_PHASE_NATIVE, /**< running a native function */
+  VM_RUNTIME_PHASE__COUNT /**< number of phases */
+} vm_runtime_phase_t;
+
+#ifdef JERRY_RUNTIME_STATS
+
+extern void vm_runtime_stats_switch_phase (vm_runtime_phase_t);
+
+/**
+ * Enter a phase, the previous phase is stored in a local variable
+ *
+ * Note:
+ *      the clock is only read by vm_runtime_stats_switch_phase when the phase changes,
+ *      so entering the current phase again (e.g. a nested function call) is cheap
+ */
+#define VM_RUNTIME_STATS_ENTER(phase) \
+  vm_runtime_phase_t vm_runtime_stats_previous_phase = (vm_runtime_phase_t) JERRY_CONTEXT (vm_runtime_phase); \
+  JERRY_CONTEXT (vm_runtime_phase_counts)[phase]++; \
+  if (vm_runtime_stats_previous_phase != (phase)) \
+  { \
+    vm_runtime_stats_switch_phase (phase); \
+  }
+
+/**
+ * Return to the phase stored by VM_RUNTIME_STATS_ENTER
+ */
+#define VM_RUNTIME_STATS_LEAVE() \
+  if (vm_runtime_stats_previous_phase != JERRY_CONTEXT (vm_runtime_phase)) \
+  { \
+    vm_runtime_stats_switch_phase (vm_runtime_stats_previous_phase); \
+  }
+
+#else /* !JERRY_RUNTIME_STATS */
+
+/**
+ * Runtime statistics are disabled
+ */
+#define VM_RUNTIME_STATS_ENTER(phase)
+
+/**
+ * Runtime statistics are disabled
+ */
+#define VM_RUNTIME_STATS_LEAVE()
+
+#endif /* JERRY_RUNTIME_STATS */
+
+extern void vm_runtime_stats_get (jerry_runtime_stats_t *);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* !VM_RUNTIME_STATS_H */
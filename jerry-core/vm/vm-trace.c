@@ -0,0 +1,326 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jcontext.h"
+#include "jerry-port.h"
+#include "vm-trace.h"
+
+#ifdef JERRY_TRACE
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_trace Timeline tracing
+ * @{
+ *
+ * The garbage collector, the escalations of the allocator, the parser and the top-level
+ * calls of the API record timestamped events into a ring buffer, which is written in
+ * the JSON trace event format of Chrome (chrome://tracing, Perfetto). Span events are
+ * recorded when they end, so an event is always written after the events nested in it.
+ */
+
+JERRY_STATIC_ASSERT ((JERRY_TRACE_BUFFER_SIZE & (JERRY_TRACE_BUFFER_SIZE - 1)) == 0,
+                     trace_buffer_size_must_be_a_power_of_2);
+
+JERRY_STATIC_ASSERT (VM_TRACE_EVENT__COUNT <= UINT8_MAX,
+                     vm_trace_event_types_must_fit_into_a_byte);
+
+/**
+ * Mask for converting the event count to an index of the ring buffer
+ */
+#define VM_TRACE_BUFFER_MASK (JERRY_TRACE_BUFFER_SIZE - 1)
+
+/**
+ * Description of an event type.
+ */
+typedef struct
+{
+  const char *name_p; /**< name of the event */
+  const char *category_p; /**< category of the event */
+  const char *arg_names_p[3]; /**< names of the arguments (NULL for unused arguments) */
+  bool is_instant; /**< the event has no duration */
+} vm_trace_event_info_t;
+
+/**
+ * Descriptions of the event types
+ */
+static const vm_trace_event_info_t vm_trace_event_info[VM_TRACE_EVENT__COUNT] =
+{
+  { "jerry_run", "api", { NULL, NULL, NULL }, false },
+  { "jerry_call_function", "api", { NULL, NULL, NULL }, false },
+  { "parse", "parser", { "source_size", NULL, NULL }, false },
+  { "compile lazy function", "parser", { "source_size", NULL, NULL }, false },
+  { "parse statements", "parser", { NULL, NULL, NULL }, false },
+  { "post processing", "parser", { NULL, NULL, NULL }, false },
+  { "gc", "gc", { "severity", "objects_before", "objects_after" }, false },
+  { "free unused memory", "memory", { "severity", "allocated_size", "heap_limit" }, true },
+};
+
+/**
+ * Output buffer of the dump.
+ */
+typedef struct
+{
+  lit_utf8_byte_t *buffer_p; /**< output buffer */
+  size_t buffer_size; /**< size of the output buffer */
+  size_t position; /**< current position in the output buffer */
+  bool is_full; /**< the output buffer is too small */
+} vm_trace_output_t;
+
+/**
+ * Initialize the timeline tracing: the tracing is stopped and the events are discarded.
+ */
+void
+vm_trace_init (void)
+{
+  JERRY_TRACE_CONTEXT (is_running) = false;
+  JERRY_TRACE_CONTEXT (event_count) = 0;
+  JERRY_TRACE_CONTEXT (start_time) = 0;
+} /* vm_trace_init */
+
+/**
+ * Discard the recorded events and start recording.
+ */
+void
+vm_trace_start (void)
+{
+  JERRY_TRACE_CONTEXT (event_count) = 0;
+  JERRY_TRACE_CONTEXT (start_time) = jerry_port_get_monotonic_time ();
+  JERRY_TRACE_CONTEXT (is_running) = true;
+} /* vm_trace_start */
+
+/**
+ * Stop recording. The recorded events are kept until the tracing is started again.
+ */
+void
+vm_trace_stop (void)
+{
+  JERRY_TRACE_CONTEXT (is_running) = false;
+} /* vm_trace_stop */
+
+/**
+ * Store an event into the ring buffer, overwriting the oldest event if the buffer is full.
+ */
+static void
+vm_trace_record (vm_trace_event_type_t type, /**< type of the event */
+                 uint64_t start_time, /**< start of the event */
+                 uint64_t duration, /**< duration of the event */
+                 uint32_t arg0, /**< first argument */
+                 uint32_t arg1, /**< second argument */
+                 uint32_t arg2) /**< third argument */
+{
+  uint64_t event_count = JERRY_TRACE_CONTEXT (event_count);
+  jerry_trace_event_t *event_p = JERRY_TRACE_CONTEXT (events) + (event_count & VM_TRACE_BUFFER_MASK);
+
+  event_p->start_time = start_time;
+  event_p->duration = duration;
+  event_p->args[0] = arg0;
+  event_p->args[1] = arg1;
+  event_p->args[2] = arg2;
+  event_p->type = (uint8_t) type;
+
+  JERRY_TRACE_CONTEXT (event_count) = event_count + 1;
+} /* vm_trace_record */
+
+/**
+ * Record a span event which is started by VM_TRACE_BEGIN and ends now.
+ *
+ * Note:
+ *      the event is dropped if the tracing is stopped while the span is running
+ */
+void
+vm_trace_end (vm_trace_event_type_t type, /**< type of the event */
+              uint64_t start_time, /**< start of the event */
+              uint32_t arg0, /**< first argument */
+              uint32_t arg1, /**< second argument */
+              uint32_t arg2) /**< third argument */
+{
+  JERRY_ASSERT (!vm_trace_event_info[type].is_instant);
+
+  if (!JERRY_TRACE_CONTEXT (is_running))
+  {
+    return;
+  }
+
+  uint64_t end_time = jerry_port_get_monotonic_time ();
+  vm_trace_record (type, start_time, end_time - start_time, arg0, arg1, arg2);
+} /* vm_trace_end */
+
+/**
+ * Record an instant event.
+ */
+void
+vm_trace_instant (vm_trace_event_type_t type, /**< type of the event */
+                  uint32_t arg0, /**< first argument */
+                  uint32_t arg1, /**< second argument */
+                  uint32_t arg2) /**< third argument */
+{
+  JERRY_ASSERT (vm_trace_event_info[type].is_instant);
+
+  vm_trace_record (type, jerry_port_get_monotonic_time (), 0, arg0, arg1, arg2);
+} /* vm_trace_instant */
+
+/**
+ * Append a zero terminated string to the output of the dump.
+ */
+static void
+vm_trace_write_string (vm_trace_output_t *output_p, /**< output buffer */
+                       const char *string_p) /**< zero terminated string */
+{
+  size_t size = strlen (string_p);
+
+  if (output_p->is_full || output_p->buffer_size - output_p->position < size)
+  {
+    output_p->is_full = true;
+    return;
+  }
+
+  memcpy (output_p->buffer_p + output_p->position, string_p, size);
+  output_p->position += size;
+} /* vm_trace_write_string */
+
+/**
+ * Append a decimal number to the output of the dump.
+ */
+static void
+vm_trace_write_uint64 (vm_trace_output_t *output_p, /**< output buffer */
+                       uint64_t value) /**< number */
+{
+  char digits[21];
+  size_t length = sizeof (digits) - 1;
+
+  digits[length] = '\0';
+
+  do
+  {
+    digits[--length] = (char) ('0' + value % 10);
+    value /= 10;
+  }
+  while (value > 0);
+
+  vm_trace_write_string (output_p, digits + length);
+} /* vm_trace_write_uint64 */
+
+/**
+ * Append a time in nanoseconds to the output of the dump as microseconds with three decimals.
+ */
+static void
+vm_trace_write_time (vm_trace_output_t *output_p, /**< output buffer */
+                     uint64_t time) /**< time in nanoseconds */
+{
+  char fraction[5];
+  uint32_t nanoseconds = (uint32_t) (time % 1000);
+
+  fraction[0] = '.';
+  fraction[1] = (char) ('0' + nanoseconds / 100);
+  fraction[2] = (char) ('0' + (nanoseconds / 10) % 10);
+  fraction[3] = (char) ('0' + nanoseconds % 10);
+  fraction[4] = '\0';
+
+  vm_trace_write_uint64 (output_p, time / 1000);
+  vm_trace_write_string (output_p, fraction);
+} /* vm_trace_write_time */
+
+/**
+ * Append an event to the output of the dump.
+ */
+static void
+vm_trace_write_event (vm_trace_output_t *output_p, /**< output buffer */
+                      const jerry_trace_event_t *event_p) /**< event */
+{
+  const vm_trace_event_info_t *info_p = vm_trace_event_info + event_p->type;
+  uint64_t start_time = JERRY_TRACE_CONTEXT (start_time);
+
+  vm_trace_write_string (output_p, "{\"name\":\"");
+  vm_trace_write_string (output_p, info_p->name_p);
+  vm_trace_write_string (output_p, "\",\"cat\":\"");
+  vm_trace_write_string (output_p, info_p->category_p);
+  vm_trace_write_string (output_p, info_p->is_instant ? "\",\"ph\":\"i\",\"s\":\"t\"" : "\",\"ph\":\"X\"");
+  vm_trace_write_string (output_p, ",\"pid\":1,\"tid\":1,\"ts\":");
+  vm_trace_write_time (output_p, event_p->start_time > start_time ? event_p->start_time - start_time : 0);
+
+  if (!info_p->is_instant)
+  {
+    vm_trace_write_string (output_p, ",\"dur\":");
+    vm_trace_write_time (output_p, event_p->duration);
+  }
+
+  vm_trace_write_string (output_p, ",\"args\":{");
+
+  for (uint32_t i = 0; i < 3 && info_p->arg_names_p[i] != NULL; i++)
+  {
+    vm_trace_write_string (output_p, i > 0 ? ",\"" : "\"");
+    vm_trace_write_string (output_p, info_p->arg_names_p[i]);
+    vm_trace_write_string (output_p, "\":");
+    vm_trace_write_uint64 (output_p, event_p->args[i]);
+  }
+
+  vm_trace_write_string (output_p, "}}");
+} /* vm_trace_write_event */
+
+/**
+ * Write the recorded events in the JSON trace event format of Chrome: a "traceEvents"
+ * array of complete ("X") and instant ("i") events whose timestamps are microseconds
+ * since the start of the tracing, and the number of overwritten events in "otherData".
+ *
+ * Note:
+ *      the recorded events are kept
+ *
+ * @return number of bytes written to the buffer
+ *         0 - if the buffer is too small
+ */
+size_t
+vm_trace_dump (lit_utf8_byte_t *buffer_p, /**< output buffer */
+               size_t buffer_size) /**< size of the output buffer */
+{
+  vm_trace_output_t output;
+  uint64_t end_count = JERRY_TRACE_CONTEXT (event_count);
+  uint64_t start_count = 0;
+
+  if (end_count > JERRY_TRACE_BUFFER_SIZE)
+  {
+    start_count = end_count - JERRY_TRACE_BUFFER_SIZE;
+  }
+
+  output.buffer_p = buffer_p;
+  output.buffer_size = buffer_size;
+  output.position = 0;
+  output.is_full = false;
+
+  vm_trace_write_string (&output, "{\"traceEvents\":[");
+
+  for (uint64_t count = start_count; count < end_count && !output.is_full; count++)
+  {
+    if (count > start_count)
+    {
+      vm_trace_write_string (&output, ",\n");
+    }
+
+    vm_trace_write_event (&output, JERRY_TRACE_CONTEXT (events) + (count & VM_TRACE_BUFFER_MASK));
+  }
+
+  vm_trace_write_string (&output, "],\n\"displayTimeUnit\":\"ms\",\"otherData\":{\"overwrittenEvents\":");
+  vm_trace_write_uint64 (&output, start_count);
+  vm_trace_write_string (&output, "}}\n");
+
+  return output.is_full ? 0 : output.position;
+} /* vm_trace_dump */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* JERRY_TRACE */
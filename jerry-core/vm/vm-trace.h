@@ -0,0 +1,120 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VM_TRACE_H
+#define VM_TRACE_H
+
+#include "jcontext.h"
+#include "jerry-port.h"
+
+/** \addtogroup vm Virtual machine
+ * @{
+ *
+ * \addtogroup vm_trace Timeline tracing
+ * @{
+ */
+
+/**
+ * Types of the events recorded by the timeline tracing
+ */
+typedef enum
+{
+  VM_TRACE_EVENT_RUN, /**< top-level jerry_run */
+  VM_TRACE_EVENT_CALL, /**< top-level jerry_call_function */
+  VM_TRACE_EVENT_PARSE, /**< parsing a script (arguments: source size) */
+  VM_TRACE_EVENT_PARSE_LAZY_FUNCTION, /**< compiling a lazy function (arguments: source size) */
+  VM_TRACE_EVENT_PARSE_STATEMENTS, /**< parsing the statements of a script */
+  VM_TRACE_EVENT_PARSE_POST_PROCESSING, /**< generating the final byte code of a script */
+  VM_TRACE_EVENT_GC, /**< garbage collection (arguments: severity, objects before, objects after) */
+  VM_TRACE_EVENT_FREE_UNUSED_MEMORY, /**< the allocator requested to free the unused memory, instant event
+                                      *   (arguments: severity, allocated size, heap limit) */
+  VM_TRACE_EVENT__COUNT /**< number of event types */
+} vm_trace_event_type_t;
+
+#ifdef JERRY_TRACE
+
+extern void vm_trace_init (void);
+extern void vm_trace_start (void);
+extern void vm_trace_stop (void);
+extern void vm_trace_end (vm_trace_event_type_t, uint64_t, uint32_t, uint32_t, uint32_t);
+extern void vm_trace_instant (vm_trace_event_type_t, uint32_t, uint32_t, uint32_t);
+extern size_t vm_trace_dump (lit_utf8_byte_t *, size_t);
+
+/**
+ * Start a span event, the start time is stored in a local variable
+ *
+ * Note:
+ *      the start time is zero if the tracing is not running, so spans which are
+ *      running when the tracing is started are not recorded
+ */
+#define VM_TRACE_BEGIN() \
+  uint64_t vm_trace_start_time = JERRY_TRACE_CONTEXT (is_running) ? jerry_port_get_monotonic_time () : 0;
+
+/**
+ * Start a span event, if no JavaScript code is running
+ */
+#define VM_TRACE_BEGIN_TOP_LEVEL() \
+  uint64_t vm_trace_start_time = ((JERRY_TRACE_CONTEXT (is_running) && JERRY_CONTEXT (vm_top_context_p) == NULL) \
+                                  ? jerry_port_get_monotonic_time () \
+                                  : 0);
+
+/**
+ * Record the span event started by VM_TRACE_BEGIN
+ */
+#define VM_TRACE_END(type, arg0, arg1, arg2) \
+  if (vm_trace_start_time != 0) \
+  { \
+    vm_trace_end ((type), vm_trace_start_time, (uint32_t) (arg0), (uint32_t) (arg1), (uint32_t) (arg2)); \
+  }
+
+/**
+ * Record an instant event
+ */
+#define VM_TRACE_INSTANT(type, arg0, arg1, arg2) \
+  if (JERRY_TRACE_CONTEXT (is_running)) \
+  { \
+    vm_trace_instant ((type), (uint32_t) (arg0), (uint32_t) (arg1), (uint32_t) (arg2)); \
+  }
+
+#else /* !JERRY_TRACE */
+
+/**
+ * Timeline tracing is disabled
+ */
+#define VM_TRACE_BEGIN()
+
+/**
+ * Timeline tracing is disabled
+ */
+#define VM_TRACE_BEGIN_TOP_LEVEL()
+
+/**
+ * Timeline tracing is disabled
+ */
+#define VM_TRACE_END(type, arg0, arg1, arg2)
+
+/**
+ * Timeline tracing is disabled
+ */
+#define VM_TRACE_INSTANT(type, arg0, arg1, arg2)
+
+#endif /* JERRY_TRACE */
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* !VM_TRACE_H */
@@ -34,6 +34,8 @@
 #include "jcontext.h"
 #include "opcodes.h"
 #include "vm.h"
+#include "vm-opcode-stats.h"
+#include "vm-runtime-stats.h"
 #include "vm-stack.h"
 
 #include <alloca.h>
@@ -720,12 +722,25 @@ vm_loop (vm_frame_ctx_t *frame_ctx_p) /**< frame context */
       uint8_t opcode = *byte_code_p++;
       uint32_t opcode_data = opcode;
 
+#ifdef JERRY_LINE_INFO
+      /* The profilers resolve the current line of a frame from its current instruction. */
+      frame_ctx_p->byte_code_p = byte_code_start_p;
+#endif /* JERRY_LINE_INFO */
+
       if (opcode == CBC_EXT_OPCODE)
       {
         opcode = *byte_code_p++;
         opcode_data = (uint32_t) ((CBC_END + 1) + opcode);
       }
 
+#ifdef JERRY_VM_OPCODE_STATS
+      /* Call instructions are dispatched again after the call is completed, this is not counted. */
+      if (frame_ctx_p->call_operation == VM_NO_EXEC_OP)
+      {
+        vm_opcode_stats_record (opcode_data);
+      }
+#endif /* JERRY_VM_OPCODE_STATS */
+
       opcode_data = vm_decode_table[opcode_data];
 
       left_value = ecma_make_simple_value (ECMA_SIMPLE_VALUE_UNDEFINED);
@@ -2568,6 +2583,9 @@ vm_execute (vm_frame_ctx_t *frame_ctx_p, /**< frame context */
   JERRY_CONTEXT (is_direct_eval_form_call) = false;
 
   prev_context_p = JERRY_CONTEXT (vm_top_context_p);
+#ifdef JERRY_CPU_PROFILER
+  frame_ctx_p->prev_context_p = prev_context_p;
+#endif /* JERRY_CPU_PROFILER */
   JERRY_CONTEXT (vm_top_context_p) = frame_ctx_p;
 
   completion_value = vm_init_loop (frame_ctx_p);
@@ -2602,6 +2620,14 @@ vm_execute (vm_frame_ctx_t *frame_ctx_p, /**< frame context */
   }
 
   JERRY_CONTEXT (vm_top_context_p) = prev_context_p;
+
+#ifdef JERRY_VM_OPCODE_STATS
+  if (prev_context_p == NULL)
+  {
+    vm_opcode_stats_end_run ();
+  }
+#endif /* JERRY_VM_OPCODE_STATS */
+
   return completion_value;
 } /* vm_execute */
 
@@ -2691,19 +2717,25 @@ vm_run (const ecma_compiled_code_t *bytecode_header_p, /**< byte-code data heade
   frame_ctx.is_eval_code = is_eval_code;
   frame_ctx.call_operation = VM_NO_EXEC_OP;
 
+  ecma_value_t completion_value;
+  VM_RUNTIME_STATS_ENTER (VM_RUNTIME_PHASE_EXECUTE);
+
   if (call_stack_size <= INLINE_STACK_SIZE)
   {
-    return vm_run_with_inline_stack (&frame_ctx,
-                                     arg_list_p,
-                                     arg_list_len);
+    completion_value = vm_run_with_inline_stack (&frame_ctx,
+                                                 arg_list_p,
+                                                 arg_list_len);
   }
   else
   {
-    return vm_run_with_alloca (&frame_ctx,
-                               arg_list_p,
-                               arg_list_len,
-                               call_stack_size);
+    completion_value = vm_run_with_alloca (&frame_ctx,
+                                           arg_list_p,
+                                           arg_list_len,
+                                           call_stack_size);
   }
+
+  VM_RUNTIME_STATS_LEAVE ();
+  return completion_value;
 } /* vm_run */
 
 /**
@@ -2738,6 +2770,59 @@ vm_is_direct_eval_form_call (void)
   return JERRY_CONTEXT (is_direct_eval_form_call);
 } /* vm_is_direct_eval_form_call */
 
+#ifdef JERRY_LINE_INFO
+
+/**
+ * Get the source line of the currently executed instruction of a frame
+ *
+ * Note:
+ *      the byte code of the frame must have line info (CBC_CODE_FLAGS_HAS_LINE_INFO),
+ *      the function does not change the state of the engine, so it can be called
+ *      from a signal handler which interrupts the engine
+ *
+ * @return line number
+ */
+uint32_t
+vm_get_current_line (const vm_frame_ctx_t *frame_ctx_p) /**< frame context */
+{
+  JERRY_ASSERT (frame_ctx_p->bytecode_header_p->status_flags & CBC_CODE_FLAGS_HAS_LINE_INFO);
+
+  const cbc_line_info_t *line_info_p = CBC_GET_LINE_INFO (frame_ctx_p->bytecode_header_p);
+  const cbc_line_info_entry_t *entries_p;
+  entries_p = (const cbc_line_info_entry_t *) (((const uint8_t *) line_info_p)
+                                               + sizeof (cbc_line_info_t)
+                                               - line_info_p->size);
+
+  uint32_t offset = (uint32_t) (frame_ctx_p->byte_code_p - frame_ctx_p->byte_code_start_p);
+  uint32_t lower = 0;
+  uint32_t upper = line_info_p->entry_count;
+
+  /* Find the last entry which starts before the current instruction. */
+  while (lower < upper)
+  {
+    uint32_t middle = (lower + upper) / 2;
+
+    if (entries_p[middle].offset <= offset)
+    {
+      lower = middle + 1;
+    }
+    else
+    {
+      upper = middle;
+    }
+  }
+
+  if (lower > 0)
+  {
+    return entries_p[lower - 1].line;
+  }
+
+  /* The initializers of a function belong to its first line. */
+  return (line_info_p->line != 0) ? line_info_p->line : 1;
+} /* vm_get_current_line */
+
+#endif /* JERRY_LINE_INFO */
+
 /**
  * @}
  * @}
@@ -285,6 +285,10 @@ extern ecma_value_t vm_run (const ecma_compiled_code_t *, ecma_value_t,
 extern bool vm_is_strict_mode (void);
 extern bool vm_is_direct_eval_form_call (void);
 
+#ifdef JERRY_LINE_INFO
+extern uint32_t vm_get_current_line (const vm_frame_ctx_t *);
+#endif /* JERRY_LINE_INFO */
+
 /**
  * @}
  * @}
@@ -14,8 +14,8 @@
  * limitations under the License.
  */
 
-#ifndef JERRY_LIBC_TIME_H
-#define JERRY_LIBC_TIME_H
+#ifndef JERRY_LIBC_SYS_TIME_H
+#define JERRY_LIBC_SYS_TIME_H
 
 #ifdef __cplusplus
 extern "C"
@@ -45,4 +45,4 @@ int gettimeofday (void *tp, void *tzp);
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
-#endif /* !JERRY_LIBC_TIME_H */
+#endif /* !JERRY_LIBC_SYS_TIME_H */
@@ -0,0 +1,48 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JERRY_LIBC_TIME_H
+#define JERRY_LIBC_TIME_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * Clock identifier type
+ */
+typedef int clockid_t;
+
+/**
+ * Monotonic clock, which is not affected by the adjustments of the system time
+ */
+#define CLOCK_MONOTONIC 1
+
+/**
+ * Time specification structure
+ */
+struct timespec
+{
+  long tv_sec;   /**< seconds */
+  long tv_nsec;  /**< nanoseconds */
+};
+
+int clock_gettime (clockid_t clock_id, struct timespec *tp);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* !JERRY_LIBC_TIME_H */
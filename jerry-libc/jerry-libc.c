@@ -62,6 +62,24 @@ memset (void *s,  /**< area to set values in */
         size_t n) /**< area size */
 {
   uint8_t *area_p = (uint8_t *) s;
+
+  /* Aligned fast case. */
+  if (n >= 4 && !(((uintptr_t) s) & 0x3))
+  {
+    size_t chunks = (n >> 2);
+    uint32_t *u32_area_p = (uint32_t *) area_p;
+    uint32_t u32_value = (uint32_t) (uint8_t) c * 0x01010101u;
+
+    do
+    {
+      *u32_area_p++ = u32_value;
+    }
+    while (--chunks);
+
+    n &= 0x3;
+    area_p = (uint8_t *) u32_area_p;
+  }
+
   while (n--)
   {
     *area_p++ = (uint8_t) c;
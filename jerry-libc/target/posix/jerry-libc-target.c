@@ -29,6 +29,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <time.h>
 
 #if defined (__linux__)
 #define SYSCALL_NO(NAME) __NR_ ## NAME
@@ -272,6 +273,36 @@ gettimeofday (void *tp,  /**< struct timeval */
   return (int) syscall_2 (SYSCALL_NO (gettimeofday), (long int) tp, (long int) tzp);
 } /* gettimeofday */
 
+/**
+ * This function can get the time of the specified clock.
+ *
+ * Note:
+ *      on OS X, where clock_gettime is not a system call, the system time is returned
+ *
+ * @return 0 if success, -1 otherwise
+ */
+int
+clock_gettime (clockid_t clock_id, /**< clock identifier */
+               struct timespec *tp) /**< [out] time of the clock */
+{
+#if defined (__linux__)
+  return (int) syscall_2 (SYSCALL_NO (clock_gettime), (long int) clock_id, (long int) tp);
+#else /* !__linux__ */
+  (void) clock_id;
+
+  struct timeval tv;
+
+  if (gettimeofday (&tv, NULL) != 0)
+  {
+    return -1;
+  }
+
+  tp->tv_sec = (long) tv.tv_sec;
+  tp->tv_nsec = (long) tv.tv_usec * 1000;
+  return 0;
+#endif /* __linux__ */
+} /* clock_gettime */
+
 // FIXME
 #if 0
 /**
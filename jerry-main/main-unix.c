@@ -23,6 +23,18 @@
 #include "jerry-port.h"
 #include "jerry-port-default.h"
 
+#ifdef JERRY_MAIN_ENABLE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* JERRY_MAIN_ENABLE_MMAP */
+
+#ifdef JERRY_MAIN_ENABLE_SIGPROF
+#include <signal.h>
+#include <sys/time.h>
+#endif /* JERRY_MAIN_ENABLE_SIGPROF */
+
 /**
  * Maximum command line arguments number
  */
@@ -41,6 +53,11 @@
 
 static uint8_t buffer[ JERRY_BUFFER_SIZE ];
 
+/**
+ * Start of the free part of the buffer (the sources of lazy functions are kept)
+ */
+static size_t buffer_offset = 0;
+
 static const uint8_t *
 read_file (const char *file_name,
            size_t *out_size_p)
@@ -52,7 +69,7 @@ read_file (const char *file_name,
     return NULL;
   }
 
-  size_t bytes_read = fread (buffer, 1u, sizeof (buffer), file);
+  size_t bytes_read = fread (buffer + buffer_offset, 1u, sizeof (buffer) - buffer_offset, file);
   if (!bytes_read)
   {
     jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to read file: %s\n", file_name);
@@ -63,9 +80,419 @@ read_file (const char *file_name,
   fclose (file);
 
   *out_size_p = bytes_read;
-  return (const uint8_t *) buffer;
+  return (const uint8_t *) buffer + buffer_offset;
 } /* read_file */
 
+#ifdef JERRY_MAIN_ENABLE_MMAP
+
+/**
+ * Map a snapshot file into the memory as read-only data
+ *
+ * @return start of the mapped file - if success
+ *         NULL - otherwise
+ */
+static const uint8_t *
+map_snapshot_file (const char *file_name, /**< file name */
+                   size_t *out_size_p) /**< [out] size of the file */
+{
+  int fd = open (file_name, O_RDONLY);
+
+  if (fd < 0)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_name);
+    return NULL;
+  }
+
+  struct stat file_stat;
+  void *mapped_p = MAP_FAILED;
+
+  if (fstat (fd, &file_stat) == 0 && file_stat.st_size > 0)
+  {
+    mapped_p = mmap (NULL, (size_t) file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+
+  close (fd);
+
+  if (mapped_p == MAP_FAILED)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to map file: %s\n", file_name);
+    return NULL;
+  }
+
+  *out_size_p = (size_t) file_stat.st_size;
+  return (const uint8_t *) mapped_p;
+} /* map_snapshot_file */
+
+/**
+ * Unmap a snapshot file mapped by map_snapshot_file
+ */
+static void
+unmap_snapshot_file (const uint8_t *snapshot_p, /**< start of the mapped file */
+                     size_t snapshot_size) /**< size of the file */
+{
+  munmap ((void *) snapshot_p, snapshot_size);
+} /* unmap_snapshot_file */
+
+#else /* !JERRY_MAIN_ENABLE_MMAP */
+
+/**
+ * Buffer of the snapshot which is executed in place when mmap is not available
+ */
+static uint8_t snapshot_in_place_buffer[ JERRY_BUFFER_SIZE ];
+
+/**
+ * Read a snapshot file into a buffer which is kept until the engine stops,
+ * because mmap is not available in this configuration (e.g. with jerry-libc).
+ * Only one snapshot can be loaded this way.
+ *
+ * @return start of the snapshot - if success
+ *         NULL - otherwise
+ */
+static const uint8_t *
+map_snapshot_file (const char *file_name, /**< file name */
+                   size_t *out_size_p) /**< [out] size of the file */
+{
+  static bool is_buffer_used = false;
+
+  if (is_buffer_used)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: only one snapshot can be executed in place: %s\n", file_name);
+    return NULL;
+  }
+
+  FILE *file = fopen (file_name, "r");
+  if (file == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_name);
+    return NULL;
+  }
+
+  size_t bytes_read = fread (snapshot_in_place_buffer, 1u, sizeof (snapshot_in_place_buffer), file);
+  fclose (file);
+
+  if (!bytes_read)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to read file: %s\n", file_name);
+    return NULL;
+  }
+
+  is_buffer_used = true;
+  *out_size_p = bytes_read;
+  return (const uint8_t *) snapshot_in_place_buffer;
+} /* map_snapshot_file */
+
+/**
+ * Release a snapshot loaded by map_snapshot_file
+ */
+static void
+unmap_snapshot_file (const uint8_t *snapshot_p, /**< start of the snapshot */
+                     size_t snapshot_size) /**< size of the snapshot */
+{
+  (void) snapshot_p;
+  (void) snapshot_size;
+} /* unmap_snapshot_file */
+
+#endif /* JERRY_MAIN_ENABLE_MMAP */
+
+/**
+ * Buffer of the saved snapshots
+ */
+static uint8_t snapshot_save_buffer[ JERRY_BUFFER_SIZE ];
+
+/**
+ * Merge snapshot files into one snapshot file
+ *
+ * @return true - if the merged snapshot is saved successfully
+ *         false - otherwise
+ */
+static bool
+merge_snapshot_files (const char **file_names_p, /**< snapshot files */
+                      int files_count, /**< number of snapshot files */
+                      const char *output_file_name_p) /**< merged snapshot file */
+{
+  const void *snapshots[JERRY_MAX_COMMAND_LINE_ARGS];
+  size_t snapshot_sizes[JERRY_MAX_COMMAND_LINE_ARGS];
+
+  for (int i = 0; i < files_count; i++)
+  {
+    const uint8_t *snapshot_p = read_file (file_names_p[i], &snapshot_sizes[i]);
+
+    if (snapshot_p == NULL)
+    {
+      return false;
+    }
+
+    snapshots[i] = snapshot_p;
+
+    /* All snapshots are kept in the buffer, and they must be aligned. */
+    buffer_offset += (snapshot_sizes[i] + sizeof (uint64_t) - 1) & ~(sizeof (uint64_t) - 1);
+  }
+
+  size_t snapshot_size = jerry_merge_snapshots (snapshots,
+                                                snapshot_sizes,
+                                                (size_t) files_count,
+                                                snapshot_save_buffer,
+                                                JERRY_BUFFER_SIZE);
+
+  if (snapshot_size == 0)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to merge snapshots\n");
+    return false;
+  }
+
+  FILE *snapshot_file_p = fopen (output_file_name_p, "w");
+  fwrite (snapshot_save_buffer, sizeof (uint8_t), snapshot_size, snapshot_file_p);
+  fclose (snapshot_file_p);
+  return true;
+} /* merge_snapshot_files */
+
+#ifdef JERRY_MAIN_ENABLE_SIGPROF
+
+/**
+ * Sampling interval of the CPU profiler in microseconds
+ */
+#define JERRY_PROFILE_INTERVAL_US (1000)
+
+/**
+ * Buffer of the CPU profile
+ */
+static uint8_t profile_buffer[ JERRY_BUFFER_SIZE ];
+
+/**
+ * Take a sample of the JavaScript call stack when the profiling timer expires.
+ */
+static void
+profile_signal_handler (int signal_number) /**< signal number */
+{
+  (void) signal_number;
+  jerry_profiler_sample ();
+} /* profile_signal_handler */
+
+/**
+ * Start the CPU profiler, which is driven by the SIGPROF signal of a profiling timer
+ *
+ * @return true - if the profiler is started
+ *         false - otherwise
+ */
+static bool
+start_profiler (void)
+{
+  if (!jerry_profiler_start ())
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: --profile requires an engine built with --cpu-profiler=on\n");
+    return false;
+  }
+
+  struct sigaction action;
+  memset (&action, 0, sizeof (action));
+  action.sa_handler = profile_signal_handler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset (&action.sa_mask);
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = JERRY_PROFILE_INTERVAL_US;
+  timer.it_value = timer.it_interval;
+
+  if (sigaction (SIGPROF, &action, NULL) != 0
+      || setitimer (ITIMER_PROF, &timer, NULL) != 0)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to start the profiling timer\n");
+    jerry_profiler_stop ();
+    return false;
+  }
+
+  return true;
+} /* start_profiler */
+
+/**
+ * Stop the CPU profiler and save the profile in collapsed stack format
+ *
+ * @return true - if the profile is saved successfully
+ *         false - otherwise
+ */
+static bool
+stop_profiler (const char *file_name_p) /**< profile file */
+{
+  struct itimerval timer;
+  memset (&timer, 0, sizeof (timer));
+  setitimer (ITIMER_PROF, &timer, NULL);
+
+  jerry_profiler_stop ();
+
+  size_t profile_size = jerry_profiler_dump (profile_buffer, JERRY_BUFFER_SIZE);
+
+  FILE *profile_file_p = fopen (file_name_p, "w");
+
+  if (profile_file_p == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_name_p);
+    return false;
+  }
+
+  fwrite (profile_buffer, sizeof (uint8_t), profile_size, profile_file_p);
+  fclose (profile_file_p);
+  return true;
+} /* stop_profiler */
+
+#endif /* JERRY_MAIN_ENABLE_SIGPROF */
+
+/**
+ * Buffer of the heap profile
+ */
+static uint8_t heap_profile_buffer[ JERRY_BUFFER_SIZE ];
+
+/**
+ * Save the report of the heap profiler
+ *
+ * @return true - if the report is saved successfully
+ *         false - otherwise
+ */
+static bool
+save_heap_profile (const char *file_name_p) /**< heap profile file */
+{
+  size_t heap_profile_size = jerry_heap_profiler_dump (heap_profile_buffer, JERRY_BUFFER_SIZE);
+
+  if (heap_profile_size == 0)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: --heap-profile requires an engine built with --heap-profiler=on\n");
+    return false;
+  }
+
+  FILE *heap_profile_file_p = fopen (file_name_p, "w");
+
+  if (heap_profile_file_p == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_name_p);
+    return false;
+  }
+
+  fwrite (heap_profile_buffer, sizeof (uint8_t), heap_profile_size, heap_profile_file_p);
+  fclose (heap_profile_file_p);
+  return true;
+} /* save_heap_profile */
+
+/**
+ * Buffer of the timeline trace
+ */
+static uint8_t trace_buffer[ JERRY_BUFFER_SIZE ];
+
+/**
+ * Stop the timeline tracing and save the recorded events
+ *
+ * @return true - if the trace is saved successfully
+ *         false - otherwise
+ */
+static bool
+save_trace (const char *file_name_p) /**< trace file */
+{
+  jerry_trace_stop ();
+
+  size_t trace_size = jerry_trace_dump (trace_buffer, JERRY_BUFFER_SIZE);
+
+  if (trace_size == 0)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to write the trace of the events\n");
+    return false;
+  }
+
+  FILE *trace_file_p = fopen (file_name_p, "w");
+
+  if (trace_file_p == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_name_p);
+    return false;
+  }
+
+  fwrite (trace_buffer, sizeof (uint8_t), trace_size, trace_file_p);
+  fclose (trace_file_p);
+  return true;
+} /* save_trace */
+
+/**
+ * Write a chunk of the heap dump into a file
+ */
+static void
+write_heap_dump (const jerry_char_t *buffer_p, /**< chunk of the heap dump */
+                 jerry_size_t buffer_size, /**< size of the chunk */
+                 void *user_data_p) /**< output file */
+{
+  fwrite (buffer_p, sizeof (uint8_t), buffer_size, (FILE *) user_data_p);
+} /* write_heap_dump */
+
+/**
+ * Save the graph of the live objects
+ *
+ * @return true - if the heap dump is saved successfully
+ *         false - otherwise
+ */
+static bool
+save_heap_dump (const char *file_name_p) /**< heap dump file */
+{
+  FILE *heap_dump_file_p = fopen (file_name_p, "w");
+
+  if (heap_dump_file_p == NULL)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: failed to open file: %s\n", file_name_p);
+    return false;
+  }
+
+  /* Only the reachable objects are dumped. */
+  jerry_gc ();
+  jerry_heap_dump (write_heap_dump, heap_dump_file_p);
+
+  fclose (heap_dump_file_p);
+  return true;
+} /* save_heap_dump */
+
+/**
+ * Print a time in milliseconds with microsecond precision
+ */
+static void
+print_time (const char *label_p, /**< label printed before the time */
+            double time) /**< time in milliseconds */
+{
+  unsigned long time_us = (unsigned long) (time * 1000.0 + 0.5);
+  jerry_port_console ("%s%lu.%03lu ms", label_p, time_us / 1000, time_us % 1000);
+} /* print_time */
+
+/**
+ * Print the runtime statistics of the engine
+ */
+static void
+print_runtime_stats (void)
+{
+  jerry_runtime_stats_t stats;
+  jerry_get_runtime_stats (&stats);
+
+  jerry_port_console ("Runtime statistics:\n");
+  print_time ("  parse:     ", stats.parse_time);
+  jerry_port_console (" (%lu compiled)\n", (unsigned long) stats.parse_count);
+  print_time ("  execution: ", stats.execution_time);
+  jerry_port_console (" (%lu runs)\n", (unsigned long) stats.execution_count);
+  print_time ("  gc:        ", stats.gc_time);
+  print_time (" (", stats.gc_max_pause);
+  jerry_port_console (" max pause, %lu runs)\n", (unsigned long) stats.gc_count);
+  print_time ("  native:    ", stats.native_time);
+  jerry_port_console (" (%lu calls)\n", (unsigned long) stats.native_call_count);
+  jerry_port_console ("  heap:      %lu bytes allocated, %lu bytes peak\n",
+                      (unsigned long) stats.heap_allocated_size,
+                      (unsigned long) stats.heap_peak_allocated_size);
+  jerry_port_console ("  objects:   %lu\n", (unsigned long) stats.object_count);
+  jerry_port_console ("  strings:   %lu\n", (unsigned long) stats.string_count);
+
+  uint64_t lookups = stats.lcache_hits + stats.lcache_misses;
+  unsigned long hit_permille = (lookups > 0) ? (unsigned long) (stats.lcache_hits * 1000 / lookups) : 0;
+
+  /* The printf of jerry-libc cannot print a percent sign from the format string. */
+  jerry_port_console ("  lcache:    %lu.%lu%s hits (%lu hits, %lu misses)\n",
+                      hit_permille / 10,
+                      hit_permille % 10,
+                      "%",
+                      (unsigned long) stats.lcache_hits,
+                      (unsigned long) stats.lcache_misses);
+} /* print_runtime_stats */
+
 /**
  * Provide the 'assert' implementation for the engine.
  *
@@ -90,6 +517,115 @@ assert_handler (const jerry_value_t func_obj_val __attribute__((unused)), /**< f
   }
 } /* assert_handler */
 
+/**
+ * Register the 'assert' function in the global object
+ */
+static void
+register_assert (void)
+{
+  jerry_value_t global_obj_val = jerry_get_global_object ();
+  jerry_value_t assert_value = jerry_create_external_function (assert_handler);
+
+  jerry_value_t assert_func_name_val = jerry_create_string ((jerry_char_t *) "assert");
+  bool is_assert_added = jerry_set_property (global_obj_val, assert_func_name_val, assert_value);
+
+  jerry_release_value (assert_func_name_val);
+  jerry_release_value (assert_value);
+  jerry_release_value (global_obj_val);
+
+  if (!is_assert_added)
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Warning: failed to register 'assert' method.");
+  }
+} /* register_assert */
+
+/**
+ * Run the scripts as independent requests, each of them in a pristine engine, and print
+ * the number of completed requests per second. The engine is restarted by jerry_cleanup
+ * and jerry_init between the requests first, then the measurement is repeated with jerry_reset.
+ *
+ * @return true - if all requests are completed without errors
+ *         false - otherwise
+ */
+static bool
+bench_requests (const char **file_names_p, /**< request scripts */
+                int files_count, /**< number of request scripts */
+                int request_count, /**< number of requests */
+                jerry_init_flag_t flags) /**< init flags of the engine */
+{
+  const jerry_char_t *sources[JERRY_MAX_COMMAND_LINE_ARGS];
+  size_t source_sizes[JERRY_MAX_COMMAND_LINE_ARGS];
+
+  for (int i = 0; i < files_count; i++)
+  {
+    sources[i] = read_file (file_names_p[i], &source_sizes[i]);
+
+    if (sources[i] == NULL)
+    {
+      return false;
+    }
+
+    /* All sources are kept in the buffer. */
+    buffer_offset += source_sizes[i];
+  }
+
+  double times[2];
+
+  for (int is_reset = 0; is_reset < 2; is_reset++)
+  {
+    double start_time = jerry_port_get_current_time ();
+
+    jerry_init (flags);
+
+    for (int i = 0; i < request_count; i++)
+    {
+      if (i > 0)
+      {
+        if (is_reset)
+        {
+          jerry_reset (flags);
+        }
+        else
+        {
+          jerry_cleanup ();
+          jerry_init (flags);
+        }
+      }
+
+      register_assert ();
+
+      int file_index = i % files_count;
+      jerry_value_t ret_value = jerry_parse (sources[file_index], source_sizes[file_index], false);
+
+      if (!jerry_value_has_error_flag (ret_value))
+      {
+        jerry_value_t func_val = ret_value;
+        ret_value = jerry_run (func_val);
+        jerry_release_value (func_val);
+      }
+
+      bool is_error = jerry_value_has_error_flag (ret_value);
+      jerry_release_value (ret_value);
+
+      if (is_error)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: request failed: %s\n", file_names_p[file_index]);
+        jerry_cleanup ();
+        return false;
+      }
+    }
+
+    jerry_cleanup ();
+
+    times[is_reset] = jerry_port_get_current_time () - start_time;
+  }
+
+  jerry_port_console ("%d requests, %d scripts\n", request_count, files_count);
+  jerry_port_console ("cleanup and init: %d requests/s\n", (int) (request_count * 1000.0 / times[0]));
+  jerry_port_console ("reset:            %d requests/s\n", (int) (request_count * 1000.0 / times[1]));
+  return true;
+} /* bench_requests */
+
 static void
 print_usage (char *name)
 {
@@ -111,9 +647,20 @@ print_help (char *name)
                       "  --mem-stats-separate\n"
                       "  --parse-only\n"
                       "  --show-opcodes\n"
+                      "  --opcode-stats\n"
+                      "  --stats\n"
+                      "  --lazy-functions\n"
                       "  --save-snapshot-for-global FILE\n"
                       "  --save-snapshot-for-eval FILE\n"
+                      "  --optimize-snapshot\n"
                       "  --exec-snapshot FILE\n"
+                      "  --exec-snapshot-mmap FILE\n"
+                      "  --merge-snapshots FILE\n"
+                      "  --bench-requests COUNT\n"
+                      "  --profile FILE\n"
+                      "  --heap-profile FILE\n"
+                      "  --heap-dump FILE\n"
+                      "  --trace FILE\n"
                       "  --log-level [0-3]\n"
                       "  --abort-on-fail\n"
                       "\n",
@@ -147,13 +694,29 @@ main (int argc,
   jerry_init_flag_t flags = JERRY_INIT_EMPTY;
 
   const char *exec_snapshot_file_names[JERRY_MAX_COMMAND_LINE_ARGS];
+  bool exec_snapshot_is_mapped[JERRY_MAX_COMMAND_LINE_ARGS];
+  const uint8_t *mapped_snapshots[JERRY_MAX_COMMAND_LINE_ARGS];
+  size_t mapped_snapshot_sizes[JERRY_MAX_COMMAND_LINE_ARGS];
   int exec_snapshots_count = 0;
+  int mapped_snapshots_count = 0;
 
   bool is_parse_only = false;
   bool is_save_snapshot_mode = false;
   bool is_save_snapshot_mode_for_global_or_eval = false;
   const char *save_snapshot_file_name_p = NULL;
 
+  const char *merge_snapshot_file_name_p = NULL;
+  const char *merged_file_names[JERRY_MAX_COMMAND_LINE_ARGS];
+  int merged_files_count = 0;
+
+  int bench_request_count = 0;
+
+  const char *profile_file_name_p = NULL;
+  const char *heap_profile_file_name_p = NULL;
+  const char *heap_dump_file_name_p = NULL;
+  const char *trace_file_name_p = NULL;
+  bool is_runtime_stats = false;
+
   bool is_repl_mode = false;
 
   for (i = 1; i < argc; i++)
@@ -187,6 +750,19 @@ main (int argc,
       flags |= JERRY_INIT_SHOW_OPCODES;
       jerry_port_default_set_log_level (JERRY_LOG_LEVEL_DEBUG);
     }
+    else if (!strcmp ("--opcode-stats", argv[i]))
+    {
+      flags |= JERRY_INIT_OPCODE_STATS;
+      jerry_port_default_set_log_level (JERRY_LOG_LEVEL_DEBUG);
+    }
+    else if (!strcmp ("--lazy-functions", argv[i]))
+    {
+      flags |= JERRY_INIT_LAZY_FUNCTIONS;
+    }
+    else if (!strcmp ("--optimize-snapshot", argv[i]))
+    {
+      flags |= JERRY_INIT_OPTIMIZE_SNAPSHOT;
+    }
     else if (!strcmp ("--save-snapshot-for-global", argv[i])
              || !strcmp ("--save-snapshot-for-eval", argv[i]))
     {
@@ -209,7 +785,8 @@ main (int argc,
 
       save_snapshot_file_name_p = argv[i];
     }
-    else if (!strcmp ("--exec-snapshot", argv[i]))
+    else if (!strcmp ("--exec-snapshot", argv[i])
+             || !strcmp ("--exec-snapshot-mmap", argv[i]))
     {
       if (++i >= argc)
       {
@@ -219,8 +796,20 @@ main (int argc,
       }
 
       assert (exec_snapshots_count < JERRY_MAX_COMMAND_LINE_ARGS);
+      exec_snapshot_is_mapped[exec_snapshots_count] = !strcmp ("--exec-snapshot-mmap", argv[i - 1]);
       exec_snapshot_file_names[exec_snapshots_count++] = argv[i];
     }
+    else if (!strcmp ("--merge-snapshots", argv[i]))
+    {
+      if (++i >= argc)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: no file specified for %s\n", argv[i - 1]);
+        print_usage (argv[0]);
+        return JERRY_STANDALONE_EXIT_CODE_FAIL;
+      }
+
+      merge_snapshot_file_name_p = argv[i];
+    }
     else if (!strcmp ("--log-level", argv[i]))
     {
       if (++i >= argc)
@@ -242,6 +831,83 @@ main (int argc,
       jerry_port_default_set_log_level (argv[i][0] - '0');
 #endif /* JERRY_ENABLE_LOG */
     }
+    else if (!strcmp ("--bench-requests", argv[i]))
+    {
+      if (++i >= argc)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: no count specified for %s\n", argv[i - 1]);
+        print_usage (argv[0]);
+        return JERRY_STANDALONE_EXIT_CODE_FAIL;
+      }
+
+      const char *count_p = argv[i];
+
+      while (*count_p >= '0' && *count_p <= '9' && bench_request_count < 100000000)
+      {
+        bench_request_count = bench_request_count * 10 + (*count_p++ - '0');
+      }
+
+      if (*count_p != '\0' || bench_request_count == 0)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: wrong format for %s\n", argv[i - 1]);
+        print_usage (argv[0]);
+        return JERRY_STANDALONE_EXIT_CODE_FAIL;
+      }
+    }
+    else if (!strcmp ("--profile", argv[i]))
+    {
+      if (++i >= argc)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: no file specified for %s\n", argv[i - 1]);
+        print_usage (argv[0]);
+        return JERRY_STANDALONE_EXIT_CODE_FAIL;
+      }
+
+#ifndef JERRY_MAIN_ENABLE_SIGPROF
+      /* The sampling timer is driven by signals, which are not provided by jerry-libc. */
+      jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: %s requires the compiler default libc\n", argv[i - 1]);
+      return JERRY_STANDALONE_EXIT_CODE_FAIL;
+#endif /* !JERRY_MAIN_ENABLE_SIGPROF */
+
+      profile_file_name_p = argv[i];
+    }
+    else if (!strcmp ("--heap-profile", argv[i]))
+    {
+      if (++i >= argc)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: no file specified for %s\n", argv[i - 1]);
+        print_usage (argv[0]);
+        return JERRY_STANDALONE_EXIT_CODE_FAIL;
+      }
+
+      heap_profile_file_name_p = argv[i];
+    }
+    else if (!strcmp ("--heap-dump", argv[i]))
+    {
+      if (++i >= argc)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: no file specified for %s\n", argv[i - 1]);
+        print_usage (argv[0]);
+        return JERRY_STANDALONE_EXIT_CODE_FAIL;
+      }
+
+      heap_dump_file_name_p = argv[i];
+    }
+    else if (!strcmp ("--trace", argv[i]))
+    {
+      if (++i >= argc)
+      {
+        jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: no file specified for %s\n", argv[i - 1]);
+        print_usage (argv[0]);
+        return JERRY_STANDALONE_EXIT_CODE_FAIL;
+      }
+
+      trace_file_name_p = argv[i];
+    }
+    else if (!strcmp ("--stats", argv[i]))
+    {
+      is_runtime_stats = true;
+    }
     else if (!strcmp ("--abort-on-fail", argv[i]))
     {
       jerry_port_default_set_abort_on_fail (true);
@@ -275,35 +941,98 @@ main (int argc,
     }
   }
 
+  if (merge_snapshot_file_name_p != NULL)
+  {
+    if (files_counter == 0 || is_save_snapshot_mode || exec_snapshots_count != 0)
+    {
+      jerry_port_log (JERRY_LOG_LEVEL_ERROR,
+                      "Error: --merge-snapshots works with snapshot files only, and at least one is required\n");
+      return JERRY_STANDALONE_EXIT_CODE_FAIL;
+    }
+
+    /* The files are snapshots, not scripts. */
+    for (i = 0; i < files_counter; i++)
+    {
+      merged_file_names[merged_files_count++] = file_names[i];
+    }
+
+    files_counter = 0;
+  }
+
   if (files_counter == 0
-      && exec_snapshots_count == 0)
+      && exec_snapshots_count == 0
+      && merge_snapshot_file_name_p == NULL)
   {
     is_repl_mode = true;
   }
 
-  jerry_init (flags);
+  if (bench_request_count > 0)
+  {
+    if (files_counter == 0
+        || is_save_snapshot_mode
+        || exec_snapshots_count != 0
+        || merge_snapshot_file_name_p != NULL
+        || profile_file_name_p != NULL
+        || heap_profile_file_name_p != NULL
+        || heap_dump_file_name_p != NULL
+        || trace_file_name_p != NULL
+        || is_runtime_stats)
+    {
+      jerry_port_log (JERRY_LOG_LEVEL_ERROR,
+                      "Error: --bench-requests works with scripts only, and at least one is required\n");
+      return JERRY_STANDALONE_EXIT_CODE_FAIL;
+    }
 
-  jerry_value_t global_obj_val = jerry_get_global_object ();
-  jerry_value_t assert_value = jerry_create_external_function (assert_handler);
+    bool is_ok = bench_requests (file_names, files_counter, bench_request_count, flags);
+    return is_ok ? JERRY_STANDALONE_EXIT_CODE_OK : JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
 
-  jerry_value_t assert_func_name_val = jerry_create_string ((jerry_char_t *) "assert");
-  bool is_assert_added = jerry_set_property (global_obj_val, assert_func_name_val, assert_value);
+  jerry_init (flags);
+  register_assert ();
 
-  jerry_release_value (assert_func_name_val);
-  jerry_release_value (assert_value);
-  jerry_release_value (global_obj_val);
+  if (trace_file_name_p != NULL && !jerry_trace_start ())
+  {
+    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Error: --trace requires an engine built with --trace=on\n");
+    jerry_cleanup ();
+    return JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
 
-  if (!is_assert_added)
+#ifdef JERRY_MAIN_ENABLE_SIGPROF
+  if (profile_file_name_p != NULL && !start_profiler ())
   {
-    jerry_port_log (JERRY_LOG_LEVEL_ERROR, "Warning: failed to register 'assert' method.");
+    jerry_cleanup ();
+    return JERRY_STANDALONE_EXIT_CODE_FAIL;
   }
+#endif /* JERRY_MAIN_ENABLE_SIGPROF */
 
   jerry_value_t ret_value = jerry_create_undefined ();
 
+  if (merge_snapshot_file_name_p != NULL
+      && !merge_snapshot_files (merged_file_names, merged_files_count, merge_snapshot_file_name_p))
+  {
+    ret_value = jerry_create_error (JERRY_ERROR_COMMON, (jerry_char_t *) "");
+  }
+
   for (int i = 0; i < exec_snapshots_count; i++)
   {
     size_t snapshot_size;
-    const uint8_t *snapshot_p = read_file (exec_snapshot_file_names[i], &snapshot_size);
+    const uint8_t *snapshot_p;
+
+    if (exec_snapshot_is_mapped[i])
+    {
+      /* The snapshot is executed in place, so it is kept until the engine stops. */
+      snapshot_p = map_snapshot_file (exec_snapshot_file_names[i], &snapshot_size);
+
+      if (snapshot_p != NULL)
+      {
+        mapped_snapshots[mapped_snapshots_count] = snapshot_p;
+        mapped_snapshot_sizes[mapped_snapshots_count++] = snapshot_size;
+      }
+    }
+    else
+    {
+      snapshot_p = read_file (exec_snapshot_file_names[i], &snapshot_size);
+    }
 
     if (snapshot_p == NULL)
     {
@@ -313,7 +1042,7 @@ main (int argc,
     {
       ret_value = jerry_exec_snapshot ((void *) snapshot_p,
                                        snapshot_size,
-                                       true);
+                                       !exec_snapshot_is_mapped[i]);
     }
 
     if (jerry_value_has_error_flag (ret_value))
@@ -336,8 +1065,6 @@ main (int argc,
 
       if (is_save_snapshot_mode)
       {
-        static uint8_t snapshot_save_buffer[ JERRY_BUFFER_SIZE ];
-
         size_t snapshot_size = jerry_parse_and_save_snapshot ((jerry_char_t *) source_p,
                                                               source_size,
                                                               is_save_snapshot_mode_for_global_or_eval,
@@ -359,6 +1086,12 @@ main (int argc,
       {
         ret_value = jerry_parse (source_p, source_size, false);
 
+        if (flags & JERRY_INIT_LAZY_FUNCTIONS)
+        {
+          /* Lazy functions are compiled from the source later. */
+          buffer_offset += source_size;
+        }
+
         if (!jerry_value_has_error_flag (ret_value) && !is_parse_only)
         {
           jerry_value_t func_val = ret_value;
@@ -463,8 +1196,41 @@ main (int argc,
   }
 
   jerry_release_value (ret_value);
+
+  if (is_runtime_stats)
+  {
+    print_runtime_stats ();
+  }
+
+  if (trace_file_name_p != NULL && !save_trace (trace_file_name_p))
+  {
+    ret_code = JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
+
+#ifdef JERRY_MAIN_ENABLE_SIGPROF
+  if (profile_file_name_p != NULL && !stop_profiler (profile_file_name_p))
+  {
+    ret_code = JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
+#endif /* JERRY_MAIN_ENABLE_SIGPROF */
+
+  if (heap_profile_file_name_p != NULL && !save_heap_profile (heap_profile_file_name_p))
+  {
+    ret_code = JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
+
+  if (heap_dump_file_name_p != NULL && !save_heap_dump (heap_dump_file_name_p))
+  {
+    ret_code = JERRY_STANDALONE_EXIT_CODE_FAIL;
+  }
+
   jerry_cleanup ();
 
+  for (int i = 0; i < mapped_snapshots_count; i++)
+  {
+    unmap_snapshot_file (mapped_snapshots[i], mapped_snapshot_sizes[i]);
+  }
+
   return ret_code;
 
 } /* main */
@@ -15,6 +15,7 @@
  */
 
 #include <sys/time.h>
+#include <time.h>
 
 #include "jerry-port.h"
 #include "jerry-port-default.h"
@@ -56,3 +57,18 @@ double jerry_port_get_current_time ()
 
   return ((double) tv.tv_sec) * 1000.0 + ((double) tv.tv_usec) / 1000.0;
 } /* jerry_port_get_current_time */
+
+/**
+ * Default implementation of jerry_port_get_monotonic_time.
+ */
+uint64_t jerry_port_get_monotonic_time ()
+{
+  struct timespec ts;
+
+  if (clock_gettime (CLOCK_MONOTONIC, &ts) != 0)
+  {
+    return 0;
+  }
+
+  return ((uint64_t) ts.tv_sec) * 1000000000u + (uint64_t) ts.tv_nsec;
+} /* jerry_port_get_monotonic_time */
@@ -83,3 +83,14 @@ jerry_port_get_current_time ()
 {
   return (double) us_ticker_read ();
 } /* jerry_port_get_current_time */
+
+/**
+ * Implementation of jerry_port_get_monotonic_time.
+ *
+ * @return current timer's counter value in nanoseconds
+ */
+uint64_t
+jerry_port_get_monotonic_time ()
+{
+  return ((uint64_t) us_ticker_read ()) * 1000u;
+} /* jerry_port_get_monotonic_time */
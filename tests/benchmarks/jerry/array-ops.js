@@ -0,0 +1,38 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Array construction and the higher order array built-ins.
+
+var numbers = [];
+
+for (var i = 0; i < 1000; i++)
+{
+  numbers.push (i);
+}
+
+var total = 0;
+
+for (var round = 0; round < 20; round++)
+{
+  var evens = numbers.filter (function (value) { return (value & 1) == 0; });
+  var squares = evens.map (function (value) { return value * value; });
+  total = squares.reduce (function (sum, value) { return sum + value; }, 0);
+
+  var copy = numbers.slice (0);
+  copy.reverse ();
+  copy.splice (10, 100);
+  assert (copy.indexOf (0) === copy.length - 1);
+}
+
+assert (total === 166167000);
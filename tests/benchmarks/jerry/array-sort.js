@@ -0,0 +1,56 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Array.prototype.sort with the default and with a custom comparator.
+
+var seed = 1;
+
+function random ()
+{
+  seed = (seed * 1103515245 + 12345) % 2147483648;
+  return seed;
+}
+
+var numbers;
+
+for (var round = 0; round < 12; round++)
+{
+  numbers = [];
+
+  for (var i = 0; i < 1000; i++)
+  {
+    numbers.push (random () % 10000);
+  }
+
+  numbers.sort (function (a, b) { return a - b; });
+}
+
+for (var i = 1; i < numbers.length; i++)
+{
+  assert (numbers[i - 1] <= numbers[i]);
+}
+
+var names = [];
+
+for (var i = 0; i < 300; i++)
+{
+  names.push ('name' + (random () % 1000));
+}
+
+names.sort ();
+
+for (var i = 1; i < names.length; i++)
+{
+  assert (names[i - 1] <= names[i]);
+}
@@ -0,0 +1,65 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Function calls, argument passing and closures capturing variables.
+
+function makeCounter (step)
+{
+  var count = 0;
+
+  return function (times)
+  {
+    for (var i = 0; i < times; i++)
+    {
+      count += step;
+    }
+
+    return count;
+  };
+}
+
+function add (a, b)
+{
+  return a + b;
+}
+
+function fib (n)
+{
+  return n < 2 ? n : fib (n - 1) + fib (n - 2);
+}
+
+var total = 0;
+
+for (var i = 0; i < 200000; i++)
+{
+  total = add (total, i & 7);
+}
+
+var counters = [];
+
+for (var i = 0; i < 100; i++)
+{
+  counters.push (makeCounter (i));
+}
+
+for (var round = 0; round < 800; round++)
+{
+  for (var i = 0; i < counters.length; i++)
+  {
+    counters[i] (2);
+  }
+}
+
+assert (counters[3] (0) === 4800);
+assert (fib (20) === 6765);
@@ -0,0 +1,33 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Date construction from time values, field access, parsing and formatting.
+
+var start = Date.parse ('2016-01-01T00:00:00.000Z');
+var total = 0;
+var text;
+
+for (var i = 0; i < 20000; i++)
+{
+  var date = new Date (start + i * 7654321);
+  total += date.getUTCMonth () + date.getUTCDate () + date.getUTCHours () + date.getUTCMinutes ();
+}
+
+for (var i = 0; i < 2000; i++)
+{
+  text = new Date (Date.parse ('2016-06-15T12:00:00.000Z') + i * 1000).toISOString ();
+}
+
+assert (text === '2016-06-15T12:33:19.000Z');
+assert (total === 1240417);
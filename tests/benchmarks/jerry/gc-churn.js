@@ -0,0 +1,36 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Short lived objects, arrays and strings which keep the garbage collector busy.
+
+var live = [];
+
+for (var i = 0; i < 50000; i++)
+{
+  var node = { index: i, next: null, label: 'n' + (i & 255) };
+  var pair = [node, { value: i }];
+
+  if ((i & 63) == 0)
+  {
+    live.push (pair);
+
+    if (live.length > 32)
+    {
+      live.shift ();
+    }
+  }
+}
+
+assert (live.length === 32);
+assert (live[31][0].index === 49984);
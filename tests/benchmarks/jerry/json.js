@@ -0,0 +1,35 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// JSON serialization and parsing of nested records.
+
+var records = [];
+
+for (var i = 0; i < 20; i++)
+{
+  records.push ({ id: i, name: 'record' + i, tags: ['a', 'b', i], active: i % 2 == 0, score: i / 4 });
+}
+
+var text;
+var parsed;
+
+for (var round = 0; round < 300; round++)
+{
+  text = JSON.stringify (records);
+  parsed = JSON.parse (text);
+}
+
+assert (parsed.length === 20);
+assert (parsed[7].name === 'record7');
+assert (parsed[8].score === 2);
@@ -0,0 +1,35 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parsing and compiling source code with eval and the Function constructor.
+// The sources differ in each round, so they are not served from the code cache.
+
+var body = '';
+
+for (var i = 0; i < 20; i++)
+{
+  body += 'function f' + i + ' (a, b) { var c = a + b * ' + i + '; if (c > 10) { return c - 1; } return c; }\n';
+}
+
+var result;
+
+for (var round = 0; round < 600; round++)
+{
+  result = eval (body + 'f19 (1, 2) + ' + round + ';');
+
+  var adder = new Function ('a', 'b', 'return a + b + ' + round + ';');
+  assert (adder (1, 2) === 3 + round);
+}
+
+assert (result === 637);
@@ -0,0 +1,50 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Named property reads and writes on objects with different shapes.
+
+function Point (x, y)
+{
+  this.x = x;
+  this.y = y;
+}
+
+var points = [];
+
+for (var i = 0; i < 32; i++)
+{
+  var point = new Point (i, i * 2);
+
+  if (i % 4 == 0)
+  {
+    point.z = i;
+  }
+
+  points.push (point);
+}
+
+var sum = 0;
+
+for (var round = 0; round < 8000; round++)
+{
+  for (var j = 0; j < points.length; j++)
+  {
+    var p = points[j];
+    p.x = p.x + 1;
+    sum += p.x + p.y;
+  }
+}
+
+assert (points[0].x === 8000);
+assert (sum > 0);
@@ -0,0 +1,43 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Regular expression compilation, matching and replacing.
+
+var words = ['alpha42', 'beta', 'gamma7', 'delta', 'epsilon100', 'zeta'];
+var numbered = /^([a-z]+)(\d+)$/;
+var matches = 0;
+
+for (var round = 0; round < 3000; round++)
+{
+  for (var i = 0; i < words.length; i++)
+  {
+    if (numbered.exec (words[i]) !== null)
+    {
+      matches++;
+    }
+  }
+}
+
+assert (matches === 9000);
+
+var text = 'The quick brown fox jumps over the lazy dog';
+var result;
+
+for (var round = 0; round < 600; round++)
+{
+  result = text.replace (/o/g, '0').replace (/\s+/g, '_');
+  assert (/^[A-Za-z0_]+$/.test (result));
+}
+
+assert (result === 'The_quick_br0wn_f0x_jumps_0ver_the_lazy_d0g');
@@ -0,0 +1,47 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// String concatenation, conversion and searching.
+
+var parts = [];
+
+for (var i = 0; i < 4000; i++)
+{
+  var text = 'item-' + i + ':' + (i * 3).toString (16);
+
+  if (text.indexOf ('ff') >= 0)
+  {
+    text = text.toUpperCase ();
+  }
+
+  parts.push (text.substring (0, 8));
+}
+
+var joined = parts.join (',');
+assert (joined.length > 20000);
+
+var line = '';
+
+for (var round = 0; round < 40; round++)
+{
+  line = '';
+
+  for (var i = 0; i < 200; i++)
+  {
+    line += String.fromCharCode (97 + (i % 26));
+  }
+}
+
+assert (line.length === 200);
+assert (joined.split (',').length === 4000);
@@ -82,3 +82,14 @@ a = [];
 for (; a[0]; ) {
   assert (false);
 }
+
+// 8.
+for (s = 0; s < { get x () { var v = 2; return v; }, set x (v) { return; } }.x; s++) {
+}
+
+assert (s === 2);
+
+for (s = 0; function () { return } && s < 3; s++) {
+}
+
+assert (s === 3);
@@ -370,3 +370,26 @@ assert (result.a == 1);
 
 result = JSON.parse(str, [1, 2, 3]);
 assert (result.a == 1);
+
+// Checking truncated texts
+check_parse_error ('"abc');
+check_parse_error ('"abc\\');
+check_parse_error ('"\\u12');
+check_parse_error ('[1');
+check_parse_error ('[1,');
+check_parse_error ('{"a"');
+check_parse_error ('{"a":');
+check_parse_error ('tru');
+check_parse_error ('nul');
+check_parse_error ('-');
+check_parse_error ('1e');
+check_parse_error ('1e+');
+check_parse_error ('-a');
+
+// Checking strings with escape sequences
+
+result = JSON.parse ('{"a\\nb": "x\\u0041\\"y", "c": ["\\t", "plain", "\\u20ac\\\\"]}');
+assert (result["a\nb"] === 'xA"y');
+assert (result.c[0] === "\t");
+assert (result.c[1] === "plain");
+assert (result.c[2] === "€\\");
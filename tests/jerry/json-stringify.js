@@ -213,3 +213,43 @@ assert (JSON.stringify (object, null, undefined) == '{"a":2}');
 assert (JSON.stringify (object, null, new Boolean (true)) == '{"a":2}');
 assert (JSON.stringify (object, null, [1, 2, 3] ) == '{"a":2}');
 assert (JSON.stringify (object, null, { "a": 3 }) == '{"a":2}');
+
+// Checking property order and property types
+object = { "b": 1, "2": 2, "a": 3, "1": 4 };
+assert (JSON.stringify (object) == '{"1":4,"2":2,"b":1,"a":3}');
+
+object = { "a": 1 };
+Object.defineProperty (object, "b", { get: function () { return 2; }, enumerable: true });
+Object.defineProperty (object, "c", { value: 3, enumerable: false });
+object.d = 4;
+assert (JSON.stringify (object) == '{"a":1,"b":2,"d":4}');
+object[0] = 0;
+assert (JSON.stringify (object) == '{"0":0,"a":1,"b":2,"d":4}');
+
+object = { "a": { toJSON: function () { delete object.b; return 1; } }, "b": 2, "c": 3 };
+assert (JSON.stringify (object) == '{"a":1,"c":3}');
+
+// Checking inherited toJSON
+function Proto () {}
+Proto.prototype.toJSON = function (key) { return "proto:" + key; };
+assert (JSON.stringify ({ "a": new Proto () }) == '{"a":"proto:a"}');
+
+Object.prototype.toJSON = function () { return 5; };
+assert (JSON.stringify ({ "a": 1 }) == '5');
+delete Object.prototype.toJSON;
+
+Array.prototype.toJSON = function () { return "array"; };
+assert (JSON.stringify ([1, 2]) == '"array"');
+delete Array.prototype.toJSON;
+
+assert (JSON.stringify (new Date (0)) == '"1970-01-01T00:00:00.000Z"');
+
+// Checking output which is longer than the initial output buffer
+array = [];
+for (var i = 0; i < 200; i++)
+{
+  array[i] = { "index": i, "text": "\u0001\"\\" };
+}
+str = JSON.stringify (array);
+assert (str.length == 6691);
+assert (JSON.stringify (JSON.parse (str)) == str);
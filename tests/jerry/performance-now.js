@@ -0,0 +1,50 @@
+// Copyright 2016 University of Szeged.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+assert (typeof performance === "object");
+assert (typeof performance.now === "function");
+assert (performance.now.length === 0);
+assert (Object.prototype.toString.call (performance) === "[object Object]");
+
+var start = performance.now ();
+assert (typeof start === "number");
+assert (start >= 0);
+
+// The time elapsed since the start of the engine is far less than a Date value.
+assert (start < Date.now ());
+
+// The clock is monotonic.
+var previous = start;
+for (var i = 0; i < 1000; i++)
+{
+  var now = performance.now ();
+  assert (now >= previous);
+  previous = now;
+}
+
+// Wait until the system time advances by at least 2 milliseconds.
+var date_start = Date.now ();
+while (Date.now () - date_start < 2)
+{
+}
+
+assert (performance.now () - start >= 1);
+
+// The property is writable and configurable like the other global objects.
+var saved = performance;
+performance = 1;
+assert (performance === 1);
+performance = saved;
+assert (delete this.performance);
+assert (typeof this.performance === "undefined");
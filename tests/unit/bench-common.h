@@ -0,0 +1,146 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include "jerry-port.h"
+
+#include "test-common.h"
+
+/**
+ * Harness of the microbenchmarks of the engine internals.
+ *
+ * The benchmarked function runs a requested number of rounds of a fixed number
+ * of operations. The number of rounds is calibrated first, so one sample takes
+ * at least BENCH_SAMPLE_TIME milliseconds of the monotonic clock of the port,
+ * which makes the resolution of the clock and the cost of the calls negligible. Then BENCH_SAMPLE_COUNT samples
+ * are taken, and the median, the median absolute deviation (MAD) and the minimum
+ * of the time of one operation are reported.
+ */
+
+/**
+ * Minimum duration of a sample in milliseconds
+ */
+#define BENCH_SAMPLE_TIME 5.0
+
+/**
+ * Number of samples of a benchmark
+ */
+#define BENCH_SAMPLE_COUNT 15
+
+/**
+ * Maximum number of rounds of a sample
+ */
+#define BENCH_MAX_ROUNDS (1u << 30)
+
+/**
+ * Benchmarked function, which runs the given number of rounds
+ */
+typedef void (*bench_func_t) (uint32_t rounds);
+
+/**
+ * Measure the time of the given number of rounds.
+ *
+ * @return time in milliseconds
+ */
+static double
+bench_measure (bench_func_t func, /**< benchmarked function */
+               uint32_t rounds) /**< number of rounds */
+{
+  uint64_t start_time = jerry_port_get_monotonic_time ();
+  func (rounds);
+  return (double) (jerry_port_get_monotonic_time () - start_time) / 1000000.0;
+} /* bench_measure */
+
+/**
+ * Sort the samples in ascending order.
+ */
+static void
+bench_sort (double *samples_p, /**< samples */
+            int count) /**< number of samples */
+{
+  for (int i = 1; i < count; i++)
+  {
+    double sample = samples_p[i];
+    int j = i;
+
+    while (j > 0 && samples_p[j - 1] > sample)
+    {
+      samples_p[j] = samples_p[j - 1];
+      j--;
+    }
+
+    samples_p[j] = sample;
+  }
+} /* bench_sort */
+
+/**
+ * Print a time in nanoseconds with one fractional digit (the printf of jerry-libc has no %f).
+ */
+static void
+bench_print_ns (const char *label_p, /**< label printed before the value */
+                double time_ns) /**< time in nanoseconds */
+{
+  uint32_t tenths = (uint32_t) (time_ns * 10.0 + 0.5);
+  printf ("%s%6u.%u", label_p, (unsigned int) (tenths / 10), (unsigned int) (tenths % 10));
+} /* bench_print_ns */
+
+/**
+ * Run a benchmark and print the time of one operation.
+ */
+static void
+bench_run (const char *name_p, /**< name of the benchmark */
+           bench_func_t func, /**< benchmarked function */
+           uint32_t ops_per_round) /**< number of operations in a round */
+{
+  uint32_t rounds = 1;
+
+  /* Warm up the caches, then double the rounds until a sample is long enough. */
+  func (rounds);
+
+  while (bench_measure (func, rounds) < BENCH_SAMPLE_TIME && rounds < BENCH_MAX_ROUNDS)
+  {
+    rounds *= 2;
+  }
+
+  double samples[BENCH_SAMPLE_COUNT];
+  double ns_per_op = 1000000.0 / ((double) rounds * (double) ops_per_round);
+
+  for (int i = 0; i < BENCH_SAMPLE_COUNT; i++)
+  {
+    samples[i] = bench_measure (func, rounds) * ns_per_op;
+  }
+
+  bench_sort (samples, BENCH_SAMPLE_COUNT);
+
+  double median = samples[BENCH_SAMPLE_COUNT / 2];
+  double deviations[BENCH_SAMPLE_COUNT];
+
+  for (int i = 0; i < BENCH_SAMPLE_COUNT; i++)
+  {
+    deviations[i] = samples[i] > median ? samples[i] - median : median - samples[i];
+  }
+
+  bench_sort (deviations, BENCH_SAMPLE_COUNT);
+
+  printf ("%-44s", name_p);
+  bench_print_ns ("", median);
+  bench_print_ns (" ns/op  MAD", deviations[BENCH_SAMPLE_COUNT / 2]);
+  bench_print_ns ("  min", samples[0]);
+  printf ("\n");
+} /* bench_run */
+
+#endif /* BENCH_COMMON_H */
@@ -0,0 +1,134 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of an expression evaluator, which calls eval with the same
+ * few expressions repeatedly (served from the compiled code cache), compared
+ * with evaluating distinct expressions of the same size (always compiled).
+ */
+
+#include "jerry-api.h"
+#include "jerry-port.h"
+
+#include "test-common.h"
+
+/**
+ * Number of eval calls of one measurement
+ */
+#define BENCH_EVAL_COUNT 5000
+
+/**
+ * Number of different expressions used by the repeated case
+ */
+#define BENCH_EXPRESSION_COUNT 4
+
+/**
+ * Number of measurements (the best one is reported)
+ */
+#define BENCH_REPEAT_COUNT 5
+
+/**
+ * Evaluator script (the source of the expressions differs only in a comment selected by the
+ * argument, so the distinct expressions do not create new literals)
+ */
+static const char *evaluator_source_p = ("var data = { price: 12, count: 3, discount: 0.25, tax: 0.2 };\n"
+                                         "function evaluate (index) {\n"
+                                         "  return eval ('/* ' + (index + 1000000) + ' */ with (data) {'\n"
+                                         "               + ' (price * count * (1 - discount)'\n"
+                                         "               + ' + (price > 10 ? tax * price : 0)) }');\n"
+                                         "}\n");
+
+/**
+ * Evaluate expressions
+ */
+static void
+run_evaluations (int modulo) /**< number of different expressions */
+{
+  jerry_value_t global_object = jerry_get_global_object ();
+  jerry_value_t func_name = jerry_create_string ((const jerry_char_t *) "evaluate");
+  jerry_value_t func = jerry_get_property (global_object, func_name);
+
+  for (int i = 0; i < BENCH_EVAL_COUNT; i++)
+  {
+    jerry_value_t arg = jerry_create_number ((double) (i % modulo));
+    jerry_value_t result = jerry_call_function (func, global_object, &arg, 1);
+
+    TEST_ASSERT (jerry_value_is_number (result));
+
+    jerry_release_value (result);
+    jerry_release_value (arg);
+  }
+
+  jerry_release_value (func);
+  jerry_release_value (func_name);
+  jerry_release_value (global_object);
+} /* run_evaluations */
+
+/**
+ * Measure the evaluations
+ *
+ * @return the best time of the measurements in milliseconds
+ */
+static double
+bench_run (int modulo, /**< number of different expressions */
+           jerry_code_cache_stats_t *stats_p) /**< [out] cache statistics of the last measurement */
+{
+  double best_time = 0;
+
+  for (int repeat = 0; repeat < BENCH_REPEAT_COUNT; repeat++)
+  {
+    jerry_init (JERRY_INIT_EMPTY);
+
+    jerry_value_t result = jerry_eval ((const jerry_char_t *) evaluator_source_p, strlen (evaluator_source_p), false);
+    TEST_ASSERT (!jerry_value_has_error_flag (result));
+    jerry_release_value (result);
+
+    double start_time = jerry_port_get_current_time ();
+    run_evaluations (modulo);
+    double time = jerry_port_get_current_time () - start_time;
+
+    jerry_get_code_cache_stats (stats_p);
+    jerry_cleanup ();
+
+    if (repeat == 0 || time < best_time)
+    {
+      best_time = time;
+    }
+  }
+
+  return best_time;
+} /* bench_run */
+
+int
+main (void)
+{
+  jerry_code_cache_stats_t repeated_stats, distinct_stats;
+
+  double repeated_time = bench_run (BENCH_EXPRESSION_COUNT, &repeated_stats);
+  double distinct_time = bench_run (BENCH_EVAL_COUNT, &distinct_stats);
+
+  printf ("%d eval calls, best of %d runs\n", BENCH_EVAL_COUNT, BENCH_REPEAT_COUNT);
+  printf ("%d expressions: %d us (cache hits: %d, misses: %d)\n",
+          BENCH_EXPRESSION_COUNT,
+          (int) (repeated_time * 1000),
+          (int) repeated_stats.hits,
+          (int) repeated_stats.misses);
+  printf ("%d expressions: %d us (cache hits: %d, misses: %d)\n",
+          BENCH_EVAL_COUNT,
+          (int) (distinct_time * 1000),
+          (int) distinct_stats.hits,
+          (int) distinct_stats.misses);
+  return 0;
+} /* main */
@@ -0,0 +1,178 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of forked request handlers: an engine is pre-warmed with a
+ * large object graph, then each request runs in a fork () of it, where the
+ * heap is shared copy-on-write with the parent. The private and shared memory
+ * of the child is reported after the request and after a garbage collection.
+ *
+ * Build with FEATURE_GC_MARK_BITMAP=ON to compare the GC, which keeps its marks
+ * in a bitmap, with the default GC, which writes a flag into every live object.
+ *
+ * The benchmark requires fork () and /proc/self/smaps_rollup, so it only
+ * measures when it is built with the compiler default libc on Linux.
+ */
+
+#include "jerry-api.h"
+#include "jerry-port.h"
+
+#include "test-common.h"
+
+#ifdef TEST_COMPILER_DEFAULT_LIBC
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif /* TEST_COMPILER_DEFAULT_LIBC */
+
+/**
+ * Number of forked children
+ */
+#define BENCH_CHILD_COUNT 4
+
+/**
+ * Script which builds the pre-warmed state
+ */
+static const char *prewarm_source_p = ("var cache = [];"
+                                       "for (var i = 0; i < 4000; i++) {"
+                                       "  cache.push ({ id: i, name: 'entry' + i, next: null });"
+                                       "  if (i > 0) { cache[i - 1].next = cache[i]; }"
+                                       "}");
+
+#ifdef TEST_COMPILER_DEFAULT_LIBC
+
+/**
+ * Script of a request, which allocates temporary objects
+ */
+static const char *request_source_p = ("var total = 0;"
+                                       "for (var i = 0; i < 200; i++) {"
+                                       "  var tmp = { value: cache[i * 10].id };"
+                                       "  total += tmp.value;"
+                                       "}"
+                                       "total;");
+
+/**
+ * Memory usage of the process in kilobytes
+ */
+typedef struct
+{
+  int private_dirty; /**< private dirty pages */
+  int shared; /**< clean and dirty pages shared with other processes */
+} bench_memory_t;
+
+/**
+ * Get the memory usage of the current process
+ */
+static void
+bench_get_memory (bench_memory_t *memory_p) /**< [out] memory usage */
+{
+  FILE *file_p = fopen ("/proc/self/smaps_rollup", "r");
+  TEST_ASSERT (file_p != NULL);
+
+  char line[128];
+  int value;
+
+  memory_p->private_dirty = 0;
+  memory_p->shared = 0;
+
+  while (fgets (line, sizeof (line), file_p) != NULL)
+  {
+    if (sscanf (line, "Private_Dirty: %d kB", &value) == 1)
+    {
+      memory_p->private_dirty = value;
+    }
+    else if (sscanf (line, "Shared_Clean: %d kB", &value) == 1
+             || sscanf (line, "Shared_Dirty: %d kB", &value) == 1)
+    {
+      memory_p->shared += value;
+    }
+  }
+
+  fclose (file_p);
+} /* bench_get_memory */
+
+/**
+ * Handle a request in a forked child
+ */
+static void
+bench_run_child (int child_index) /**< index of the child */
+{
+  bench_memory_t start, after_request, after_gc;
+
+  bench_get_memory (&start);
+
+  jerry_value_t result = jerry_eval ((const jerry_char_t *) request_source_p, strlen (request_source_p), false);
+  TEST_ASSERT (jerry_value_is_number (result));
+  jerry_release_value (result);
+
+  bench_get_memory (&after_request);
+
+  jerry_gc ();
+
+  bench_get_memory (&after_gc);
+
+  printf ("child %d: private %d kB, shared %d kB; after request +%d kB private; after GC +%d kB private\n",
+          child_index,
+          after_gc.private_dirty,
+          after_gc.shared,
+          after_request.private_dirty - start.private_dirty,
+          after_gc.private_dirty - after_request.private_dirty);
+} /* bench_run_child */
+
+#endif /* TEST_COMPILER_DEFAULT_LIBC */
+
+int
+main (void)
+{
+  jerry_init (JERRY_INIT_EMPTY);
+
+  jerry_value_t result = jerry_eval ((const jerry_char_t *) prewarm_source_p, strlen (prewarm_source_p), false);
+  TEST_ASSERT (!jerry_value_has_error_flag (result));
+  jerry_release_value (result);
+
+  /* The pre-warmed state is settled before forking. */
+  jerry_gc ();
+
+#ifdef TEST_COMPILER_DEFAULT_LIBC
+#ifdef JERRY_GC_MARK_BITMAP
+  printf ("GC marks: bitmap\n");
+#else /* !JERRY_GC_MARK_BITMAP */
+  printf ("GC marks: object headers\n");
+#endif /* JERRY_GC_MARK_BITMAP */
+
+  for (int i = 0; i < BENCH_CHILD_COUNT; i++)
+  {
+    fflush (stdout);
+
+    pid_t pid = fork ();
+    TEST_ASSERT (pid >= 0);
+
+    if (pid == 0)
+    {
+      bench_run_child (i);
+      fflush (stdout);
+      _exit (0);
+    }
+
+    int status;
+    TEST_ASSERT (waitpid (pid, &status, 0) == pid && WIFEXITED (status) && WEXITSTATUS (status) == 0);
+  }
+#else /* !TEST_COMPILER_DEFAULT_LIBC */
+  printf ("fork () is not available, build with COMPILER_DEFAULT_LIBC=ON\n");
+#endif /* TEST_COMPILER_DEFAULT_LIBC */
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
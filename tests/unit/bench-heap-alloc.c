@@ -0,0 +1,224 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of the memory allocators: jmem_heap_alloc_block and
+ * jmem_heap_free_block with blocks freed in allocation order, in reverse
+ * order and in random order, and on a fragmented heap, and the
+ * jmem_pools_alloc and jmem_pools_free pair.
+ */
+
+#include "jmem-allocator.h"
+#include "jmem-heap.h"
+#include "jmem-poolman.h"
+
+#include "bench-common.h"
+
+/**
+ * Number of blocks allocated by a round
+ */
+#define BENCH_BLOCK_COUNT 256
+
+/**
+ * Number of small blocks which fragment the heap
+ */
+#define BENCH_HOLE_COUNT 2048
+
+/**
+ * Size of the holes of the fragmented heap (smaller than any block allocated on it)
+ */
+#define BENCH_HOLE_SIZE 16
+
+/**
+ * Size of the blocks allocated on the fragmented heap
+ */
+#define BENCH_FRAGMENTED_BLOCK_SIZE 24
+
+/**
+ * Allocated blocks
+ */
+static void *blocks[BENCH_BLOCK_COUNT];
+
+/**
+ * Sizes of the allocated blocks
+ */
+static size_t block_sizes[BENCH_BLOCK_COUNT];
+
+/**
+ * Order of freeing the blocks in the random order benchmark
+ */
+static int free_order[BENCH_BLOCK_COUNT];
+
+/**
+ * Blocks which fragment the heap
+ */
+static void *holes[BENCH_HOLE_COUNT];
+
+/**
+ * Allocate all blocks.
+ */
+static void
+alloc_blocks (void)
+{
+  for (int i = 0; i < BENCH_BLOCK_COUNT; i++)
+  {
+    blocks[i] = jmem_heap_alloc_block (block_sizes[i]);
+  }
+} /* alloc_blocks */
+
+/**
+ * Allocate the blocks and free them in allocation order.
+ */
+static void
+bench_heap_fifo (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    alloc_blocks ();
+
+    for (int i = 0; i < BENCH_BLOCK_COUNT; i++)
+    {
+      jmem_heap_free_block (blocks[i], block_sizes[i]);
+    }
+  }
+} /* bench_heap_fifo */
+
+/**
+ * Allocate the blocks and free them in reverse order.
+ */
+static void
+bench_heap_lifo (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    alloc_blocks ();
+
+    for (int i = BENCH_BLOCK_COUNT - 1; i >= 0; i--)
+    {
+      jmem_heap_free_block (blocks[i], block_sizes[i]);
+    }
+  }
+} /* bench_heap_lifo */
+
+/**
+ * Allocate the blocks and free them in random order.
+ */
+static void
+bench_heap_random (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    alloc_blocks ();
+
+    for (int i = 0; i < BENCH_BLOCK_COUNT; i++)
+    {
+      int index = free_order[i];
+      jmem_heap_free_block (blocks[index], block_sizes[index]);
+    }
+  }
+} /* bench_heap_random */
+
+/**
+ * Allocate and free blocks which do not fit into the holes of the fragmented heap.
+ */
+static void
+bench_heap_fragmented (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    for (int i = 0; i < BENCH_BLOCK_COUNT; i++)
+    {
+      blocks[i] = jmem_heap_alloc_block (BENCH_FRAGMENTED_BLOCK_SIZE);
+    }
+
+    for (int i = 0; i < BENCH_BLOCK_COUNT; i++)
+    {
+      jmem_heap_free_block (blocks[i], BENCH_FRAGMENTED_BLOCK_SIZE);
+    }
+  }
+} /* bench_heap_fragmented */
+
+/**
+ * Allocate pool chunks and free them in reverse order.
+ */
+static void
+bench_pools (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    for (int i = 0; i < BENCH_BLOCK_COUNT; i++)
+    {
+      blocks[i] = jmem_pools_alloc ();
+    }
+
+    for (int i = BENCH_BLOCK_COUNT - 1; i >= 0; i--)
+    {
+      jmem_pools_free (blocks[i]);
+    }
+  }
+} /* bench_pools */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jmem_init ();
+
+  for (int i = 0; i < BENCH_BLOCK_COUNT; i++)
+  {
+    /* Mixed sizes from 8 to 64 bytes, the typical sizes of the engine's allocations. */
+    block_sizes[i] = (size_t) (8 + (rand () % 8) * 8);
+    free_order[i] = i;
+  }
+
+  for (int i = BENCH_BLOCK_COUNT - 1; i > 0; i--)
+  {
+    int j = rand () % (i + 1);
+    int index = free_order[i];
+    free_order[i] = free_order[j];
+    free_order[j] = index;
+  }
+
+  printf ("%-44s %s\n", "benchmark (one operation is an alloc + free)", "median / MAD / min in ns");
+
+  bench_run ("heap alloc/free, fifo", bench_heap_fifo, BENCH_BLOCK_COUNT);
+  bench_run ("heap alloc/free, lifo", bench_heap_lifo, BENCH_BLOCK_COUNT);
+  bench_run ("heap alloc/free, random order", bench_heap_random, BENCH_BLOCK_COUNT);
+
+  /* Allocate small blocks and free every second one, so the free list starts with many holes. */
+  for (int i = 0; i < BENCH_HOLE_COUNT; i++)
+  {
+    holes[i] = jmem_heap_alloc_block (BENCH_HOLE_SIZE);
+  }
+
+  for (int i = 0; i < BENCH_HOLE_COUNT; i += 2)
+  {
+    jmem_heap_free_block (holes[i], BENCH_HOLE_SIZE);
+  }
+
+  bench_run ("heap alloc/free, fragmented heap", bench_heap_fragmented, BENCH_BLOCK_COUNT);
+
+  for (int i = 1; i < BENCH_HOLE_COUNT; i += 2)
+  {
+    jmem_heap_free_block (holes[i], BENCH_HOLE_SIZE);
+  }
+
+  bench_run ("pools alloc/free", bench_pools, BENCH_BLOCK_COUNT);
+
+  jmem_pools_collect_empty ();
+  jmem_finalize (false);
+  return 0;
+} /* main */
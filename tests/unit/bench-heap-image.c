@@ -0,0 +1,207 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of engine start-up: a cold start, which runs a bootstrap
+ * script after jerry_init, compared with a warm start, which loads the heap
+ * image saved after the bootstrap script was run.
+ */
+
+#include "jerry-api.h"
+#include "jerry-port.h"
+
+#include "test-common.h"
+
+/**
+ * Number of functions defined by the bootstrap script
+ */
+#define BENCH_FUNCTION_COUNT 600
+
+/**
+ * Number of measured start-ups (the best one is reported)
+ */
+#define BENCH_REPEAT_COUNT 20
+
+/**
+ * Source of the bootstrap script
+ */
+static char bootstrap_source[BENCH_FUNCTION_COUNT * 128];
+
+/**
+ * Size of the bootstrap script
+ */
+static size_t bootstrap_source_size;
+
+/**
+ * Buffer of the heap image
+ */
+static uint8_t heap_image[512 * 1024];
+
+/**
+ * Size of the heap image
+ */
+static size_t heap_image_size;
+
+/**
+ * Script run after the start-up, which uses the bootstrap script
+ */
+static const char *job_source_p = "lib.f17 (1, 2).value + lib.f42 (3, 4).value";
+
+/**
+ * Append a string to the bootstrap script
+ */
+static void
+bootstrap_append (const char *str_p) /**< string */
+{
+  size_t size = strlen (str_p);
+
+  TEST_ASSERT (bootstrap_source_size + size < sizeof (bootstrap_source));
+  memcpy (bootstrap_source + bootstrap_source_size, str_p, size);
+  bootstrap_source_size += size;
+} /* bootstrap_append */
+
+/**
+ * Append a non-negative integer to the bootstrap script
+ */
+static void
+bootstrap_append_int (int value) /**< value */
+{
+  char digits[12];
+  char *digit_p = digits + sizeof (digits) - 1;
+
+  *digit_p = '\0';
+
+  do
+  {
+    *(--digit_p) = (char) ('0' + value % 10);
+    value /= 10;
+  }
+  while (value > 0);
+
+  bootstrap_append (digit_p);
+} /* bootstrap_append_int */
+
+/**
+ * Generate the bootstrap script
+ */
+static void
+generate_bootstrap_source (void)
+{
+  bootstrap_append ("var lib = {};\n");
+
+  for (int i = 0; i < BENCH_FUNCTION_COUNT; i++)
+  {
+    bootstrap_append ("lib.f");
+    bootstrap_append_int (i);
+    bootstrap_append (" = function (a, b) { var t = a * ");
+    bootstrap_append_int (i);
+    bootstrap_append (" + b; return { value: t, name: 'f");
+    bootstrap_append_int (i);
+    bootstrap_append ("' }; };\n");
+  }
+} /* generate_bootstrap_source */
+
+/**
+ * Run the bootstrap script
+ */
+static void
+run_bootstrap (void)
+{
+  jerry_value_t result = jerry_eval ((const jerry_char_t *) bootstrap_source, bootstrap_source_size, false);
+  TEST_ASSERT (!jerry_value_has_error_flag (result));
+  jerry_release_value (result);
+} /* run_bootstrap */
+
+/**
+ * Run a job, which uses the functions defined by the bootstrap script
+ */
+static void
+run_job (void)
+{
+  jerry_value_t result = jerry_eval ((const jerry_char_t *) job_source_p, strlen (job_source_p), false);
+  TEST_ASSERT (jerry_value_is_number (result) && jerry_get_number_value (result) == 17 + 2 + 42 * 3 + 4);
+  jerry_release_value (result);
+} /* run_job */
+
+/**
+ * Start the engine by running the bootstrap script
+ */
+static void
+cold_start (void)
+{
+  jerry_init (JERRY_INIT_EMPTY);
+  run_bootstrap ();
+} /* cold_start */
+
+/**
+ * Start the engine by loading the heap image
+ */
+static void
+warm_start (void)
+{
+  TEST_ASSERT (jerry_load_heap_image (JERRY_INIT_EMPTY, heap_image, heap_image_size));
+} /* warm_start */
+
+/**
+ * Measure a start-up function
+ *
+ * @return the best time of the measurements in milliseconds
+ */
+static double
+bench_run (void (*start_func) (void)) /**< start-up function */
+{
+  double best_time = 0;
+
+  for (int repeat = 0; repeat < BENCH_REPEAT_COUNT; repeat++)
+  {
+    double start_time = jerry_port_get_current_time ();
+
+    start_func ();
+
+    double time = jerry_port_get_current_time () - start_time;
+
+    run_job ();
+    jerry_cleanup ();
+
+    if (repeat == 0 || time < best_time)
+    {
+      best_time = time;
+    }
+  }
+
+  return best_time;
+} /* bench_run */
+
+int
+main (void)
+{
+  generate_bootstrap_source ();
+
+  cold_start ();
+  heap_image_size = jerry_save_heap_image (heap_image, sizeof (heap_image));
+  TEST_ASSERT (heap_image_size != 0);
+  jerry_cleanup ();
+
+  double cold_time = bench_run (cold_start);
+  double warm_time = bench_run (warm_start);
+
+  printf ("bootstrap script: %d bytes, heap image: %d bytes, best of %d runs\n",
+          (int) bootstrap_source_size,
+          (int) heap_image_size,
+          BENCH_REPEAT_COUNT);
+  printf ("cold start: %d us\n", (int) (cold_time * 1000));
+  printf ("warm start: %d us\n", (int) (warm_time * 1000));
+  return 0;
+} /* main */
@@ -0,0 +1,246 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of loading a large library, from which only a few
+ * functions are used: the functions are compiled when the library is
+ * parsed, compared with compiling them on their first call
+ * (JERRY_INIT_LAZY_FUNCTIONS).
+ */
+
+#include "jerry-api.h"
+#include "jerry-port.h"
+
+#include "test-common.h"
+
+/**
+ * Number of functions defined by the library
+ */
+#define BENCH_FUNCTION_COUNT 500
+
+/**
+ * Every BENCH_CALL_STEP-th function of the library is called
+ */
+#define BENCH_CALL_STEP 20
+
+/**
+ * Number of measurements (the best one is reported)
+ */
+#define BENCH_REPEAT_COUNT 20
+
+/**
+ * Source of the library
+ */
+static char library_source[BENCH_FUNCTION_COUNT * 512];
+
+/**
+ * Size of the library
+ */
+static size_t library_source_size;
+
+/**
+ * Source of the script, which uses the library
+ */
+static char job_source[BENCH_FUNCTION_COUNT * 16];
+
+/**
+ * Size of the script, which uses the library
+ */
+static size_t job_source_size;
+
+/**
+ * Append a string to a source buffer
+ */
+static void
+source_append (char *buffer_p, /**< source buffer */
+               size_t buffer_size, /**< size of the buffer */
+               size_t *size_p, /**< [in/out] size of the source */
+               const char *str_p) /**< string */
+{
+  size_t size = strlen (str_p);
+
+  TEST_ASSERT (*size_p + size < buffer_size);
+  memcpy (buffer_p + *size_p, str_p, size);
+  *size_p += size;
+} /* source_append */
+
+/**
+ * Append a string to the library
+ */
+static void
+library_append (const char *str_p) /**< string */
+{
+  source_append (library_source, sizeof (library_source), &library_source_size, str_p);
+} /* library_append */
+
+/**
+ * Append a string to the script, which uses the library
+ */
+static void
+job_append (const char *str_p) /**< string */
+{
+  source_append (job_source, sizeof (job_source), &job_source_size, str_p);
+} /* job_append */
+
+/**
+ * Convert a non-negative integer to string
+ *
+ * @return pointer to the string (valid until the next call)
+ */
+static const char *
+int_to_string (int value) /**< value */
+{
+  static char digits[12];
+  char *digit_p = digits + sizeof (digits) - 1;
+
+  *digit_p = '\0';
+
+  do
+  {
+    *(--digit_p) = (char) ('0' + value % 10);
+    value /= 10;
+  }
+  while (value > 0);
+
+  return digit_p;
+} /* int_to_string */
+
+/**
+ * Generate the library and the script, which uses it
+ */
+static void
+generate_sources (void)
+{
+  library_append ("var lib = {};\n");
+  job_append ("var sum = 0;\n");
+
+  for (int i = 0; i < BENCH_FUNCTION_COUNT; i++)
+  {
+    library_append ("lib.f");
+    library_append (int_to_string (i));
+    library_append (" = function (list, limit) {\n"
+                    "  var result = { count: 0, total: 0, items: [] };\n"
+                    "  function accept (value) { return value % 3 !== 0 && value < limit; }\n"
+                    "  for (var i = 0; i < list.length; i++) {\n"
+                    "    if (accept (list[i])) {\n"
+                    "      result.count++;\n"
+                    "      result.total += list[i] * ");
+    library_append (int_to_string (i));
+    library_append (";\n"
+                    "      result.items.push ('item' + list[i]);\n"
+                    "    }\n"
+                    "  }\n"
+                    "  return result.total;\n"
+                    "};\n");
+
+    if (i % BENCH_CALL_STEP == 0)
+    {
+      job_append ("sum += lib.f");
+      job_append (int_to_string (i));
+      job_append (" ([1, 2, 4], 10);\n");
+    }
+  }
+
+  job_append ("sum;");
+} /* generate_sources */
+
+/**
+ * Parse the library
+ */
+static void
+parse_library (void)
+{
+  jerry_value_t parsed_code = jerry_parse ((const jerry_char_t *) library_source, library_source_size, false);
+  TEST_ASSERT (!jerry_value_has_error_flag (parsed_code));
+
+  jerry_value_t result = jerry_run (parsed_code);
+  TEST_ASSERT (!jerry_value_has_error_flag (result));
+
+  jerry_release_value (result);
+  jerry_release_value (parsed_code);
+} /* parse_library */
+
+/**
+ * Run the script, which uses the library
+ */
+static void
+run_job (void)
+{
+  jerry_value_t result = jerry_eval ((const jerry_char_t *) job_source, job_source_size, false);
+
+  /* Each called function returns 7 * its index. */
+  int called_count = (BENCH_FUNCTION_COUNT - 1) / BENCH_CALL_STEP + 1;
+  int expected_sum = 7 * BENCH_CALL_STEP * called_count * (called_count - 1) / 2;
+
+  TEST_ASSERT (jerry_value_is_number (result) && jerry_get_number_value (result) == expected_sum);
+  jerry_release_value (result);
+} /* run_job */
+
+/**
+ * Measure loading the library and using it
+ */
+static void
+bench_run (jerry_init_flag_t flags, /**< init flags */
+           double *parse_time_p, /**< [out] best time of parsing in milliseconds */
+           double *total_time_p) /**< [out] best time of parsing and running in milliseconds */
+{
+  for (int repeat = 0; repeat < BENCH_REPEAT_COUNT; repeat++)
+  {
+    jerry_init (flags);
+
+    double start_time = jerry_port_get_current_time ();
+    parse_library ();
+    double parse_time = jerry_port_get_current_time () - start_time;
+    run_job ();
+    double total_time = jerry_port_get_current_time () - start_time;
+
+    jerry_cleanup ();
+
+    if (repeat == 0 || parse_time < *parse_time_p)
+    {
+      *parse_time_p = parse_time;
+    }
+
+    if (repeat == 0 || total_time < *total_time_p)
+    {
+      *total_time_p = total_time;
+    }
+  }
+} /* bench_run */
+
+int
+main (void)
+{
+  double eager_parse_time, eager_total_time;
+  double lazy_parse_time, lazy_total_time;
+
+  generate_sources ();
+
+  bench_run (JERRY_INIT_EMPTY, &eager_parse_time, &eager_total_time);
+  bench_run (JERRY_INIT_LAZY_FUNCTIONS, &lazy_parse_time, &lazy_total_time);
+
+  printf ("library: %d bytes, %d functions, %d of them called, best of %d runs\n",
+          (int) library_source_size,
+          BENCH_FUNCTION_COUNT,
+          (BENCH_FUNCTION_COUNT - 1) / BENCH_CALL_STEP + 1,
+          BENCH_REPEAT_COUNT);
+  printf ("eager: parse %d us, parse and run %d us\n",
+          (int) (eager_parse_time * 1000),
+          (int) (eager_total_time * 1000));
+  printf ("lazy:  parse %d us, parse and run %d us\n",
+          (int) (lazy_parse_time * 1000),
+          (int) (lazy_total_time * 1000));
+  return 0;
+} /* main */
@@ -0,0 +1,250 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of the string internals: the lookup of literals by
+ * ecma_find_or_create_literal_string, the comparison of strings by
+ * ecma_compare_ecma_strings, the number to string and string to number
+ * conversions, and the string hash of lit_utf8_string_hash_combine.
+ */
+
+#include "ecma-helpers.h"
+#include "ecma-literal-storage.h"
+#include "lit-strings.h"
+
+#include "bench-common.h"
+
+/**
+ * Number of literals in the literal storage
+ */
+#define BENCH_LITERAL_COUNT 256
+
+/**
+ * Maximum length of a literal
+ */
+#define BENCH_LITERAL_MAX_LENGTH 16
+
+/**
+ * Length of the long strings
+ */
+#define BENCH_LONG_STRING_LENGTH 256
+
+/**
+ * Number of numbers converted by a round
+ */
+#define BENCH_NUMBER_COUNT 4
+
+/**
+ * Literals looked up in the literal storage
+ */
+static lit_utf8_byte_t literals[BENCH_LITERAL_COUNT][BENCH_LITERAL_MAX_LENGTH];
+
+/**
+ * Lengths of the literals
+ */
+static lit_utf8_size_t literal_lengths[BENCH_LITERAL_COUNT];
+
+/**
+ * Long string used by the hash benchmark
+ */
+static lit_utf8_byte_t long_string[BENCH_LONG_STRING_LENGTH];
+
+/**
+ * Compared strings: two equal strings, and a string which differs only in its last character
+ */
+static ecma_string_t *equal_string_p;
+static ecma_string_t *equal_copy_string_p;
+static ecma_string_t *different_string_p;
+
+/**
+ * Numbers converted to strings: an integer, a fraction, a negative number and a large exponent
+ */
+static const ecma_number_t numbers[BENCH_NUMBER_COUNT] =
+{
+  123456789.0, 0.1, -42.125, 1.5e300
+};
+
+/**
+ * String forms of the numbers
+ */
+static const char *number_strings[BENCH_NUMBER_COUNT] =
+{
+  "123456789", "0.1", "-42.125", "1.5e+300"
+};
+
+/**
+ * Sum of the results (keeps the compiler from dropping the benchmarked calls)
+ */
+static uint32_t checksum;
+
+/**
+ * Look up every literal of the literal storage.
+ */
+static void
+bench_find_literal (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    for (int i = 0; i < BENCH_LITERAL_COUNT; i++)
+    {
+      checksum += ecma_find_or_create_literal_string (literals[i], literal_lengths[i]);
+    }
+  }
+} /* bench_find_literal */
+
+/**
+ * Compare two equal strings, which are stored separately.
+ */
+static void
+bench_compare_equal (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    checksum += ecma_compare_ecma_strings (equal_string_p, equal_copy_string_p);
+  }
+} /* bench_compare_equal */
+
+/**
+ * Compare two strings with the same length which differ only in their last character.
+ */
+static void
+bench_compare_different (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    checksum += ecma_compare_ecma_strings (equal_string_p, different_string_p);
+  }
+} /* bench_compare_different */
+
+/**
+ * Convert numbers to strings.
+ */
+static void
+bench_number_to_string (uint32_t rounds) /**< number of rounds */
+{
+  lit_utf8_byte_t buffer[ECMA_MAX_CHARS_IN_STRINGIFIED_NUMBER];
+
+  while (rounds-- > 0)
+  {
+    for (int i = 0; i < BENCH_NUMBER_COUNT; i++)
+    {
+      checksum += ecma_number_to_utf8_string (numbers[i], buffer, sizeof (buffer));
+    }
+  }
+} /* bench_number_to_string */
+
+/**
+ * Convert strings to numbers.
+ */
+static void
+bench_string_to_number (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    for (int i = 0; i < BENCH_NUMBER_COUNT; i++)
+    {
+      const char *string_p = number_strings[i];
+      ecma_number_t number = ecma_utf8_string_to_number ((const lit_utf8_byte_t *) string_p,
+                                                          (lit_utf8_size_t) strlen (string_p));
+      checksum += (number == numbers[i]);
+    }
+  }
+} /* bench_string_to_number */
+
+/**
+ * Hash a string of the typical length of a property name.
+ */
+static void
+bench_hash_short (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    checksum += lit_utf8_string_hash_combine ((lit_string_hash_t) rounds, long_string, BENCH_LITERAL_MAX_LENGTH);
+  }
+} /* bench_hash_short */
+
+/**
+ * Hash a long string.
+ */
+static void
+bench_hash_long (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    checksum += lit_utf8_string_hash_combine ((lit_string_hash_t) rounds, long_string, BENCH_LONG_STRING_LENGTH);
+  }
+} /* bench_hash_long */
+
+/**
+ * Generate an identifier-like string.
+ */
+static void
+generate_string (lit_utf8_byte_t *string_p, /**< [out] string */
+                 lit_utf8_size_t length) /**< length of the string */
+{
+  static const lit_utf8_byte_t characters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_$";
+  static const lit_utf8_size_t character_count = (lit_utf8_size_t) (sizeof (characters) - 1);
+
+  for (lit_utf8_size_t i = 0; i < length; i++)
+  {
+    string_p[i] = characters[(unsigned long) rand () % character_count];
+  }
+} /* generate_string */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jmem_init ();
+
+  for (int i = 0; i < BENCH_LITERAL_COUNT; i++)
+  {
+    literal_lengths[i] = (lit_utf8_size_t) (4 + (rand () % (BENCH_LITERAL_MAX_LENGTH - 4)));
+    generate_string (literals[i], literal_lengths[i]);
+    ecma_find_or_create_literal_string (literals[i], literal_lengths[i]);
+  }
+
+  generate_string (long_string, BENCH_LONG_STRING_LENGTH);
+
+  equal_string_p = ecma_new_ecma_string_from_utf8 (long_string, BENCH_LONG_STRING_LENGTH);
+  equal_copy_string_p = ecma_new_ecma_string_from_utf8 (long_string, BENCH_LONG_STRING_LENGTH);
+  long_string[BENCH_LONG_STRING_LENGTH - 1] = (lit_utf8_byte_t) (long_string[BENCH_LONG_STRING_LENGTH - 1] ^ 1);
+  different_string_p = ecma_new_ecma_string_from_utf8 (long_string, BENCH_LONG_STRING_LENGTH);
+
+  TEST_ASSERT (equal_string_p != equal_copy_string_p);
+  TEST_ASSERT (ecma_compare_ecma_strings (equal_string_p, equal_copy_string_p));
+  TEST_ASSERT (!ecma_compare_ecma_strings (equal_string_p, different_string_p));
+
+  printf ("%-44s %s\n", "benchmark", "median / MAD / min in ns");
+
+  bench_run ("find literal string (256 literals)", bench_find_literal, BENCH_LITERAL_COUNT);
+  bench_run ("compare strings, equal (256 bytes)", bench_compare_equal, 1);
+  bench_run ("compare strings, different (256 bytes)", bench_compare_different, 1);
+  bench_run ("number to string", bench_number_to_string, BENCH_NUMBER_COUNT);
+  bench_run ("string to number", bench_string_to_number, BENCH_NUMBER_COUNT);
+  bench_run ("hash combine (16 bytes)", bench_hash_short, 1);
+  bench_run ("hash combine (256 bytes)", bench_hash_long, 1);
+
+  TEST_ASSERT (checksum != 0);
+
+  ecma_deref_ecma_string (different_string_p);
+  ecma_deref_ecma_string (equal_copy_string_p);
+  ecma_deref_ecma_string (equal_string_p);
+
+  ecma_finalize_lit_storage ();
+  jmem_finalize (true);
+  return 0;
+} /* main */
@@ -0,0 +1,194 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of marshalling native records into JS objects and back:
+ * per-field jerry_set_property / jerry_get_property calls compared with the
+ * batched jerry_create_object_with_properties and jerry_get_properties
+ * functions (both use the same field name values).
+ */
+
+#include "jerry-api.h"
+#include "jerry-port.h"
+
+#include "test-common.h"
+
+/**
+ * Number of fields of a record
+ */
+#define BENCH_FIELD_COUNT 20
+
+/**
+ * Number of records marshalled by one measurement
+ */
+#define BENCH_RECORD_COUNT 2000
+
+/**
+ * Number of measurements (the best one is reported)
+ */
+#define BENCH_REPEAT_COUNT 5
+
+/**
+ * Field names of a record
+ */
+static const char *field_names[BENCH_FIELD_COUNT] =
+{
+  "id", "name", "kind", "owner", "group", "size", "mode", "flags", "created", "modified",
+  "accessed", "parent", "first", "last", "count", "offset", "length", "checksum", "version", "state"
+};
+
+/**
+ * Native record marshalled by the benchmark
+ */
+static double record[BENCH_FIELD_COUNT];
+
+/**
+ * Field names created once and shared by both marshalling functions
+ */
+static jerry_value_t name_values[BENCH_FIELD_COUNT];
+
+/**
+ * Sum of the unmarshalled fields (keeps the compiler from dropping the reads)
+ */
+static double checksum;
+
+/**
+ * Create an object from the record and read it back with one API call per field
+ */
+static void
+marshal_per_field (void)
+{
+  jerry_value_t object = jerry_create_object ();
+
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    jerry_value_t value = jerry_create_number (record[i]);
+    jerry_value_t result = jerry_set_property (object, name_values[i], value);
+
+    TEST_ASSERT (!jerry_value_has_error_flag (result));
+
+    jerry_release_value (result);
+    jerry_release_value (value);
+  }
+
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    jerry_value_t value = jerry_get_property (object, name_values[i]);
+
+    checksum += jerry_get_number_value (value);
+
+    jerry_release_value (value);
+  }
+
+  jerry_release_value (object);
+} /* marshal_per_field */
+
+/**
+ * Create an object from the record and read it back with the batched API calls
+ */
+static void
+marshal_batched (void)
+{
+  jerry_value_t values[BENCH_FIELD_COUNT];
+
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    values[i] = jerry_create_number (record[i]);
+  }
+
+  jerry_value_t object = jerry_create_object_with_properties (name_values, values, BENCH_FIELD_COUNT);
+  TEST_ASSERT (!jerry_value_has_error_flag (object));
+
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    jerry_release_value (values[i]);
+  }
+
+  jerry_value_t result = jerry_get_properties (object, name_values, values, BENCH_FIELD_COUNT);
+  TEST_ASSERT (!jerry_value_has_error_flag (result));
+  jerry_release_value (result);
+
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    checksum += jerry_get_number_value (values[i]);
+    jerry_release_value (values[i]);
+  }
+
+  jerry_release_value (object);
+} /* marshal_batched */
+
+/**
+ * Run a marshalling function on all records
+ *
+ * @return the best time of the measurements in milliseconds
+ */
+static double
+bench_run (void (*marshal_func) (void)) /**< marshalling function */
+{
+  double best_time = 0;
+
+  for (int repeat = 0; repeat < BENCH_REPEAT_COUNT; repeat++)
+  {
+    double start_time = jerry_port_get_current_time ();
+
+    for (int i = 0; i < BENCH_RECORD_COUNT; i++)
+    {
+      record[0] = (double) i;
+      marshal_func ();
+    }
+
+    double time = jerry_port_get_current_time () - start_time;
+
+    if (repeat == 0 || time < best_time)
+    {
+      best_time = time;
+    }
+  }
+
+  return best_time;
+} /* bench_run */
+
+int
+main (void)
+{
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    record[i] = (double) (i * 3);
+  }
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    name_values[i] = jerry_create_string ((const jerry_char_t *) field_names[i]);
+  }
+
+  double per_field_time = bench_run (marshal_per_field);
+  double batched_time = bench_run (marshal_batched);
+
+  for (int i = 0; i < BENCH_FIELD_COUNT; i++)
+  {
+    jerry_release_value (name_values[i]);
+  }
+
+  jerry_cleanup ();
+
+  TEST_ASSERT (checksum > 0);
+
+  printf ("%d records of %d fields, best of %d runs\n", BENCH_RECORD_COUNT, BENCH_FIELD_COUNT, BENCH_REPEAT_COUNT);
+  printf ("per-field: %d us\n", (int) (per_field_time * 1000));
+  printf ("batched:   %d us\n", (int) (batched_time * 1000));
+  return 0;
+} /* main */
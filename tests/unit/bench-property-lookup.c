@@ -0,0 +1,209 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Microbenchmark of the property lookup internals: the lookup cache
+ * (ecma_lcache_lookup) and the property hashmap (ecma_property_hashmap_find)
+ * of an object with many properties, for present and missing names.
+ */
+
+#include "ecma-helpers.h"
+#include "ecma-lcache.h"
+#include "ecma-property-hashmap.h"
+#include "jerry-api.h"
+
+#include "bench-common.h"
+
+/**
+ * Number of properties of the object
+ */
+#define BENCH_PROPERTY_COUNT 64
+
+/**
+ * Object whose properties are looked up
+ */
+static ecma_object_t *object_p;
+
+/**
+ * Names of the properties (the same strings which are stored in the object)
+ */
+static ecma_string_t *names[BENCH_PROPERTY_COUNT];
+
+/**
+ * Names whose properties are in the lookup cache
+ */
+static ecma_string_t *cached_names[BENCH_PROPERTY_COUNT];
+
+/**
+ * Number of names whose properties are in the lookup cache
+ */
+static uint32_t cached_name_count;
+
+/**
+ * Name which is not a property of the object
+ */
+static ecma_string_t *missing_name_p;
+
+/**
+ * Number of the found properties (keeps the compiler from dropping the lookups)
+ */
+static uint32_t found_count;
+
+#ifndef CONFIG_ECMA_LCACHE_DISABLE
+
+/**
+ * Look up the cached properties in the lookup cache.
+ */
+static void
+bench_lcache_hit (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    for (uint32_t i = 0; i < cached_name_count; i++)
+    {
+      found_count += (ecma_lcache_lookup (object_p, cached_names[i]) != NULL);
+    }
+  }
+} /* bench_lcache_hit */
+
+/**
+ * Look up a missing property in the lookup cache.
+ */
+static void
+bench_lcache_miss (uint32_t rounds) /**< number of rounds */
+{
+  while (rounds-- > 0)
+  {
+    found_count += (ecma_lcache_lookup (object_p, missing_name_p) != NULL);
+  }
+} /* bench_lcache_miss */
+
+#endif /* !CONFIG_ECMA_LCACHE_DISABLE */
+
+#ifndef CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE
+
+/**
+ * Look up all properties in the property hashmap.
+ */
+static void
+bench_hashmap_hit (uint32_t rounds) /**< number of rounds */
+{
+  ecma_property_hashmap_t *hashmap_p = (ecma_property_hashmap_t *) ecma_get_property_list (object_p);
+  ecma_string_t *real_name_p;
+
+  while (rounds-- > 0)
+  {
+    for (int i = 0; i < BENCH_PROPERTY_COUNT; i++)
+    {
+      found_count += (ecma_property_hashmap_find (hashmap_p, names[i], &real_name_p) != NULL);
+    }
+  }
+} /* bench_hashmap_hit */
+
+/**
+ * Look up a missing property in the property hashmap.
+ */
+static void
+bench_hashmap_miss (uint32_t rounds) /**< number of rounds */
+{
+  ecma_property_hashmap_t *hashmap_p = (ecma_property_hashmap_t *) ecma_get_property_list (object_p);
+  ecma_string_t *real_name_p;
+
+  while (rounds-- > 0)
+  {
+    found_count += (ecma_property_hashmap_find (hashmap_p, missing_name_p, &real_name_p) != NULL);
+  }
+} /* bench_hashmap_miss */
+
+#endif /* !CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  jerry_value_t object = jerry_create_object ();
+  jerry_value_t name_values[BENCH_PROPERTY_COUNT];
+  char name_buffer[] = "property_aa";
+
+  for (int i = 0; i < BENCH_PROPERTY_COUNT; i++)
+  {
+    name_buffer[sizeof (name_buffer) - 3] = (char) ('a' + i / 26);
+    name_buffer[sizeof (name_buffer) - 2] = (char) ('a' + i % 26);
+
+    name_values[i] = jerry_create_string ((const jerry_char_t *) name_buffer);
+
+    jerry_value_t value = jerry_create_number ((double) i);
+    jerry_value_t result = jerry_set_property (object, name_values[i], value);
+    TEST_ASSERT (!jerry_value_has_error_flag (result));
+
+    jerry_release_value (result);
+    jerry_release_value (value);
+
+    names[i] = ecma_get_string_from_value (name_values[i]);
+  }
+
+  jerry_value_t missing_name = jerry_create_string ((const jerry_char_t *) "missing");
+  missing_name_p = ecma_get_string_from_value (missing_name);
+  object_p = ecma_get_object_from_value (object);
+
+  /* The generic lookup creates the hashmap of the object and fills the lookup cache. */
+  for (int i = 0; i < BENCH_PROPERTY_COUNT; i++)
+  {
+    TEST_ASSERT (ecma_find_named_property (object_p, names[i]) != NULL);
+  }
+
+  TEST_ASSERT (ecma_find_named_property (object_p, missing_name_p) == NULL);
+
+  printf ("%-44s %s\n", "benchmark", "median / MAD / min in ns");
+
+#ifndef CONFIG_ECMA_LCACHE_DISABLE
+  /* Properties evicted from the lookup cache by the others are not benchmarked. */
+  for (int i = 0; i < BENCH_PROPERTY_COUNT; i++)
+  {
+    if (ecma_lcache_lookup (object_p, names[i]) != NULL)
+    {
+      cached_names[cached_name_count++] = names[i];
+    }
+  }
+
+  TEST_ASSERT (cached_name_count > 0);
+
+  bench_run ("lcache lookup, hit", bench_lcache_hit, cached_name_count);
+  bench_run ("lcache lookup, miss", bench_lcache_miss, 1);
+#endif /* !CONFIG_ECMA_LCACHE_DISABLE */
+
+#ifndef CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE
+  TEST_ASSERT (ECMA_PROPERTY_GET_TYPE (ecma_get_property_list (object_p)->types + 0) == ECMA_PROPERTY_TYPE_HASHMAP);
+
+  bench_run ("hashmap find, hit (64 properties)", bench_hashmap_hit, BENCH_PROPERTY_COUNT);
+  bench_run ("hashmap find, miss (64 properties)", bench_hashmap_miss, 1);
+#endif /* !CONFIG_ECMA_PROPERTY_HASHMAP_DISABLE */
+
+  TEST_ASSERT (found_count > 0);
+
+  jerry_release_value (missing_name);
+
+  for (int i = 0; i < BENCH_PROPERTY_COUNT; i++)
+  {
+    jerry_release_value (name_values[i]);
+  }
+
+  jerry_release_value (object);
+  jerry_cleanup ();
+  return 0;
+} /* main */
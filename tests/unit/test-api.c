@@ -16,6 +16,8 @@
 
 #include "config.h"
 #include "jerry-api.h"
+#include "jerry-heap-image.h"
+#include "jerry-snapshot.h"
 
 #include "test-common.h"
 
@@ -287,6 +289,42 @@ set_property (const jerry_value_t obj_val, /**< object value */
   return ret_val;
 } /* set_property */
 
+/**
+ * Output buffer of the JSON serialization tests
+ */
+static char json_output_buffer[1024];
+
+/**
+ * Number of bytes written into the JSON output buffer
+ */
+static size_t json_output_size = 0;
+
+static void
+json_output (const jerry_char_t *buffer_p, /**< chunk of JSON text */
+             jerry_size_t buffer_size, /**< size of the chunk */
+             void *user_data_p) /**< user data */
+{
+  int *chunk_count_p = (int *) user_data_p;
+  (*chunk_count_p)++;
+
+  TEST_ASSERT (json_output_size + buffer_size <= sizeof (json_output_buffer));
+  memcpy (json_output_buffer + json_output_size, buffer_p, buffer_size);
+  json_output_size += buffer_size;
+} /* json_output */
+
+/**
+ * Number of external string buffers released by the engine
+ */
+static int external_string_free_count = 0;
+
+static void
+external_string_free (const jerry_char_t *string_p, /**< string buffer */
+                      jerry_size_t string_size) /**< string size */
+{
+  TEST_ASSERT (string_p != NULL && string_size > 0);
+  external_string_free_count++;
+} /* external_string_free */
+
 static bool
 test_run_simple (const char *script_p) /**< source code to run */
 {
@@ -697,6 +735,206 @@ main (void)
 
   jerry_release_value (val_t);
 
+  // Test: jerry_json_parse
+  const char *json_src_p = "{\"a\": [1, \"x\\ny\"], \"b\": true}, trailing";
+  obj_val = jerry_json_parse ((const jerry_char_t *) json_src_p, 29);
+  JERRY_ASSERT (!jerry_value_has_error_flag (obj_val));
+  JERRY_ASSERT (jerry_value_is_object (obj_val));
+  val_t = get_property (obj_val, "a");
+  JERRY_ASSERT (jerry_value_is_array (val_t));
+  JERRY_ASSERT (jerry_get_array_length (val_t) == 2);
+  res = jerry_get_property_by_index (val_t, 1);
+  JERRY_ASSERT (jerry_value_is_string (res));
+  sz = jerry_string_to_char_buffer (res, (jerry_char_t *) buffer, sizeof (buffer));
+  JERRY_ASSERT (sz == 3 && !strncmp (buffer, "x\ny", 3));
+  jerry_release_value (res);
+  jerry_release_value (val_t);
+  jerry_release_value (obj_val);
+
+  res = jerry_json_parse ((const jerry_char_t *) json_src_p, 30);
+  JERRY_ASSERT (jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+
+  res = jerry_json_parse ((const jerry_char_t *) json_src_p, 12);
+  JERRY_ASSERT (jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+
+  // Test: jerry_json_stringify
+  int chunk_count = 0;
+  json_output_size = 0;
+  val_p = get_property (global_obj_val, "p");
+  res = jerry_json_stringify (val_p, json_output, &chunk_count);
+  JERRY_ASSERT (!jerry_value_has_error_flag (res));
+  JERRY_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+  jerry_release_value (res);
+  jerry_release_value (val_p);
+  JERRY_ASSERT (chunk_count == 1);
+  const char *json_expected_p = "{\"alpha\":32,\"bravo\":false,\"charlie\":{},\"delta\":123.45,\"echo\":\"foobar\"}";
+  JERRY_ASSERT (json_output_size == strlen (json_expected_p));
+  JERRY_ASSERT (!strncmp (json_output_buffer, json_expected_p, json_output_size));
+
+  const char *json_array_src_p = "var a = []; for (var i = 0; i < 100; i++) a[i] = 'abcdef'; a";
+  obj_val = jerry_eval ((jerry_char_t *) json_array_src_p, strlen (json_array_src_p), false);
+  JERRY_ASSERT (!jerry_value_has_error_flag (obj_val));
+  chunk_count = 0;
+  json_output_size = 0;
+  res = jerry_json_stringify (obj_val, json_output, &chunk_count);
+  JERRY_ASSERT (!jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+  jerry_release_value (obj_val);
+  JERRY_ASSERT (chunk_count > 1);
+  JERRY_ASSERT (json_output_size == 100 * 9 + 1);
+  JERRY_ASSERT (json_output_buffer[0] == '[' && json_output_buffer[json_output_size - 1] == ']');
+
+  chunk_count = 0;
+  val_foo = get_property (global_obj_val, "foo");
+  res = jerry_json_stringify (val_foo, json_output, &chunk_count);
+  JERRY_ASSERT (!jerry_value_has_error_flag (res));
+  JERRY_ASSERT (jerry_value_is_undefined (res));
+  JERRY_ASSERT (chunk_count == 0);
+  jerry_release_value (val_foo);
+
+  obj_val = jerry_eval ((jerry_char_t *) "var c = {}; c.c = c; c", 22, false);
+  JERRY_ASSERT (!jerry_value_has_error_flag (obj_val));
+  res = jerry_json_stringify (obj_val, json_output, &chunk_count);
+  JERRY_ASSERT (jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+  jerry_release_value (obj_val);
+
+  // Test: external strings
+  static const jerry_char_t external_str[] = "external \xc3\xa9 string";
+  const jerry_size_t external_str_size = (jerry_size_t) (sizeof (external_str) - 1);
+
+  val_t = jerry_create_external_string (external_str, external_str_size, external_string_free);
+  JERRY_ASSERT (jerry_value_is_string (val_t));
+  JERRY_ASSERT (jerry_get_string_size (val_t) == external_str_size);
+  JERRY_ASSERT (jerry_get_string_length (val_t) == external_str_size - 1);
+  sz = jerry_string_to_char_buffer (val_t, (jerry_char_t *) buffer, sizeof (buffer));
+  JERRY_ASSERT (sz == external_str_size && !memcmp (buffer, external_str, sz));
+
+  const jerry_char_t *view_p;
+  JERRY_ASSERT (jerry_get_string_view (val_t, &view_p, &sz));
+  JERRY_ASSERT (view_p == external_str && sz == external_str_size);
+
+  res = set_property (global_obj_val, "ext", val_t);
+  JERRY_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+  jerry_release_value (res);
+  jerry_release_value (val_t);
+
+  const char *external_test_p = ("ext + '!' === 'external \u00e9 string!' && ext.length === 17 "
+                                 "&& ext.indexOf ('string') === 11 && ext.charAt (9) === '\u00e9' "
+                                 "&& ({ 'external \u00e9 string': true })[ext] && ext > 'extern' && ext < 'f'");
+  res = jerry_eval ((const jerry_char_t *) external_test_p, strlen (external_test_p), false);
+  JERRY_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+  jerry_release_value (res);
+  JERRY_ASSERT (external_string_free_count == 0);
+
+  val_t = jerry_create_string ((const jerry_char_t *) "ext");
+  JERRY_ASSERT (jerry_delete_property (global_obj_val, val_t));
+  jerry_release_value (val_t);
+  /* String wrapper objects created by the method calls also refer to the string. */
+  jerry_gc ();
+  JERRY_ASSERT (external_string_free_count == 1);
+
+  val_t = jerry_create_external_string ((const jerry_char_t *) "12345", 5, external_string_free);
+  val_p = jerry_create_array (1);
+  res = jerry_set_property (val_p, val_t, val_t);
+  JERRY_ASSERT (!jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+  jerry_release_value (val_t);
+  res = get_property (val_p, "length");
+  JERRY_ASSERT (jerry_value_is_number (res) && jerry_get_number_value (res) == 12346.0);
+  jerry_release_value (res);
+  jerry_release_value (val_p);
+  jerry_gc ();
+  JERRY_ASSERT (external_string_free_count == 2);
+
+  /* Magic strings are not stored externally. */
+  val_t = jerry_create_external_string ((const jerry_char_t *) "length", 6, external_string_free);
+  JERRY_ASSERT (external_string_free_count == 3);
+  JERRY_ASSERT (jerry_get_string_size (val_t) == 6);
+  jerry_release_value (val_t);
+
+  // Test: string views
+  val_t = jerry_create_string ((const jerry_char_t *) "view \xc3\xa9");
+  JERRY_ASSERT (jerry_get_string_view (val_t, &view_p, &sz));
+  JERRY_ASSERT (sz == 7 && !memcmp (view_p, "view \xc3\xa9", 7));
+  jerry_release_value (val_t);
+
+  val_t = jerry_create_string ((const jerry_char_t *) "prototype");
+  JERRY_ASSERT (jerry_get_string_view (val_t, &view_p, &sz));
+  JERRY_ASSERT (sz == 9 && !memcmp (view_p, "prototype", 9));
+  jerry_release_value (val_t);
+
+  val_t = jerry_eval ((const jerry_char_t *) "String (42)", 11, false);
+  JERRY_ASSERT (jerry_value_is_string (val_t));
+  JERRY_ASSERT (!jerry_get_string_view (val_t, &view_p, &sz));
+  JERRY_ASSERT (view_p == NULL && sz == 0);
+  jerry_release_value (val_t);
+
+  val_t = jerry_create_number (42.0);
+  JERRY_ASSERT (!jerry_get_string_view (val_t, &view_p, &sz));
+  jerry_release_value (val_t);
+
+  // Test: batched property functions
+  jerry_value_t batch_names[3], batch_values[3];
+  batch_names[0] = jerry_create_string ((const jerry_char_t *) "x");
+  batch_names[1] = jerry_create_string ((const jerry_char_t *) "y");
+  batch_names[2] = jerry_create_string ((const jerry_char_t *) "x");
+  batch_values[0] = jerry_create_number (1.0);
+  batch_values[1] = jerry_create_string ((const jerry_char_t *) "two");
+  batch_values[2] = jerry_create_number (3.0);
+
+  obj_val = jerry_create_object_with_properties (batch_names, batch_values, 3);
+  JERRY_ASSERT (jerry_value_is_object (obj_val));
+  res = get_property (obj_val, "x");
+  JERRY_ASSERT (jerry_value_is_number (res) && jerry_get_number_value (res) == 3.0);
+  jerry_release_value (res);
+  jerry_release_value (batch_values[1]);
+
+  batch_values[1] = jerry_create_number (4.0);
+  res = jerry_set_properties (obj_val, batch_names + 1, batch_values + 1, 2);
+  JERRY_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+  jerry_release_value (res);
+
+  for (int i = 0; i < 3; i++)
+  {
+    jerry_release_value (batch_values[i]);
+  }
+
+  res = jerry_get_properties (obj_val, batch_names, batch_values, 2);
+  JERRY_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+  JERRY_ASSERT (jerry_value_is_number (batch_values[0]) && jerry_get_number_value (batch_values[0]) == 3.0);
+  JERRY_ASSERT (jerry_value_is_number (batch_values[1]) && jerry_get_number_value (batch_values[1]) == 4.0);
+  jerry_release_value (res);
+  jerry_release_value (batch_values[0]);
+  jerry_release_value (batch_values[1]);
+
+  jerry_release_value (obj_val);
+
+  obj_val = jerry_eval ((const jerry_char_t *) "({ get y () { throw 5; } })", 27, false);
+  JERRY_ASSERT (jerry_value_is_object (obj_val));
+  res = jerry_get_properties (obj_val, batch_names, batch_values, 2);
+  JERRY_ASSERT (jerry_value_has_error_flag (res));
+  JERRY_ASSERT (jerry_value_is_undefined (batch_values[0]) && jerry_value_is_undefined (batch_values[1]));
+  jerry_release_value (res);
+
+  val_t = jerry_create_number (1.0);
+  res = jerry_get_properties (val_t, batch_names, batch_values, 2);
+  JERRY_ASSERT (jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+  jerry_release_value (val_t);
+
+  res = jerry_create_object_with_properties (batch_values, batch_names, 1);
+  JERRY_ASSERT (jerry_value_has_error_flag (res));
+  jerry_release_value (res);
+  jerry_release_value (obj_val);
+
+  for (int i = 0; i < 3; i++)
+  {
+    jerry_release_value (batch_names[i]);
+  }
+
   // cleanup.
   jerry_release_value (global_obj_val);
 
@@ -724,6 +962,50 @@ main (void)
   jerry_release_value (res);
   jerry_release_value (parsed_code_val);
 
+  // Reset the engine
+  const char *reset_test_p = ("var user_value = 5; Math.max = null; Object.prototype.extra = 1;"
+                              "typeof user_value === 'number' && Math.max === null && ({}).extra === 1");
+  res = jerry_eval ((const jerry_char_t *) reset_test_p, strlen (reset_test_p), false);
+  JERRY_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+  jerry_release_value (res);
+
+  /* A value which is not released by the host is dropped by the reset. */
+  val_t = jerry_create_object ();
+
+  JERRY_ASSERT (jerry_reset (JERRY_INIT_EMPTY));
+
+  reset_test_p = ("typeof user_value === 'undefined' && typeof Math.max === 'function'"
+                  "&& ({}).extra === undefined && Math.max (3, 4) === 4");
+  res = jerry_eval ((const jerry_char_t *) reset_test_p, strlen (reset_test_p), false);
+  JERRY_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+  jerry_release_value (res);
+
+  /* The external magic strings are kept. */
+  parsed_code_val = jerry_parse ((jerry_char_t *) ms_code_src_p, strlen (ms_code_src_p), false);
+  JERRY_ASSERT (!jerry_value_has_error_flag (parsed_code_val));
+  jerry_release_value (parsed_code_val);
+
+  /* The free callbacks of released external strings and native handles are called. */
+  external_string_free_count = 0;
+  test_api_is_free_callback_was_called = false;
+
+  global_obj_val = jerry_get_global_object ();
+  val_t = jerry_create_external_string (external_str, external_str_size, external_string_free);
+  res = set_property (global_obj_val, "ext", val_t);
+  jerry_release_value (res);
+  jerry_release_value (val_t);
+
+  val_t = jerry_create_object ();
+  jerry_set_object_native_handle (val_t, (uintptr_t) 0x0012345678abcdefull, handler_construct_freecb);
+  res = set_property (global_obj_val, "native", val_t);
+  jerry_release_value (res);
+  jerry_release_value (val_t);
+  jerry_release_value (global_obj_val);
+
+  JERRY_ASSERT (jerry_reset (JERRY_INIT_EMPTY));
+  JERRY_ASSERT (external_string_free_count == 1);
+  JERRY_ASSERT (test_api_is_free_callback_was_called);
+
   jerry_cleanup ();
 
   // Dump / execute snapshot
@@ -783,6 +1065,330 @@ main (void)
     TEST_ASSERT (!strncmp (buffer, "string from snapshot", (size_t) sz));
 
     jerry_cleanup ();
+
+    /* Long string literals are used in place from a snapshot which is not copied. */
+    const char *long_literal_p = "'a string literal which is long enough to be used in place'";
+    const jerry_char_t *view_p;
+
+    jerry_init (JERRY_INIT_EMPTY);
+    global_mode_snapshot_size = jerry_parse_and_save_snapshot ((jerry_char_t *) long_literal_p,
+                                                               strlen (long_literal_p),
+                                                               true,
+                                                               false,
+                                                               global_mode_snapshot_buffer,
+                                                               sizeof (global_mode_snapshot_buffer));
+    TEST_ASSERT (global_mode_snapshot_size != 0);
+    jerry_cleanup ();
+
+    jerry_init (JERRY_INIT_EMPTY);
+    res = jerry_exec_snapshot (global_mode_snapshot_buffer, global_mode_snapshot_size, false);
+    TEST_ASSERT (jerry_get_string_view (res, &view_p, &sz));
+    TEST_ASSERT (sz == strlen (long_literal_p) - 2);
+    TEST_ASSERT (view_p > global_mode_snapshot_buffer
+                 && view_p + sz <= global_mode_snapshot_buffer + global_mode_snapshot_size);
+    jerry_release_value (res);
+
+    res = jerry_exec_snapshot (global_mode_snapshot_buffer, global_mode_snapshot_size, true);
+    TEST_ASSERT (jerry_get_string_view (res, &view_p, &sz));
+    TEST_ASSERT (view_p > global_mode_snapshot_buffer
+                 && view_p + sz <= global_mode_snapshot_buffer + global_mode_snapshot_size);
+    jerry_release_value (res);
+    jerry_cleanup ();
+
+    jerry_init (JERRY_INIT_EMPTY);
+    res = jerry_exec_snapshot (global_mode_snapshot_buffer, global_mode_snapshot_size, true);
+    TEST_ASSERT (jerry_get_string_view (res, &view_p, &sz));
+    TEST_ASSERT (view_p < global_mode_snapshot_buffer
+                 || view_p >= global_mode_snapshot_buffer + global_mode_snapshot_size);
+    jerry_release_value (res);
+    jerry_cleanup ();
+
+    /* Merged snapshots share their literals and identical functions. */
+    static uint8_t merged_snapshot_buffer[1024];
+    const char *module_a_p = "var module_name = 'module a'; function twice (x) { return x * 2; } twice (1)";
+    const char *module_b_p = "function twice (x) { return x * 2; } module_name + twice (2)";
+
+    jerry_init (JERRY_INIT_EMPTY);
+    global_mode_snapshot_size = jerry_parse_and_save_snapshot ((jerry_char_t *) module_a_p,
+                                                               strlen (module_a_p),
+                                                               true,
+                                                               false,
+                                                               global_mode_snapshot_buffer,
+                                                               sizeof (global_mode_snapshot_buffer));
+    TEST_ASSERT (global_mode_snapshot_size != 0);
+    jerry_cleanup ();
+
+    jerry_init (JERRY_INIT_EMPTY);
+    eval_mode_snapshot_size = jerry_parse_and_save_snapshot ((jerry_char_t *) module_b_p,
+                                                             strlen (module_b_p),
+                                                             false,
+                                                             false,
+                                                             eval_mode_snapshot_buffer,
+                                                             sizeof (eval_mode_snapshot_buffer));
+    TEST_ASSERT (eval_mode_snapshot_size != 0);
+    jerry_cleanup ();
+
+    const void *snapshots[2] = { global_mode_snapshot_buffer, eval_mode_snapshot_buffer };
+    size_t snapshot_sizes[2] = { global_mode_snapshot_size, eval_mode_snapshot_size };
+
+    jerry_init (JERRY_INIT_EMPTY);
+    size_t merged_snapshot_size = jerry_merge_snapshots (snapshots,
+                                                         snapshot_sizes,
+                                                         2,
+                                                         merged_snapshot_buffer,
+                                                         sizeof (merged_snapshot_buffer));
+    TEST_ASSERT (merged_snapshot_size != 0);
+    TEST_ASSERT (merged_snapshot_size < global_mode_snapshot_size + eval_mode_snapshot_size);
+    jerry_cleanup ();
+
+    jerry_init (JERRY_INIT_EMPTY);
+    res = jerry_exec_snapshot (merged_snapshot_buffer, merged_snapshot_size, false);
+    sz = jerry_string_to_char_buffer (res, (jerry_char_t *) buffer, sizeof (buffer));
+    TEST_ASSERT (sz == 9 && !strncmp (buffer, "module a4", (size_t) sz));
+    jerry_release_value (res);
+
+    res = jerry_exec_snapshot_at (merged_snapshot_buffer, merged_snapshot_size, 0, true);
+    TEST_ASSERT (jerry_value_is_number (res) && jerry_get_number_value (res) == 2);
+    jerry_release_value (res);
+
+    res = jerry_exec_snapshot_at (merged_snapshot_buffer, merged_snapshot_size, 2, true);
+    TEST_ASSERT (jerry_value_has_error_flag (res));
+    jerry_release_value (res);
+    jerry_cleanup ();
+
+    /* The number of functions is checked before the size of the offset table is computed. */
+    const size_t number_of_funcs_pos = offsetof (jerry_snapshot_header_t, number_of_funcs);
+    uint32_t number_of_funcs;
+    memcpy (&number_of_funcs, merged_snapshot_buffer + number_of_funcs_pos, sizeof (uint32_t));
+
+    const uint32_t overflowing_number_of_funcs = (uint32_t) ((UINT32_MAX / sizeof (uint32_t)) + 2);
+    memcpy (merged_snapshot_buffer + number_of_funcs_pos, &overflowing_number_of_funcs, sizeof (uint32_t));
+
+    jerry_init (JERRY_INIT_EMPTY);
+    res = jerry_exec_snapshot (merged_snapshot_buffer, merged_snapshot_size, false);
+    TEST_ASSERT (jerry_value_has_error_flag (res));
+    jerry_release_value (res);
+    jerry_cleanup ();
+
+    memcpy (merged_snapshot_buffer + number_of_funcs_pos, &number_of_funcs, sizeof (uint32_t));
+
+    /* Optimized snapshots are smaller, and they produce the same results. */
+    const char *constant_code_p = ("var DEBUG = false;"
+                                   "function scale (v) { var unused = 1; if (DEBUG || !true) { v = 0; }"
+                                   "  return v * (60 * 60 * 24) + ('a' + 'b').length + (-(5) | 0); }"
+                                   "scale (2) + (1 < 2 ? 1 : 0);");
+
+    jerry_init (JERRY_INIT_EMPTY);
+    global_mode_snapshot_size = jerry_parse_and_save_snapshot ((jerry_char_t *) constant_code_p,
+                                                               strlen (constant_code_p),
+                                                               true,
+                                                               false,
+                                                               global_mode_snapshot_buffer,
+                                                               sizeof (global_mode_snapshot_buffer));
+    TEST_ASSERT (global_mode_snapshot_size != 0);
+    jerry_cleanup ();
+
+    jerry_init (JERRY_INIT_OPTIMIZE_SNAPSHOT);
+    size_t optimized_snapshot_size = jerry_parse_and_save_snapshot ((jerry_char_t *) constant_code_p,
+                                                                    strlen (constant_code_p),
+                                                                    true,
+                                                                    false,
+                                                                    merged_snapshot_buffer,
+                                                                    sizeof (merged_snapshot_buffer));
+    TEST_ASSERT (optimized_snapshot_size != 0 && optimized_snapshot_size < global_mode_snapshot_size);
+    jerry_cleanup ();
+
+    for (int i = 0; i < 2; i++)
+    {
+      jerry_init (JERRY_INIT_EMPTY);
+      res = jerry_exec_snapshot (i == 0 ? global_mode_snapshot_buffer : merged_snapshot_buffer,
+                                 i == 0 ? global_mode_snapshot_size : optimized_snapshot_size,
+                                 false);
+      TEST_ASSERT (jerry_value_is_number (res) && jerry_get_number_value (res) == 172800 + 2 - 5 + 1);
+      jerry_release_value (res);
+      jerry_cleanup ();
+    }
+
+    /* The nested functions of a snapshot which is not copied are loaded on their first call. */
+    const char *library_code_p = ("function fact (n) { return n <= 1 ? 1 : n * fact (n - 1); }"
+                                  "function Point (x, y) { 'use strict'; this.x = x; this.y = y; }"
+                                  "function counter () { var c = 0; return function () { return ++c; }; }"
+                                  "var unused = function (a, b, c) { return /a+/.test (a); };"
+                                  "var next = counter (); next ();"
+                                  "unused.length === 3 && fact (5) === 120 && fact.length === 1"
+                                  "&& new Point (1, 2).y === 2 && next () === 2 && counter () () === 1");
+
+    jerry_init (JERRY_INIT_EMPTY);
+    global_mode_snapshot_size = jerry_parse_and_save_snapshot ((jerry_char_t *) library_code_p,
+                                                               strlen (library_code_p),
+                                                               true,
+                                                               false,
+                                                               global_mode_snapshot_buffer,
+                                                               sizeof (global_mode_snapshot_buffer));
+    TEST_ASSERT (global_mode_snapshot_size != 0);
+    jerry_cleanup ();
+
+    for (int i = 0; i < 2; i++)
+    {
+      jerry_init (JERRY_INIT_EMPTY);
+      res = jerry_exec_snapshot (global_mode_snapshot_buffer, global_mode_snapshot_size, i == 0);
+      TEST_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+      jerry_release_value (res);
+
+      /* The snapshot functions are still usable after the snapshot is executed again. */
+      res = jerry_exec_snapshot (global_mode_snapshot_buffer, global_mode_snapshot_size, i == 0);
+      TEST_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+      jerry_release_value (res);
+      jerry_cleanup ();
+    }
+  }
+
+  // Save / load heap image
+  {
+    static uint8_t heap_image_buffer[65536];
+    const char *bootstrap_src_p = ("var counter = 40;"
+                                   "function next () { return ++counter; }"
+                                   "var obj = { name: 'heap image' };"
+                                   "var re = /a+b/;");
+    const char *check_src_p = "next () === 41 && obj.name === 'heap image' && re.test ('xaab')";
+
+    jerry_init (JERRY_INIT_EMPTY);
+    res = jerry_eval ((jerry_char_t *) bootstrap_src_p, strlen (bootstrap_src_p), false);
+    TEST_ASSERT (!jerry_value_has_error_flag (res));
+    jerry_release_value (res);
+
+    TEST_ASSERT (jerry_save_heap_image (heap_image_buffer, 16) == 0);
+
+    size_t heap_image_size = jerry_save_heap_image (heap_image_buffer, sizeof (heap_image_buffer));
+    TEST_ASSERT (heap_image_size != 0 && heap_image_size <= sizeof (heap_image_buffer));
+
+    /* The engine is still usable after saving. */
+    res = jerry_eval ((jerry_char_t *) check_src_p, strlen (check_src_p), false);
+    TEST_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+    jerry_release_value (res);
+    jerry_cleanup ();
+
+    for (int i = 0; i < 2; i++)
+    {
+      TEST_ASSERT (jerry_load_heap_image (JERRY_INIT_EMPTY, heap_image_buffer, heap_image_size));
+      res = jerry_eval ((jerry_char_t *) check_src_p, strlen (check_src_p), false);
+      TEST_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+      jerry_release_value (res);
+      jerry_cleanup ();
+    }
+
+    TEST_ASSERT (!jerry_load_heap_image (JERRY_INIT_EMPTY, heap_image_buffer, 8));
+    TEST_ASSERT (!jerry_load_heap_image (JERRY_INIT_EMPTY, heap_image_buffer, heap_image_size - 8));
+
+    heap_image_buffer[0] ^= 0xff;
+    TEST_ASSERT (!jerry_load_heap_image (JERRY_INIT_EMPTY, heap_image_buffer, heap_image_size));
+    heap_image_buffer[0] ^= 0xff;
+
+    /* The free region list of the image is validated. */
+    const size_t first_free_offset_pos = offsetof (jerry_heap_image_header_t, jmem.first_free_offset);
+    uint32_t first_free_offset;
+    memcpy (&first_free_offset, heap_image_buffer + first_free_offset_pos, sizeof (uint32_t));
+    TEST_ASSERT (first_free_offset != UINT32_MAX);
+
+    const uint32_t invalid_offsets[] = { first_free_offset + 1, (uint32_t) heap_image_size, UINT32_MAX - 8 };
+
+    for (size_t i = 0; i < sizeof (invalid_offsets) / sizeof (invalid_offsets[0]); i++)
+    {
+      memcpy (heap_image_buffer + first_free_offset_pos, invalid_offsets + i, sizeof (uint32_t));
+      TEST_ASSERT (!jerry_load_heap_image (JERRY_INIT_EMPTY, heap_image_buffer, heap_image_size));
+    }
+
+    memcpy (heap_image_buffer + first_free_offset_pos, &first_free_offset, sizeof (uint32_t));
+    TEST_ASSERT (jerry_load_heap_image (JERRY_INIT_EMPTY, heap_image_buffer, heap_image_size));
+    jerry_cleanup ();
+  }
+
+  // Lazy function compilation
+  {
+    const char *lazy_src_p = ("function add (a, b) { return a + b; }"
+                              "function broken () { return (1 + ); }"
+                              "var closures = [];"
+                              "for (var i = 0; i < 3; i++) {"
+                              "  closures.push (function (x) { return x + i; });"
+                              "}");
+    const char *check_src_p = ("add.length === 2 && add (1, 2) === 3"
+                               "&& closures[0].length === 1 && closures[0] (1) === 4 && closures[2] (2) === 5");
+    const char *broken_src_p = "broken ()";
+
+    jerry_init (JERRY_INIT_LAZY_FUNCTIONS);
+
+    /* The syntax error in the body of broken () is only reported when it is called. */
+    parsed_code_val = jerry_parse ((jerry_char_t *) lazy_src_p, strlen (lazy_src_p), false);
+    TEST_ASSERT (!jerry_value_has_error_flag (parsed_code_val));
+
+    res = jerry_run (parsed_code_val);
+    TEST_ASSERT (!jerry_value_has_error_flag (res));
+    jerry_release_value (res);
+    jerry_release_value (parsed_code_val);
+
+    res = jerry_eval ((jerry_char_t *) check_src_p, strlen (check_src_p), false);
+    TEST_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+    jerry_release_value (res);
+
+    for (int i = 0; i < 2; i++)
+    {
+      res = jerry_eval ((jerry_char_t *) broken_src_p, strlen (broken_src_p), false);
+      TEST_ASSERT (jerry_value_has_error_flag (res));
+      jerry_release_value (res);
+    }
+
+    jerry_cleanup ();
+  }
+
+  // Compiled code cache
+  {
+    const char *counter_src_p = "var counter = (typeof counter === 'number') ? counter + 1 : 1; counter";
+    const char *this_src_p = "(function () { return this === undefined; }) ()";
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+    jerry_code_cache_stats_t stats;
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
+    jerry_init (JERRY_INIT_EMPTY);
+
+    for (int i = 1; i <= 3; i++)
+    {
+      res = jerry_eval ((jerry_char_t *) counter_src_p, strlen (counter_src_p), false);
+      TEST_ASSERT (jerry_value_is_number (res) && jerry_get_number_value (res) == i);
+      jerry_release_value (res);
+    }
+
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+    jerry_get_code_cache_stats (&stats);
+    TEST_ASSERT (stats.misses == 1 && stats.hits == 2);
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
+    /* Strict and non-strict code is cached separately. */
+    res = jerry_eval ((jerry_char_t *) this_src_p, strlen (this_src_p), false);
+    TEST_ASSERT (jerry_value_is_boolean (res) && !jerry_get_boolean_value (res));
+    jerry_release_value (res);
+
+    parsed_code_val = jerry_parse ((jerry_char_t *) this_src_p, strlen (this_src_p), true);
+    TEST_ASSERT (!jerry_value_has_error_flag (parsed_code_val));
+
+    res = jerry_run (parsed_code_val);
+    TEST_ASSERT (jerry_value_is_boolean (res) && jerry_get_boolean_value (res));
+    jerry_release_value (res);
+    jerry_release_value (parsed_code_val);
+
+    parsed_code_val = jerry_parse ((jerry_char_t *) counter_src_p, strlen (counter_src_p), false);
+    TEST_ASSERT (!jerry_value_has_error_flag (parsed_code_val));
+
+    res = jerry_run (parsed_code_val);
+    TEST_ASSERT (jerry_value_is_number (res) && jerry_get_number_value (res) == 4);
+    jerry_release_value (res);
+    jerry_release_value (parsed_code_val);
+
+#ifndef CONFIG_PARSER_CODE_CACHE_DISABLE
+    jerry_get_code_cache_stats (&stats);
+    TEST_ASSERT (stats.misses == 3 && stats.hits == 3 && stats.evictions == 0);
+#endif /* !CONFIG_PARSER_CODE_CACHE_DISABLE */
+
+    jerry_cleanup ();
   }
 
   return 0;
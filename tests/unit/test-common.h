@@ -69,4 +69,20 @@ do \
   srand (seed); \
 } while (0)
 
+/**
+ * Parse and run a script, neither of which may throw an error.
+ */
+#define TEST_RUN_SCRIPT(source_p) \
+do \
+{ \
+  jerry_value_t test_func_val = jerry_parse ((const jerry_char_t *) (source_p), strlen (source_p), false); \
+  TEST_ASSERT (!jerry_value_has_error_flag (test_func_val)); \
+ \
+  jerry_value_t test_result_val = jerry_run (test_func_val); \
+  TEST_ASSERT (!jerry_value_has_error_flag (test_result_val)); \
+ \
+  jerry_release_value (test_result_val); \
+  jerry_release_value (test_func_val); \
+} while (0)
+
 #endif /* TEST_COMMON_H */
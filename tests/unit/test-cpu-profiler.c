@@ -0,0 +1,187 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jcontext.h"
+#include "jerry-api.h"
+#include "vm-profiler.h"
+
+#include "test-common.h"
+
+/**
+ * Script whose functions take samples with the native 'sample' function
+ */
+static const char *test_source_p = ("function outer () {\n"
+                                    "  return inner ();\n"
+                                    "}\n"
+                                    "function inner () {\n"
+                                    "  sample ();\n"
+                                    "  return 1;\n"
+                                    "}\n"
+                                    "var f = function () {\n"
+                                    "  sample ();\n"
+                                    "};\n"
+                                    "outer ();\n"
+                                    "outer (); outer ();\n"
+                                    "f ();\n"
+                                    "({ get value () { sample (); } }).value;\n"
+                                    "sample ();\n");
+
+#ifdef JERRY_CPU_PROFILER
+
+/**
+ * Expected profile of the script
+ */
+static const char *test_profile_p = ("(program):11;outer:2;inner:5 1\n"
+                                     "(program):12;outer:2;inner:5 2\n"
+                                     "(program):13;(anonymous):9 1\n"
+                                     "(program):14;value:14 1\n"
+                                     "(program):15 1\n");
+
+/**
+ * Number of the samples taken by the script
+ */
+#define TEST_SAMPLE_COUNT 6
+
+/**
+ * Expected depth and currently executed line of the innermost frame of each sample
+ */
+static const uint32_t test_samples[TEST_SAMPLE_COUNT][2] =
+{
+  { 3, 5 }, { 3, 5 }, { 3, 5 }, { 2, 9 }, { 2, 14 }, { 1, 15 }
+};
+
+/**
+ * Check the samples stored in the sample buffer of the profiler.
+ */
+static void
+check_samples (void)
+{
+  uint32_t index = JERRY_CPU_PROFILER_CONTEXT (read_index);
+  uint32_t mask = JERRY_CPU_PROFILER_BUFFER_SIZE - 1;
+
+  TEST_ASSERT (JERRY_CPU_PROFILER_CONTEXT (dropped_samples) == 0);
+
+  for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; i++)
+  {
+    TEST_ASSERT (index != JERRY_CPU_PROFILER_CONTEXT (write_index));
+
+    uint32_t depth = JERRY_CPU_PROFILER_CONTEXT (buffer)[index & mask];
+    TEST_ASSERT (depth == test_samples[i][0]);
+
+    /* The innermost frame follows the depth, and the current line is its last word. */
+    TEST_ASSERT (JERRY_CPU_PROFILER_CONTEXT (buffer)[(index + VM_PROFILER_FRAME_SIZE) & mask] == test_samples[i][1]);
+
+    index += 1 + depth * VM_PROFILER_FRAME_SIZE;
+  }
+
+  TEST_ASSERT (index == JERRY_CPU_PROFILER_CONTEXT (write_index));
+} /* check_samples */
+
+#endif /* JERRY_CPU_PROFILER */
+
+/**
+ * Take a sample of the JavaScript call stack.
+ *
+ * @return undefined
+ */
+static jerry_value_t
+sample_handler (const jerry_value_t func_obj_val, /**< function object */
+                const jerry_value_t this_val, /**< this value */
+                const jerry_value_t args_p[], /**< arguments list */
+                const jerry_length_t args_cnt) /**< arguments length */
+{
+  (void) func_obj_val;
+  (void) this_val;
+  (void) args_p;
+  (void) args_cnt;
+
+  jerry_profiler_sample ();
+  return jerry_create_undefined ();
+} /* sample_handler */
+
+/**
+ * Register the native 'sample' function.
+ */
+static void
+register_sample_function (void)
+{
+  jerry_value_t global_obj_val = jerry_get_global_object ();
+  jerry_value_t function_val = jerry_create_external_function (sample_handler);
+  jerry_value_t name_val = jerry_create_string ((const jerry_char_t *) "sample");
+
+  jerry_value_t result_val = jerry_set_property (global_obj_val, name_val, function_val);
+  TEST_ASSERT (!jerry_value_has_error_flag (result_val));
+
+  jerry_release_value (result_val);
+  jerry_release_value (name_val);
+  jerry_release_value (function_val);
+  jerry_release_value (global_obj_val);
+} /* register_sample_function */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  static jerry_char_t profile[1024];
+
+  jerry_init (JERRY_INIT_EMPTY);
+  register_sample_function ();
+
+#ifdef JERRY_CPU_PROFILER
+  size_t profile_size = strlen (test_profile_p);
+
+  /* No samples are taken while the profiler is stopped. */
+  TEST_RUN_SCRIPT (test_source_p);
+  TEST_ASSERT (JERRY_CPU_PROFILER_CONTEXT (write_index) == JERRY_CPU_PROFILER_CONTEXT (read_index));
+  TEST_ASSERT (jerry_profiler_dump (profile, sizeof (profile)) == 0);
+
+  TEST_ASSERT (jerry_profiler_start ());
+  TEST_RUN_SCRIPT (test_source_p);
+  jerry_profiler_stop ();
+  check_samples ();
+
+  /* The samples are kept if the buffer is too small. */
+  TEST_ASSERT (jerry_profiler_dump (profile, profile_size - 1) == 0);
+  check_samples ();
+
+  TEST_ASSERT (jerry_profiler_dump (profile, sizeof (profile)) == profile_size);
+  TEST_ASSERT (memcmp (profile, test_profile_p, profile_size) == 0);
+
+  /* The dumped samples are removed. */
+  TEST_ASSERT (JERRY_CPU_PROFILER_CONTEXT (write_index) == JERRY_CPU_PROFILER_CONTEXT (read_index));
+  TEST_ASSERT (jerry_profiler_dump (profile, sizeof (profile)) == 0);
+
+  /* The names of lazy functions are kept until they are compiled. */
+  TEST_ASSERT (jerry_reset (JERRY_INIT_LAZY_FUNCTIONS));
+  register_sample_function ();
+
+  TEST_ASSERT (jerry_profiler_start ());
+  TEST_RUN_SCRIPT (test_source_p);
+  jerry_profiler_stop ();
+  check_samples ();
+
+  TEST_ASSERT (jerry_profiler_dump (profile, sizeof (profile)) == profile_size);
+  TEST_ASSERT (memcmp (profile, test_profile_p, profile_size) == 0);
+#else /* !JERRY_CPU_PROFILER */
+  TEST_ASSERT (!jerry_profiler_start ());
+  TEST_RUN_SCRIPT (test_source_p);
+  jerry_profiler_stop ();
+  TEST_ASSERT (jerry_profiler_dump (profile, sizeof (profile)) == 0);
+#endif /* JERRY_CPU_PROFILER */
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
@@ -0,0 +1,376 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ecma-helpers.h"
+#include "jerry-api.h"
+
+#include "test-common.h"
+
+/**
+ * Script which builds a small object graph
+ */
+static const char *test_source_p = ("var holder = { payload: { text: 'first' + ' line' } };\n"
+                                    "holder.payload.self = holder;\n"
+                                    "holder['odd\\\\\\nname'] = 1;\n"
+                                    "Object.defineProperty (holder, 'accessor',\n"
+                                    "                       { get: function () { return 1; } });\n");
+
+/**
+ * Maximum number of lines of the heap dump
+ */
+#define MAX_DUMP_LINES 4096
+
+/**
+ * Line of the heap dump
+ */
+typedef struct
+{
+  char type; /**< 'O' for an object, 'E' for a reference to an object, 'S' for a reference to a string */
+  uint32_t id; /**< identifier of the object, or of the referencing object */
+  uint32_t target_id; /**< identifier of the referenced object or string (0 for an object) */
+  uint32_t size; /**< size of the object or of the referenced string (0 for a reference to an object) */
+  uint32_t ref_count; /**< reference counter of the object (0 for a reference) */
+  const char *kind_p; /**< type of the object, or kind of the reference */
+  size_t kind_size; /**< size of the type or the kind */
+  const char *name_p; /**< escaped name of the property (NULL if there is no name) */
+  size_t name_size; /**< size of the name */
+} dump_line_t;
+
+/**
+ * Collected heap dump
+ */
+static char dump[64 * 1024];
+
+/**
+ * Size of the collected heap dump
+ */
+static size_t dump_size = 0;
+
+/**
+ * Number of the chunks passed to the callback
+ */
+static int dump_chunks = 0;
+
+/**
+ * Parsed lines of the heap dump
+ */
+static dump_line_t dump_lines[MAX_DUMP_LINES];
+
+/**
+ * Number of the parsed lines
+ */
+static uint32_t dump_line_count = 0;
+
+/**
+ * Collect the chunks of the heap dump.
+ */
+static void
+collect_dump (const jerry_char_t *buffer_p, /**< chunk of the heap dump */
+              jerry_size_t buffer_size, /**< size of the chunk */
+              void *user_data_p) /**< user data */
+{
+  TEST_ASSERT (user_data_p == (void *) &dump_size);
+  TEST_ASSERT (buffer_size > 0);
+  TEST_ASSERT (dump_size + buffer_size < sizeof (dump));
+
+  memcpy (dump + dump_size, buffer_p, buffer_size);
+  dump_size += buffer_size;
+  dump_chunks++;
+} /* collect_dump */
+
+/**
+ * Parse a field of a dump line, which is preceded by a space.
+ *
+ * @return position after the field
+ */
+static const char *
+parse_field (const char *position_p, /**< position of the space before the field */
+             const char **field_p, /**< [out] start of the field */
+             size_t *field_size_p) /**< [out] size of the field */
+{
+  TEST_ASSERT (*position_p == ' ');
+  position_p++;
+
+  *field_p = position_p;
+
+  while (*position_p != ' ' && *position_p != '\n')
+  {
+    TEST_ASSERT (*position_p != '\0');
+    position_p++;
+  }
+
+  *field_size_p = (size_t) (position_p - *field_p);
+  TEST_ASSERT (*field_size_p > 0);
+  return position_p;
+} /* parse_field */
+
+/**
+ * Parse a numeric field of a dump line, which is preceded by a space.
+ *
+ * @return position after the field
+ */
+static const char *
+parse_number (const char *position_p, /**< position of the space before the field */
+              uint32_t *number_p) /**< [out] value of the field */
+{
+  const char *field_p;
+  size_t field_size;
+
+  position_p = parse_field (position_p, &field_p, &field_size);
+  *number_p = 0;
+
+  for (size_t i = 0; i < field_size; i++)
+  {
+    TEST_ASSERT (field_p[i] >= '0' && field_p[i] <= '9');
+    *number_p = *number_p * 10 + (uint32_t) (field_p[i] - '0');
+  }
+
+  return position_p;
+} /* parse_number */
+
+/**
+ * Parse the collected heap dump into dump_lines.
+ */
+static void
+parse_dump (void)
+{
+  const char *header_p = "# jerry-heap-dump 1\n";
+  TEST_ASSERT (memcmp (dump, header_p, strlen (header_p)) == 0);
+
+  const char *position_p = dump + strlen (header_p);
+
+  while (*position_p != '\0')
+  {
+    TEST_ASSERT (dump_line_count < MAX_DUMP_LINES);
+
+    dump_line_t *line_p = dump_lines + dump_line_count++;
+    memset (line_p, 0, sizeof (dump_line_t));
+
+    line_p->type = *position_p++;
+    position_p = parse_number (position_p, &line_p->id);
+
+    switch (line_p->type)
+    {
+      case 'O':
+      {
+        position_p = parse_field (position_p, &line_p->kind_p, &line_p->kind_size);
+        position_p = parse_number (position_p, &line_p->size);
+        position_p = parse_number (position_p, &line_p->ref_count);
+        break;
+      }
+      case 'E':
+      {
+        position_p = parse_number (position_p, &line_p->target_id);
+        position_p = parse_field (position_p, &line_p->kind_p, &line_p->kind_size);
+        break;
+      }
+      default:
+      {
+        TEST_ASSERT (line_p->type == 'S');
+
+        position_p = parse_number (position_p, &line_p->target_id);
+        position_p = parse_number (position_p, &line_p->size);
+        position_p = parse_field (position_p, &line_p->kind_p, &line_p->kind_size);
+        break;
+      }
+    }
+
+    if (*position_p == ' ')
+    {
+      /* The name is the rest of the line, since it may contain spaces. */
+      line_p->name_p = ++position_p;
+
+      while (*position_p != '\n')
+      {
+        TEST_ASSERT (*position_p != '\0');
+        position_p++;
+      }
+
+      line_p->name_size = (size_t) (position_p - line_p->name_p);
+    }
+
+    TEST_ASSERT (*position_p == '\n');
+    position_p++;
+  }
+} /* parse_dump */
+
+/**
+ * Check whether a field of a parsed line equals to a string.
+ *
+ * @return true - if the field equals to the string,
+ *         false - otherwise
+ */
+static bool
+is_field_equal (const char *field_p, /**< field (NULL if missing) */
+                size_t field_size, /**< size of the field */
+                const char *string_p) /**< string (NULL for a missing field) */
+{
+  if (field_p == NULL || string_p == NULL)
+  {
+    return field_p == string_p;
+  }
+
+  return field_size == strlen (string_p) && memcmp (field_p, string_p, field_size) == 0;
+} /* is_field_equal */
+
+/**
+ * Find the line of an object.
+ *
+ * @return the line - if it is found,
+ *         NULL - otherwise
+ */
+static const dump_line_t *
+find_object (uint32_t id) /**< identifier of the object */
+{
+  for (uint32_t i = 0; i < dump_line_count; i++)
+  {
+    if (dump_lines[i].type == 'O' && dump_lines[i].id == id)
+    {
+      return dump_lines + i;
+    }
+  }
+
+  return NULL;
+} /* find_object */
+
+/**
+ * Find the line of a reference.
+ *
+ * @return the line - if it is found,
+ *         NULL - otherwise
+ */
+static const dump_line_t *
+find_reference (char type, /**< 'E' or 'S' */
+                uint32_t id, /**< identifier of the referencing object */
+                const char *kind_p, /**< kind of the reference */
+                const char *name_p) /**< escaped name of the property (NULL if there is no name) */
+{
+  for (uint32_t i = 0; i < dump_line_count; i++)
+  {
+    const dump_line_t *line_p = dump_lines + i;
+
+    if (line_p->type == type
+        && line_p->id == id
+        && is_field_equal (line_p->kind_p, line_p->kind_size, kind_p)
+        && is_field_equal (line_p->name_p, line_p->name_size, name_p))
+    {
+      return line_p;
+    }
+  }
+
+  return NULL;
+} /* find_reference */
+
+/**
+ * Get a property of an object.
+ *
+ * @return value of the property
+ */
+static jerry_value_t
+get_property (jerry_value_t object_val, /**< object */
+              const char *name_p) /**< name of the property */
+{
+  jerry_value_t name_val = jerry_create_string ((const jerry_char_t *) name_p);
+  jerry_value_t result_val = jerry_get_property (object_val, name_val);
+  jerry_release_value (name_val);
+
+  TEST_ASSERT (jerry_value_is_object (result_val));
+  return result_val;
+} /* get_property */
+
+/**
+ * Get the identifier of an object used by the heap dump.
+ *
+ * @return identifier of the object
+ */
+static uint32_t
+get_object_id (jerry_value_t object_val) /**< object */
+{
+  jmem_cpointer_t object_cp;
+  ECMA_SET_NON_NULL_POINTER (object_cp, ecma_get_object_from_value (object_val));
+  return object_cp;
+} /* get_object_id */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+  TEST_RUN_SCRIPT (test_source_p);
+
+  jerry_value_t global_obj_val = jerry_get_global_object ();
+  jerry_value_t holder_val = get_property (global_obj_val, "holder");
+  jerry_value_t payload_val = get_property (holder_val, "payload");
+
+  uint32_t global_id = get_object_id (global_obj_val);
+  uint32_t holder_id = get_object_id (holder_val);
+  uint32_t payload_id = get_object_id (payload_val);
+
+  jerry_release_value (payload_val);
+  jerry_release_value (holder_val);
+  jerry_release_value (global_obj_val);
+
+  jerry_gc ();
+  jerry_heap_dump (collect_dump, &dump_size);
+  dump[dump_size] = '\0';
+
+  /* The dump is passed in several chunks. */
+  TEST_ASSERT (dump_chunks > 1);
+
+  parse_dump ();
+
+  /* The global object is referenced by the engine, the objects of the script only by other objects. */
+  const dump_line_t *global_p = find_object (global_id);
+  const dump_line_t *holder_p = find_object (holder_id);
+
+  TEST_ASSERT (global_p != NULL && global_p->ref_count > 0);
+  TEST_ASSERT (holder_p != NULL && holder_p->ref_count == 0);
+  TEST_ASSERT (is_field_equal (holder_p->kind_p, holder_p->kind_size, "object"));
+
+  /* Every referenced object is in the dump. */
+  for (uint32_t i = 0; i < dump_line_count; i++)
+  {
+    TEST_ASSERT (dump_lines[i].type != 'E' || find_object (dump_lines[i].target_id) != NULL);
+  }
+
+  /* References to objects and strings with the names of the properties. */
+  const dump_line_t *line_p = find_reference ('E', global_id, "property", "holder");
+  TEST_ASSERT (line_p != NULL && line_p->target_id == holder_id);
+
+  line_p = find_reference ('E', holder_id, "property", "payload");
+  TEST_ASSERT (line_p != NULL && line_p->target_id == payload_id);
+
+  line_p = find_reference ('E', payload_id, "property", "self");
+  TEST_ASSERT (line_p != NULL && line_p->target_id == holder_id);
+
+  line_p = find_reference ('S', payload_id, "property", "text");
+  TEST_ASSERT (line_p != NULL && line_p->size > 0);
+
+  TEST_ASSERT (find_reference ('S', global_id, "name", "holder") != NULL);
+  TEST_ASSERT (find_reference ('E', holder_id, "prototype", NULL) != NULL);
+
+  /* The accessor has a getter, whose scope is referenced by the function object. */
+  line_p = find_reference ('E', holder_id, "getter", "accessor");
+  TEST_ASSERT (line_p != NULL);
+  TEST_ASSERT (find_reference ('E', line_p->target_id, "scope", NULL) != NULL);
+  TEST_ASSERT (find_reference ('E', holder_id, "setter", "accessor") == NULL);
+
+  /* The new line and the backslash characters are escaped. */
+  TEST_ASSERT (find_reference ('S', holder_id, "name", "odd\\\\\\nname") != NULL);
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
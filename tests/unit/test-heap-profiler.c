@@ -0,0 +1,145 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jcontext.h"
+#include "jerry-api.h"
+#include "vm-heap-profiler.h"
+
+#include "test-common.h"
+
+/**
+ * Script whose functions allocate objects and strings on known lines
+ */
+static const char *test_source_p = ("var objects = [];\n"
+                                    "function makeObjects (count) {\n"
+                                    "  for (var i = 0; i < count; i++) {\n"
+                                    "    objects.push ({ value: i });\n"
+                                    "  }\n"
+                                    "}\n"
+                                    "function makeStrings (count) {\n"
+                                    "  var result = [];\n"
+                                    "  for (var i = 0; i < count; i++) {\n"
+                                    "    result.push ('item' + i);\n"
+                                    "  }\n"
+                                    "  return result;\n"
+                                    "}\n"
+                                    "makeObjects (100);\n"
+                                    "var strings = makeStrings (100);\n");
+
+#ifdef JERRY_HEAP_PROFILER
+
+/**
+ * Script which drops the objects and the strings
+ */
+static const char *test_release_source_p = "objects = undefined; strings = undefined;\n";
+
+/**
+ * Find an allocation site in the site table of the profiler.
+ *
+ * @return the site - if it is found,
+ *         NULL - otherwise
+ */
+static const jerry_heap_profiler_site_t *
+find_site (jmem_alloc_category_t category, /**< category of the allocated blocks */
+           const char *name_p, /**< name of the function, NULL for allocations outside of JavaScript code */
+           uint32_t line) /**< source line */
+{
+  size_t name_size = (name_p != NULL) ? strlen (name_p) : 0;
+
+  for (uint32_t i = 0; i < JERRY_HEAP_PROFILER_SITE_TABLE_SIZE; i++)
+  {
+    const jerry_heap_profiler_site_t *site_p = JERRY_HEAP_PROFILER_CONTEXT (sites) + i;
+    bool is_matching_location;
+
+    if (name_p == NULL)
+    {
+      is_matching_location = (site_p->function_line == VM_HEAP_PROFILER_NO_FRAME);
+    }
+    else
+    {
+      is_matching_location = (site_p->function_line != VM_HEAP_PROFILER_NO_FRAME
+                              && site_p->function_line != VM_HEAP_PROFILER_NO_LINE_INFO
+                              && site_p->line == line
+                              && site_p->name_size == name_size
+                              && memcmp (site_p->name, name_p, name_size) == 0);
+    }
+
+    if (site_p->is_used && site_p->category == category && is_matching_location)
+    {
+      return site_p;
+    }
+  }
+
+  return NULL;
+} /* find_site */
+
+#endif /* JERRY_HEAP_PROFILER */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  static jerry_char_t report[16 * 1024];
+
+  jerry_init (JERRY_INIT_EMPTY);
+  TEST_RUN_SCRIPT (test_source_p);
+
+#ifdef JERRY_HEAP_PROFILER
+  /* The report is not written into a too small buffer. */
+  TEST_ASSERT (jerry_heap_profiler_dump (report, 16) == 0);
+
+  size_t report_size = jerry_heap_profiler_dump (report, sizeof (report) - 1);
+  TEST_ASSERT (report_size > 0);
+
+  const char *header_p = "# live_bytes live_blocks allocated_bytes allocated_blocks category site\n";
+  TEST_ASSERT (memcmp (report, header_p, strlen (header_p)) == 0);
+
+  /* Each object has a property pair besides the object itself. */
+  const jerry_heap_profiler_site_t *objects_p = find_site (JMEM_ALLOC_CATEGORY_OBJECT, "makeObjects", 4);
+  const jerry_heap_profiler_site_t *pairs_p = find_site (JMEM_ALLOC_CATEGORY_PROPERTY_PAIR, "makeObjects", 4);
+  const jerry_heap_profiler_site_t *strings_p = find_site (JMEM_ALLOC_CATEGORY_STRING, "makeStrings", 10);
+  const jerry_heap_profiler_site_t *byte_code_p = find_site (JMEM_ALLOC_CATEGORY_BYTE_CODE, NULL, 0);
+
+  TEST_ASSERT (objects_p != NULL && objects_p->live_blocks >= 100 && objects_p->live_bytes >= 100 * 8);
+  TEST_ASSERT (pairs_p != NULL && pairs_p->live_blocks >= 100 && pairs_p->live_bytes >= 100 * 16);
+  TEST_ASSERT (strings_p != NULL && strings_p->live_blocks >= 100 && strings_p->live_bytes >= 100 * 8);
+  TEST_ASSERT (byte_code_p != NULL && byte_code_p->live_bytes > 0);
+  TEST_ASSERT (find_site (JMEM_ALLOC_CATEGORY_OBJECT, "unknownFunction", 1) == NULL);
+
+  uint64_t objects_allocated_bytes = objects_p->allocated_bytes;
+
+  /* The live bytes of the sites drop when the blocks are freed, the allocated bytes are kept. */
+  TEST_RUN_SCRIPT (test_release_source_p);
+  jerry_gc ();
+
+  /* The built-in push function, which is instantiated on its first access, is kept. */
+  TEST_ASSERT (objects_p->live_bytes < 100 * 8);
+  TEST_ASSERT (objects_p->allocated_bytes == objects_allocated_bytes);
+  TEST_ASSERT (pairs_p->live_bytes == 0 && pairs_p->live_blocks == 0);
+  TEST_ASSERT (strings_p->live_bytes == 0 && strings_p->live_blocks == 0);
+
+  /* The sites are discarded by a reset. */
+  TEST_ASSERT (jerry_reset (JERRY_INIT_EMPTY));
+
+  TEST_ASSERT (find_site (JMEM_ALLOC_CATEGORY_OBJECT, "makeObjects", 4) == NULL);
+  TEST_ASSERT (jerry_heap_profiler_dump (report, sizeof (report) - 1) > 0);
+#else /* !JERRY_HEAP_PROFILER */
+  TEST_ASSERT (jerry_heap_profiler_dump (report, sizeof (report)) == 0);
+#endif /* JERRY_HEAP_PROFILER */
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
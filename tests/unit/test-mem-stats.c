@@ -0,0 +1,105 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jerry-api.h"
+
+#include "test-common.h"
+
+/**
+ * Script which keeps objects, functions, floats, strings and a regular expression alive
+ */
+static const char *test_source_p = ("var objects = [];\n"
+                                    "for (var i = 0; i < 50; i++) {\n"
+                                    "  objects.push ({ value: i + 0.5, name: 'item' + i, f: function () {} });\n"
+                                    "}\n"
+                                    "var re = /a+b*c/g;\n");
+
+/**
+ * Script which drops the values created by the test script
+ */
+static const char *test_release_source_p = "objects = undefined; re = undefined;\n";
+
+/**
+ * Get the memory usage statistics of a memory type.
+ *
+ * @return statistics of the memory type
+ */
+static jerry_mem_type_stats_t
+get_stats (jerry_mem_type_t type) /**< memory type */
+{
+  jerry_mem_type_stats_t stats;
+  TEST_ASSERT (jerry_get_mem_type_stats (type, &stats));
+  TEST_ASSERT (stats.peak_allocated_bytes >= stats.allocated_bytes);
+  return stats;
+} /* get_stats */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  jerry_mem_type_stats_t stats;
+
+  if (!jerry_get_mem_type_stats (JERRY_MEM_TYPE_OBJECT, &stats))
+  {
+    /* The engine is built without memory statistics. */
+    jerry_cleanup ();
+    return 0;
+  }
+
+  TEST_ASSERT (!jerry_get_mem_type_stats (JERRY_MEM_TYPE__COUNT, &stats));
+
+  /* The built-ins are created by jerry_init. */
+  TEST_ASSERT (get_stats (JERRY_MEM_TYPE_EXTENDED_OBJECT).allocated_blocks > 0);
+  TEST_ASSERT (get_stats (JERRY_MEM_TYPE_LEXICAL_ENVIRONMENT).allocated_blocks > 0);
+
+  jerry_mem_type_stats_t objects_before = get_stats (JERRY_MEM_TYPE_OBJECT);
+  jerry_mem_type_stats_t functions_before = get_stats (JERRY_MEM_TYPE_EXTENDED_OBJECT);
+  jerry_mem_type_stats_t numbers_before = get_stats (JERRY_MEM_TYPE_NUMBER);
+  jerry_mem_type_stats_t strings_before = get_stats (JERRY_MEM_TYPE_STRING);
+
+  TEST_RUN_SCRIPT (test_source_p);
+  jerry_gc ();
+
+  jerry_mem_type_stats_t objects = get_stats (JERRY_MEM_TYPE_OBJECT);
+  jerry_mem_type_stats_t functions = get_stats (JERRY_MEM_TYPE_EXTENDED_OBJECT);
+  jerry_mem_type_stats_t numbers = get_stats (JERRY_MEM_TYPE_NUMBER);
+  jerry_mem_type_stats_t strings = get_stats (JERRY_MEM_TYPE_STRING);
+
+  TEST_ASSERT (objects.allocated_blocks >= objects_before.allocated_blocks + 50);
+  TEST_ASSERT (functions.allocated_blocks >= functions_before.allocated_blocks + 50);
+  TEST_ASSERT (numbers.allocated_blocks >= numbers_before.allocated_blocks + 50);
+  TEST_ASSERT (strings.allocated_blocks >= strings_before.allocated_blocks + 50);
+  TEST_ASSERT (get_stats (JERRY_MEM_TYPE_REGEXP_BYTE_CODE).allocated_bytes > 0);
+  TEST_ASSERT (get_stats (JERRY_MEM_TYPE_BYTE_CODE).allocated_bytes > 0);
+  TEST_ASSERT (get_stats (JERRY_MEM_TYPE_PROPERTY_PAIR).allocated_bytes > 0);
+
+  /* The live blocks are freed, but the peak and the number of allocations are kept. */
+  TEST_RUN_SCRIPT (test_release_source_p);
+  jerry_gc ();
+
+  jerry_mem_type_stats_t numbers_after = get_stats (JERRY_MEM_TYPE_NUMBER);
+
+  TEST_ASSERT (get_stats (JERRY_MEM_TYPE_OBJECT).allocated_blocks < objects.allocated_blocks);
+  TEST_ASSERT (get_stats (JERRY_MEM_TYPE_EXTENDED_OBJECT).allocated_blocks < functions.allocated_blocks);
+  TEST_ASSERT (numbers_after.allocated_blocks < numbers.allocated_blocks);
+  TEST_ASSERT (numbers_after.peak_allocated_bytes >= numbers.allocated_bytes);
+  TEST_ASSERT (numbers_after.alloc_count >= numbers.alloc_count);
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
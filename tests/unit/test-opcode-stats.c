@@ -0,0 +1,108 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jcontext.h"
+#include "jerry-api.h"
+
+#include "test-common.h"
+
+/**
+ * Script which calls a function ten times
+ */
+static const char *test_source_p = ("function f (x) {\n"
+                                    "  return x + 1;\n"
+                                    "}\n"
+                                    "var s = 0;\n"
+                                    "for (var i = 0; i < 10; i++) {\n"
+                                    "  s = f (s);\n"
+                                    "}\n");
+
+#ifdef JERRY_VM_OPCODE_STATS
+
+/**
+ * Check the totals of the opcode counters: every executed instruction is counted once,
+ * and it forms a pair with the previous instruction unless it starts a run.
+ */
+static void
+check_totals (uint64_t run_count) /**< number of runs since the counters are cleared */
+{
+  uint64_t opcode_total = 0;
+  uint64_t pair_total = JERRY_OPCODE_STATS_CONTEXT (dropped_pairs);
+  uint32_t pair_count = 0;
+
+  for (uint32_t i = 0; i < JERRY_OPCODE_STATS_COUNT; i++)
+  {
+    opcode_total += JERRY_OPCODE_STATS_CONTEXT (counts)[i];
+  }
+
+  for (uint32_t i = 0; i < JERRY_OPCODE_STATS_PAIR_TABLE_SIZE; i++)
+  {
+    if (JERRY_OPCODE_STATS_CONTEXT (pairs)[i].key != 0)
+    {
+      pair_total += JERRY_OPCODE_STATS_CONTEXT (pairs)[i].count;
+      pair_count++;
+    }
+  }
+
+  TEST_ASSERT (opcode_total == JERRY_OPCODE_STATS_CONTEXT (instruction_count));
+  TEST_ASSERT (pair_total + run_count == opcode_total);
+  TEST_ASSERT (pair_count == JERRY_OPCODE_STATS_CONTEXT (pair_count));
+} /* check_totals */
+
+#endif /* JERRY_VM_OPCODE_STATS */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  TEST_RUN_SCRIPT (test_source_p);
+
+#ifdef JERRY_VM_OPCODE_STATS
+  check_totals (1);
+
+  /* Call instructions are counted once, although they are dispatched twice. */
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_CALL1_PUSH_RESULT", NULL) == 10);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_RETURN", NULL) == 10);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_ADD", "CBC_RETURN") == 10);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_RETURN", "CBC_ASSIGN_SET_IDENT_BLOCK") == 10);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_RETURN", "CBC_ADD") == 0);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_UNKNOWN", NULL) == 0);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_ADD", "CBC_UNKNOWN") == 0);
+
+  /* The last instruction of a run does not form a pair with the first one of the next run. */
+  TEST_RUN_SCRIPT (test_source_p);
+  check_totals (2);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_CALL1_PUSH_RESULT", NULL) == 20);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_PUSH_NUMBER_0", NULL) == 4);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_RETURN_WITH_BLOCK", "CBC_PUSH_NUMBER_0") == 0);
+
+  TEST_ASSERT (jerry_opcode_stats_print ());
+
+  jerry_opcode_stats_reset ();
+  TEST_ASSERT (JERRY_OPCODE_STATS_CONTEXT (instruction_count) == 0);
+  check_totals (0);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_CALL1_PUSH_RESULT", NULL) == 0);
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_ADD", "CBC_RETURN") == 0);
+#else /* !JERRY_VM_OPCODE_STATS */
+  TEST_ASSERT (!jerry_opcode_stats_print ());
+  TEST_ASSERT (jerry_opcode_stats_get_count ("CBC_CALL1_PUSH_RESULT", NULL) == 0);
+#endif /* JERRY_VM_OPCODE_STATS */
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
@@ -0,0 +1,142 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jerry-api.h"
+#include "jerry-port.h"
+
+#include "test-common.h"
+
+/**
+ * Time spent by the native function in milliseconds
+ */
+#define NATIVE_BUSY_TIME 5.0
+
+/**
+ * Script which calls JavaScript functions, a native function and eval
+ */
+static const char *test_source_p = ("function add (a, b) { return a + b; }\n"
+                                    "var sum = 0;\n"
+                                    "for (var i = 0; i < 100; i++) { sum = add (sum, i); }\n"
+                                    "var o = { x: 1, y: 2 };\n"
+                                    "for (var i = 0; i < 100; i++) { sum += o.x + o.y; }\n"
+                                    "busy ();\n"
+                                    "eval ('sum + 1');\n");
+
+/**
+ * Runtime statistics queried by the native function
+ */
+static jerry_runtime_stats_t native_stats;
+
+/**
+ * Native function which keeps the engine busy for NATIVE_BUSY_TIME milliseconds
+ */
+static jerry_value_t
+busy_handler (const jerry_value_t func_obj_val, /**< function object */
+              const jerry_value_t this_val, /**< this value */
+              const jerry_value_t args_p[], /**< arguments list */
+              const jerry_length_t args_cnt) /**< arguments length */
+{
+  JERRY_UNUSED (func_obj_val);
+  JERRY_UNUSED (this_val);
+  JERRY_UNUSED (args_p);
+  JERRY_UNUSED (args_cnt);
+
+  double start_time = jerry_port_get_current_time ();
+
+  while (jerry_port_get_current_time () - start_time < NATIVE_BUSY_TIME)
+  {
+  }
+
+  jerry_get_runtime_stats (&native_stats);
+  return jerry_create_undefined ();
+} /* busy_handler */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+  jerry_runtime_stats_t stats;
+  jerry_get_runtime_stats (&stats);
+
+  /* The built-ins are created by jerry_init, but nothing is run. */
+  TEST_ASSERT (stats.object_count > 0);
+  TEST_ASSERT (stats.heap_allocated_size > 0);
+  TEST_ASSERT (stats.heap_peak_allocated_size >= stats.heap_allocated_size);
+
+#ifdef JERRY_RUNTIME_STATS
+  TEST_ASSERT (stats.parse_count == 0);
+  TEST_ASSERT (stats.execution_count == 0);
+  TEST_ASSERT (stats.native_call_count == 0);
+  TEST_ASSERT (stats.parse_time == 0 && stats.execution_time == 0 && stats.native_time == 0);
+#endif /* JERRY_RUNTIME_STATS */
+
+  size_t initial_string_count = stats.string_count;
+
+  jerry_value_t global_obj_val = jerry_get_global_object ();
+  jerry_value_t busy_val = jerry_create_external_function (busy_handler);
+
+  jerry_get_runtime_stats (&stats);
+  size_t string_count = stats.string_count;
+
+  jerry_value_t busy_name_val = jerry_create_string ((const jerry_char_t *) "busy");
+
+  jerry_get_runtime_stats (&stats);
+  TEST_ASSERT (stats.string_count == string_count + 1);
+
+  jerry_release_value (jerry_set_property (global_obj_val, busy_name_val, busy_val));
+  jerry_release_value (busy_name_val);
+  jerry_release_value (busy_val);
+  jerry_release_value (global_obj_val);
+
+  TEST_RUN_SCRIPT (test_source_p);
+
+  jerry_gc ();
+  jerry_get_runtime_stats (&stats);
+
+#ifdef JERRY_RUNTIME_STATS
+  /* The script and the eval code are compiled, the script, the functions and the eval code are executed. */
+  TEST_ASSERT (stats.parse_count == 2);
+  TEST_ASSERT (stats.execution_count == 102);
+  TEST_ASSERT (stats.native_call_count == 1);
+  TEST_ASSERT (stats.gc_count >= 1);
+  TEST_ASSERT (stats.gc_max_pause <= stats.gc_time);
+
+  /* The statistics queried by the native function include the time of the running phase. */
+  TEST_ASSERT (stats.native_time >= NATIVE_BUSY_TIME);
+  TEST_ASSERT (native_stats.native_time >= NATIVE_BUSY_TIME);
+  TEST_ASSERT (native_stats.execution_count == 101);
+
+#ifndef CONFIG_ECMA_LCACHE_DISABLE
+  TEST_ASSERT (stats.lcache_hits > 0);
+#endif /* !CONFIG_ECMA_LCACHE_DISABLE */
+#endif /* JERRY_RUNTIME_STATS */
+
+  TEST_ASSERT (stats.heap_peak_allocated_size >= stats.heap_allocated_size);
+
+  /* The statistics are cleared by jerry_reset. */
+  TEST_ASSERT (jerry_reset (JERRY_INIT_EMPTY));
+  jerry_get_runtime_stats (&stats);
+
+  TEST_ASSERT (stats.parse_count == 0);
+  TEST_ASSERT (stats.execution_count == 0);
+  TEST_ASSERT (stats.native_call_count == 0);
+  TEST_ASSERT (stats.string_count == initial_string_count);
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
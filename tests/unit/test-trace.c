@@ -0,0 +1,207 @@
+/* Copyright 2016 University of Szeged.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jerry-api.h"
+#include "vm-trace.h"
+
+#include "test-common.h"
+
+/**
+ * Buffer of the trace
+ */
+static jerry_char_t trace_buffer[1024 * 1024];
+
+#ifdef JERRY_TRACE
+
+/**
+ * Script which defines a function calling a native function
+ */
+static const char *test_source_p = ("function f (g) { return g (); }\n"
+                                    "var objects = [];\n"
+                                    "for (var i = 0; i < 100; i++) { objects.push ({ value: i }); }\n");
+
+/**
+ * Native function which calls a JavaScript function, this call is not a top-level call
+ */
+static jerry_value_t
+nested_call_handler (const jerry_value_t func_obj_val, /**< function object */
+                     const jerry_value_t this_val, /**< this value */
+                     const jerry_value_t args_p[], /**< arguments list */
+                     const jerry_length_t args_cnt) /**< arguments length */
+{
+  JERRY_UNUSED (func_obj_val);
+  JERRY_UNUSED (args_p);
+  JERRY_UNUSED (args_cnt);
+
+  jerry_value_t global_obj_val = jerry_get_global_object ();
+  jerry_value_t name_val = jerry_create_string ((const jerry_char_t *) "Object");
+  jerry_value_t object_func_val = jerry_get_property (global_obj_val, name_val);
+
+  jerry_value_t result_val = jerry_call_function (object_func_val, this_val, NULL, 0);
+  TEST_ASSERT (!jerry_value_has_error_flag (result_val));
+
+  jerry_release_value (object_func_val);
+  jerry_release_value (name_val);
+  jerry_release_value (global_obj_val);
+  return result_val;
+} /* nested_call_handler */
+
+/**
+ * Write the trace into the buffer.
+ *
+ * @return size of the trace
+ */
+static size_t
+dump_trace (void)
+{
+  size_t size = jerry_trace_dump (trace_buffer, sizeof (trace_buffer));
+  TEST_ASSERT (size > 0);
+  return size;
+} /* dump_trace */
+
+/**
+ * Count the events of a type which are kept in the ring buffer of the tracing.
+ *
+ * @return number of events
+ */
+static uint32_t
+count_events (vm_trace_event_type_t type) /**< type of the events */
+{
+  uint64_t event_count = JERRY_TRACE_CONTEXT (event_count);
+  uint64_t index = (event_count > JERRY_TRACE_BUFFER_SIZE) ? event_count - JERRY_TRACE_BUFFER_SIZE : 0;
+  uint32_t count = 0;
+
+  while (index < event_count)
+  {
+    if (JERRY_TRACE_CONTEXT (events)[index & (JERRY_TRACE_BUFFER_SIZE - 1)].type == type)
+    {
+      count++;
+    }
+
+    index++;
+  }
+
+  return count;
+} /* count_events */
+
+/**
+ * Find the first event of a type which is kept in the ring buffer of the tracing.
+ *
+ * @return the event - if it is found,
+ *         NULL - otherwise
+ */
+static const jerry_trace_event_t *
+find_event (vm_trace_event_type_t type) /**< type of the event */
+{
+  uint64_t event_count = JERRY_TRACE_CONTEXT (event_count);
+  uint64_t index = (event_count > JERRY_TRACE_BUFFER_SIZE) ? event_count - JERRY_TRACE_BUFFER_SIZE : 0;
+
+  while (index < event_count)
+  {
+    const jerry_trace_event_t *event_p = JERRY_TRACE_CONTEXT (events) + (index & (JERRY_TRACE_BUFFER_SIZE - 1));
+
+    if (event_p->type == type)
+    {
+      return event_p;
+    }
+
+    index++;
+  }
+
+  return NULL;
+} /* find_event */
+
+#endif /* JERRY_TRACE */
+
+int
+main (void)
+{
+  TEST_INIT ();
+
+  jerry_init (JERRY_INIT_EMPTY);
+
+#ifdef JERRY_TRACE
+  TEST_ASSERT (jerry_trace_start ());
+
+  /* No events are recorded yet. */
+  TEST_ASSERT (JERRY_TRACE_CONTEXT (event_count) == 0);
+  dump_trace ();
+
+  TEST_RUN_SCRIPT (test_source_p);
+
+  jerry_value_t global_obj_val = jerry_get_global_object ();
+  jerry_value_t name_val = jerry_create_string ((const jerry_char_t *) "f");
+  jerry_value_t f_val = jerry_get_property (global_obj_val, name_val);
+  jerry_value_t native_val = jerry_create_external_function (nested_call_handler);
+
+  jerry_value_t result_val = jerry_call_function (f_val, global_obj_val, &native_val, 1);
+  TEST_ASSERT (jerry_value_is_object (result_val));
+
+  jerry_release_value (result_val);
+  jerry_release_value (native_val);
+  jerry_release_value (f_val);
+  jerry_release_value (name_val);
+  jerry_release_value (global_obj_val);
+
+  jerry_gc ();
+
+  TEST_ASSERT (count_events (VM_TRACE_EVENT_PARSE) == 1);
+  TEST_ASSERT (count_events (VM_TRACE_EVENT_PARSE_STATEMENTS) == 1);
+  TEST_ASSERT (count_events (VM_TRACE_EVENT_PARSE_POST_PROCESSING) == 1);
+  TEST_ASSERT (count_events (VM_TRACE_EVENT_RUN) == 1);
+  TEST_ASSERT (count_events (VM_TRACE_EVENT_GC) >= 1);
+
+  /* The call of the native function is not a top-level call. */
+  TEST_ASSERT (count_events (VM_TRACE_EVENT_CALL) == 1);
+
+  /* The parse event records the size of the source, the gc event the objects before and after it. */
+  TEST_ASSERT (find_event (VM_TRACE_EVENT_PARSE)->args[0] == strlen (test_source_p));
+
+  const jerry_trace_event_t *gc_event_p = find_event (VM_TRACE_EVENT_GC);
+  TEST_ASSERT (gc_event_p->args[1] >= gc_event_p->args[2]);
+
+  size_t trace_size = dump_trace ();
+  TEST_ASSERT (!strncmp ((const char *) trace_buffer, "{\"traceEvents\":[", 16));
+
+  /* The events are kept when the buffer is too small. */
+  TEST_ASSERT (jerry_trace_dump (trace_buffer, trace_size - 1) == 0);
+  TEST_ASSERT (dump_trace () == trace_size);
+
+  /* No events are recorded after the tracing is stopped. */
+  uint64_t event_count = JERRY_TRACE_CONTEXT (event_count);
+
+  jerry_trace_stop ();
+  jerry_gc ();
+  TEST_ASSERT (JERRY_TRACE_CONTEXT (event_count) == event_count);
+
+  /* The oldest events are overwritten when the ring buffer is full. */
+  TEST_ASSERT (jerry_trace_start ());
+
+  for (uint32_t i = 0; i < 5000; i++)
+  {
+    jerry_gc ();
+  }
+
+  TEST_ASSERT (JERRY_TRACE_CONTEXT (event_count) == 5000);
+  TEST_ASSERT (count_events (VM_TRACE_EVENT_GC) == JERRY_TRACE_BUFFER_SIZE);
+  dump_trace ();
+#else /* !JERRY_TRACE */
+  TEST_ASSERT (!jerry_trace_start ());
+  TEST_ASSERT (jerry_trace_dump (trace_buffer, sizeof (trace_buffer)) == 0);
+#endif /* JERRY_TRACE */
+
+  jerry_cleanup ();
+  return 0;
+} /* main */
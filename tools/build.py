@@ -42,6 +42,12 @@ def add_build_args(parser):
     parser.add_argument('--mem-stress-test', choices=['on', 'off'], default='off', help='Enable mem-stress test (default: %(default)s)')
     parser.add_argument('--snapshot-save', choices=['on', 'off'], default='on', help='Allow to save snapshot files (default: %(default)s)')
     parser.add_argument('--snapshot-exec', choices=['on', 'off'], default='on', help='Allow to execute snapshot files (default: %(default)s)')
+    parser.add_argument('--gc-mark-bitmap', choices=['on', 'off'], default='off', help='Keep the GC marks in a bitmap outside of the objects (default: %(default)s)')
+    parser.add_argument('--cpu-profiler', choices=['on', 'off'], default='off', help='Enable the sampling CPU profiler (default: %(default)s)')
+    parser.add_argument('--opcode-stats', choices=['on', 'off'], default='off', help='Count the executed opcodes and opcode pairs (default: %(default)s)')
+    parser.add_argument('--heap-profiler', choices=['on', 'off'], default='off', help='Enable the allocation site heap profiler (default: %(default)s)')
+    parser.add_argument('--trace', choices=['on', 'off'], default='off', help='Enable the GC and heap timeline tracing (default: %(default)s)')
+    parser.add_argument('--runtime-stats', choices=['on', 'off'], default='off', help='Enable the runtime statistics (default: %(default)s)')
     parser.add_argument('--cmake-param', action='append', default=[], help='Add custom arguments to CMake')
     parser.add_argument('--compile-flag', action='append', default=[], help='Add custom compile flag')
     parser.add_argument('--linker-flag', action='append', default=[], help='Add custom linker flag')
@@ -77,6 +83,12 @@ def generate_build_options(arguments):
     build_options.append('-DFEATURE_MEM_STRESS_TEST=%s' % arguments.mem_stress_test.upper())
     build_options.append('-DFEATURE_SNAPSHOT_SAVE=%s' % arguments.snapshot_save.upper())
     build_options.append('-DFEATURE_SNAPSHOT_EXEC=%s' % arguments.snapshot_exec.upper())
+    build_options.append('-DFEATURE_GC_MARK_BITMAP=%s' % arguments.gc_mark_bitmap.upper())
+    build_options.append('-DFEATURE_CPU_PROFILER=%s' % arguments.cpu_profiler.upper())
+    build_options.append('-DFEATURE_VM_OPCODE_STATS=%s' % arguments.opcode_stats.upper())
+    build_options.append('-DFEATURE_HEAP_PROFILER=%s' % arguments.heap_profiler.upper())
+    build_options.append('-DFEATURE_TRACE=%s' % arguments.trace.upper())
+    build_options.append('-DFEATURE_RUNTIME_STATS=%s' % arguments.runtime_stats.upper())
     build_options.append('-DENABLE_ALL_IN_ONE=%s' % arguments.all_in_one.upper())
     build_options.append('-DENABLE_LTO=%s' % arguments.lto.upper())
     build_options.append('-DENABLE_STRIP=%s' % arguments.strip.upper())
@@ -0,0 +1,211 @@
+#!/usr/bin/env python
+
+# Copyright 2016 University of Szeged.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Computes the dominator tree and the retained sizes of a heap dump written
+# by jerry_heap_dump (or by the --heap-dump option of the jerry shell).
+#
+# The roots of the graph are the objects whose reference counter is greater
+# than zero. The retained size of an object is the size of the memory which
+# would be freed if the object were freed: its own size and the size of the
+# objects and strings which are only reachable through it.
+
+from __future__ import print_function
+
+import argparse
+import sys
+
+ROOT = 0
+
+class HeapGraph:
+    def __init__(self):
+        # Index 0 is the virtual root which references the roots of the garbage collector.
+        self.labels = ['(roots)']
+        self.sizes = [0]
+        self.edges = [[]]
+        self.names = [None]
+        self.indices = {}
+
+    def node(self, key):
+        index = self.indices.get(key)
+        if index is None:
+            index = len(self.labels)
+            self.indices[key] = index
+            self.labels.append(None)
+            self.sizes.append(0)
+            self.edges.append([])
+            self.names.append(None)
+        return index
+
+    def add_edge(self, from_index, to_index, name):
+        self.edges[from_index].append(to_index)
+        if name is not None and self.names[to_index] is None:
+            self.names[to_index] = name
+
+
+def unescape(name):
+    return name.replace('\\n', '\n').replace('\\\\', '\\')
+
+
+def parse_dump(dump_file):
+    graph = HeapGraph()
+
+    for line_number, line in enumerate(dump_file, 1):
+        line = line.rstrip('\n')
+
+        if not line or line.startswith('#'):
+            continue
+
+        if line.startswith('O '):
+            fields = line.split(' ', 4)
+            index = graph.node(('O', fields[1]))
+            graph.labels[index] = fields[2]
+            graph.sizes[index] = int(fields[3])
+            if int(fields[4]) > 0:
+                graph.add_edge(ROOT, index, None)
+        elif line.startswith('E '):
+            fields = line.split(' ', 4)
+            name = unescape(fields[4]) if len(fields) > 4 else None
+            graph.add_edge(graph.node(('O', fields[1])), graph.node(('O', fields[2])), name)
+        elif line.startswith('S '):
+            fields = line.split(' ', 5)
+            index = graph.node(('S', fields[2]))
+            graph.labels[index] = 'string'
+            graph.sizes[index] = int(fields[3])
+            if fields[4] == 'name' and len(fields) > 5:
+                # The names of the properties are the best description of strings.
+                graph.names[index] = graph.names[index] or unescape(fields[5])
+            graph.add_edge(graph.node(('O', fields[1])), index, None)
+        else:
+            raise ValueError('line %d: unknown record: %s' % (line_number, line))
+
+    return graph
+
+
+def reverse_postorder(graph):
+    order = []
+    visited = [False] * len(graph.labels)
+    visited[ROOT] = True
+    stack = [(ROOT, 0)]
+
+    while stack:
+        index, edge_index = stack[-1]
+        edges = graph.edges[index]
+
+        if edge_index < len(edges):
+            stack[-1] = (index, edge_index + 1)
+            target = edges[edge_index]
+            if not visited[target]:
+                visited[target] = True
+                stack.append((target, 0))
+        else:
+            stack.pop()
+            order.append(index)
+
+    order.reverse()
+    return order
+
+
+def compute_dominators(graph, order):
+    # Iterative algorithm of Cooper, Harvey and Kennedy.
+    position = [-1] * len(graph.labels)
+    for i, index in enumerate(order):
+        position[index] = i
+
+    predecessors = [[] for _ in graph.labels]
+    for index in order:
+        for target in graph.edges[index]:
+            predecessors[target].append(index)
+
+    idom = [None] * len(graph.labels)
+    idom[ROOT] = ROOT
+
+    def intersect(a, b):
+        while a != b:
+            while position[a] > position[b]:
+                a = idom[a]
+            while position[b] > position[a]:
+                b = idom[b]
+        return a
+
+    changed = True
+    while changed:
+        changed = False
+        for index in order[1:]:
+            new_idom = None
+            for predecessor in predecessors[index]:
+                if idom[predecessor] is None:
+                    continue
+                new_idom = predecessor if new_idom is None else intersect(predecessor, new_idom)
+            if idom[index] != new_idom:
+                idom[index] = new_idom
+                changed = True
+
+    return idom
+
+
+def compute_retained_sizes(graph, order, idom):
+    retained = list(graph.sizes)
+    for index in reversed(order[1:]):
+        retained[idom[index]] += retained[index]
+    return retained
+
+
+def describe(graph, index):
+    name = graph.names[index]
+    if name is None:
+        return graph.labels[index]
+    return '%s %s' % (graph.labels[index], name.replace('\n', '\\n'))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compute the retained sizes of a jerry heap dump')
+    parser.add_argument('dump', help='heap dump file')
+    parser.add_argument('--top', type=int, default=20, help='number of the largest retainers (default: %(default)s)')
+    parser.add_argument('--by-type', action='store_true', help='print the self sizes summed by type')
+    args = parser.parse_args()
+
+    with open(args.dump) as dump_file:
+        graph = parse_dump(dump_file)
+
+    order = reverse_postorder(graph)
+    idom = compute_dominators(graph, order)
+    retained = compute_retained_sizes(graph, order, idom)
+
+    unreachable = len(graph.labels) - len(order)
+    print('# nodes: %d, reachable bytes: %d, unreachable nodes: %d' % (len(order) - 1, retained[ROOT], unreachable))
+
+    if args.by_type:
+        totals = {}
+        for index in order[1:]:
+            count, size = totals.get(graph.labels[index], (0, 0))
+            totals[graph.labels[index]] = (count + 1, size + graph.sizes[index])
+
+        print('# self_bytes count type')
+        for label, (count, size) in sorted(totals.items(), key=lambda item: -item[1][1]):
+            print('%d %d %s' % (size, count, label))
+        return
+
+    print('# retained_bytes self_bytes dominator_depth node')
+    depth = [0] * len(graph.labels)
+    for index in order[1:]:
+        depth[index] = depth[idom[index]] + 1
+
+    for index in sorted(order[1:], key=lambda index: -retained[index])[:args.top]:
+        print('%d %d %d %s' % (retained[index], graph.sizes[index], depth[index], describe(graph, index)))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
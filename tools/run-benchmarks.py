@@ -0,0 +1,309 @@
+#!/usr/bin/env python
+
+# Copyright 2016 University of Szeged.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Runs the benchmark suite with one engine, or compares two engines.
+#
+# Each benchmark is run a few times to warm up the caches, then it is run
+# repeatedly, and the runs of the engines are interleaved, so a drift of the
+# machine's speed affects both engines. The CPU time (user + system) and the
+# peak RSS of every run are collected, and reported by their median, median
+# absolute deviation (MAD) and a distribution free 95% confidence interval of
+# the median. The peak RSS is polled from /proc, so it can miss the growth of
+# the last few milliseconds of a run. The peak heap usage is measured by an
+# extra run with --mem-stats when the engine is built with memory statistics.
+
+from __future__ import print_function
+
+import argparse
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from settings import *
+
+BENCHMARKS_DIR = path.join(PROJECT_DIR, 'tests', 'benchmarks', 'jerry')
+
+# Quantile of the standard normal distribution for a 95% confidence interval
+Z_95 = 1.96
+
+# Interval of polling the state of a running engine in seconds
+POLL_INTERVAL = 0.002
+
+timer = getattr(time, 'perf_counter', time.time)
+
+
+class BenchmarkError(Exception):
+    pass
+
+
+def get_arguments():
+    parser = argparse.ArgumentParser(description='Run the benchmarks with one engine or compare two engines')
+    parser.add_argument('engines', nargs='+', metavar='ENGINE', help='engine to measure, a second engine is compared to the first one')
+    parser.add_argument('--benchmarks', nargs='+', metavar='FILE', help='benchmarks to run (default: all benchmarks in %s)' % path.relpath(BENCHMARKS_DIR, PROJECT_DIR))
+    parser.add_argument('--warmup', type=int, default=1, help='number of runs before the measurement (default: %(default)s)')
+    parser.add_argument('--repeats', type=int, default=10, help='number of measured runs (default: %(default)s)')
+    parser.add_argument('--timeout', type=float, default=60, help='timeout of a run in seconds (default: %(default)s)')
+    parser.add_argument('--json', metavar='FILE', help='write the results as JSON to FILE')
+
+    args = parser.parse_args()
+
+    if len(args.engines) > 2:
+        parser.error('at most two engines can be compared')
+
+    if args.repeats < 1 or args.warmup < 0:
+        parser.error('the number of repeats must be positive, and the number of warmup runs must not be negative')
+
+    return args
+
+
+def read_peak_rss(pid):
+    # The high water mark of the resident set of the process in kilobytes (Linux only).
+    try:
+        with open('/proc/%d/status' % pid) as status_file:
+            for line in status_file:
+                if line.startswith('VmHWM:'):
+                    return int(line.split()[1])
+    except (IOError, OSError, ValueError):
+        pass
+    return None
+
+
+def run_once(engine, options, benchmark, timeout):
+    command = [engine] + options + [benchmark]
+
+    with tempfile.TemporaryFile() as output_file:
+        start = timer()
+        process = subprocess.Popen(command, stdout=output_file, stderr=subprocess.STDOUT)
+        deadline = start + timeout
+        peak_rss = None
+
+        # The maximum RSS reported by wait4 includes the memory of this script, which is
+        # inherited through fork, so the high water mark of the engine is polled instead.
+        while True:
+            pid, status, usage = os.wait4(process.pid, os.WNOHANG)
+            if pid != 0:
+                break
+
+            rss = read_peak_rss(process.pid)
+            if rss is not None and (peak_rss is None or rss > peak_rss):
+                peak_rss = rss
+
+            if timer() > deadline:
+                process.kill()
+
+            time.sleep(POLL_INTERVAL)
+
+        wall_time = timer() - start
+        process.returncode = status
+
+        output_file.seek(0)
+        output = output_file.read().decode('utf-8', 'replace')
+
+    if not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0:
+        raise BenchmarkError('%s failed with status %d:\n%s' % (' '.join(command), status, output))
+
+    return {
+        'time': usage.ru_utime + usage.ru_stime,
+        'wall_time': wall_time,
+        'rss': peak_rss if peak_rss is not None else usage.ru_maxrss,
+        'output': output,
+    }
+
+
+def measure_peak_heap(engine, benchmark, timeout):
+    output = run_once(engine, ['--mem-stats'], benchmark, timeout)['output']
+    match = re.search(r'Peak allocated = (\d+) bytes', output)
+    return int(match.group(1)) if match else None
+
+
+def median(values):
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return (ordered[middle - 1] + ordered[middle]) / 2.0
+
+
+def summarize(values):
+    ordered = sorted(values)
+    count = len(ordered)
+    center = median(ordered)
+
+    # Distribution free confidence interval of the median from the order statistics.
+    spread = Z_95 * math.sqrt(count) / 2.0
+    low = max(int(math.floor(count / 2.0 - spread)) - 1, 0)
+    high = min(int(math.ceil(1 + count / 2.0 + spread)) - 1, count - 1)
+
+    return {
+        'median': center,
+        'mad': median([abs(value - center) for value in ordered]),
+        'ci_low': ordered[low],
+        'ci_high': ordered[high],
+        'min': ordered[0],
+        'max': ordered[-1],
+        'samples': values,
+    }
+
+
+def compare(old, new):
+    if old['median'] <= 0 or old['ci_low'] <= 0:
+        return None
+
+    ratio = new['median'] / float(old['median'])
+    ratio_low = new['ci_low'] / float(old['ci_high'])
+    ratio_high = new['ci_high'] / float(old['ci_low'])
+
+    if ratio_high < 1:
+        verdict = 'better'
+    elif ratio_low > 1:
+        verdict = 'worse'
+    else:
+        verdict = 'same'
+
+    return {'ratio': ratio, 'ci_low': ratio_low, 'ci_high': ratio_high, 'verdict': verdict}
+
+
+def geometric_mean(values):
+    if not values:
+        return None
+    return math.exp(sum(math.log(value) for value in values) / len(values))
+
+
+def run_benchmark(engines, benchmark, args):
+    samples = [{'time': [], 'wall_time': [], 'rss': []} for _ in engines]
+
+    for _ in range(args.warmup):
+        for engine in engines:
+            run_once(engine, [], benchmark, args.timeout)
+
+    for repeat in range(args.repeats):
+        # Alternate the order of the engines, so neither of them always runs first.
+        order = list(range(len(engines)))
+        if repeat % 2:
+            order.reverse()
+
+        for index in order:
+            result = run_once(engines[index], [], benchmark, args.timeout)
+            for key in samples[index]:
+                samples[index][key].append(result[key])
+
+    results = []
+    for index, engine in enumerate(engines):
+        result = dict((key, summarize(values)) for key, values in samples[index].items())
+        result['peak_heap'] = measure_peak_heap(engine, benchmark, args.timeout)
+        results.append(result)
+
+    return results
+
+
+def format_time(summary):
+    return '%.3fs +-%.3f [%.3f, %.3f]' % (summary['median'], summary['mad'], summary['ci_low'], summary['ci_high'])
+
+
+def format_change(comparison):
+    if comparison is None:
+        return 'n/a'
+    return '%+.1f%% [%+.1f%%, %+.1f%%] %s' % ((comparison['ratio'] - 1) * 100,
+                                             (comparison['ci_low'] - 1) * 100,
+                                             (comparison['ci_high'] - 1) * 100,
+                                             comparison['verdict'])
+
+
+def format_peak_heap(peak_heap):
+    return '-' if peak_heap is None else str(peak_heap)
+
+
+def main():
+    args = get_arguments()
+
+    for engine in args.engines:
+        if not os.access(engine, os.X_OK):
+            print('%s: engine is not executable' % engine)
+            return 1
+
+    benchmarks = args.benchmarks
+    if not benchmarks:
+        benchmarks = sorted(path.join(BENCHMARKS_DIR, name) for name in os.listdir(BENCHMARKS_DIR) if name.endswith('.js'))
+
+    is_compare = len(args.engines) == 2
+    report = {
+        'engines': args.engines,
+        'warmup': args.warmup,
+        'repeats': args.repeats,
+        'benchmarks': {},
+    }
+    time_ratios = []
+    failed = 0
+
+    if is_compare:
+        print('%-48s | %-38s | %-36s | %-30s | %s' % ('Benchmark', 'Time (median +-MAD [95% CI])',
+                                                     'Time change', 'RSS change (kB)', 'Peak heap (bytes)'))
+    else:
+        print('%-48s | %-38s | %-10s | %s' % ('Benchmark', 'Time (median +-MAD [95% CI])', 'RSS (kB)', 'Peak heap (bytes)'))
+
+    for benchmark in benchmarks:
+        name = path.splitext(path.basename(benchmark))[0]
+
+        try:
+            results = run_benchmark(args.engines, benchmark, args)
+        except BenchmarkError as error:
+            print('%-48s | FAILED' % name)
+            print(str(error), file=sys.stderr)
+            failed += 1
+            continue
+
+        entry = {'engines': results}
+
+        if is_compare:
+            old, new = results
+            entry['time_change'] = compare(old['time'], new['time'])
+            entry['rss_change'] = compare(old['rss'], new['rss'])
+
+            if entry['time_change']:
+                time_ratios.append(entry['time_change']['ratio'])
+
+            print('%-48s | %-38s | %-36s | %-30s | %s -> %s' % (name, format_time(new['time']),
+                                                                format_change(entry['time_change']),
+                                                                '%d -> %d %s' % (old['rss']['median'], new['rss']['median'],
+                                                                                 format_change(entry['rss_change']).split(' ')[-1]),
+                                                                format_peak_heap(old['peak_heap']),
+                                                                format_peak_heap(new['peak_heap'])))
+        else:
+            result = results[0]
+            print('%-48s | %-38s | %-10d | %s' % (name, format_time(result['time']), result['rss']['median'],
+                                                  format_peak_heap(result['peak_heap'])))
+
+        report['benchmarks'][name] = entry
+
+    if is_compare:
+        gmean = geometric_mean(time_ratios)
+        report['time_ratio_geometric_mean'] = gmean
+        if gmean is not None:
+            print('Geometric mean of the time ratios: %.4f (%+.2f%%)' % (gmean, (gmean - 1) * 100))
+
+    if args.json:
+        with open(args.json, 'w') as json_file:
+            json.dump(report, json_file, indent=2, sort_keys=True)
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
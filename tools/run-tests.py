@@ -60,6 +60,7 @@ class Options:
 jerry_unittests_options = [
                            Options('unittests', ['--unittests']),
                            Options('unittests-debug', ['--unittests', '--debug']),
+                           Options('unittests-debug-diagnostics', ['--unittests', '--debug', '--cpu-profiler=on', '--opcode-stats=on', '--heap-profiler=on', '--mem-stats=on', '--trace=on', '--runtime-stats=on']),
                           ]
 
 # Test options for jerry-tests
@@ -68,6 +69,14 @@ jerry_tests_options = [
                         Options('jerry_tests-snapshot', ['--snapshot-save=on', '--snapshot-exec=on'], ['--snapshot']),
                         Options('jerry_tests-debug', ['--debug']),
                         Options('jerry_tests-debug-snapshot', ['--debug', '--snapshot-save=on', '--snapshot-exec=on'], ['--snapshot']),
+                        Options('jerry_tests-debug-gc-mark-bitmap', ['--debug', '--gc-mark-bitmap=on']),
+                        Options('jerry_tests-debug-cpu-profiler', ['--debug', '--cpu-profiler=on', '--snapshot-save=on', '--snapshot-exec=on'], ['--snapshot']),
+                        Options('jerry_tests-debug-opcode-stats', ['--debug', '--opcode-stats=on']),
+                        Options('jerry_tests-debug-heap-profiler', ['--debug', '--heap-profiler=on']),
+                        Options('jerry_tests-debug-trace', ['--debug', '--trace=on']),
+                        Options('jerry_tests-debug-runtime-stats', ['--debug', '--runtime-stats=on']),
+                        Options('jerry_tests-debug-snapshot-optimized', ['--debug', '--snapshot-save=on', '--snapshot-exec=on'], ['--snapshot', '--optimize-snapshot']),
+                        Options('jerry_tests-debug-snapshot-mmap', ['--debug', '--snapshot-save=on', '--snapshot-exec=on'], ['--snapshot-mmap']),
                       ]
 
 # Test options for jerry-test-suite
@@ -16,7 +16,7 @@
 # limitations under the License.
 
 # Usage:
-#       ./tools/runners/run-test-suite.sh ENGINE TESTS [--snapshot] ENGINE_ARGS....
+#       ./tools/runners/run-test-suite.sh ENGINE TESTS [--snapshot | --snapshot-mmap] ENGINE_ARGS....
 
 TIMEOUT=${TIMEOUT:=5}
 
@@ -33,12 +33,21 @@ TEST_FILES=$OUTPUT_DIR/$TESTS_BASENAME.files
 TEST_FAILED=$OUTPUT_DIR/$TESTS_BASENAME.failed
 TEST_PASSED=$OUTPUT_DIR/$TESTS_BASENAME.passed
 
-if [ "$1" == "--snapshot" ]
+if [ "$1" == "--snapshot" ] || [ "$1" == "--snapshot-mmap" ]
 then
     TEST_FILES="$TEST_FILES.snapshot"
     TEST_FAILED="$TEST_FAILED.snapshot"
     TEST_PASSED="$TEST_PASSED.snapshot"
     IS_SNAPSHOT=true;
+    SNAPSHOT_OPTION="$1"
+    EXEC_SNAPSHOT_OPTION="--exec-snapshot"
+
+    if [ "$1" == "--snapshot-mmap" ]
+    then
+        # The snapshot is executed in place, and its functions are loaded on their first call
+        EXEC_SNAPSHOT_OPTION="--exec-snapshot-mmap"
+    fi
+
     shift
 fi
 
@@ -125,8 +134,8 @@ do
         then
             echo "[$tested/$total] $cmd_line: PASS"
 
-            cmd_line="${ENGINE#$ROOT_DIR} $ENGINE_ARGS --exec-snapshot $SNAPSHOT_TEMP"
-            ( ulimit -t $TIMEOUT; $ENGINE $ENGINE_ARGS --exec-snapshot $SNAPSHOT_TEMP &> $ENGINE_TEMP )
+            cmd_line="${ENGINE#$ROOT_DIR} $ENGINE_ARGS $EXEC_SNAPSHOT_OPTION $SNAPSHOT_TEMP"
+            ( ulimit -t $TIMEOUT; $ENGINE $ENGINE_ARGS $EXEC_SNAPSHOT_OPTION $SNAPSHOT_TEMP &> $ENGINE_TEMP )
             status_code=$?
         fi
 
@@ -167,7 +176,7 @@ ratio=$(echo $passed*100/$total | bc)
 
 if [ "$IS_SNAPSHOT" == true ]
 then
-    ENGINE_ARGS="--snapshot $ENGINE_ARGS"
+    ENGINE_ARGS="$SNAPSHOT_OPTION $ENGINE_ARGS"
 fi
 
 echo "[summary] ${ENGINE#$ROOT_DIR} $ENGINE_ARGS ${TESTS#$ROOT_DIR}: $passed PASS, $failed FAIL, $total total, $ratio% success"